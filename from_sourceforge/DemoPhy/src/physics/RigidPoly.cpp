@@ -29,4 +29,12 @@ gpx::math::Vector<2> RigidPoly::normal(gpx::math::const_PointRef<2> pre, gpx::ma
 	return result;
 }
 
+bool RigidPoly::query(gpx::math::const_PointRef<2> pre, gpx::math::const_PointRef<2> post, Intersection & result) const
+{
+	if (!CPoly::query(pre, post, result))
+		return false;
+	rotateToGlobal(result.normal);
+	return true;
+}
+
 }
@@ -24,6 +24,8 @@ class RigidPoly : public gpx::phy2d::cnewton::pmepp2_s::CRigidBody,
 
 	public:
 		virtual gpx::math::Vector<2> normal(gpx::math::const_PointRef<2> pre, gpx::math::const_PointRef<2> post) const;
+
+		virtual bool query(gpx::math::const_PointRef<2> pre, gpx::math::const_PointRef<2> post, Intersection & result) const;
 };
 
 }
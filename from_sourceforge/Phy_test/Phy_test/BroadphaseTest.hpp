@@ -0,0 +1,296 @@
+#ifndef BROADPHASETEST_HPP
+#define BROADPHASETEST_HPP
+
+#include "ColliderPrecisionTest.hpp"
+
+#include <gpx/phy2d/cnewton/pmepp2_s/AABBTree.hpp>
+#include <gpx/phy2d/cnewton/pmepp2_s/BruteForceBroadphase.hpp>
+#include <gpx/phy2d/cnewton/pmepp2_s/SweepAndPruneBroadphase.hpp>
+#include <gpx/phy2d/cnewton/pmepp2_s/SpatialHashBroadphase.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * AABBTree query callback, which collects data of found leaves.
+ */
+struct BroadphaseTestCollector
+{
+	std::vector<int> found;
+
+	void operator()(int data)
+	{
+		found.push_back(data);
+	}
+};
+
+/**
+ * Query AABBTree and compare sorted results with boxes, which overlap query box.
+ */
+bool broadphaseTestQuery(const gpx::phy2d::cnewton::pmepp2_s::AABBTree<int> & tree, const std::vector<bool> & present, const std::vector<gpx::real_t> & boxes, const gpx::real_t * min, const gpx::real_t * max, int line)
+{
+	BroadphaseTestCollector collector;
+	tree.query(min, max, collector);
+	std::sort(collector.found.begin(), collector.found.end());
+
+	std::vector<int> expected;
+	for (std::size_t i = 0; i < present.size(); i++)
+		if (present[i] && boxes[i * 4] <= max[0] && min[0] <= boxes[i * 4 + 2] && boxes[i * 4 + 1] <= max[1] && min[1] <= boxes[i * 4 + 3])
+			expected.push_back(static_cast<int>(i));
+
+	if (collector.found != expected) {
+		cerr << "Error: AABBTree query (" << min[0] << ", " << min[1] << ") - (" << max[0] << ", " << max[1] << ") found: " << collector.found.size() << " (" << expected.size() << ") line: " << line << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Unit boxes placed in 8 x 8 grid with gaps of unit width are inserted into AABBTree.
+ * Tree is queried with boxes, which cover grid cells, touch boxes at their edges or fall
+ * into gaps. Then every third box is removed and every fifth box is moved to a new place
+ * with refit, and queries are repeated. Results are compared with brute force search.
+ */
+void AABBTreeTest()
+{
+	using gpx::real_t;
+	typedef gpx::phy2d::cnewton::pmepp2_s::AABBTree<int> Tree;
+
+	cout << "AABBTreeTest: testing AABBTree insertions, removals and refits type: " << typeid(real_t).name() << endl;
+
+	static const int GRID = 8;
+	static const real_t QUERIES[][4] = {
+		{0.0, 0.0, 1.0, 1.0},		//single box
+		{1.0, 1.0, 2.0, 2.0},		//touches corners of four boxes
+		{1.25, 1.25, 1.75, 1.75},	//gap
+		{1.5, 0.0, 1.75, 16.0},		//gap column
+		{0.5, 0.5, 4.5, 4.5},		//nine boxes
+		{-10.0, -10.0, 20.0, 20.0},	//all boxes
+		{20.0, 20.0, 30.0, 30.0},	//outside
+		{13.0, 13.0, 15.5, 15.5}	//corner
+	};
+
+	std::size_t failures = 0;
+
+	Tree tree;
+	std::vector<real_t> boxes;
+	std::vector<bool> present;
+	std::vector<Tree::node_t> leaves;
+	for (int i = 0; i < GRID * GRID; i++) {
+		real_t min[2] = {static_cast<real_t>(2 * (i % GRID)), static_cast<real_t>(2 * (i / GRID))};
+		real_t max[2] = {min[0] + real_t(1.0), min[1] + real_t(1.0)};
+		boxes.push_back(min[0]);
+		boxes.push_back(min[1]);
+		boxes.push_back(max[0]);
+		boxes.push_back(max[1]);
+		present.push_back(true);
+		leaves.push_back(tree.insert(min, max, i));
+	}
+
+	if (tree.size() != static_cast<std::size_t>(GRID * GRID)) {
+		cerr << "Error: AABBTree size: " << tree.size() << " (" << GRID * GRID << ") line: " << __LINE__ << endl;
+		failures++;
+	}
+	//balanced tree of 64 leaves should not be much higher than 6
+	if (tree.height() > 12) {
+		cerr << "Error: AABBTree height: " << tree.height() << " line: " << __LINE__ << endl;
+		failures++;
+	}
+	for (std::size_t q = 0; q < sizeof(QUERIES) / sizeof(QUERIES[0]); q++)
+		if (!broadphaseTestQuery(tree, present, boxes, QUERIES[q], QUERIES[q] + 2, __LINE__))
+			failures++;
+
+	for (int i = 0; i < GRID * GRID; i += 3) {
+		tree.remove(leaves[i]);
+		present[i] = false;
+	}
+	for (int i = 1; i < GRID * GRID; i += 5) {
+		if (!present[i])
+			continue;
+		//move box diagonally by half of grid
+		for (int c = 0; c < 4; c++)
+			boxes[i * 4 + c] += static_cast<real_t>(GRID) * real_t(0.5);
+		tree.refit(leaves[i], & boxes[i * 4], & boxes[i * 4 + 2]);
+		if (tree.data(leaves[i]) != i) {
+			cerr << "Error: AABBTree leaf data: " << tree.data(leaves[i]) << " (" << i << ") line: " << __LINE__ << endl;
+			failures++;
+		}
+	}
+
+	std::size_t count = static_cast<std::size_t>(std::count(present.begin(), present.end(), true));
+	if (tree.size() != count) {
+		cerr << "Error: AABBTree size: " << tree.size() << " (" << count << ") line: " << __LINE__ << endl;
+		failures++;
+	}
+	for (std::size_t q = 0; q < sizeof(QUERIES) / sizeof(QUERIES[0]); q++)
+		if (!broadphaseTestQuery(tree, present, boxes, QUERIES[q], QUERIES[q] + 2, __LINE__))
+			failures++;
+
+	//removed leaves should be reused by new insertions
+	for (int i = 0; i < GRID * GRID; i += 3) {
+		leaves[i] = tree.insert(& boxes[i * 4], & boxes[i * 4 + 2], i);
+		present[i] = true;
+	}
+	for (std::size_t q = 0; q < sizeof(QUERIES) / sizeof(QUERIES[0]); q++)
+		if (!broadphaseTestQuery(tree, present, boxes, QUERIES[q], QUERIES[q] + 2, __LINE__))
+			failures++;
+
+	if (failures == 0 && !silent)
+		cout << "OK: AABBTreeTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: AABBTreeTest failures: " << failures << endl;
+}
+
+/**
+ * Boxes of random sizes scattered randomly, some of them movable and some fixed,
+ * together with unbounded walls. Movables wander randomly, fixed boxes are occasionally
+ * moved and refitted, and in the middle of the run objects are removed and handle of
+ * removed movable is reused by a new one. Candidate pairs found by sweep and prune and
+ * spatial hash broadphases (with auto-tuned and with fixed cell size) are compared with
+ * those found by brute force broadphase each frame.
+ */
+void BroadphaseTest()
+{
+	using gpx::real_t;
+	namespace NNS = gpx::phy2d::cnewton::pmepp2_s;
+
+	cout << "BroadphaseTest: comparing candidate pairs with brute force broadphase type: " << typeid(real_t).name() << endl;
+
+	static const std::size_t SHAPES = 4;
+	static const std::size_t MOVABLES = 80;
+	static const std::size_t FIXED = 40;
+	static const int FRAMES = 100;
+	static const int REMOVAL_FRAME = FRAMES / 2;
+	static const real_t HALF_SIZES[SHAPES][2] = {{0.1, 0.1}, {0.5, 0.25}, {0.3, 0.8}, {1.5, 0.2}};
+
+	std::srand(1);
+
+	std::size_t failures = 0;
+
+	NNS::BruteForceBroadphase bruteForce;
+	NNS::SweepAndPruneBroadphase sweepAndPrune;
+	NNS::SpatialHashBroadphase spatialHash;
+	NNS::SpatialHashBroadphase spatialHashFixedCell(0.7);
+	NNS::Broadphase * broadphases[] = {& bruteForce, & sweepAndPrune, & spatialHash, & spatialHashFixedCell};
+	static const char * BROADPHASE_NAMES[] = {"BruteForceBroadphase", "SweepAndPruneBroadphase", "SpatialHashBroadphase", "SpatialHashBroadphase(0.7)"};
+	static const std::size_t BROADPHASES = sizeof(broadphases) / sizeof(broadphases[0]);
+
+	real_t coords[SHAPES][8];
+	gpx::model::VertexData<2> vertices[SHAPES];
+	for (std::size_t s = 0; s < SHAPES; s++) {
+		for (std::size_t v = 0; v < 4; v++) {
+			coords[s][v * 2] = (v == 0 || v == 3) ? -HALF_SIZES[s][0] : HALF_SIZES[s][0];
+			coords[s][v * 2 + 1] = v < 2 ? -HALF_SIZES[s][1] : HALF_SIZES[s][1];
+		}
+		vertices[s].setData(coords[s], 4);
+	}
+
+	NNS::Broadphase::handle_t handle = 0;
+	ColliderPrecisionTestWall left(ColliderPrecisionTestWall::LEFT);
+	ColliderPrecisionTestWall bottom(ColliderPrecisionTestWall::BOTTOM);
+	left.setPos(0.0, 0.0);
+	bottom.setPos(0.0, 0.0);
+	for (std::size_t b = 0; b < BROADPHASES; b++) {
+		broadphases[b]->addFixed(& left, handle);
+		broadphases[b]->addFixed(& bottom, handle + 1);
+	}
+	handle += 2;
+
+	std::vector<ColliderPrecisionTestPoly *> fixed;
+	std::vector<NNS::Broadphase::handle_t> fixedHandles;
+	for (std::size_t i = 0; i < FIXED; i++) {
+		fixed.push_back(new ColliderPrecisionTestPoly(vertices[std::rand() % SHAPES], 1.0));
+		fixed[i]->setPos(static_cast<real_t>(0.1 * (std::rand() % 200)), static_cast<real_t>(0.1 * (std::rand() % 200)));
+		fixed[i]->setAngle(static_cast<real_t>(0.1 * (std::rand() % 32)));
+		fixedHandles.push_back(handle++);
+		for (std::size_t b = 0; b < BROADPHASES; b++)
+			broadphases[b]->addFixed(fixed[i], fixedHandles[i]);
+	}
+
+	std::vector<ColliderPrecisionTestPoly *> movables;
+	std::vector<NNS::Broadphase::handle_t> movableHandles;
+	for (std::size_t i = 0; i < MOVABLES; i++) {
+		movables.push_back(new ColliderPrecisionTestPoly(vertices[std::rand() % SHAPES], 1.0));
+		movables[i]->setPos(static_cast<real_t>(0.1 * (std::rand() % 200)), static_cast<real_t>(0.1 * (std::rand() % 200)));
+		movableHandles.push_back(handle++);
+		for (std::size_t b = 0; b < BROADPHASES; b++)
+			broadphases[b]->addMovable(movables[i], movableHandles[i]);
+	}
+
+	std::size_t total = 0;
+	for (int frame = 0; frame < FRAMES; frame++) {
+		//move post-collision states of movables
+		for (std::size_t i = 0; i < movables.size(); i++) {
+			movables[i]->swapBuffers();
+			movables[i]->setPos(movables[i]->pos()[0] + static_cast<real_t>(0.05 * (std::rand() % 11 - 5)), movables[i]->pos()[1] + static_cast<real_t>(0.05 * (std::rand() % 11 - 5)));
+			movables[i]->setAngle(movables[i]->angle() + static_cast<real_t>(0.05 * (std::rand() % 3 - 1)));
+			movables[i]->swapBuffers();
+		}
+
+		if (frame == REMOVAL_FRAME) {
+			//remove movable and fixed object and reuse handle of removed movable
+			for (std::size_t b = 0; b < BROADPHASES; b++) {
+				broadphases[b]->removeMovable(movableHandles[0]);
+				broadphases[b]->removeFixed(fixedHandles[0]);
+			}
+			delete movables[0];
+			movables[0] = new ColliderPrecisionTestPoly(vertices[SHAPES - 1], 1.0);
+			movables[0]->setPos(10.0, 10.0);
+			for (std::size_t b = 0; b < BROADPHASES; b++)
+				broadphases[b]->addMovable(movables[0], movableHandles[0]);
+			delete fixed[0];
+			fixed.erase(fixed.begin());
+			fixedHandles.erase(fixedHandles.begin());
+			spatialHashFixedCell.setCellSize(2.5);
+		}
+
+		if (frame % 10 == 5) {
+			ColliderPrecisionTestPoly * obj = fixed[static_cast<std::size_t>(frame / 10) % fixed.size()];
+			obj->setPos(obj->pos()[0] + static_cast<real_t>(0.3 * (frame % 7) - 1.0), obj->pos()[1] + real_t(0.5));
+			for (std::size_t b = 0; b < BROADPHASES; b++)
+				broadphases[b]->refitFixed(fixedHandles[static_cast<std::size_t>(frame / 10) % fixed.size()]);
+		}
+
+		NNS::Broadphase::PairsContainer reference;
+		for (std::size_t b = 0; b < BROADPHASES; b++) {
+			broadphases[b]->update();
+			NNS::Broadphase::PairsContainer pairs;
+			broadphases[b]->pairs(pairs);
+			if (b == 0) {
+				reference.swap(pairs);
+				total += reference.size();
+			} else if (pairs != reference) {
+				cerr << "Error: " << BROADPHASE_NAMES[b] << " frame: " << frame << " pairs: " << pairs.size() << " (" << reference.size() << ") line: " << __LINE__ << endl;
+				failures++;
+			}
+		}
+	}
+
+	//each movable is a candidate of both unbounded walls, so pairs of bounded objects have to come on top of these
+	if (total <= static_cast<std::size_t>(FRAMES) * 2 * MOVABLES) {
+		cerr << "Error: BroadphaseTest candidate pairs: " << total << " line: " << __LINE__ << endl;
+		failures++;
+	}
+	if (!silent)
+		cout << "candidate pairs in " << FRAMES << " frames: " << total << endl;
+
+	for (std::size_t b = 0; b < BROADPHASES; b++) {
+		for (std::size_t i = 0; i < movables.size(); i++)
+			broadphases[b]->removeMovable(movableHandles[i]);
+		for (std::size_t i = 0; i < fixed.size(); i++)
+			broadphases[b]->removeFixed(fixedHandles[i]);
+		broadphases[b]->removeFixed(0);
+		broadphases[b]->removeFixed(1);
+	}
+	for (std::size_t i = 0; i < movables.size(); i++)
+		delete movables[i];
+	for (std::size_t i = 0; i < fixed.size(); i++)
+		delete fixed[i];
+
+	if (failures == 0 && !silent)
+		cout << "OK: BroadphaseTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: BroadphaseTest failures: " << failures << endl;
+}
+
+#endif // BROADPHASETEST_HPP
@@ -0,0 +1,79 @@
+#ifndef COLLIDERALLOCATIONTEST_HPP
+#define COLLIDERALLOCATIONTEST_HPP
+
+#include "ColliderPrecisionTest.hpp"
+#include "AllocationCounter.hpp"
+
+/**
+ * Twelve unit boxes stacked in four columns of three boxes, dropped onto the ground
+ * between two walls from a small height. Once the stacks have settled, clusters keep
+ * their sizes, so that Collider should run solely on storage grown during earlier
+ * frames. Scene is run with each LCP solver and heap allocations are counted over
+ * a sequence of frames after warm-up.
+ */
+void ColliderAllocationTest()
+{
+	using gpx::real_t;
+	namespace NNS = gpx::phy2d::cnewton::pmepp2_s;
+
+	cout << "ColliderAllocationTest: counting steady state allocations type: " << typeid(real_t).name() << endl;
+
+	static const std::size_t COLUMNS = 4;
+	static const std::size_t ROWS = 3;
+	static const int WARM_UP_STEPS = 400;
+	static const int COUNTED_STEPS = 200;
+	static const NNS::Collider::solver_t SOLVERS[] = {NNS::Collider::NN_SOLVER, NNS::Collider::PGS_SOLVER, NNS::Collider::DANTZIG_SOLVER};
+	static const char * SOLVER_NAMES[] = {"NN_SOLVER", "PGS_SOLVER", "DANTZIG_SOLVER"};
+
+	std::size_t failures = 0;
+
+	for (std::size_t s = 0; s < sizeof(SOLVERS) / sizeof(SOLVERS[0]); s++) {
+		NNS::Collider collider;
+		collider.setSolver(SOLVERS[s]);
+		ColliderPrecisionTestWall left(ColliderPrecisionTestWall::LEFT);
+		ColliderPrecisionTestWall right(ColliderPrecisionTestWall::RIGHT);
+		ColliderPrecisionTestWall bottom(ColliderPrecisionTestWall::BOTTOM);
+		left.setPos(0.0, 0.0);
+		right.setPos(10.0, 0.0);
+		bottom.setPos(0.0, 0.0);
+		collider.addFixed(& left);
+		collider.addFixed(& right);
+		collider.addFixed(& bottom);
+
+		real_t coords[8] = {-0.5, -0.5, 0.5, -0.5, 0.5, 0.5, -0.5, 0.5};
+		gpx::model::VertexData<2> vertices;
+		vertices.setData(coords, 4);
+		gpx::phy2d::Force gravity(real_t(0.0), real_t(-10.0));
+		std::vector<ColliderPrecisionTestPoly *> boxes;
+		for (std::size_t i = 0; i < COLUMNS * ROWS; i++) {
+			boxes.push_back(new ColliderPrecisionTestPoly(vertices, 1.0));
+			boxes[i]->setPos(static_cast<real_t>(1.5 + 2.0 * static_cast<double>(i % COLUMNS)), static_cast<real_t>(0.51 + 1.01 * static_cast<double>(i / COLUMNS)));
+			boxes[i]->mountForce(& gravity, gpx::math::Point<2>());
+			collider.addMovable(boxes[i]);
+		}
+
+		for (int step = 0; step < WARM_UP_STEPS; step++)
+			collider.update(0.01);
+		{
+			AllocationCounter allocations;
+			for (int step = 0; step < COUNTED_STEPS; step++)
+				collider.update(0.01);
+			if (allocations.count() != 0) {
+				cerr << "Error: Collider solver: " << SOLVER_NAMES[s] << " allocations: " << allocations.count() << " in " << COUNTED_STEPS << " steps line: " << __LINE__ << endl;
+				failures++;
+			}
+		}
+
+		for (std::size_t i = 0; i < boxes.size(); i++) {
+			collider.removeMovable(boxes[i]);
+			delete boxes[i];
+		}
+	}
+
+	if (failures == 0 && !silent)
+		cout << "OK: ColliderAllocationTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: ColliderAllocationTest failures: " << failures << endl;
+}
+
+#endif // COLLIDERALLOCATIONTEST_HPP
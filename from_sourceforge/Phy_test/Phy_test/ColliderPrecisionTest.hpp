@@ -0,0 +1,245 @@
+#ifndef COLLIDERPRECISIONTEST_HPP
+#define COLLIDERPRECISIONTEST_HPP
+
+#include <gpx/phy2d/Force.hpp>
+#include <gpx/phy2d/cdetect/interseg/CPoly.hpp>
+#include <gpx/phy2d/cnewton/pmepp2_s/CRigidBody.hpp>
+#include <gpx/phy2d/cnewton/pmepp2_s/CMaterialBody.hpp>
+#include <gpx/phy2d/cnewton/pmepp2_s/Collider.hpp>
+#include <gpx/model/functions.hpp>
+
+#include <iomanip>
+#include <limits>
+#include <vector>
+
+/**
+ * Half-plane wall. Wall occupies half-plane on the outer side of its position, which is
+ * selected by wall side.
+ */
+class ColliderPrecisionTestWall : public gpx::phy2d::cnewton::pmepp2_s::CMaterialBody,
+		public virtual gpx::phy2d::cdetect::interseg::ICPoly
+{
+	public:
+		enum side_t {
+			LEFT,
+			RIGHT,
+			BOTTOM
+		};
+
+	public:
+		ColliderPrecisionTestWall(side_t side):
+			CMaterialBody(std::numeric_limits<gpx::real_t>::infinity()),
+			m_side(side)
+		{
+		}
+
+		element_t elements() const
+		{
+			return 1;
+		}
+
+		const ICPoly * element(element_t ) const
+		{
+			return this;
+		}
+
+		const gpx::model::VertexData<2> & cvertices() const
+		{
+			return m_vertices;
+		}
+
+		bool test(gpx::math::const_PointRef<2> pre, gpx::math::const_PointRef<2> ) const
+		{
+			switch (m_side) {
+				case LEFT:
+					return pre[0] < 0.0;
+				case RIGHT:
+					return pre[0] > 0.0;
+				default:
+					return pre[1] < 0.0;
+			}
+		}
+
+		gpx::math::Vector<2> normal(gpx::math::const_PointRef<2> , gpx::math::const_PointRef<2> ) const
+		{
+			switch (m_side) {
+				case LEFT:
+					return gpx::math::Vector<2>(gpx::real_t(1.0), gpx::real_t(0.0));
+				case RIGHT:
+					return gpx::math::Vector<2>(gpx::real_t(-1.0), gpx::real_t(0.0));
+				default:
+					return gpx::math::Vector<2>(gpx::real_t(0.0), gpx::real_t(1.0));
+			}
+		}
+
+	private:
+		side_t m_side;
+		gpx::model::VertexData<2> m_vertices;
+};
+
+/**
+ * Rigid polygon. Normals and intersections are found in local coordinates of polygon, so
+ * they are rotated to global coordinates.
+ */
+class ColliderPrecisionTestPoly : public gpx::phy2d::cnewton::pmepp2_s::CRigidBody,
+		public gpx::phy2d::cdetect::interseg::CPoly<gpx::model::NONE>
+{
+	typedef gpx::phy2d::cdetect::interseg::CPoly<gpx::model::NONE> CPoly;
+
+	public:
+		ColliderPrecisionTestPoly(const gpx::model::VertexData<2> & vertices, gpx::real_t mass):
+			CRigidBody(mass, 0.5 * mass * gpx::model::sqboundr(vertices)),
+			CPoly(vertices)
+		{
+		}
+
+		gpx::math::Vector<2> normal(gpx::math::const_PointRef<2> pre, gpx::math::const_PointRef<2> post) const
+		{
+			gpx::math::Vector<2> result(CPoly::normal(pre, post));
+			rotateToGlobal(result);
+			return result;
+		}
+
+		bool query(gpx::math::const_PointRef<2> pre, gpx::math::const_PointRef<2> post, Intersection & result) const
+		{
+			if (!CPoly::query(pre, post, result))
+				return false;
+			rotateToGlobal(result.normal);
+			return true;
+		}
+};
+
+/**
+ * Trajectory tolerance. Reference trajectory has been recorded by double precision build,
+ * so double precision builds should reproduce it up to the last printed digits. Single
+ * precision trajectories depart from it when boxes hit each other and then they stay
+ * within about a millimetre.
+ */
+template <typename T>
+T colliderPrecisionTestTolerance();
+
+template <>
+inline
+float colliderPrecisionTestTolerance<float>()
+{
+	return 5.0e-3f;
+}
+
+template <>
+inline
+double colliderPrecisionTestTolerance<double>()
+{
+	return 1.0e-6;
+}
+
+/**
+ * Unit boxes falling onto the ground between two walls: a box landing flat, two tilted
+ * ones and a pair of boxes stacked on top of each other. Scene is run by Collider with
+ * default settings in precision selected by GPX_REAL and positions and angles of boxes
+ * are compared with reference trajectory. If not silent, trajectory is printed in format
+ * of reference table.
+ */
+void ColliderPrecisionTest()
+{
+	using gpx::real_t;
+	namespace NNS = gpx::phy2d::cnewton::pmepp2_s;
+
+	cout << "ColliderPrecisionTest: comparing trajectories with double precision reference type: " << typeid(real_t).name() << endl;
+
+	static const std::size_t BOXES = 4;
+	static const int STEPS = 150;
+	static const int SAMPLE_STEPS = 10;
+	static const double INITIAL[BOXES][3] = {
+		{2.0, 1.0, 0.1},
+		{5.0, 0.75, 0.0},
+		{5.2, 2.0, 0.05},
+		{8.0, 1.5, -0.2}
+	};
+	//positions and angles of boxes recorded every SAMPLE_STEPS steps by double precision build
+	static const double REFERENCE[STEPS / SAMPLE_STEPS][BOXES * 3] = {
+		{2.000000000, 0.945000000, 0.100000000, 5.000000000, 0.695000000, 0.000000000, 5.200000000, 1.945000000, 0.050000000, 8.000000000, 1.445000000, -0.200000000},
+		{2.000000000, 0.790000000, 0.100000000, 5.000000000, 0.540000000, 0.000000000, 5.200000000, 1.790000000, 0.050000000, 8.000000000, 1.290000000, -0.200000000},
+		{2.000000000, 0.551654355, 0.070183018, 5.000000000, 0.501000000, 0.000000000, 5.200000000, 1.535000000, 0.050000000, 8.000000000, 1.035000000, -0.200000000},
+		{2.000000000, 0.503857172, 0.004934734, 4.997664954, 0.501000000, 0.000000000, 5.202443027, 1.514545873, -0.043775577, 8.000000000, 0.680000000, -0.200000000},
+		{2.000000000, 0.500367555, -0.000063205, 4.992230436, 0.501000000, 0.000000000, 5.207877545, 1.503605679, -0.007035064, 8.000000000, 0.503117698, 0.005849069},
+		{2.000000000, 0.500367555, -0.000063205, 4.985928549, 0.501000000, 0.000000000, 5.214181686, 1.501823853, 0.000146666, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.979581837, 0.501000000, 0.000000000, 5.220528505, 1.501440406, 0.000880135, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.973231063, 0.501000000, 0.000000000, 5.226880102, 1.501456236, -0.000376020, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.966852588, 0.501000000, 0.000000000, 5.233258577, 1.501452973, -0.000382544, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.960447994, 0.501000000, 0.000000000, 5.239663171, 1.501449580, -0.000389327, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.954016344, 0.501000000, 0.000000000, 5.246094820, 1.501446050, -0.000396384, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.947556647, 0.501000000, 0.000000000, 5.252554517, 1.501442373, -0.000403735, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.941067851, 0.501000000, 0.000000000, 5.259043314, 1.501438540, -0.000411398, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.934548836, 0.501000000, 0.000000000, 5.265562328, 1.501434540, -0.000419395, 8.000000000, 0.500502059, 0.000594506},
+		{2.000000000, 0.500367555, -0.000063205, 4.927998416, 0.501000000, 0.000000000, 5.272112749, 1.501430361, -0.000427750, 8.000000000, 0.500502059, 0.000594506}
+	};
+
+	std::size_t failures = 0;
+
+	NNS::Collider collider;
+	ColliderPrecisionTestWall left(ColliderPrecisionTestWall::LEFT);
+	ColliderPrecisionTestWall right(ColliderPrecisionTestWall::RIGHT);
+	ColliderPrecisionTestWall bottom(ColliderPrecisionTestWall::BOTTOM);
+	left.setPos(0.0, 0.0);
+	right.setPos(10.0, 0.0);
+	bottom.setPos(0.0, 0.0);
+	collider.addFixed(& left);
+	collider.addFixed(& right);
+	collider.addFixed(& bottom);
+
+	real_t coords[8] = {-0.5, -0.5, 0.5, -0.5, 0.5, 0.5, -0.5, 0.5};
+	gpx::model::VertexData<2> vertices;
+	vertices.setData(coords, 4);
+	gpx::phy2d::Force gravity(real_t(0.0), real_t(-10.0));
+	std::vector<ColliderPrecisionTestPoly *> boxes;
+	for (std::size_t i = 0; i < BOXES; i++) {
+		boxes.push_back(new ColliderPrecisionTestPoly(vertices, 1.0));
+		boxes[i]->setPos(static_cast<real_t>(INITIAL[i][0]), static_cast<real_t>(INITIAL[i][1]));
+		boxes[i]->setAngle(static_cast<real_t>(INITIAL[i][2]));
+		boxes[i]->mountForce(& gravity, gpx::math::Point<2>());
+		collider.addMovable(boxes[i]);
+	}
+
+	real_t tol = colliderPrecisionTestTolerance<real_t>();
+	for (int s = 1; s <= STEPS; s++) {
+		collider.update(0.01);
+		if (s % SAMPLE_STEPS != 0)
+			continue;
+		if (!silent)
+			cout << "\t\t{";
+		for (std::size_t i = 0; i < BOXES; i++) {
+			real_t sample[3] = {boxes[i]->pos()[0], boxes[i]->pos()[1], boxes[i]->angle()};
+			for (std::size_t c = 0; c < 3; c++) {
+				double reference = REFERENCE[s / SAMPLE_STEPS - 1][i * 3 + c];
+				if (std::abs(static_cast<double>(sample[c]) - reference) > tol) {
+					cerr << "Error: Collider step: " << s << " box: " << i << " coordinate: " << c << " " << sample[c] << " (" << reference << ") line: " << __LINE__ << endl;
+					failures++;
+				}
+				if (!silent)
+					cout << std::fixed << std::setprecision(9) << static_cast<double>(sample[c]) << (i * 3 + c + 1 < BOXES * 3 ? ", " : "");
+			}
+		}
+		if (!silent)
+			cout << (s < STEPS ? "}," : "}") << endl;
+	}
+
+	//boxes should come to rest on the ground (third one on top of the second one)
+	static const double REST[BOXES] = {0.5, 0.5, 1.5, 0.5};
+	for (std::size_t i = 0; i < BOXES; i++)
+		if (std::abs(static_cast<double>(boxes[i]->pos()[1]) - REST[i]) > 0.01) {
+			cerr << "Error: Collider box: " << i << " rests at: " << boxes[i]->pos()[1] << " (" << REST[i] << ") line: " << __LINE__ << endl;
+			failures++;
+		}
+
+	for (std::size_t i = 0; i < BOXES; i++) {
+		collider.removeMovable(boxes[i]);
+		delete boxes[i];
+	}
+
+	if (failures == 0 && !silent)
+		cout << "OK: ColliderPrecisionTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: ColliderPrecisionTest failures: " << failures << endl;
+}
+
+#endif // COLLIDERPRECISIONTEST_HPP
@@ -0,0 +1,120 @@
+#ifndef CONTACTCACHETEST_HPP
+#define CONTACTCACHETEST_HPP
+
+#include "ColliderPrecisionTest.hpp"
+
+#include <gpx/phy2d/cnewton/pmepp2_s/Introspector.hpp>
+
+/**
+ * Twelve unit boxes stacked in four columns of three boxes, solved by projected
+ * Gauss-Seidel solver. Once the stacks have settled, contacts keep their keys from
+ * frame to frame, so that each of them should be found in contact cache. Iterations of
+ * the solver are counted with warm starting disabled and enabled; impulses cached from
+ * previous frame should let the solver converge in fewer iterations. Finally a box is
+ * removed and entries referring to it should be evicted from the cache.
+ */
+void ContactCacheTest()
+{
+	using gpx::real_t;
+	namespace NNS = gpx::phy2d::cnewton::pmepp2_s;
+
+	cout << "ContactCacheTest: warm starting projected Gauss-Seidel solver type: " << typeid(real_t).name() << endl;
+
+	static const std::size_t COLUMNS = 4;
+	static const std::size_t ROWS = 3;
+	static const int WARM_UP_STEPS = 400;
+	static const int COUNTED_STEPS = 100;
+
+	std::size_t failures = 0;
+	std::size_t iterations[2] = {0, 0};
+
+	for (int warm = 0; warm < 2; warm++) {
+		NNS::Collider collider;
+		NNS::Introspector introspector;
+		collider.setIntrospector(introspector);
+		collider.setSolver(NNS::Collider::PGS_SOLVER);
+		collider.setWarmStarting(warm != 0);
+		ColliderPrecisionTestWall left(ColliderPrecisionTestWall::LEFT);
+		ColliderPrecisionTestWall right(ColliderPrecisionTestWall::RIGHT);
+		ColliderPrecisionTestWall bottom(ColliderPrecisionTestWall::BOTTOM);
+		left.setPos(0.0, 0.0);
+		right.setPos(10.0, 0.0);
+		bottom.setPos(0.0, 0.0);
+		collider.addFixed(& left);
+		collider.addFixed(& right);
+		collider.addFixed(& bottom);
+
+		real_t coords[8] = {-0.5, -0.5, 0.5, -0.5, 0.5, 0.5, -0.5, 0.5};
+		gpx::model::VertexData<2> vertices;
+		vertices.setData(coords, 4);
+		gpx::phy2d::Force gravity(real_t(0.0), real_t(-10.0));
+		std::vector<ColliderPrecisionTestPoly *> boxes;
+		for (std::size_t i = 0; i < COLUMNS * ROWS; i++) {
+			boxes.push_back(new ColliderPrecisionTestPoly(vertices, 1.0));
+			boxes[i]->setPos(static_cast<real_t>(1.5 + 2.0 * static_cast<double>(i % COLUMNS)), static_cast<real_t>(0.51 + 1.01 * static_cast<double>(i / COLUMNS)));
+			boxes[i]->mountForce(& gravity, gpx::math::Point<2>());
+			collider.addMovable(boxes[i]);
+		}
+
+		for (int step = 0; step < WARM_UP_STEPS; step++)
+			collider.update(0.01);
+		introspector.resetLCPStats();
+		collider.contactCache().resetStats();
+		for (int step = 0; step < COUNTED_STEPS; step++)
+			collider.update(0.01);
+		iterations[warm] = introspector.lcpIterationCount();
+
+		if (introspector.lcpSolveCount() == 0) {
+			cerr << "Error: Collider has not used PGS solver warm starting: " << warm << " line: " << __LINE__ << endl;
+			failures++;
+		}
+
+		if (warm) {
+			//keys of resting contacts should be stable, so that all of them are found in cache
+			const NNS::ContactCache & cache = collider.contactCache();
+			if (cache.hitCount() == 0 || cache.missCount() != 0) {
+				cerr << "Error: ContactCache hits: " << cache.hitCount() << " misses: " << cache.missCount() << " line: " << __LINE__ << endl;
+				failures++;
+			}
+
+			//removing top box of the first column should evict its contacts with the box below
+			std::size_t size = cache.size();
+			ColliderPrecisionTestPoly * top = boxes[(ROWS - 1) * COLUMNS];
+			collider.removeMovable(top);
+			boxes.erase(boxes.begin() + (ROWS - 1) * COLUMNS);
+			delete top;
+			if (cache.size() >= size) {
+				cerr << "Error: ContactCache size after removal: " << cache.size() << " (" << size << ") line: " << __LINE__ << endl;
+				failures++;
+			}
+
+			//remaining contacts should still be found in cache
+			collider.update(0.01);
+			collider.contactCache().resetStats();
+			collider.update(0.01);
+			if (cache.hitCount() == 0 || cache.missCount() != 0) {
+				cerr << "Error: ContactCache after removal hits: " << cache.hitCount() << " misses: " << cache.missCount() << " line: " << __LINE__ << endl;
+				failures++;
+			}
+		}
+
+		for (std::size_t i = 0; i < boxes.size(); i++) {
+			collider.removeMovable(boxes[i]);
+			delete boxes[i];
+		}
+	}
+
+	if (!silent)
+		cout << "PGS iterations in " << COUNTED_STEPS << " steps cold: " << iterations[0] << " warm: " << iterations[1] << endl;
+	if (iterations[1] >= iterations[0]) {
+		cerr << "Error: warm started PGS iterations: " << iterations[1] << " (cold: " << iterations[0] << ") line: " << __LINE__ << endl;
+		failures++;
+	}
+
+	if (failures == 0 && !silent)
+		cout << "OK: ContactCacheTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: ContactCacheTest failures: " << failures << endl;
+}
+
+#endif // CONTACTCACHETEST_HPP
@@ -0,0 +1,46 @@
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+QMAKE_CXXFLAGS += -std=c++11
+unix: QMAKE_CXXFLAGS += -pthread
+unix: LIBS += -pthread
+
+DEFINES += GPX_DYNAMIC
+#precision must match the one Phy library has been built with
+#DEFINES += GPX_REAL=float
+
+#X
+INCLUDEPATH += $$PWD/../../gpx/X/wc/include
+DEPENDPATH += $$PWD/../../gpx/X/wc/include
+
+#Eigen (required by eigen math backend only)
+INCLUDEPATH += $$PWD/../../Eigen/include
+DEPENDPATH += $$PWD/../../Eigen/include
+
+#Phy
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../gpx-build/Phy/wc/release -llibgpx-phy
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../gpx-build/Phy/wc/debug -llibgpx-phy
+else:unix: LIBS += -L$$PWD/../../gpx-build/Phy/wc -llibgpx-phy
+INCLUDEPATH += $$PWD/../../gpx/Phy/wc/include
+DEPENDPATH += $$PWD/../../gpx/Phy/wc/include
+
+#allocation counter shared with X_math_test
+INCLUDEPATH += $$PWD/../../X_math_test/X_math_test
+DEPENDPATH += $$PWD/../../X_math_test/X_math_test
+
+SOURCES += main.cpp \
+    ../../X_math_test/X_math_test/AllocationCounter.cpp \
+    tests.hpp \
+    ColliderPrecisionTest.hpp \
+    ColliderAllocationTest.hpp \
+    ContactCacheTest.hpp \
+    BroadphaseTest.hpp
+
+HEADERS += \
+    ../../X_math_test/X_math_test/AllocationCounter.hpp \
+    tests.hpp \
+    ColliderPrecisionTest.hpp \
+    ColliderAllocationTest.hpp \
+    ContactCacheTest.hpp \
+    BroadphaseTest.hpp
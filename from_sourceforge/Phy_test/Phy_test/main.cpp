@@ -0,0 +1,22 @@
+#include "tests.hpp"
+#include "ColliderPrecisionTest.hpp"
+#include "ColliderAllocationTest.hpp"
+#include "ContactCacheTest.hpp"
+#include "BroadphaseTest.hpp"
+
+int main()
+{
+#ifdef NDEBUG
+	cout << "NDEBUG" << endl;
+#endif
+
+//	silent = false;
+
+	ColliderPrecisionTest();
+	ColliderAllocationTest();
+	ContactCacheTest();
+	AABBTreeTest();
+	BroadphaseTest();
+
+	return 0;
+}
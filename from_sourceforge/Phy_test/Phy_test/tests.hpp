@@ -0,0 +1,23 @@
+#ifndef TESTS_HPP
+#define TESTS_HPP
+
+#include <iostream>
+#include <typeinfo>
+#include <cmath>
+
+#define GPX_LOG_INIT_FUNC myLogInit
+
+#include <gpx/platform.hpp>
+#include <gpx/log.hpp>
+
+using namespace std;
+
+inline
+void myLogInit(gpx::log::Log * log)
+{
+	log->combinedStream().attachStream(std::cout);
+}
+
+bool silent = true;
+
+#endif // TESTS_HPP
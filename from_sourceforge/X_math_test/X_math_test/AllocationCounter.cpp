@@ -0,0 +1,97 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+AllocationCounter * AllocationCounter::Active = 0;
+
+AllocationCounter::AllocationCounter():
+	m_count(0)
+{
+	Active = this;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+	Active = 0;
+}
+
+std::size_t AllocationCounter::count() const
+{
+	return m_count;
+}
+
+void AllocationCounter::Allocated()
+{
+	AllocationCounter * active = Active;
+	if (active)
+		active->m_count++;
+}
+
+namespace {
+
+void * countedAlloc(std::size_t size)
+{
+	AllocationCounter::Allocated();
+	return std::malloc(size ? size : 1);
+}
+
+}
+
+void * operator new(std::size_t size)
+{
+	void * ptr = countedAlloc(size);
+	if (ptr == 0)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void * operator new[](std::size_t size)
+{
+	void * ptr = countedAlloc(size);
+	if (ptr == 0)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void * operator new(std::size_t size, const std::nothrow_t & ) noexcept
+{
+	return countedAlloc(size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t & ) noexcept
+{
+	return countedAlloc(size);
+}
+
+void operator delete(void * ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void * ptr, const std::nothrow_t & ) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * ptr, const std::nothrow_t & ) noexcept
+{
+	std::free(ptr);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void * ptr, std::size_t ) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t ) noexcept
+{
+	std::free(ptr);
+}
+#endif /* __cpp_sized_deallocation */
@@ -0,0 +1,48 @@
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+
+/**
+ * Allocation counter. Counts allocations performed through global allocation functions
+ * during lifetime of counter object. All forms of global operator new and operator delete
+ * are replaced in AllocationCounter.cpp, which has to be linked into test binary.
+ * Counters can not be nested and they should be used by one thread at a time.
+ */
+class AllocationCounter
+{
+	public:
+		/**
+		 * Constructor. Starts counting.
+		 */
+		AllocationCounter();
+
+		/**
+		 * Destructor. Stops counting.
+		 */
+		~AllocationCounter();
+
+		/**
+		 * Get number of allocations.
+		 * @return number of allocations performed since counter has been created.
+		 */
+		std::size_t count() const;
+
+		/**
+		 * Allocation hook. Called by replaced allocation functions.
+		 */
+		static void Allocated();
+
+	private:
+		AllocationCounter(const AllocationCounter & other);
+
+		AllocationCounter & operator =(const AllocationCounter & other);
+
+	private:
+		static AllocationCounter * Active;
+
+	private:
+		std::size_t m_count;
+};
+
+#endif // ALLOCATIONCOUNTER_HPP
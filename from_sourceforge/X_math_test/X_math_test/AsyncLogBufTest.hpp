@@ -0,0 +1,198 @@
+#ifndef ASYNCLOGBUFTEST_HPP
+#define ASYNCLOGBUFTEST_HPP
+
+#include <gpx/log/AsyncLogBuf.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Sink buffer, which holds drain thread until it is released.
+ */
+class AsyncLogBufTestSink: public std::streambuf
+{
+	public:
+		AsyncLogBufTestSink(std::streambuf * target):
+			m_target(target),
+			m_blocked(true)
+		{
+		}
+
+		void release()
+		{
+			m_blocked = false;
+		}
+
+	protected:
+		virtual int sync()
+		{
+			return m_target->pubsync();
+		}
+
+		virtual int_type overflow(int_type c)
+		{
+			wait();
+			return m_target->sputc(traits_type::to_char_type(c));
+		}
+
+		virtual std::streamsize xsputn(const char_type * s, std::streamsize n)
+		{
+			wait();
+			return m_target->sputn(s, n);
+		}
+
+	private:
+		void wait()
+		{
+			while (m_blocked)
+				std::this_thread::yield();
+		}
+
+	private:
+		std::streambuf * m_target;
+		std::atomic<bool> m_blocked;
+};
+
+inline
+std::vector<std::string> asyncLogBufTestRead(const char * fileName)
+{
+	std::vector<std::string> lines;
+	std::ifstream file(fileName);
+	std::string line;
+	while (std::getline(file, line))
+		lines.push_back(line);
+	return lines;
+}
+
+inline
+std::string asyncLogBufTestRecord(std::size_t i)
+{
+	std::ostringstream record;
+	record << "record " << i;
+	return record.str();
+}
+
+inline
+void AsyncLogBufTest()
+{
+	cout << "AsyncLogBufTest: testing gpx::log::AsyncLogBuf" << endl;
+
+	const char * FILE_NAME = "AsyncLogBufTest.log";
+	const std::size_t RECORDS = 1000;
+	std::size_t failures = 0;
+
+	//records reach the file in order, long records are split and joined back
+	{
+		std::string longRecord(3 * gpx::log::AsyncLogBuf::RECORD_SIZE + 7, 'x');
+		{
+			std::ofstream file(FILE_NAME);
+			gpx::log::AsyncLogBuf buf(64, gpx::log::AsyncLogBuf::BLOCK);
+			buf.attachStream(file);
+			std::ostream out(& buf);
+			for (std::size_t i = 0; i < RECORDS; i++)
+				out << asyncLogBufTestRecord(i) << std::endl;
+			out << longRecord << std::endl;
+			buf.flush();
+			std::vector<std::string> lines = asyncLogBufTestRead(FILE_NAME);
+			if (lines.size() != RECORDS + 1) {
+				cerr << "Error: expected " << RECORDS + 1 << " lines, got " << lines.size() << " line: " << __LINE__ << endl;
+				failures++;
+			} else {
+				for (std::size_t i = 0; i < RECORDS; i++)
+					if (lines[i] != asyncLogBufTestRecord(i))
+						failures++;
+				if (lines[RECORDS] != longRecord)
+					failures++;
+			}
+			if (buf.droppedCount() != 0)
+				failures++;
+			out << "unflushed" << std::endl;
+		}
+		//destructor writes out remaining records
+		std::vector<std::string> lines = asyncLogBufTestRead(FILE_NAME);
+		if (lines.empty() || lines.back() != "unflushed") {
+			cerr << "Error: records lost on destruction, line: " << __LINE__ << endl;
+			failures++;
+		}
+	}
+
+	//drop policy: when drain thread is stuck, records exceeding capacity are dropped
+	{
+		std::ofstream file(FILE_NAME);
+		AsyncLogBufTestSink sink(file.rdbuf());
+		gpx::log::AsyncLogBuf buf(16, gpx::log::AsyncLogBuf::DROP);
+		buf.attachBuffer(& sink);
+		std::ostream out(& buf);
+		for (std::size_t i = 0; i < 100; i++)
+			out << asyncLogBufTestRecord(i) << std::endl;
+		if (buf.droppedCount() != 100 - buf.capacity()) {
+			cerr << "Error: dropped " << buf.droppedCount() << " records, expected " << 100 - buf.capacity() << " line: " << __LINE__ << endl;
+			failures++;
+		}
+		sink.release();
+		buf.flush();
+		std::vector<std::string> lines = asyncLogBufTestRead(FILE_NAME);
+		if (lines.size() != buf.capacity())
+			failures++;
+		for (std::size_t i = 0; i < lines.size(); i++)
+			if (lines[i] != asyncLogBufTestRecord(i))
+				failures++;
+	}
+
+	//block policy: producer waits for drain thread, nothing is lost
+	{
+		std::ofstream file(FILE_NAME);
+		AsyncLogBufTestSink sink(file.rdbuf());
+		gpx::log::AsyncLogBuf buf(16, gpx::log::AsyncLogBuf::BLOCK);
+		buf.attachBuffer(& sink);
+		std::thread releaser([& sink]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			sink.release();
+		});
+		std::ostream out(& buf);
+		for (std::size_t i = 0; i < 100; i++)
+			out << asyncLogBufTestRecord(i) << std::endl;
+		buf.flush();
+		releaser.join();
+		std::vector<std::string> lines = asyncLogBufTestRead(FILE_NAME);
+		if (lines.size() != 100 || buf.droppedCount() != 0) {
+			cerr << "Error: block policy lost records, line: " << __LINE__ << endl;
+			failures++;
+		}
+		for (std::size_t i = 0; i < lines.size(); i++)
+			if (lines[i] != asyncLogBufTestRecord(i))
+				failures++;
+	}
+
+	//Log::flush() (used by GPX_FATAL and GPX_CRITICAL) reaches asynchronous buffers
+	{
+		std::ofstream file(FILE_NAME);
+		gpx::log::AsyncLogBuf buf;
+		buf.attachStream(file);
+		gpx::log::Log::Instance().combinedStream().detachStream(cout);
+		gpx::log::Log::Instance().combinedStream().attachBuffer(& buf);
+		gpx::log::Log::Instance().infoStream() << "fatal message" << std::endl;
+		gpx::log::Log::Instance().flush();
+		std::vector<std::string> lines = asyncLogBufTestRead(FILE_NAME);
+		if (lines.size() != 1 || lines[0] != "fatal message") {
+			cerr << "Error: Log::flush() did not write queued records, line: " << __LINE__ << endl;
+			failures++;
+		}
+		gpx::log::Log::Instance().combinedStream().detachBuffer(& buf);
+		gpx::log::Log::Instance().combinedStream().attachStream(cout);
+	}
+
+	std::remove(FILE_NAME);
+
+	if (failures == 0 && !silent)
+		cout << "OK: AsyncLogBufTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: AsyncLogBufTest failures: " << failures << endl;
+}
+
+#endif // ASYNCLOGBUFTEST_HPP
@@ -0,0 +1,163 @@
+#ifndef EDGEKERNELTEST_HPP
+#define EDGEKERNELTEST_HPP
+
+#include <gpx/model/EdgeData.hpp>
+#include <gpx/model/Poly.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+/**
+ * Find first intersecting edge using model::intersect() or model::xintersect().
+ */
+inline
+std::size_t edgeKernelReference(bool exclusive, const gpx::real_t * A, const gpx::real_t * B, const gpx::model::EdgeData & edges, std::size_t begin)
+{
+	for (std::size_t i = begin; i < edges.size(); i++) {
+		gpx::real_t C[2] = {edges.x1()[i], edges.y1()[i]};
+		gpx::real_t D[2] = {edges.x2()[i], edges.y2()[i]};
+		gpx::model::const_SegmentPtr<2> AB(A, B);
+		gpx::model::const_SegmentPtr<2> CD(C, D);
+		if (exclusive ? gpx::model::xintersect(AB, CD) : gpx::model::intersect(AB, CD))
+			return i;
+	}
+	return edges.size();
+}
+
+/**
+ * Compare kernel against reference for all starting edges.
+ */
+inline
+bool edgeKernelCompare(const gpx::real_t * A, const gpx::real_t * B, const gpx::model::EdgeData & edges, int line)
+{
+	bool result = true;
+	for (std::size_t begin = 0; begin <= edges.size(); begin++) {
+		std::size_t expected = edgeKernelReference(false, A, B, edges, begin);
+		std::size_t actual = edges.intersect(A, B, begin);
+		if (actual != expected) {
+			cerr << "Error: intersect() " << actual << " != " << expected << " begin: " << begin << " line: " << line << endl;
+			result = false;
+		}
+		expected = edgeKernelReference(true, A, B, edges, begin);
+		actual = edges.xintersect(A, B, begin);
+		if (actual != expected) {
+			cerr << "Error: xintersect() " << actual << " != " << expected << " begin: " << begin << " line: " << line << endl;
+			result = false;
+		}
+	}
+	return result;
+}
+
+#define EDGEKERNELCOMPARE(A, B, EDGES) (edgeKernelCompare(A, B, EDGES, __LINE__))
+
+/**
+ * Random coordinate. Small integers produce plenty of collinear points and shared
+ * endpoints, while drand() covers wide range of magnitudes.
+ */
+inline
+gpx::real_t edgeKernelCoord(bool grid)
+{
+	if (grid)
+		return static_cast<gpx::real_t>(std::rand() % 5 - 2);
+	return drand<gpx::real_t>();
+}
+
+void EdgeKernelTest()
+{
+	using gpx::real_t;
+	using gpx::model::EdgeData;
+
+	cout << "EdgeKernelTest: testing gpx::model::EdgeKernel type: " << typeid(real_t).name() << endl;
+
+	std::size_t failures = 0;
+
+	//random inputs (edge counts cover full packs and remainders)
+	for (int round = 0; round < 2000; round++) {
+		bool grid = round % 2;
+		EdgeData edges;
+		std::size_t size = static_cast<std::size_t>(std::rand() % 20);
+		for (std::size_t i = 0; i < size; i++) {
+			real_t first[2] = {edgeKernelCoord(grid), edgeKernelCoord(grid)};
+			real_t second[2] = {edgeKernelCoord(grid), edgeKernelCoord(grid)};
+			edges.push_back(first, second);
+		}
+		real_t A[2] = {edgeKernelCoord(grid), edgeKernelCoord(grid)};
+		real_t B[2] = {edgeKernelCoord(grid), edgeKernelCoord(grid)};
+		if (!EDGEKERNELCOMPARE(A, B, edges))
+			failures++;
+	}
+
+	//degenerate inputs
+	{
+		const real_t inf = std::numeric_limits<real_t>::infinity();
+		const real_t nan = std::numeric_limits<real_t>::quiet_NaN();
+		const real_t tiny = std::numeric_limits<real_t>::denorm_min();
+		const real_t big = std::numeric_limits<real_t>::max();
+		const real_t coords[][4] = {
+			{0.0, 0.0, 1.0, 1.0},	//regular edge
+			{0.0, 0.0, 0.0, 0.0},	//zero-length edge
+			{1.0, 1.0, 0.0, 0.0},	//reversed edge
+			{-1.0, -1.0, 2.0, 2.0},	//collinear, overlapping
+			{2.0, 2.0, 3.0, 3.0},	//collinear, disjoint
+			{1.0, 1.0, 1.0, 0.0},	//shared endpoint
+			{0.5, 0.5, 0.5, 0.5},	//point on segment
+			{-0.0, 0.0, 0.0, -0.0},	//signed zeros
+			{tiny, 0.0, -tiny, 0.0},	//denormals
+			{0.0, -1.0, 0.0, 1.0},	//crossing at endpoint
+			{nan, 0.0, 1.0, 0.0},	//NaN
+			{0.0, 0.0, inf, inf},	//infinity
+			{-inf, 0.0, inf, 0.0},	//infinities
+			{big, -big, -big, big}	//overflow
+		};
+		const std::size_t count = sizeof(coords) / sizeof(coords[0]);
+
+		EdgeData edges;
+		for (std::size_t i = 0; i < count; i++)
+			edges.push_back(coords[i], coords[i] + 2);
+
+		//each edge used as segment as well
+		for (std::size_t i = 0; i < count; i++)
+			if (!EDGEKERNELCOMPARE(coords[i], coords[i] + 2, edges))
+				failures++;
+
+		//edges mixed in packs
+		for (int round = 0; round < 200; round++) {
+			EdgeData mixed;
+			std::size_t size = static_cast<std::size_t>(std::rand() % 20);
+			for (std::size_t i = 0; i < size; i++) {
+				std::size_t e = static_cast<std::size_t>(std::rand()) % count;
+				mixed.push_back(coords[e], coords[e] + 2);
+			}
+			std::size_t s = static_cast<std::size_t>(std::rand()) % count;
+			if (!EDGEKERNELCOMPARE(coords[s], coords[s] + 2, mixed))
+				failures++;
+		}
+	}
+
+	//edges assigned from polygon
+	{
+		real_t square[] = {0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 1.0};
+		gpx::model::Poly<2, gpx::model::NONE, real_t> poly(gpx::model::VertexData<2, real_t>(square, 4));
+		EdgeData edges;
+		edges.assign(poly.begin(), poly.end());
+		if (edges.size() != 4) {
+			cerr << "Error: " << edges.size() << " != 4 line: " << __LINE__ << endl;
+			failures++;
+		}
+		real_t A[2] = {-0.5, 0.5};
+		real_t B[2] = {0.5, 0.5};
+		if (edges.intersect(A, B) != 3) {
+			cerr << "Error: " << edges.intersect(A, B) << " != 3 line: " << __LINE__ << endl;
+			failures++;
+		}
+		if (!EDGEKERNELCOMPARE(A, B, edges))
+			failures++;
+	}
+
+	if (failures == 0 && !silent)
+		cout << "OK: EdgeKernelTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: EdgeKernelTest failures: " << failures << endl;
+}
+
+#endif // EDGEKERNELTEST_HPP
@@ -0,0 +1,281 @@
+#ifndef LCPSOLVERTEST_HPP
+#define LCPSOLVERTEST_HPP
+
+#include "AllocationCounter.hpp"
+
+#include <gpx/math/LCPSolver.hpp>
+
+#include <algorithm>
+
+/**
+ * Linear complementarity problem with known solution. Problems have been captured
+ * from contact clusters of pmepp2_s::CRigidBody objects (matrices filled by
+ * CRigidBody::aCoefs() and CRigidBody::bCoefs()). Known solutions have been found
+ * by exhaustive search over active sets in exact rational arithmetic. Solution
+ * (x) of rank deficient problems is not unique, but w = ax - b is. Larger clusters
+ * come from a resting stack hit by a tilted box, where Dantzig pivoting clamps
+ * several contacts and releases some of them later.
+ */
+struct LCPSolverTestProblem
+{
+	std::size_t n;
+	bool fullRank;
+	double a[64];
+	double b[8];
+	double x[8];
+	double w[8];
+};
+
+const LCPSolverTestProblem LCP_SOLVER_TEST_PROBLEMS[] = {
+	//2x2, rank deficient, all unknowns zero
+	{2, false,
+		{0.0, 0.0,
+		 0.0, 0.0},
+		{0.0, 0.0},
+		{0.0, 0.0},
+		{0.0, 0.0}},
+	//2x2, full rank
+	{2, true,
+		{2.000349084483118, 6.092998994233767e-08,
+		 6.092998994233767e-08, 1.999650915516882},
+		{0.09995003378417705, 0.19989999617741597},
+		{0.049966292617864894, 0.09996744510843729},
+		{0.0, 0.0}},
+	//3x3, full rank
+	{3, true,
+		{3.25123001520903, -0.4843747182775473, -1.5156252817224527,
+		 -0.4843747182775473, 2.0, 0.0,
+		 -1.5156252817224527, 0.0, 2.0},
+		{4.7257914508087095, 0.10000000000000214, 0.09999999999999981},
+		{2.4306876491653613, 0.6386818226425939, 1.8920058265227684},
+		{0.0, 0.0, 0.0}},
+	//4x4, full rank
+	{4, true,
+		{3.566352386670951, 0.49557290602983806, 0.00026406667819134366, -2.0002639969469795,
+		 0.49557290602983806, 3.565298027367764, -1.7522141720984346, -0.24778582790156556,
+		 0.00026406667819134366, -1.7522141720984346, 2.0, 0.0,
+		 -2.0002639969469795, -0.24778582790156556, 0.0, 2.0},
+		{0.16849863130217907, 0.09993848769299205, 0.1, 0.1},
+		{0.15875594793439363, 0.08030584580099633, 0.12033555947952158, 0.21872622872074607},
+		{0.0, 0.0, 0.0, 0.0}},
+	//4x4, rank deficient
+	{4, false,
+		{3.707755497602303, -0.033206485829486265, -1.9656905393309958, 0.0,
+		 -0.033206485829486265, 2.0, 0.0, 0.0,
+		 -1.9656905393309958, 0.0, 2.0, 0.0,
+		 0.0, 0.0, 0.0, 0.0},
+		{2.9259199558159703, 0.1, 0.1, 0.0},
+		{1.704487369491808, 0.07830001784078403, 1.725247348309611, 0.0},
+		{0.0, 0.0, 0.0, 0.0}},
+	//5x5, full rank
+	{5, true,
+		{2.8940852004575026, -1.9408519306753997, -0.05600863780793752, -0.9232099232134937, -1.0069972601588886,
+		 -1.9408519306753997, 2.0, 0.0, 0.0, 0.0,
+		 -0.05600863780793752, 0.0, 2.0, 0.0, 0.0,
+		 -0.9232099232134937, 0.0, 0.0, 3.0031213815572295, 1.8182399732930326,
+		 -1.0069972601588886, 0.0, 0.0, 1.8182399732930326, 3.0133958969745596},
+		{0.06269089623085286, 0.09999999999999998, 0.09999999999999998, 0.9064840296083213, 0.9525475682750641},
+		{0.8637497534620047, 0.8882051883135662, 0.07418872354917437, 0.31706452196199425, 0.4134344965361821},
+		{0.0, 0.0, 0.0, 0.0, 0.0}},
+	//3x3, rank deficient
+	{3, false,
+		{2.7195553083411492, 0.0, -0.16730928716713356,
+		 0.0, 0.0, 0.0,
+		 -0.16730928716713356, 0.0, 3.950831630956172},
+		{0.6900305079226574, 0.0, 0.031227791646711633},
+		{0.25487946719993154, 0.0, 0.018697707348159696},
+		{0.0, 0.0, 0.0}},
+	//5x5, rank deficient
+	{5, false,
+		{2.9692096306955893, 0.0, 0.0, 0.0, 0.0,
+		 0.0, 0.0, 0.0, 0.0, 0.0,
+		 0.0, 0.0, 0.0, 0.0, 0.0,
+		 0.0, 0.0, 0.0, 3.0347382990060594, 1.5028294585507003,
+		 0.0, 0.0, 0.0, 1.5028294585507003, 3.088783906427953},
+		{0.9935064613469353, 0.0, 0.0, 0.01545895038113776, 0.016363226000878583},
+		{0.33460300380144903, 0.0, 0.0, 0.0032547739170670138, 0.0037140364055621277},
+		{0.0, 0.0, 0.0, 0.0, 0.0}},
+	//4x4, full rank, unconstrained solution has negative values
+	{4, true,
+		{3.3727269782102915, 3.2548127065175523, -1.9894409002014797, -0.010588694037651392,
+		 3.2548127065175523, 3.4147762197384965, -1.627531239965114, -0.3725567604218505,
+		 -1.9894409002014797, -1.627531239965114, 2.0001402503485233, 9.83508019469781e-09,
+		 -0.010588694037651392, -0.3725567604218505, 9.83508019469781e-09, 1.9998597496514765},
+		{0.27903520631708656, 0.32021682936526624, 0.19989679653646386, 0.09995002476137718},
+		{0.3432107517897726, 0.0, 0.4413162041375407, 0.051795719214901524},
+		{0.0, 0.059317132282434876, 0.0, 0.0}},
+	//8x8, rank deficient
+	{8, false,
+		{2.413946036737173, 0.0, 0.0, -1.021982089140479, 0.0, 0.0, 0.0, 0.0,
+		 0.0, 2.9388350997641224, 0.9111312517436545, 0.0, -1.0170528461708714, 0.0, 0.0, 0.0,
+		 0.0, 0.9111312517436545, 2.9560913517358904, -0.4447036964786536, 0.0, 0.0, 0.0, 0.0,
+		 -1.021982089140479, 0.0, -0.4447036964786536, 3.4081519638769864, 0.0, 0.0, 0.0, 0.0,
+		 0.0, -1.0170528461708714, 0.0, 0.0, 2.9620119866023717, -1.1435434949112928, 0.0, 0.0,
+		 0.0, 0.0, 0.0, 0.0, -1.1435434949112928, 3.4343330017552125, 0.0, 0.0,
+		 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+		 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+		{0.05322071988894006, 0.3843711276772287, 0.034221832429081944, 0.05945280771185901, 0.009172631383825403, 0.08588259859570058, 0.0, 0.0},
+		{0.03371236085995726, 0.15730389314445897, 0.0, 0.027553418300794198, 0.07661261174245937, 0.050517073415212305, 0.0, 0.0},
+		{0.0, 0.0, 0.09684955366679326, 0.0, 0.0, 0.0, 0.0, 0.0}},
+	//4x4, full rank, 2 clamped contacts released, 1 unknown zero
+	{4, true,
+		{3.400616750561812, 3.28099665736649, -1.996090681533776, -0.005772847088356681,
+		 3.28099665736649, 3.419908357320294, -1.6411118415940984, -0.3600963933536173,
+		 -1.996090681533776, -1.6411118415940984, 2.001887759874375, 1.7818202590058618e-06,
+		 -0.005772847088356681, -0.3600963933536173, 1.7818202590058618e-06, 1.9981122401256255},
+		{0.3428981356344663, 0.35785032509472675, 0.10000000000000002, 0.10000000000000002},
+		{0.3140470950790777, 0.0, 0.3630904808091776, 0.05095424413698524},
+		{0.0, 0.05831661694955931, 0.0, 0.0}},
+	//5x5, full rank, 2 clamped contacts released, 1 unknown zero
+	{5, true,
+		{3.343122648059, 3.1883262942803, -1.9959500794851461, -0.0059120836982037295, -0.595815964859148,
+		 3.1883262942803, 3.3629837466821986, -1.5947380716178994, -0.4063827032615165, -0.9999595668919896,
+		 -1.9959500794851461, -1.5947380716178994, 2.001887759874375, 1.7818202590058618e-06, 0.0,
+		 -0.0059120836982037295, -0.4063827032615165, 1.7818202590058618e-06, 1.9981122401256255, 0.0,
+		 -0.595815964859148, -0.9999595668919896, 0.0, 0.0, 1.9919513726139506},
+		{0.6891205105785146, 0.6801601630469516, 0.10000000000000002, 0.10000000000000002, 0.9559238198023984},
+		{0.0, 0.8355897669699803, 0.7155977724474043, 0.21999162230479927, 0.8993592042009529},
+		{0.00956170299771626, 0.0, 0.0, 0.0, 0.0}},
+	//8x8, full rank, 3 clamped contacts released, 4 unknowns zero
+	{8, true,
+		{3.9924685747082704, 0.9944449279551778, 0.23018196580174946, 0.9972248689888661, 0.9990108808958291, 0.9962315309173874, 0.0, 0.0,
+		 0.9944449279551778, 3.052367919769181, 2.467217037950237, -0.0024899757362284447, 1.0518619908502074, 0.0, -0.28079248962675135, -0.232799987968448,
+		 0.23018196580174946, 2.467217037950237, 3.056778660678784, -0.7667149020045647, 1.2222464110054962, 0.0, -0.9979974300229899, -0.9965276013012835,
+		 0.9972248689888661, -0.0024899757362284447, -0.7667149020045647, 1.9972258266676115, 0.0, 0.0, 0.0, 0.0,
+		 0.9990108808958291, 1.0518619908502074, 1.2222464110054962, 0.0, 3.045937130193212, -0.0030636984022766045, -0.2699285724485122, -0.22123241328666346,
+		 0.9962315309173874, 0.0, 0.0, 0.0, -0.0030636984022766045, 1.997220498965397, 0.0, 0.0,
+		 0.0, -0.28079248962675135, -0.9979974300229899, 0.0, -0.2699285724485122, 0.0, 3.8697414115471545, 3.9857334080901747,
+		 0.0, -0.232799987968448, -0.9965276013012835, 0.0, -0.22123241328666346, 0.0, 3.9857334080901747, 4.1171432809436475},
+		{0.4409355710134055, 0.24047849160772433, 0.23107253509936843, 0.296452081245846, 0.23957200671316134, 0.34466867846359595, 1.7374191570539679, 1.7428195821394161},
+		{0.0, 0.0, 0.31654047540628827, 0.2699486325625131, 0.0, 0.17257417427977617, 0.5306105808208933, 0.0},
+		{0.07304966145185537, 0.3908319309594341, 0.0, 0.0, 0.003562781461073238, 0.0, 0.0, 0.05661141585315356}},
+	//8x8, full rank, 2 clamped contacts released, 4 unknowns zero
+	{8, true,
+		{3.364436906701731, 2.9562967853925657, -0.7825510754311582, 0.006312018990708879, -2.062409066136955, 0.06675221911416795, 0.0, 0.0,
+		 2.9562967853925657, 3.09908175025683, 0.08333451080310317, 0.5510224999559468, -1.4821235077363746, -0.5179374292040525, 0.0, 0.0,
+		 -0.7825510754311582, 0.08333451080310317, 4.74139520265447, 2.939193680928498, 0.646668512289312, -2.1721961350117502, 0.10351189996538812, -0.8457298265647677,
+		 0.006312018990708879, 0.5510224999559468, 2.939193680928498, 2.8808366338475744, -0.06863231771185674, -1.931249952407029, 0.642923878587628, 0.6068759936846739,
+		 -2.062409066136955, -1.4821235077363746, 0.646668512289312, -0.06863231771185674, 2.0001264090746673, 7.98962718207008e-09, 0.0, 0.0,
+		 0.06675221911416795, -0.5179374292040525, -2.1721961350117502, -1.931249952407029, 7.98962718207008e-09, 1.9998735909253327, 0.0, 0.0,
+		 0.0, 0.0, 0.10351189996538812, 0.642923878587628, 0.0, 0.0, 3.8173394779229985, 0.5650683519564508,
+		 0.0, 0.0, -0.8457298265647677, 0.6068759936846739, 0.0, 0.0, 0.5650683519564508, 4.176990482218273},
+		{7.992221985379545, 7.551813855138096, 5.795513964618699, 7.1328543100042445, 0.10000000000000002, 0.1, 3.19702521908036, 3.577613016112698},
+		{6.5491373997206495, 0.0, 0.0, 7.136480421928711, 7.047951280754367, 6.723003906440433, 0.0, 0.0},
+		{0.0, 1.8137116353108182, 0.008954748460464486, 0.0, 0.0, 0.0, 1.3911884532507186, 0.7533456313565092}},
+	//8x8, rank deficient, 2 clamped contacts released, 2 unknowns zero
+	{8, false,
+		{3.007141598561005, 1.7953813123119347, -0.0016626504729960745, -1.998334585118498, -1.1022382402490631, -0.9116729816952874, 0.0, 0.0,
+		 1.7953813123119347, 3.0137922975153675, -1.1023083631264834, -0.8976916368735165, 0.0009847915933977047, -1.8647783830472526, 0.0, 0.0,
+		 -0.0016626504729960745, -1.1023083631264834, 2.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+		 -1.998334585118498, -0.8976916368735165, 0.0, 2.0, 0.0, 0.0, 0.0, 0.0,
+		 -1.1022382402490631, 0.0009847915933977047, 0.0, 0.0, 3.744013724203777, 0.2733066079122263, 0.0, 0.0,
+		 -0.9116729816952874, -1.8647783830472526, 0.0, 0.0, 0.2733066079122263, 3.7467211998319674, 0.0, 0.0,
+		 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+		 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+		{0.15965163598499943, 0.22605313026531093, 0.1, 0.1, 0.0008758695351248069, 0.022433227381584764, 0.0, 0.0},
+		{0.3986013075820176, 0.13565086848897875, 0.12509591072668008, 0.5091557143958937, 0.10566356850167372, 0.1627843367989633, 0.0, 0.0},
+		{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}}
+};
+
+/**
+ * Check solution against known one and complementarity conditions x >= 0, w >= 0,
+ * x(i)w(i) = 0. Differences are measured in units of b vector.
+ */
+template <int LCP_METHOD, typename T>
+bool lcpSolverCheck(const LCPSolverTestProblem & problem, gpx::math::const_VectorRef<gpx::math::SIZE_DYNAMIC, T> x, T eps, int line)
+{
+	std::size_t n = problem.n;
+	T scale = T(1.0);
+	for (std::size_t i = 0; i < n; i++)
+		scale = std::max(scale, static_cast<T>(std::abs(problem.b[i])));
+
+	bool result = true;
+	for (std::size_t i = 0; i < n; i++) {
+		T w = -static_cast<T>(problem.b[i]);
+		for (std::size_t j = 0; j < n; j++)
+			w += static_cast<T>(problem.a[i * n + j]) * x(j);
+		T aii = static_cast<T>(problem.a[i * n + i]);
+		if (x(i) < T()
+				|| w < -eps * scale
+				|| std::abs(x(i) * w) * aii > eps * scale * scale
+				|| std::abs(w - static_cast<T>(problem.w[i])) > eps * scale
+				|| (problem.fullRank && std::abs(x(i) - static_cast<T>(problem.x[i])) * aii > eps * scale)) {
+			cerr << "Error: LCPSolver<" << LCP_METHOD << "> x(" << i << "): " << x(i) << " (" << problem.x[i] << ") w(" << i << "): " << w << " (" << problem.w[i] << ") line: " << line << endl;
+			result = false;
+		}
+	}
+	return result;
+}
+
+template <typename T>
+void LCPSolverTest()
+{
+	using gpx::math::LCPSolver;
+	using gpx::math::LCP_PGS;
+	using gpx::math::LCP_DANTZIG;
+
+	cout << "LCPSolverTest: testing gpx::math::LCPSolver type: " << typeid(T).name() << endl;
+
+	std::size_t failures = 0;
+	T eps = std::sqrt(std::numeric_limits<T>::epsilon());
+
+	for (std::size_t p = 0; p < sizeof(LCP_SOLVER_TEST_PROBLEMS) / sizeof(LCP_SOLVER_TEST_PROBLEMS[0]); p++) {
+		const LCPSolverTestProblem & problem = LCP_SOLVER_TEST_PROBLEMS[p];
+		gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> a(T(), problem.n, problem.n);
+		gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> b(T(), problem.n);
+		for (std::size_t i = 0; i < problem.n; i++) {
+			b(i) = static_cast<T>(problem.b[i]);
+			for (std::size_t j = 0; j < problem.n; j++)
+				a(i, j) = static_cast<T>(problem.a[i * problem.n + j]);
+		}
+
+		//Dantzig
+		{
+			LCPSolver<LCP_DANTZIG, gpx::math::SIZE_DYNAMIC, T> solver(a);
+			gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> x(solver.solve(b));
+			if (!solver.solved()) {
+				cerr << "Error: LCPSolver<LCP_DANTZIG> problem " << p << " not solved line: " << __LINE__ << endl;
+				failures++;
+			} else if (!lcpSolverCheck<LCP_DANTZIG, T>(problem, x, eps, __LINE__))
+				failures++;
+		}
+
+		//Dantzig with workspace grown by the first solution should not allocate anything
+		{
+			gpx::math::LCPSolverWorkspace<gpx::math::SIZE_DYNAMIC, T> workspace;
+			gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> x(T(), problem.n);
+			LCPSolver<LCP_DANTZIG, gpx::math::SIZE_DYNAMIC, T>(a, workspace).solve(b, x);
+			{
+				AllocationCounter allocations;
+				LCPSolver<LCP_DANTZIG, gpx::math::SIZE_DYNAMIC, T> solver(a, workspace);
+				solver.solve(b, x);
+				if (allocations.count() != 0) {
+					cerr << "Error: LCPSolver<LCP_DANTZIG> problem " << p << " allocations: " << allocations.count() << " line: " << __LINE__ << endl;
+					failures++;
+				}
+			}
+			if (!lcpSolverCheck<LCP_DANTZIG, T>(problem, x, eps, __LINE__))
+				failures++;
+		}
+
+		//projected Gauss-Seidel
+		{
+			LCPSolver<LCP_PGS, gpx::math::SIZE_DYNAMIC, T> solver(a);
+			solver.setMaxIterations(10000);
+			solver.setTolerance(eps * eps);
+			gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> x(solver.solve(b));
+			//PGS converges slowly on rank deficient problems, thus only w is checked with loose tolerance
+			LCPSolverTestProblem relaxed = problem;
+			relaxed.fullRank = false;
+			if (!lcpSolverCheck<LCP_PGS, T>(relaxed, x, std::sqrt(eps), __LINE__))
+				failures++;
+		}
+	}
+
+	if (failures == 0 && !silent)
+		cout << "OK: LCPSolverTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: LCPSolverTest failures: " << failures << endl;
+}
+
+#endif // LCPSOLVERTEST_HPP
@@ -0,0 +1,128 @@
+#ifndef NNSOLVERWORKSPACETEST_HPP
+#define NNSOLVERWORKSPACETEST_HPP
+
+#include "AllocationCounter.hpp"
+
+#include <gpx/math/NNSolver.hpp>
+
+#include <cstdlib>
+
+/**
+ * Fill symmetric positive definite system with known positive solution.
+ */
+template <typename T>
+void nnSolverWorkspaceFill(gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> & a, gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> & b, gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> & x, std::size_t n)
+{
+	a.resize(n, n);
+	a.zero();
+	for (std::size_t k = 0; k < n; k++) {
+		T dir[16];
+		for (std::size_t i = 0; i < n; i++)
+			dir[i] = static_cast<T>(std::rand() % 2001 - 1000) / static_cast<T>(1000.0);
+		for (std::size_t i = 0; i < n; i++)
+			for (std::size_t j = 0; j < n; j++)
+				a(i, j) += dir[i] * dir[j];
+	}
+	for (std::size_t i = 0; i < n; i++)
+		a(i, i) += static_cast<T>(n);
+
+	x.resize(n);
+	for (std::size_t i = 0; i < n; i++)
+		x(i) = static_cast<T>(1 + std::rand() % 1000) / static_cast<T>(100.0);
+	b.resize(n);
+	for (std::size_t i = 0; i < n; i++) {
+		b(i) = T();
+		for (std::size_t j = 0; j < n; j++)
+			b(i) += a(i, j) * x(j);
+	}
+}
+
+template <typename T>
+void NNSolverWorkspaceTest()
+{
+	typedef gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> DenseMatrix;
+	typedef gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> DenseVector;
+
+	cout << "NNSolverWorkspaceTest: testing gpx::math::NNSolverWorkspace type: " << typeid(T).name() << endl;
+
+	const std::size_t MAX_SIZE = 16;
+	std::size_t failures = 0;
+
+	DenseMatrix a(T(), MAX_SIZE, MAX_SIZE, MAX_SIZE * MAX_SIZE);
+	DenseVector b(T(), MAX_SIZE, MAX_SIZE);
+	DenseVector bCopy(T(), MAX_SIZE, MAX_SIZE);
+	DenseVector expected(T(), MAX_SIZE, MAX_SIZE);
+	DenseVector x(T(), MAX_SIZE, MAX_SIZE);
+
+	gpx::math::NNSolverWorkspace<gpx::math::SIZE_DYNAMIC, T> workspace;
+
+	//workspace grows with systems and is not shrunk
+	for (std::size_t n = 1; n <= MAX_SIZE; n++) {
+		nnSolverWorkspaceFill(a, b, expected, n);
+		gpx::math::NNSolver<gpx::math::EQ_SYMMETRIC, gpx::math::SIZE_DYNAMIC, T> solver(a, workspace);
+		x.resize(n);
+		solver.solve(b, x);
+		if (workspace.capacity() < n)
+			failures++;
+	}
+	nnSolverWorkspaceFill(a, b, expected, 3);
+	{
+		gpx::math::NNSolver<gpx::math::EQ_GENERAL, gpx::math::SIZE_DYNAMIC, T> solver(a, workspace);
+		x.resize(3);
+		solver.solve(b, x);
+	}
+	if (workspace.capacity() != MAX_SIZE)
+		failures++;
+
+	//after warm-up solvers do not allocate memory
+	for (int round = 0; round < 50; round++) {
+		std::size_t n = 1 + static_cast<std::size_t>(std::rand() % MAX_SIZE);
+		nnSolverWorkspaceFill(a, b, expected, n);
+		bCopy = b;
+		x.resize(n);
+
+		{
+			AllocationCounter allocations;
+			gpx::math::NNSolver<gpx::math::EQ_SYMMETRIC, gpx::math::SIZE_DYNAMIC, T> solver(a, workspace);
+			solver.solve(b, x);
+			if (allocations.count() != 0) {
+				cerr << "Error: symmetric NNSolver performed " << allocations.count() << " allocations, line: " << __LINE__ << endl;
+				failures++;
+			}
+		}
+		for (std::size_t i = 0; i < n; i++)
+			if (!A(x(i), expected(i)))
+				failures++;
+
+		b = bCopy;
+		{
+			AllocationCounter allocations;
+			gpx::math::NNSolver<gpx::math::EQ_GENERAL, gpx::math::SIZE_DYNAMIC, T> solver(a, workspace);
+			solver.solve(b, x);
+			if (allocations.count() != 0) {
+				cerr << "Error: general NNSolver performed " << allocations.count() << " allocations, line: " << __LINE__ << endl;
+				failures++;
+			}
+		}
+		for (std::size_t i = 0; i < n; i++)
+			if (!A(x(i), expected(i)))
+				failures++;
+	}
+
+	//solver without workspace gives the same results
+	nnSolverWorkspaceFill(a, b, expected, MAX_SIZE);
+	{
+		gpx::math::NNSolver<gpx::math::EQ_SYMMETRIC, gpx::math::SIZE_DYNAMIC, T> solver(a);
+		DenseVector result = solver.solve(b);
+		for (std::size_t i = 0; i < MAX_SIZE; i++)
+			if (!A(result(i), expected(i)))
+				failures++;
+	}
+
+	if (failures == 0 && !silent)
+		cout << "OK: NNSolverWorkspaceTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: NNSolverWorkspaceTest failures: " << failures << endl;
+}
+
+#endif // NNSOLVERWORKSPACETEST_HPP
@@ -0,0 +1,246 @@
+#ifndef PRECISIONTEST_HPP
+#define PRECISIONTEST_HPP
+
+#include "LCPSolverTest.hpp"
+
+#include <gpx/math/LCPSolver.hpp>
+#include <gpx/math/NNSolver.hpp>
+#include <gpx/model/functions.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * Stack of boxes falling onto the ground. Canonical contact scene reduced to vertical
+ * motion. In each step gravity is applied, contact impulses between neighbouring boxes
+ * (and between bottom box and the ground) are found by LCPSolver and positions are
+ * integrated. Contacts are speculative, i.e. approaching boxes may close the gap within
+ * a step, but may not penetrate. Scene can be run with any floating point type, so that
+ * trajectories computed in different precisions can be compared.
+ */
+template <int LCP_METHOD, typename T>
+class PrecisionTestStack
+{
+	public:
+		static const std::size_t SIZE = 6;
+
+	public:
+		PrecisionTestStack():
+			m_a(T(), SIZE, SIZE),
+			m_b(T(), SIZE),
+			m_x(T(), SIZE)
+		{
+			static const double MASSES[SIZE] = {1.0, 2.0, 1.0, 3.0, 1.0, 2.0};
+			for (std::size_t i = 0; i < SIZE; i++) {
+				m_m[i] = static_cast<T>(MASSES[i]);
+				m_y[i] = static_cast<T>(0.1 + 1.25 * static_cast<double>(i));
+				m_v[i] = T();
+			}
+			//contact k joins box k with box k - 1 (or ground), so matrix is tridiagonal
+			for (std::size_t k = 0; k < SIZE; k++) {
+				m_a(k, k) = T(1.0) / m_m[k];
+				if (k > 0) {
+					m_a(k, k) += T(1.0) / m_m[k - 1];
+					m_a(k, k - 1) = m_a(k - 1, k) = -T(1.0) / m_m[k - 1];
+				}
+			}
+		}
+
+		void step(T dt)
+		{
+			const T G = static_cast<T>(10.0);
+			const T H = static_cast<T>(1.0);
+			const T BETA = static_cast<T>(0.2);
+
+			for (std::size_t i = 0; i < SIZE; i++)
+				m_v[i] -= G * dt;
+
+			for (std::size_t k = 0; k < SIZE; k++) {
+				T vn = k > 0 ? m_v[k] - m_v[k - 1] : m_v[k];
+				T gap = k > 0 ? m_y[k] - m_y[k - 1] - H : m_y[k];
+				m_b(k) = gap > T() ? -vn - gap / dt : -vn - BETA * gap / dt;
+			}
+			gpx::math::LCPSolver<LCP_METHOD, gpx::math::SIZE_DYNAMIC, T> solver(m_a);
+			m_x = solver.solve(m_b);
+
+			for (std::size_t k = 0; k < SIZE; k++) {
+				m_v[k] += m_x(k) / m_m[k];
+				if (k > 0)
+					m_v[k - 1] -= m_x(k) / m_m[k - 1];
+			}
+			for (std::size_t i = 0; i < SIZE; i++)
+				m_y[i] += m_v[i] * dt;
+		}
+
+		T y(std::size_t i) const
+		{
+			return m_y[i];
+		}
+
+	private:
+		gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> m_a;
+		gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> m_b;
+		gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> m_x;
+		T m_m[SIZE];
+		T m_y[SIZE];
+		T m_v[SIZE];
+};
+
+/**
+ * Run stack scene in single and double precision and compare trajectories.
+ * @param tol relative tolerance of positions.
+ * @return number of steps at which trajectories diverged.
+ */
+template <int LCP_METHOD>
+std::size_t precisionTestTrajectory(double tol, int line)
+{
+	PrecisionTestStack<LCP_METHOD, float> single;
+	PrecisionTestStack<LCP_METHOD, double> reference;
+	std::size_t failures = 0;
+	for (int s = 0; s < 300; s++) {
+		single.step(0.01f);
+		reference.step(0.01);
+		for (std::size_t i = 0; i < PrecisionTestStack<LCP_METHOD, double>::SIZE; i++) {
+			double y = reference.y(i);
+			if (std::abs(static_cast<double>(single.y(i)) - y) > tol * (1.0 + std::abs(y))) {
+				cerr << "Error: LCPSolver<" << LCP_METHOD << "> step: " << s << " y(" << i << "): " << single.y(i) << " (" << y << ") line: " << line << endl;
+				failures++;
+			}
+		}
+	}
+	//boxes should come to rest on top of each other
+	for (std::size_t i = 0; i < PrecisionTestStack<LCP_METHOD, float>::SIZE; i++)
+		if (std::abs(single.y(i) - static_cast<float>(i)) > 0.01f) {
+			cerr << "Error: LCPSolver<" << LCP_METHOD << "> box " << i << " rests at: " << single.y(i) << " line: " << line << endl;
+			failures++;
+		}
+	return failures;
+}
+
+/**
+ * Solve captured full rank problems with non-negative solver. Only problems, which
+ * have w = 0 are used, so that non-negative solver should find the same x.
+ * @param tol relative tolerance of solution.
+ * @return number of failed problems.
+ */
+template <int EQ_FLAGS, typename T>
+std::size_t precisionTestNNSolver(T tol, int line)
+{
+	std::size_t failures = 0;
+	for (std::size_t p = 0; p < sizeof(LCP_SOLVER_TEST_PROBLEMS) / sizeof(LCP_SOLVER_TEST_PROBLEMS[0]); p++) {
+		const LCPSolverTestProblem & problem = LCP_SOLVER_TEST_PROBLEMS[p];
+		if (!problem.fullRank || std::count(problem.w, problem.w + problem.n, 0.0) != static_cast<std::ptrdiff_t>(problem.n))
+			continue;
+		gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> a(T(), problem.n, problem.n);
+		gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> b(T(), problem.n);
+		T scale = T(1.0);
+		for (std::size_t i = 0; i < problem.n; i++) {
+			b(i) = static_cast<T>(problem.b[i]);
+			scale = std::max(scale, std::abs(b(i)));
+			for (std::size_t j = 0; j < problem.n; j++)
+				a(i, j) = static_cast<T>(problem.a[i * problem.n + j]);
+		}
+		gpx::math::NNSolver<EQ_FLAGS, gpx::math::SIZE_DYNAMIC, T> solver(a);
+		gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> x(solver.solve(b));
+		for (std::size_t i = 0; i < problem.n; i++)
+			if (std::abs(x(i) - static_cast<T>(problem.x[i])) * static_cast<T>(problem.a[i * problem.n + i]) > tol * scale) {
+				cerr << "Error: NNSolver<" << EQ_FLAGS << "> type: " << typeid(T).name() << " problem: " << p << " x(" << i << "): " << x(i) << " (" << problem.x[i] << ") line: " << line << endl;
+				failures++;
+			}
+	}
+	return failures;
+}
+
+void PrecisionTest()
+{
+	using gpx::real_t;
+
+	cout << "PrecisionTest: testing single and double precision type: " << typeid(real_t).name() << endl;
+
+	std::size_t failures = 0;
+
+	//per type epsilons
+	if (gpx::epsilon<real_t>() != gpx::EPS) {
+		cerr << "Error: epsilon<real_t>() " << gpx::epsilon<real_t>() << " != " << gpx::EPS << " line: " << __LINE__ << endl;
+		failures++;
+	}
+	if (!gpx::math::ape(1.0f, 1.0f + 8.0f * std::numeric_limits<float>::epsilon())
+			|| gpx::math::ape(1.0f, 1.001f)
+			|| !gpx::math::ape(1.0, 1.0 + 8.0 * std::numeric_limits<double>::epsilon())
+			|| gpx::math::ape(1.0, 1.0 + static_cast<double>(gpx::epsilon<float>()))) {
+		cerr << "Error: ape() does not respect precision of type line: " << __LINE__ << endl;
+		failures++;
+	}
+	if (gpx::math::eps(0.5f) != gpx::epsilon<float>() || gpx::math::eps(0.5) != gpx::epsilon<double>()) {
+		cerr << "Error: eps() does not respect precision of type line: " << __LINE__ << endl;
+		failures++;
+	}
+
+	//points computed on a line (coming through origin, so that rounding affects only scaling)
+	//are collinear, points off the line by a fraction of segment length are not
+	for (int round = 0; round < 1000; round++) {
+		real_t A[2] = {0.0, 0.0};
+		real_t B[2] = {drand<real_t>(), drand<real_t>()};
+		if (B[0] == 0.0 && B[1] == 0.0)
+			continue;
+		real_t t = drand<real_t>();
+		real_t C[2] = {t * B[0], t * B[1]};
+		int onLine = gpx::model::ccw(A, B, C);
+		real_t D[2] = {B[0] - static_cast<real_t>(0.01) * B[1], B[1] + static_cast<real_t>(0.01) * B[0]};
+		int offLine = gpx::model::ccw(A, B, D);
+		if (onLine != 0 || offLine != 1) {
+			cerr << "Error: ccw() on line: " << onLine << " off line: " << offLine << " line: " << __LINE__ << endl;
+			failures++;
+		}
+	}
+
+	//segments ending on a line coming through origin at points, which are representable
+	//exactly (power of two fractions of direction vector), so that only rounding of ccw()
+	//arithmetic is involved: segment ending on the other one touches it (intersect()
+	//includes endpoints, xintersect() excludes them), segments lying on the same line are
+	//collinear and do not intersect, while segment shifted off the line by a fraction of
+	//its length does not touch it
+	for (int round = 0; round < 1000; round++) {
+		real_t C[2] = {0.0, 0.0};
+		real_t D[2] = {drand<real_t>(), drand<real_t>()};
+		if (D[0] == 0.0 && D[1] == 0.0)
+			continue;
+		real_t t = std::ldexp(static_cast<real_t>(1.0), -1 - std::rand() % 4);
+		real_t B[2] = {t * D[0], t * D[1]};
+		real_t A[2] = {B[0] - static_cast<real_t>(0.5) * D[1], B[1] + static_cast<real_t>(0.5) * D[0]};
+		real_t E[2] = {static_cast<real_t>(0.5) * B[0], static_cast<real_t>(0.5) * B[1]};
+		real_t F[2] = {E[0] - static_cast<real_t>(0.01) * D[1], E[1] + static_cast<real_t>(0.01) * D[0]};
+		real_t G[2] = {B[0] - static_cast<real_t>(0.01) * D[1], B[1] + static_cast<real_t>(0.01) * D[0]};
+		gpx::model::const_SegmentPtr<2> CD(C, D);
+		gpx::model::const_SegmentPtr<2> AB(A, B);
+		gpx::model::const_SegmentPtr<2> EB(E, B);
+		gpx::model::const_SegmentPtr<2> FG(F, G);
+		bool grazing = gpx::model::intersect(AB, CD);
+		bool xgrazing = gpx::model::xintersect(AB, CD);
+		bool collinear = gpx::model::intersect(EB, CD);
+		bool shifted = gpx::model::intersect(FG, CD);
+		if (!grazing || xgrazing || collinear || shifted) {
+			cerr << "Error: intersect() grazing: " << grazing << " xintersect() grazing: " << xgrazing << " collinear: " << collinear << " shifted: " << shifted << " line: " << __LINE__ << endl;
+			failures++;
+		}
+	}
+
+	//non-negative solver in both precisions
+	float tolSingle = std::sqrt(std::numeric_limits<float>::epsilon());
+	double tolDouble = std::sqrt(std::numeric_limits<double>::epsilon());
+	failures += precisionTestNNSolver<gpx::math::EQ_SYMMETRIC, float>(tolSingle, __LINE__);
+	failures += precisionTestNNSolver<gpx::math::EQ_GENERAL, float>(tolSingle, __LINE__);
+	failures += precisionTestNNSolver<gpx::math::EQ_SYMMETRIC, double>(tolDouble, __LINE__);
+	failures += precisionTestNNSolver<gpx::math::EQ_GENERAL, double>(tolDouble, __LINE__);
+
+	//trajectories of stack scene
+	failures += precisionTestTrajectory<gpx::math::LCP_DANTZIG>(tolSingle, __LINE__);
+	failures += precisionTestTrajectory<gpx::math::LCP_PGS>(tolSingle, __LINE__);
+
+	if (failures == 0 && !silent)
+		cout << "OK: PrecisionTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: PrecisionTest failures: " << failures << endl;
+}
+
+#endif // PRECISIONTEST_HPP
@@ -0,0 +1,134 @@
+#ifndef SMALLMATRIXTEST_HPP
+#define SMALLMATRIXTEST_HPP
+
+#include <gpx/math/structures.hpp>
+
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Fill matrix with random elements from [-1, 1] and add @a n on diagonal, so that matrix
+ * is diagonally dominant and thus well conditioned.
+ */
+template <typename T>
+void smallMatrixTestRandom(T * elements, std::size_t n)
+{
+	for (std::size_t i = 0; i < n * n; i++)
+		elements[i] = static_cast<T>(2.0 * std::rand() / RAND_MAX - 1.0);
+	for (std::size_t i = 0; i < n; i++)
+		elements[i * n + i] += static_cast<T>(n);
+}
+
+template <typename T>
+bool smallMatrixTestClose(T v1, T v2, T tol)
+{
+	return std::abs(v1 - v2) <= tol * (static_cast<T>(1.0) + std::abs(v2));
+}
+
+/**
+ * Measure average time of operation in nanoseconds.
+ */
+template <typename OP>
+double smallMatrixTestTime(OP op, int repeats)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repeats; r++)
+		op();
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+/**
+ * Compare unrolled kernels of N x N matrices against generic loops, which are used by
+ * dynamic matrices of the same size. If not silent, operations are also timed.
+ * @return number of failures.
+ */
+template <std::size_t N, typename T>
+std::size_t smallMatrixTestSize()
+{
+	typedef gpx::math::Matrix<N, N, T> Fixed;
+	typedef gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> Dynamic;
+
+	std::size_t failures = 0;
+	T tol = static_cast<T>(64.0 * N) * std::numeric_limits<T>::epsilon();
+	T elements1[N * N];
+	T elements2[N * N];
+
+	for (int round = 0; round < 100; round++) {
+		smallMatrixTestRandom(elements1, N);
+		smallMatrixTestRandom(elements2, N);
+		Fixed a(elements1);
+		Fixed b(elements2);
+		Dynamic da(elements1, N, N);
+		Dynamic db(elements2, N, N);
+		gpx::math::Vector<N, T> v(elements2);
+		gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> dv(elements2, N);
+
+		Fixed p = a * b;
+		Dynamic dp = da * db;
+		gpx::math::Vector<N, T> pv = a * v;
+		gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> dpv = da * dv;
+		Fixed m(a);
+		m *= b;
+		Fixed t(a);
+		t.transpose();
+		Fixed i(a);
+		i.invert();
+		Dynamic di(da);
+		di.invert();
+		Fixed r = a * i;
+		bool ok = smallMatrixTestClose(a.det(), da.det(), tol);
+		for (std::size_t row = 0; row < N; row++) {
+			ok = ok && smallMatrixTestClose(pv(row), dpv(row), tol);
+			for (std::size_t col = 0; col < N; col++) {
+				ok = ok && smallMatrixTestClose(p(row, col), dp(row, col), tol);
+				ok = ok && smallMatrixTestClose(m(row, col), dp(row, col), tol);
+				ok = ok && t(row, col) == a(col, row);
+				ok = ok && smallMatrixTestClose(i(row, col), di(row, col), tol);
+				ok = ok && smallMatrixTestClose(r(row, col), row == col ? static_cast<T>(1.0) : T(), tol);
+			}
+		}
+		if (!ok) {
+			cerr << "Error: " << N << "x" << N << " kernels differ from generic loops round: " << round << " line: " << __LINE__ << endl;
+			failures++;
+		}
+	}
+
+	if (!silent) {
+		Fixed a, b;
+		Dynamic da(T(), N, N), db(T(), N, N);
+		smallMatrixTestRandom(a.ptr(), N);
+		smallMatrixTestRandom(b.ptr(), N);
+		da = a.ptr();
+		db = b.ptr();
+		const int REPEATS = 100000;
+		T sink = T();
+		//sign of an element is flipped in each repetition, so that operations can not be hoisted out of loops
+		cout << "SmallMatrixTest: " << N << "x" << N << " type: " << typeid(T).name() << " [ns] fixed (dynamic):"
+				<< " prod: " << smallMatrixTestTime([&]() { a(0, 0) = -a(0, 0); sink += (a * b)(N - 1, N - 1); }, REPEATS)
+				<< " (" << smallMatrixTestTime([&]() { da(0, 0) = -da(0, 0); sink += (da * db)(N - 1, N - 1); }, REPEATS) << ")"
+				<< " det: " << smallMatrixTestTime([&]() { a(0, 0) = -a(0, 0); sink += a.det(); }, REPEATS)
+				<< " (" << smallMatrixTestTime([&]() { da(0, 0) = -da(0, 0); sink += da.det(); }, REPEATS) << ")"
+				<< " invert: " << smallMatrixTestTime([&]() { a.invert(); }, REPEATS)
+				<< " (" << smallMatrixTestTime([&]() { da.invert(); }, REPEATS) << ")"
+				<< " sink: " << sink << endl;
+	}
+	return failures;
+}
+
+template <typename T>
+void SmallMatrixTest()
+{
+	cout << "SmallMatrixTest: testing unrolled 2x2, 3x3 and 4x4 matrix kernels type: " << typeid(T).name() << endl;
+
+	std::size_t failures = 0;
+	failures += smallMatrixTestSize<2, T>();
+	failures += smallMatrixTestSize<3, T>();
+	failures += smallMatrixTestSize<4, T>();
+
+	if (failures == 0 && !silent)
+		cout << "OK: SmallMatrixTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: SmallMatrixTest failures: " << failures << endl;
+}
+
+#endif // SMALLMATRIXTEST_HPP
@@ -0,0 +1,201 @@
+#ifndef SPARSEMATRIXTEST_HPP
+#define SPARSEMATRIXTEST_HPP
+
+#include "AllocationCounter.hpp"
+
+#include <gpx/math/SparseMatrix.hpp>
+#include <gpx/math/SparseLCPSolver.hpp>
+#include <gpx/math/LCPSolver.hpp>
+
+#include <cstdlib>
+
+/**
+ * Fill dense and sparse matrices with contact-like system. Each "body" couples
+ * a small group of neighbouring unknowns with symmetric positive semi-definite block,
+ * just like aCoefs() functions do.
+ */
+template <typename T>
+void sparseMatrixFill(gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> & dense, gpx::math::SparseMatrix<T> & sparse, std::size_t n)
+{
+	dense.resize(n, n);
+	dense.zero();
+	sparse.resize(n, n);
+	for (std::size_t body = 0; body < n; body++) {
+		std::size_t first = body;
+		std::size_t count = 1 + static_cast<std::size_t>(std::rand() % 3);
+		T dir[3];
+		for (std::size_t k = 0; k < count; k++)
+			dir[k] = static_cast<T>(std::rand() % 2001 - 1000) / static_cast<T>(1000.0);
+		for (std::size_t v = 0; v < count && first + v < n; v++)
+			for (std::size_t i = 0; i < count && first + i < n; i++) {
+				T val = static_cast<T>(1.0) + dir[v] * dir[i];
+				dense(first + v, first + i) += val;
+				sparse.add(first + v, first + i, val);
+			}
+	}
+}
+
+template <typename T>
+void SparseMatrixTest()
+{
+	typedef gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> DenseMatrix;
+	typedef gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> DenseVector;
+
+	cout << "SparseMatrixTest: testing gpx::math::SparseMatrix type: " << typeid(T).name() << endl;
+
+	std::size_t failures = 0;
+
+	//empty matrix
+	{
+		gpx::math::SparseMatrix<T> m(3, 4);
+		m.compress();
+		if (m.rows() != 3 || m.cols() != 4 || m.nonZeros() != 0 || !A(m.get(2, 3), T()))
+			failures++;
+	}
+
+	//accumulation, order of columns and access in both phases
+	{
+		gpx::math::SparseMatrix<T> m(2, 3);
+		m.add(0, 2, static_cast<T>(1.0));
+		m.add(0, 0, static_cast<T>(2.0));
+		m.add(0, 2, static_cast<T>(3.0));
+		m.add(1, 1, static_cast<T>(-1.0));
+		if (m.compressed() || !A(m.get(0, 2), static_cast<T>(4.0)) || !A(m.get(0, 1), T()))
+			failures++;
+		m.compress();
+		if (!m.compressed() || m.nonZeros() != 3 || m.rowBegin(0) != 0 || m.rowEnd(0) != 2 || m.rowEnd(1) != 3)
+			failures++;
+		if (m.col(0) != 0 || m.col(1) != 2 || !A(m.val(1), static_cast<T>(4.0)) || !A(m.get(1, 1), static_cast<T>(-1.0)))
+			failures++;
+
+		//refill reuses matrix
+		m.resize(2, 2);
+		m.add(1, 0, static_cast<T>(5.0));
+		m.compress();
+		if (m.nonZeros() != 1 || !A(m.get(1, 0), static_cast<T>(5.0)) || !A(m.get(0, 1), T()))
+			failures++;
+	}
+
+	//comparison with dense matrix
+	for (int round = 0; round < 50; round++) {
+		std::size_t n = 1 + static_cast<std::size_t>(std::rand() % 40);
+		DenseMatrix dense(T(), n, n);
+		gpx::math::SparseMatrix<T> sparse;
+		sparseMatrixFill(dense, sparse, n);
+		sparse.compress();
+
+		std::size_t zeroed = static_cast<std::size_t>(std::rand()) % n;
+		sparse.zeroRow(zeroed);
+		sparse.zeroCol(zeroed);
+		for (std::size_t i = 0; i < n; i++) {
+			dense(zeroed, i) = T();
+			dense(i, zeroed) = T();
+		}
+
+		for (std::size_t row = 0; row < n; row++)
+			for (std::size_t col = 0; col < n; col++)
+				if (dense(row, col) != sparse.get(row, col)) {
+					cerr << "Error: " << sparse.get(row, col) << " != " << dense(row, col) << " line: " << __LINE__ << endl;
+					failures++;
+				}
+
+		DenseVector x(T(), n);
+		DenseVector b(T(), n);
+		for (std::size_t i = 0; i < n; i++) {
+			x(i) = static_cast<T>(std::rand() % 2001 - 1000) / static_cast<T>(1000.0);
+			b(i) = static_cast<T>(std::rand() % 2001 - 1000) / static_cast<T>(1000.0);
+		}
+		DenseVector dProd(dense.prod(x));
+		DenseVector sProd(sparse.prod(x));
+		for (std::size_t i = 0; i < n; i++)
+			if (!A(sProd(i), dProd(i)))
+				failures++;
+
+		//sparse solver visits the same non-zero elements in the same order, thus results are identical
+		gpx::math::LCPSolver<gpx::math::LCP_PGS, gpx::math::SIZE_DYNAMIC, T> dSolver(dense);
+		gpx::math::SparseLCPSolver<gpx::math::LCP_PGS, T> sSolver(sparse);
+		DenseVector dResult(dSolver.solve(b));
+		DenseVector sResult(sSolver.solve(b));
+		if (sSolver.direct()) {
+			//backend has solved system directly, check that result satisfies w = ax - b = 0
+			DenseVector w(dense.prod(sResult));
+			for (std::size_t i = 0; i < n; i++)
+				if (sResult(i) < T() || (i != zeroed && std::abs(w(i) - b(i)) > sSolver.tolerance() * static_cast<T>(n)))
+					failures++;
+		} else if (dSolver.iterations() != sSolver.iterations() || dSolver.residual() != sSolver.residual()) {
+			cerr << "Error: SparseLCPSolver iterations: " << sSolver.iterations() << " != " << dSolver.iterations() << " line: " << __LINE__ << endl;
+			failures++;
+		}
+		for (std::size_t i = 0; i < n && !sSolver.direct(); i++)
+			if (dResult(i) != sResult(i)) {
+				cerr << "Error: SparseLCPSolver " << sResult(i) << " != " << dResult(i) << " line: " << __LINE__ << endl;
+				failures++;
+			}
+	}
+
+	//positive definite system with non-negative solution; backends with sparse direct solver solve it without iterating
+	for (int round = 0; round < 10; round++) {
+		std::size_t n = 2 + static_cast<std::size_t>(std::rand() % 40);
+		DenseMatrix dense(T(), n, n);
+		gpx::math::SparseMatrix<T> sparse(n, n);
+		DenseVector b(T(), n);
+		for (std::size_t i = 0; i < n; i++) {
+			dense(i, i) = static_cast<T>(4.0);
+			sparse.add(i, i, static_cast<T>(4.0));
+			if (i > 0) {
+				dense(i, i - 1) = dense(i - 1, i) = static_cast<T>(-1.0);
+				sparse.add(i, i - 1, static_cast<T>(-1.0));
+				sparse.add(i - 1, i, static_cast<T>(-1.0));
+			}
+			b(i) = static_cast<T>(std::rand() % 1000 + 1) / static_cast<T>(1000.0);
+		}
+		sparse.compress();
+
+		gpx::math::LCPSolver<gpx::math::LCP_DANTZIG, gpx::math::SIZE_DYNAMIC, T> dSolver(dense);
+		gpx::math::SparseLCPSolver<gpx::math::LCP_PGS, T> sSolver(sparse);
+		sSolver.setMaxIterations(1000);
+		DenseVector dResult(dSolver.solve(b));
+		DenseVector sResult(sSolver.solve(b));
+		if (!sSolver.converged() || (sSolver.direct() && sSolver.iterations() != 0)) {
+			cerr << "Error: SparseLCPSolver direct: " << sSolver.direct() << " iterations: " << sSolver.iterations() << " line: " << __LINE__ << endl;
+			failures++;
+		}
+		for (std::size_t i = 0; i < n; i++)
+			if (std::abs(dResult(i) - sResult(i)) > static_cast<T>(1.0e-4)) {
+				cerr << "Error: SparseLCPSolver " << sResult(i) << " != " << dResult(i) << " line: " << __LINE__ << endl;
+				failures++;
+			}
+
+		//solver with workspace grown by the first solution should not allocate anything (sparse direct solvers of some backends allocate during factorization)
+		bool factorizes = GPX_X_MATH_BACKEND_NAMESPACE::SparseSolver<T>().factorize(sparse);
+		gpx::math::SparseLCPSolverWorkspace<T> workspace;
+		DenseVector wResult(T(), n);
+		gpx::math::SparseLCPSolver<gpx::math::LCP_PGS, T>(sparse, workspace).solve(b, wResult);
+		{
+			AllocationCounter allocations;
+			gpx::math::SparseLCPSolver<gpx::math::LCP_PGS, T> wSolver(sparse, workspace);
+			wSolver.setMaxIterations(1000);
+			wSolver.solve(b, sResult, wResult);
+			if (allocations.count() != 0 && !factorizes) {
+				cerr << "Error: SparseLCPSolver allocations: " << allocations.count() << " line: " << __LINE__ << endl;
+				failures++;
+			}
+			if (!wSolver.converged()) {
+				cerr << "Error: SparseLCPSolver warm start has not converged line: " << __LINE__ << endl;
+				failures++;
+			}
+		}
+		for (std::size_t i = 0; i < n; i++)
+			if (std::abs(dResult(i) - wResult(i)) > static_cast<T>(1.0e-4)) {
+				cerr << "Error: SparseLCPSolver " << wResult(i) << " != " << dResult(i) << " line: " << __LINE__ << endl;
+				failures++;
+			}
+	}
+
+	if (failures == 0 && !silent)
+		cout << "OK: SparseMatrixTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: SparseMatrixTest failures: " << failures << endl;
+}
+
+#endif // SPARSEMATRIXTEST_HPP
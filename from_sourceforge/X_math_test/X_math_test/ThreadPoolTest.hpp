@@ -0,0 +1,56 @@
+#ifndef THREADPOOLTEST_HPP
+#define THREADPOOLTEST_HPP
+
+#include <gpx/utils/ThreadPool.hpp>
+
+#include <atomic>
+#include <vector>
+
+inline
+void ThreadPoolTest()
+{
+	cout << "ThreadPoolTest: testing gpx::utils::ThreadPool" << endl;
+
+	const std::size_t TASKS = 1000;
+	std::size_t failures = 0;
+
+	for (std::size_t threads = 1; threads <= 4; threads++) {
+		gpx::utils::ThreadPool pool(threads);
+		if (pool.threads() != threads)
+			failures++;
+
+		//each task is executed exactly once, by thread of valid index
+		for (int round = 0; round < 20; round++) {
+			std::vector<std::atomic<int> > executions(TASKS);
+			for (std::size_t i = 0; i < TASKS; i++)
+				executions[i] = 0;
+			std::atomic<std::size_t> invalidThreads(0);
+			pool.run(TASKS, [& executions, & invalidThreads, & pool](std::size_t task, std::size_t thread) {
+				executions[task]++;
+				if (thread >= pool.threads())
+					invalidThreads++;
+			});
+			for (std::size_t i = 0; i < TASKS; i++)
+				if (executions[i] != 1) {
+					cerr << "Error: task " << i << " executed " << executions[i] << " times, threads: " << threads << " line: " << __LINE__ << endl;
+					failures++;
+				}
+			if (invalidThreads != 0)
+				failures++;
+		}
+
+		//empty batch and single task
+		std::size_t calls = 0;
+		pool.run(0, [& calls](std::size_t, std::size_t) { calls++; });
+		pool.run(1, [& calls](std::size_t task, std::size_t thread) { calls += 1 + task + thread; });
+		if (calls != 1)
+			failures++;
+	}
+
+	if (failures == 0 && !silent)
+		cout << "OK: ThreadPoolTest" << endl;
+	else if (failures > 0)
+		cerr << "Error: ThreadPoolTest failures: " << failures << endl;
+}
+
+#endif // THREADPOOLTEST_HPP
@@ -3,6 +3,8 @@ CONFIG += console
 CONFIG -= app_bundle
 CONFIG -= qt
 QMAKE_CXXFLAGS += -std=c++11
+unix: QMAKE_CXXFLAGS += -pthread
+unix: LIBS += -pthread
 #QMAKE_CXXFLAGS += -fno-implicit-templates
 
 DEFINES += GPX_DYNAMIC
@@ -11,16 +13,38 @@ DEFINES += GPX_DYNAMIC
 INCLUDEPATH += $$PWD/../../gpx/X/wc/include
 DEPENDPATH += $$PWD/../../gpx/X/wc/include
 
+#Eigen (required by eigen math backend only)
+INCLUDEPATH += $$PWD/../../Eigen/include
+DEPENDPATH += $$PWD/../../Eigen/include
+
 SOURCES += main.cpp \
+    AllocationCounter.cpp \
     tests.hpp \
     const_VectorRefTest.hpp \
     VectorRefTest.hpp \
     VectorTest.hpp \
-    MatrixTest.hpp
+    MatrixTest.hpp \
+    EdgeKernelTest.hpp \
+    LCPSolverTest.hpp \
+    SparseMatrixTest.hpp \
+    NNSolverWorkspaceTest.hpp \
+    PrecisionTest.hpp \
+    SmallMatrixTest.hpp \
+    AsyncLogBufTest.hpp \
+    ThreadPoolTest.hpp
 
 HEADERS += \
+    AllocationCounter.hpp \
     tests.hpp \
     const_VectorRefTest.hpp \
     VectorRefTest.hpp \
     VectorTest.hpp \
-    MatrixTest.hpp
+    MatrixTest.hpp \
+    EdgeKernelTest.hpp \
+    LCPSolverTest.hpp \
+    SparseMatrixTest.hpp \
+    NNSolverWorkspaceTest.hpp \
+    PrecisionTest.hpp \
+    SmallMatrixTest.hpp \
+    AsyncLogBufTest.hpp \
+    ThreadPoolTest.hpp
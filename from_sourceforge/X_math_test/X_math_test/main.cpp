@@ -3,6 +3,14 @@
 #include "VectorRefTest.hpp"
 #include "VectorTest.hpp"
 #include "MatrixTest.hpp"
+#include "EdgeKernelTest.hpp"
+#include "LCPSolverTest.hpp"
+#include "SparseMatrixTest.hpp"
+#include "NNSolverWorkspaceTest.hpp"
+#include "PrecisionTest.hpp"
+#include "SmallMatrixTest.hpp"
+#include "AsyncLogBufTest.hpp"
+#include "ThreadPoolTest.hpp"
 
 //#include <gpx/model/Segment.hpp>
 //#include <gpx/model/SegmentPtr.hpp>
@@ -878,6 +886,15 @@ int main()
 //	silent = false;
 	std::srand(time(0));
 
+	EdgeKernelTest();
+	LCPSolverTest<gpx::real_t>();
+	SparseMatrixTest<gpx::real_t>();
+	NNSolverWorkspaceTest<gpx::real_t>();
+	PrecisionTest();
+	SmallMatrixTest<gpx::real_t>();
+	AsyncLogBufTest();
+	ThreadPoolTest();
+
 	//@todo turn on Vector and VectorPtr dependend tests
 //	const_VectorRefTest<gpx::math::const_VectorRef, 1, gpx::real_t, gpx::math::Vector, gpx::math::VectorRef, gpx::math::Matrix>();
 //	const_VectorRefTest<gpx::math::const_VectorRef, 2, gpx::real_t, gpx::math::Vector, gpx::math::VectorRef, gpx::math::Matrix>();
@@ -19,6 +19,7 @@
 #include <gpx/platform.hpp>
 #include <gpx/math/constants.hpp>
 #include <gpx/math/structures.hpp>
+#include <gpx/math/SparseLCPSolver.hpp>	//pulls in backend headers (e.g. Eigen), which must be parsed before A() macro is defined
 
 //#include <gpx/math/Solver.hpp>
 #include <gpx/log.hpp>
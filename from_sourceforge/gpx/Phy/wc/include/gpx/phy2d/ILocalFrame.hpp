@@ -29,10 +29,48 @@ class ILocalFrame
 		 */
 		virtual math::Point<2> mapToLocal(math::const_PointRef<2> point) const = 0;
 
+		/**
+		 * Map points to global coordinates. Default implementation maps points one by
+		 * one. Implementations may map them in one pass.
+		 * @param points array of @a count points, which coordinates are stored contiguously.
+		 * @param count number of points.
+		 * @param result array of 2 * @a count coordinates, where mapped points will be stored.
+		 */
+		virtual void mapToGlobal(const real_t * points, std::size_t count, real_t * result) const;
+
+		/**
+		 * Map points to local coordinates. Default implementation maps points one by
+		 * one. Implementations may map them in one pass.
+		 * @param points array of @a count points, which coordinates are stored contiguously.
+		 * @param count number of points.
+		 * @param result array of 2 * @a count coordinates, where mapped points will be stored.
+		 */
+		virtual void mapToLocal(const real_t * points, std::size_t count, real_t * result) const;
+
 	protected:
 		~ILocalFrame() {}
 };
 
+inline
+void ILocalFrame::mapToGlobal(const real_t * points, std::size_t count, real_t * result) const
+{
+	for (std::size_t i = 0; i < 2 * count; i += 2) {
+		math::Point<2> mapped(mapToGlobal(math::const_PointRef<2>(points + i)));
+		result[i] = mapped[0];
+		result[i + 1] = mapped[1];
+	}
+}
+
+inline
+void ILocalFrame::mapToLocal(const real_t * points, std::size_t count, real_t * result) const
+{
+	for (std::size_t i = 0; i < 2 * count; i += 2) {
+		math::Point<2> mapped(mapToLocal(math::const_PointRef<2>(points + i)));
+		result[i] = mapped[0];
+		result[i + 1] = mapped[1];
+	}
+}
+
 }
 }
 
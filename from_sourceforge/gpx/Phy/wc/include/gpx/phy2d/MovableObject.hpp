@@ -10,6 +10,7 @@
 #include "../phy/IMovable.hpp"
 #include "../phy/IRecordable.hpp"
 #include "ILocalFrame.hpp"
+#include "RigidTransform.hpp"
 #include "PhyObject.hpp"
 
 #include <gpx/platform.hpp>
@@ -22,10 +23,10 @@ namespace phy2d {
 
 /**
  * Movable object. Represents time dependent, physical object, which location can be
- * determined. This class keeps transformation matrices and updates them according to
- * position. Derived classes may need to provide own matrix construction mechanism by
- * re-implementing virtual constructTMatrix() and constructTMatrixInv() functions.
- * Position parameter and matrices are double buffered. Class allocates double
+ * determined. This class keeps transformations and updates them according to
+ * position. Derived classes may need to provide own transformation construction mechanism
+ * by re-implementing virtual constructTMatrix() and constructTMatrixInv() functions.
+ * Position parameter and transformations are double buffered. Class allocates double
  * buffer controller which may be used by derived classes.
  */
 class GPX_API MovableObject: public PhyObject,
@@ -67,14 +68,24 @@ class GPX_API MovableObject: public PhyObject,
 		void setPos(real_t x, real_t y);
 
 		/**
-		 * Get transformation matrix.
+		 * Get transformation.
 		 */
-		const phy::TransformationMatrix & tMatrix() const;
+		const RigidTransform & transform() const;
 
 		/**
-		 * Get inverted transformation matrix.
+		 * Get inverted transformation.
 		 */
-		const phy::TransformationMatrix & tMatrixInv() const;
+		const RigidTransform & transformInv() const;
+
+		/**
+		 * Get transformation matrix. Matrix is constructed from transform().
+		 */
+		phy::TransformationMatrix tMatrix() const;
+
+		/**
+		 * Get inverted transformation matrix. Matrix is constructed from transformInv().
+		 */
+		phy::TransformationMatrix tMatrixInv() const;
 
 		//ILocalFrame
 		virtual math::Point<2> mapToLocal(math::const_PointRef<2> point) const;
@@ -82,6 +93,12 @@ class GPX_API MovableObject: public PhyObject,
 		//ILocalFrame
 		virtual math::Point<2> mapToGlobal(math::const_PointRef<2> point) const;
 
+		//ILocalFrame
+		virtual void mapToLocal(const real_t * points, std::size_t count, real_t * result) const;
+
+		//ILocalFrame
+		virtual void mapToGlobal(const real_t * points, std::size_t count, real_t * result) const;
+
 		//IRecordable
 		virtual std::size_t snapshotSize() const;
 
@@ -146,9 +163,9 @@ class GPX_API MovableObject: public PhyObject,
 		void setPosB(real_t x, real_t y);
 
 		/**
-		 * Update transformation matrix and inverted transformation matrix.
+		 * Update transformation and inverted transformation.
 		 * Calling this function denotes that background parameter, which
-		 * affects transformation matrix has been changed and matrices should
+		 * affects transformation has been changed and transformations should
 		 * be updated. In response function will call constructTMatrix() and
 		 * constructTMatrixInv() (request *may* be lazy evaluated and these
 		 * functions will not be called immediately).
@@ -156,30 +173,30 @@ class GPX_API MovableObject: public PhyObject,
 		void updateTMatricesB();
 
 		/**
-		 * Construct transformation matrix. This function should be re-implemented whenever
+		 * Construct transformation. This function should be re-implemented whenever
 		 * derived class provides own transformation parameters.
-		 * @param tMatrix transformation matrix (existing data will be overwritten).
+		 * @param transform transformation (existing data will be overwritten).
 		 *
 		 * @note if transformation parameter is double buffered, then background buffer values shall be used.
 		 *
 		 * @todo swap buffers before constructTMatrix(active, active) calls.
 		 */
-		virtual void constructTMatrix(phy::TransformationMatrix & tMatrix);
+		virtual void constructTMatrix(RigidTransform & transform);
 
 		/**
-		 * Construct inverted transformation matrix. This function should be re-implemented
+		 * Construct inverted transformation. This function should be re-implemented
 		 * whenever derived class provides own transformation parameters.
-		 * @param tInvMatrix inverted transformation matrix (existing data will be overwritten).
+		 * @param transformInv inverted transformation (existing data will be overwritten).
 		 *
 		 * @note if transformation parameter is double buffered, then background buffer values shall be used.
 		 */
-		virtual void constructTMatrixInv(phy::TransformationMatrix & tMatrixInv);
+		virtual void constructTMatrixInv(RigidTransform & transformInv);
 
 	private:
 		utils::DoubleBufferController m_doubleBufferController;	///< Double buffer controller.
 		utils::DoubleBuffer<math::Point<2> > m_pos;				///< Position (double buffered).
-		utils::DoubleBuffer<phy::TransformationMatrix> m_tMatrix;		///< Transformation matrix (double buffered).
-		utils::DoubleBuffer<phy::TransformationMatrix> m_tMatrixInv;	///< Inverted transformation matrix (double buffered).
+		utils::DoubleBuffer<RigidTransform> m_transform;		///< Transformation (double buffered).
+		utils::DoubleBuffer<RigidTransform> m_transformInv;	///< Inverted transformation (double buffered).
 //		utils::DoubleBuffer<bool> m_updateTMatrix;
 };
 
@@ -192,10 +192,10 @@ class GPX_API RigidBody : public MaterialBody
 		real_t resultantMoment() const;
 
 		//Parent
-		virtual void constructTMatrix(phy::TransformationMatrix & tMatrix);
+		virtual void constructTMatrix(RigidTransform & transform);
 
 		//Parent
-		virtual void constructTMatrixInv(phy::TransformationMatrix & tInvMatrix);
+		virtual void constructTMatrixInv(RigidTransform & transformInv);
 
 	private:
 		utils::DoubleBuffer<real_t> m_angleSin;	///< Cached value of current angle's sine.
@@ -0,0 +1,217 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_Phy2d_RIGIDTRANSFORM_HPP_
+#define GPX_Phy2d_RIGIDTRANSFORM_HPP_
+
+#include "../phy/TransformationMatrix.hpp"
+
+#include <gpx/platform.hpp>
+#include <gpx/math/structures.hpp>
+
+namespace gpx {
+namespace phy2d {
+
+/**
+ * Rigid transformation. Compact form of 2D transformation, which consists of rotation
+ * followed by translation. Transformation is described by cosine and sine of rotation
+ * angle and translation vector, which are stored contiguously in that order. Point
+ * [x, y] is mapped to [cos * x - sin * y + tx, sin * x + cos * y + ty]. Initially
+ * transformation is an identity.
+ */
+class GPX_API RigidTransform
+{
+	public:
+		static const std::size_t SIZE = 4;	///< Number of parameters describing transformation.
+
+		/**
+		 * Default constructor. Creates identity transformation.
+		 */
+		RigidTransform();
+
+		/**
+		 * Constructor.
+		 * @param cos cosine of rotation angle.
+		 * @param sin sine of rotation angle.
+		 * @param tx x coordinate of translation.
+		 * @param ty y coordinate of translation.
+		 */
+		RigidTransform(real_t cos, real_t sin, real_t tx, real_t ty);
+
+		/**
+		 * Set transformation parameters.
+		 * @param cos cosine of rotation angle.
+		 * @param sin sine of rotation angle.
+		 * @param tx x coordinate of translation.
+		 * @param ty y coordinate of translation.
+		 */
+		void set(real_t cos, real_t sin, real_t tx, real_t ty);
+
+		/**
+		 * Set translation. Rotation remains unchanged.
+		 * @param tx x coordinate of translation.
+		 * @param ty y coordinate of translation.
+		 */
+		void setTranslation(real_t tx, real_t ty);
+
+		/**
+		 * Get cosine of rotation angle.
+		 * @return cosine of rotation angle.
+		 */
+		real_t cos() const;
+
+		/**
+		 * Get sine of rotation angle.
+		 * @return sine of rotation angle.
+		 */
+		real_t sin() const;
+
+		/**
+		 * Get x coordinate of translation.
+		 * @return x coordinate of translation.
+		 */
+		real_t tx() const;
+
+		/**
+		 * Get y coordinate of translation.
+		 * @return y coordinate of translation.
+		 */
+		real_t ty() const;
+
+		/**
+		 * Get pointer to parameters. Parameters are stored in order: cosine, sine, x and y
+		 * coordinates of translation.
+		 * @return pointer to array of SIZE parameters.
+		 */
+		const real_t * ptr() const;
+
+		/**
+		 * Get pointer to parameters.
+		 * @return pointer to array of SIZE parameters.
+		 */
+		real_t * ptr();
+
+		/**
+		 * Vector product. Vector is only rotated.
+		 * @param vec vector to be transformed.
+		 * @return transformed vector.
+		 */
+		math::Vector<2> prod(math::const_VectorRef<2> vec) const;
+
+		/**
+		 * Vector product. Alias of prod().
+		 * @param vec vector to be transformed.
+		 * @return transformed vector.
+		 */
+		math::Vector<2> operator *(math::const_VectorRef<2> vec) const;
+
+		/**
+		 * Point product. Point is rotated and translated.
+		 * @param point point to be transformed.
+		 * @return transformed point.
+		 */
+		math::Point<2> prod(math::const_PointRef<2> point) const;
+
+		/**
+		 * Point product. Alias of prod().
+		 * @param point point to be transformed.
+		 * @return transformed point.
+		 */
+		math::Point<2> operator *(math::const_PointRef<2> point) const;
+
+		/**
+		 * Batch point product.
+		 * @param points array of @a count points, which coordinates are stored contiguously.
+		 * @param count number of points.
+		 * @param result array of 2 * @a count coordinates, where transformed points will be
+		 * stored. Array may be the same as @a points.
+		 */
+		void prod(const real_t * points, std::size_t count, real_t * result) const;
+
+		/**
+		 * Composition of transformations.
+		 * @param other transformation to be applied first.
+		 * @return transformation, which applies @a other and then this transformation.
+		 */
+		RigidTransform prod(const RigidTransform & other) const;
+
+		/**
+		 * Composition of transformations. Alias of prod().
+		 * @param other transformation to be applied first.
+		 * @return transformation, which applies @a other and then this transformation.
+		 */
+		RigidTransform operator *(const RigidTransform & other) const;
+
+		/**
+		 * Get inverted transformation.
+		 * @return inverted transformation.
+		 */
+		RigidTransform inverted() const;
+
+		/**
+		 * Get transformation in the form of 4x4 transformation matrix. Provided for
+		 * renderers, which expect OpenGL compatible matrices.
+		 * @return transformation matrix.
+		 */
+		phy::TransformationMatrix matrix() const;
+
+		/**
+		 * Write transformation to 4x4 transformation matrix. Only upper left 2x2 block
+		 * and translation column are written.
+		 * @param matrix transformation matrix.
+		 */
+		void toMatrix(phy::TransformationMatrix & matrix) const;
+
+	private:
+		real_t m_data[SIZE];	///< Cosine, sine, x and y coordinates of translation.
+};
+
+inline
+real_t RigidTransform::cos() const
+{
+	return m_data[0];
+}
+
+inline
+real_t RigidTransform::sin() const
+{
+	return m_data[1];
+}
+
+inline
+real_t RigidTransform::tx() const
+{
+	return m_data[2];
+}
+
+inline
+real_t RigidTransform::ty() const
+{
+	return m_data[3];
+}
+
+inline
+math::Point<2> RigidTransform::prod(math::const_PointRef<2> point) const
+{
+	//same order of operations as in TransformationMatrix::prod()
+	return math::Point<2>(m_data[2] + m_data[0] * point[0] + -m_data[1] * point[1],
+						  m_data[3] + m_data[1] * point[0] + m_data[0] * point[1]);
+}
+
+inline
+math::Point<2> RigidTransform::operator *(math::const_PointRef<2> point) const
+{
+	return prod(point);
+}
+
+}
+}
+
+#endif /* GPX_Phy2d_RIGIDTRANSFORM_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -7,6 +7,7 @@
 #define GPX_Phy2d_STATICOBJECT_HPP_
 
 #include "../phy/TransformationMatrix.hpp"
+#include "RigidTransform.hpp"
 
 #include <gpx/platform.hpp>
 
@@ -60,9 +61,14 @@ class GPX_API StaticObject
 		void setY(real_t y);
 
 		/**
-		 * Get transformation matrix;
+		 * Get transformation.
 		 */
-		const phy::TransformationMatrix & tMatrix() const;
+		const RigidTransform & transform() const;
+
+		/**
+		 * Get transformation matrix. Matrix is constructed from transform().
+		 */
+		phy::TransformationMatrix tMatrix() const;
 
 		/**
 		 * Map point from global to local coordinates.
@@ -89,16 +95,16 @@ class GPX_API StaticObject
 
 	protected:
 		/**
-		 * Construct transformation matrix. This virtual function can be re-implemented.
-		 * @param tMatrix transformation matrix.
-		 * @param invTMatrix inverted transformation matrix.
+		 * Construct transformation. This virtual function can be re-implemented.
+		 * @param transform transformation.
+		 * @param transformInv inverted transformation.
 		 */
-		virtual void constructTMatrix(phy::TransformationMatrix & tMatrix, phy::TransformationMatrix & tMatrixInv);
+		virtual void constructTMatrix(RigidTransform & transform, RigidTransform & transformInv);
 
 	private:
 		math::Point<2> m_pos; //position
-		phy::TransformationMatrix m_tMatrix;
-		phy::TransformationMatrix m_tMatrixInv;
+		RigidTransform m_transform;
+		RigidTransform m_transformInv;
 };
 
 }
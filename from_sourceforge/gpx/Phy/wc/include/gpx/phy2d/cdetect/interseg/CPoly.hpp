@@ -10,6 +10,7 @@
 
 #include <gpx/model/Poly.hpp>
 #include <gpx/model/functions.hpp>
+#include <gpx/model/EdgeData.hpp>
 #include <gpx/log.hpp>
 
 namespace gpx {
@@ -18,9 +19,11 @@ namespace cdetect {
 namespace interseg {
 
 /**
- * Colliding polygon frame implementation.
+ * Colliding polygon frame implementation. Edges of polygon are copied into
+ * model::EdgeData, so that segment tests can be performed with model::EdgeKernel.
+ * Whenever polygon vertices are modified updateEdges() has to be called.
  *
- * @todo consider using/test model::sqdistance() instead of model::intersection(prePost, seg)).dot() in normal().
+ * @todo consider using/test model::sqdistance() instead of model::intersection(prePost, seg)).dot() in query().
  */
 template <class DERIVED>
 class base_CPoly : public virtual ICPoly,
@@ -39,12 +42,33 @@ class base_CPoly : public virtual ICPoly,
 		//ICPoly
 		virtual bool test(math::const_PointRef<2> pre, math::const_PointRef<2> post) const;
 
+		/**
+		 * Segment query. Edges are scanned once. Similarly to normal(), normal vector
+		 * is given in local coordinates, so classes which map normal() to global
+		 * coordinates, should map normal obtained with this function as well.
+		 * @param pre pre-collision point.
+		 * @param post post-collision point.
+		 * @param result intersection data.
+		 * @return @p true if segment intersects polygon, @p false otherwise.
+		 */
+		//ICPoly
+		virtual bool query(math::const_PointRef<2> pre, math::const_PointRef<2> post, Intersection & result) const;
+
+		//ICPoly
+		virtual real_t boundr() const;
+
 		//ICPolyGroup
 		virtual element_t elements() const;
 
 		//ICPolyGroup
 		virtual const ICPoly * element(element_t i) const;
 
+		/**
+		 * Update edges. Copies edges of polygon into edge data used by test() and
+		 * query(). Should be called each time polygon vertices are modified.
+		 */
+		void updateEdges();
+
 	protected:
 		/**
 		 * Default constructor. This class is not intended to be used directly - use
@@ -56,6 +80,9 @@ class base_CPoly : public virtual ICPoly,
 		DERIVED & derived();
 
 		const DERIVED & derived() const;
+
+	private:
+		model::EdgeData m_edges;
 };
 
 template <class DERIVED>
@@ -72,57 +99,55 @@ const model::VertexData<2> & base_CPoly<DERIVED>::cvertices() const
 template <class DERIVED>
 math::Vector<2> base_CPoly<DERIVED>::normal(math::const_PointRef<2> pre, math::const_PointRef<2> post) const
 {
-	model::const_SegmentPtr<2> seg, result;
-	real_t dst = std::numeric_limits<real_t>::infinity(); //distance
-	model::const_SegmentPtr<2> prePost(pre.ptr(), post.ptr());
-
-	typename DERIVED::const_iterator i = derived().begin();
-	seg.setFirstPtr(*i);
-	while (++i != derived().end()) {
-		seg.setSecondPtr(*i);
-		if (model::intersect(seg, prePost)) {
-			//if more segments are intersecting take one closer to post-collision point (note that bumper's post is wedge's pre)
-			real_t newDst = (post - model::intersection(prePost, seg)).dot();
-			if (newDst < dst) {
-				result = seg;
-				dst = newDst;
-			}
-		}
-		seg.setFirstPtr(seg->second().ptr()); //next iteration
-	}
-	seg.setSecondPtr(*(derived().begin())); //looping segment
-	if (model::intersect(seg, prePost))
-		//if more segments are intersecting take one closer to post-collision point (note that bumper's post is wedge's pre)
-		if ((post - model::intersection(prePost, seg)).dot() < dst)
-			result = seg;
-
-	if (result.isNull()) {
+	Intersection result;
+	if (!base_CPoly<DERIVED>::query(pre, post, result)) {
 		//shouldn't happen if segment was tested with test() before, but to avoid tragedy...
-		//note: this warning is going to be removed after test and normal are merged.
 		GPX_WARN("can't determine normal vector for given collision points: " << pre << post);
 		return math::Vector<2>();
 	}
-	return (result->second() - result->first()).normalize().orthoCW();
+	return result.normal;
 }
 
 template <class DERIVED>
 bool base_CPoly<DERIVED>::test(math::const_PointRef<2> pre, math::const_PointRef<2> post) const
 {
-	const real_t * first;
-	const real_t * second;
+	return m_edges.intersect(pre.ptr(), post.ptr()) != m_edges.size();
+}
 
-	typename DERIVED::const_iterator i = derived().begin();
-	first = *i;
-	while (++i != derived().end()) {
-		second = *i;
-		if (model::intersect(model::const_SegmentPtr<2>(pre.ptr(), post.ptr()), model::const_SegmentPtr<2>(first, second)))
-			return true;
-		first = second;	//next iteration
+template <class DERIVED>
+bool base_CPoly<DERIVED>::query(math::const_PointRef<2> pre, math::const_PointRef<2> post, Intersection & result) const
+{
+	real_t dst = std::numeric_limits<real_t>::infinity(); //distance
+	model::const_SegmentPtr<2> prePost(pre.ptr(), post.ptr());
+	std::size_t nearest = NO_EDGE;
+
+	for (std::size_t edge = m_edges.intersect(pre.ptr(), post.ptr()); edge < m_edges.size(); edge = m_edges.intersect(pre.ptr(), post.ptr(), edge + 1)) {
+		real_t first[2] = {m_edges.x1()[edge], m_edges.y1()[edge]};
+		real_t second[2] = {m_edges.x2()[edge], m_edges.y2()[edge]};
+		//if more segments are intersecting take one closer to post-collision point (note that bumper's post is wedge's pre)
+		math::Point<2> point = model::intersection(prePost, model::const_SegmentPtr<2>(first, second));
+		real_t newDst = (post - point).dot();
+		if (newDst < dst) {
+			nearest = edge;
+			dst = newDst;
+			result.edge = edge;
+			result.point = point;
+		}
 	}
-	second = *(derived().begin()); //looping segment
-	if (model::intersect(model::const_SegmentPtr<2>(pre.ptr(), post.ptr()), model::const_SegmentPtr<2>(first, second)))
-		return true;
-	return false;
+
+	if (nearest == NO_EDGE)
+		return false;
+	real_t first[2] = {m_edges.x1()[nearest], m_edges.y1()[nearest]};
+	real_t second[2] = {m_edges.x2()[nearest], m_edges.y2()[nearest]};
+	model::const_SegmentPtr<2> seg(first, second);
+	result.normal = (seg->second() - seg->first()).normalize().orthoCW();
+	return true;
+}
+
+template <class DERIVED>
+real_t base_CPoly<DERIVED>::boundr() const
+{
+	return model::boundr(cvertices());
 }
 
 template <class DERIVED>
@@ -137,6 +162,12 @@ const ICPoly * base_CPoly<DERIVED>::element(element_t ) const
 	return this;
 }
 
+template <class DERIVED>
+void base_CPoly<DERIVED>::updateEdges()
+{
+	m_edges.assign(derived().begin(), derived().end());
+}
+
 template <class DERIVED>
 const DERIVED & base_CPoly<DERIVED>::derived() const
 {
@@ -179,12 +210,14 @@ template <model::index_t INDEX>
 CPoly<INDEX>::CPoly(typename Parent::index_t * indices, std::size_t size, const model::VertexData<2> & vdata):
 	Parent(indices, size, vdata)
 {
+	this->updateEdges();
 }
 
 template <model::index_t INDEX>
 CPoly<INDEX>::CPoly(const typename Parent::Index & index, const model::VertexData<2> & vdata):
 	Parent(index, vdata)
 {
+	this->updateEdges();
 }
 
 
@@ -209,6 +242,7 @@ inline
 CPoly<model::NONE>::CPoly(const model::VertexData<2> & vdata):
 	Parent(vdata)
 {
+	updateEdges();
 }
 
 
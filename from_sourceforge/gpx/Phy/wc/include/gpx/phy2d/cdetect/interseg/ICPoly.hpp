@@ -9,6 +9,8 @@
 #include <gpx/model/VertexData.hpp>
 #include <gpx/math/structures.hpp>
 
+#include <limits>
+
 namespace gpx {
 namespace phy2d {
 namespace cdetect {
@@ -19,6 +21,19 @@ namespace interseg {
  */
 class ICPoly
 {
+	public:
+		static const std::size_t NO_EDGE = static_cast<std::size_t>(-1);	///< Edge index indicating that edge is unknown.
+
+		/**
+		 * Intersection. Result of query().
+		 */
+		struct Intersection
+		{
+			std::size_t edge;		///< Index of intersected edge or NO_EDGE.
+			math::Point<2> point;	///< Intersection point in local coordinates.
+			math::Vector<2> normal;	///< Normal vector given in global coordinates, as returned by normal().
+		};
+
 	public:
 		/**
 		 * Get colliding vertices. C-vertices or colliding vertices are those vertices
@@ -53,6 +68,44 @@ class ICPoly
 		 */
 		virtual bool test(math::const_PointRef<2> pre, math::const_PointRef<2> post) const = 0;
 
+		/**
+		 * Segment query. Fused segment test and normal query. Function performs test()
+		 * and, if segment intersects an object, obtains nearest intersected edge,
+		 * intersection point and normal (as if normal() was called), all at once.
+		 * If more edges are intersected, edge nearest to post-collision point is taken.
+		 * @param pre pre-collision point.
+		 * @param post post-collision point.
+		 * @param result intersection data. It is filled only if function returns @p true.
+		 * @return @p true if segment defined by pre- and post-collision points intersects
+		 * an object, @p false otherwise.
+		 *
+		 * @note default implementation calls test() and normal(). It is not able to determine
+		 * intersected edge, so it sets @a result edge to NO_EDGE and intersection point to
+		 * @a post.
+		 */
+		virtual bool query(math::const_PointRef<2> pre, math::const_PointRef<2> post, Intersection & result) const
+		{
+			if (!test(pre, post))
+				return false;
+			result.edge = NO_EDGE;
+			result.point = post;
+			result.normal = normal(pre, post);
+			return true;
+		}
+
+		/**
+		 * Get bounding radius. Bounding radius defines a circle centered at the origin of
+		 * object's local coordinates, which encloses c-vertices and all the points, for
+		 * which test() may return @p true. Colliders use it to discard distant objects
+		 * before segment tests are performed.
+		 * @return bounding radius. Default implementation returns infinity, which means
+		 * that element is unbounded and can not be discarded.
+		 */
+		virtual real_t boundr() const
+		{
+			return std::numeric_limits<real_t>::infinity();
+		}
+
 	protected:
 		~ICPoly() {}
 };
@@ -0,0 +1,499 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_Phy2d_CNEWTON_PMEPP2_S_AABBTREE_HPP_
+#define GPX_Phy2d_CNEWTON_PMEPP2_S_AABBTREE_HPP_
+
+#include <gpx/platform.hpp>
+#include <gpx/log.hpp>
+
+#include <vector>
+#include <algorithm>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+/**
+ * Dynamic axis-aligned bounding box tree. Bounding volume hierarchy, which supports
+ * insertions, removals and refits of leaves. Tree is kept balanced with rotations,
+ * and new leaves are placed according to perimeter heuristic, so queries run in
+ * logarithmic time.
+ * @tparam T type of data associated with leaves.
+ */
+template <typename T>
+class AABBTree
+{
+	public:
+		typedef int node_t;	///< Node identifier type.
+
+		static const node_t NULL_NODE = -1;
+
+	public:
+		AABBTree();
+
+	public:
+		/**
+		 * Insert leaf.
+		 * @param min box minimal coordinates.
+		 * @param max box maximal coordinates.
+		 * @param data data associated with leaf.
+		 * @return leaf identifier. Identifier remains valid until leaf is removed.
+		 *
+		 * @warning boxes must be bounded.
+		 */
+		node_t insert(const real_t * min, const real_t * max, const T & data);
+
+		/**
+		 * Remove leaf.
+		 * @param leaf leaf identifier.
+		 */
+		void remove(node_t leaf);
+
+		/**
+		 * Refit leaf. Leaf box is replaced with the new one and boxes of its ancestors
+		 * are recomputed. Tree structure remains untouched, so refit is cheap, but if
+		 * leaf is moved far away, quality of the tree degrades. In such case consider
+		 * removing and inserting leaf again.
+		 * @param leaf leaf identifier.
+		 * @param min new box minimal coordinates.
+		 * @param max new box maximal coordinates.
+		 */
+		void refit(node_t leaf, const real_t * min, const real_t * max);
+
+		/**
+		 * Query tree. Callback is invoked with data of each leaf, which box overlaps
+		 * given box. Touching boxes are considered as overlapping.
+		 * @param min box minimal coordinates.
+		 * @param max box maximal coordinates.
+		 * @param callback callback object, which provides <tt>operator()(const T &)</tt>.
+		 */
+		template <class CALLBACK>
+		void query(const real_t * min, const real_t * max, CALLBACK & callback) const;
+
+		/**
+		 * Get leaf data.
+		 * @param leaf leaf identifier.
+		 * @return data associated with leaf.
+		 */
+		const T & data(node_t leaf) const;
+
+		/**
+		 * Get number of leaves.
+		 * @return number of leaves.
+		 */
+		std::size_t size() const;
+
+		/**
+		 * Get tree height.
+		 * @return height of the tree. Empty tree and tree with single leaf have
+		 * height equal to 0.
+		 */
+		int height() const;
+
+	private:
+		struct Node
+		{
+			real_t min[2];
+			real_t max[2];
+			node_t parent;	///< Parent node. For free nodes this is next free node.
+			node_t child1;
+			node_t child2;
+			int height;		///< Height of subtree. Leaves have height 0, free nodes -1.
+			T data;
+
+			bool isLeaf() const;
+		};
+
+		typedef std::vector<Node> NodesContainer;
+		typedef std::vector<node_t> StackContainer;
+
+		node_t allocateNode();
+
+		void freeNode(node_t node);
+
+		void insertLeaf(node_t leaf);
+
+		void removeLeaf(node_t leaf);
+
+		void fixUpwards(node_t node, bool rebalance);
+
+		node_t balance(node_t iA);
+
+		void combine(node_t node, node_t first, node_t second);
+
+		static real_t Perimeter(const real_t * min, const real_t * max);
+
+		static real_t CombinedPerimeter(const Node & first, const Node & second);
+
+		static bool Overlaps(const Node & node, const real_t * min, const real_t * max);
+
+	private:
+		NodesContainer m_nodes;
+		node_t m_root;
+		node_t m_free;
+		std::size_t m_leaves;
+		mutable StackContainer m_stack;
+};
+
+template <typename T>
+AABBTree<T>::AABBTree():
+	m_root(NULL_NODE),
+	m_free(NULL_NODE),
+	m_leaves(0)
+{
+}
+
+template <typename T>
+typename AABBTree<T>::node_t AABBTree<T>::insert(const real_t * min, const real_t * max, const T & data)
+{
+	node_t leaf = allocateNode();
+	Node & node = m_nodes[leaf];
+	node.min[0] = min[0];
+	node.min[1] = min[1];
+	node.max[0] = max[0];
+	node.max[1] = max[1];
+	node.height = 0;
+	node.data = data;
+	insertLeaf(leaf);
+	m_leaves++;
+	return leaf;
+}
+
+template <typename T>
+void AABBTree<T>::remove(node_t leaf)
+{
+	GPX_ASSERT(m_nodes[leaf].isLeaf() && (m_nodes[leaf].height == 0), "node is not a leaf");
+	removeLeaf(leaf);
+	freeNode(leaf);
+	m_leaves--;
+}
+
+template <typename T>
+void AABBTree<T>::refit(node_t leaf, const real_t * min, const real_t * max)
+{
+	GPX_ASSERT(m_nodes[leaf].isLeaf() && (m_nodes[leaf].height == 0), "node is not a leaf");
+	Node & node = m_nodes[leaf];
+	node.min[0] = min[0];
+	node.min[1] = min[1];
+	node.max[0] = max[0];
+	node.max[1] = max[1];
+	fixUpwards(node.parent, false);
+}
+
+template <typename T>
+template <class CALLBACK>
+void AABBTree<T>::query(const real_t * min, const real_t * max, CALLBACK & callback) const
+{
+	if (m_root == NULL_NODE)
+		return;
+
+	m_stack.clear();
+	m_stack.push_back(m_root);
+	while (!m_stack.empty()) {
+		const Node & node = m_nodes[m_stack.back()];
+		m_stack.pop_back();
+		if (!Overlaps(node, min, max))
+			continue;
+		if (node.isLeaf())
+			callback(node.data);
+		else {
+			m_stack.push_back(node.child1);
+			m_stack.push_back(node.child2);
+		}
+	}
+}
+
+template <typename T>
+const T & AABBTree<T>::data(node_t leaf) const
+{
+	return m_nodes[leaf].data;
+}
+
+template <typename T>
+std::size_t AABBTree<T>::size() const
+{
+	return m_leaves;
+}
+
+template <typename T>
+int AABBTree<T>::height() const
+{
+	if (m_root == NULL_NODE)
+		return 0;
+	return m_nodes[m_root].height;
+}
+
+template <typename T>
+typename AABBTree<T>::node_t AABBTree<T>::allocateNode()
+{
+	if (m_free == NULL_NODE) {
+		m_nodes.push_back(Node());
+		m_free = static_cast<node_t>(m_nodes.size() - 1);
+		m_nodes[m_free].parent = NULL_NODE;
+	}
+	node_t node = m_free;
+	m_free = m_nodes[node].parent;
+	m_nodes[node].parent = NULL_NODE;
+	m_nodes[node].child1 = NULL_NODE;
+	m_nodes[node].child2 = NULL_NODE;
+	m_nodes[node].height = 0;
+	return node;
+}
+
+template <typename T>
+void AABBTree<T>::freeNode(node_t node)
+{
+	m_nodes[node].parent = m_free;
+	m_nodes[node].height = -1;
+	m_free = node;
+}
+
+template <typename T>
+void AABBTree<T>::insertLeaf(node_t leaf)
+{
+	if (m_root == NULL_NODE) {
+		m_root = leaf;
+		m_nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	//find the best sibling - descend while cost of creating new parent is higher than pushing leaf down
+	const Node & leafNode = m_nodes[leaf];
+	node_t index = m_root;
+	while (!m_nodes[index].isLeaf()) {
+		const Node & node = m_nodes[index];
+		real_t area = Perimeter(node.min, node.max);
+		real_t combinedArea = CombinedPerimeter(node, leafNode);
+		//cost of creating a new parent for this node and the new leaf
+		real_t cost = 2.0 * combinedArea;
+		//minimum cost of pushing the leaf further down the tree
+		real_t inheritanceCost = 2.0 * (combinedArea - area);
+
+		real_t childCost[2];
+		node_t children[2] = {node.child1, node.child2};
+		for (int i = 0; i < 2; i++) {
+			const Node & child = m_nodes[children[i]];
+			childCost[i] = CombinedPerimeter(child, leafNode) + inheritanceCost;
+			if (!child.isLeaf())
+				childCost[i] -= Perimeter(child.min, child.max);
+		}
+
+		if ((cost < childCost[0]) && (cost < childCost[1]))
+			break;
+		index = childCost[0] < childCost[1] ? children[0] : children[1];
+	}
+	node_t sibling = index;
+
+	//create new parent
+	node_t oldParent = m_nodes[sibling].parent;
+	node_t newParent = allocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	combine(newParent, sibling, leaf);
+	if (oldParent != NULL_NODE) {
+		if (m_nodes[oldParent].child1 == sibling)
+			m_nodes[oldParent].child1 = newParent;
+		else
+			m_nodes[oldParent].child2 = newParent;
+	} else
+		m_root = newParent;
+	m_nodes[newParent].child1 = sibling;
+	m_nodes[newParent].child2 = leaf;
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	fixUpwards(m_nodes[leaf].parent, true);
+}
+
+template <typename T>
+void AABBTree<T>::removeLeaf(node_t leaf)
+{
+	if (leaf == m_root) {
+		m_root = NULL_NODE;
+		return;
+	}
+
+	node_t parent = m_nodes[leaf].parent;
+	node_t grandParent = m_nodes[parent].parent;
+	node_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	if (grandParent != NULL_NODE) {
+		//connect sibling to grand parent and destroy parent
+		if (m_nodes[grandParent].child1 == parent)
+			m_nodes[grandParent].child1 = sibling;
+		else
+			m_nodes[grandParent].child2 = sibling;
+		m_nodes[sibling].parent = grandParent;
+		freeNode(parent);
+		fixUpwards(grandParent, true);
+	} else {
+		m_root = sibling;
+		m_nodes[sibling].parent = NULL_NODE;
+		freeNode(parent);
+	}
+}
+
+template <typename T>
+void AABBTree<T>::fixUpwards(node_t node, bool rebalance)
+{
+	while (node != NULL_NODE) {
+		if (rebalance)
+			node = balance(node);
+		Node & n = m_nodes[node];
+		n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+		combine(node, n.child1, n.child2);
+		node = n.parent;
+	}
+}
+
+template <typename T>
+typename AABBTree<T>::node_t AABBTree<T>::balance(node_t iA)
+{
+	//perform left or right rotation if node A is imbalanced
+	Node & A = m_nodes[iA];
+	if (A.isLeaf() || (A.height < 2))
+		return iA;
+
+	node_t iB = A.child1;
+	node_t iC = A.child2;
+	Node & B = m_nodes[iB];
+	Node & C = m_nodes[iC];
+
+	int balance = C.height - B.height;
+
+	if (balance > 1) {
+		//rotate C up
+		node_t iF = C.child1;
+		node_t iG = C.child2;
+		Node & F = m_nodes[iF];
+		Node & G = m_nodes[iG];
+
+		//swap A and C
+		C.child1 = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+		if (C.parent != NULL_NODE) {
+			if (m_nodes[C.parent].child1 == iA)
+				m_nodes[C.parent].child1 = iC;
+			else
+				m_nodes[C.parent].child2 = iC;
+		} else
+			m_root = iC;
+
+		//rotate
+		if (F.height > G.height) {
+			C.child2 = iF;
+			A.child2 = iG;
+			G.parent = iA;
+			combine(iA, iB, iG);
+			combine(iC, iA, iF);
+			A.height = 1 + std::max(B.height, G.height);
+			C.height = 1 + std::max(A.height, F.height);
+		} else {
+			C.child2 = iG;
+			A.child2 = iF;
+			F.parent = iA;
+			combine(iA, iB, iF);
+			combine(iC, iA, iG);
+			A.height = 1 + std::max(B.height, F.height);
+			C.height = 1 + std::max(A.height, G.height);
+		}
+		return iC;
+	}
+
+	if (balance < -1) {
+		//rotate B up
+		node_t iD = B.child1;
+		node_t iE = B.child2;
+		Node & D = m_nodes[iD];
+		Node & E = m_nodes[iE];
+
+		//swap A and B
+		B.child1 = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+		if (B.parent != NULL_NODE) {
+			if (m_nodes[B.parent].child1 == iA)
+				m_nodes[B.parent].child1 = iB;
+			else
+				m_nodes[B.parent].child2 = iB;
+		} else
+			m_root = iB;
+
+		//rotate
+		if (D.height > E.height) {
+			B.child2 = iD;
+			A.child1 = iE;
+			E.parent = iA;
+			combine(iA, iC, iE);
+			combine(iB, iA, iD);
+			A.height = 1 + std::max(C.height, E.height);
+			B.height = 1 + std::max(A.height, D.height);
+		} else {
+			B.child2 = iE;
+			A.child1 = iD;
+			D.parent = iA;
+			combine(iA, iC, iD);
+			combine(iB, iA, iE);
+			A.height = 1 + std::max(C.height, D.height);
+			B.height = 1 + std::max(A.height, E.height);
+		}
+		return iB;
+	}
+
+	return iA;
+}
+
+template <typename T>
+void AABBTree<T>::combine(node_t node, node_t first, node_t second)
+{
+	Node & n = m_nodes[node];
+	const Node & f = m_nodes[first];
+	const Node & s = m_nodes[second];
+	for (int i = 0; i < 2; i++) {
+		n.min[i] = std::min(f.min[i], s.min[i]);
+		n.max[i] = std::max(f.max[i], s.max[i]);
+	}
+}
+
+template <typename T>
+real_t AABBTree<T>::Perimeter(const real_t * min, const real_t * max)
+{
+	return 2.0 * ((max[0] - min[0]) + (max[1] - min[1]));
+}
+
+template <typename T>
+real_t AABBTree<T>::CombinedPerimeter(const Node & first, const Node & second)
+{
+	return 2.0 * ((std::max(first.max[0], second.max[0]) - std::min(first.min[0], second.min[0]))
+			+ (std::max(first.max[1], second.max[1]) - std::min(first.min[1], second.min[1])));
+}
+
+template <typename T>
+bool AABBTree<T>::Overlaps(const Node & node, const real_t * min, const real_t * max)
+{
+	return (node.min[0] <= max[0]) && (min[0] <= node.max[0])
+			&& (node.min[1] <= max[1]) && (min[1] <= node.max[1]);
+}
+
+template <typename T>
+bool AABBTree<T>::Node::isLeaf() const
+{
+	return child1 == NULL_NODE;
+}
+
+}
+}
+}
+}
+
+#endif /* GPX_Phy2d_CNEWTON_PMEPP2_S_AABBTREE_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -9,6 +9,7 @@
 #include "Cluster.hpp"
 
 #include <gpx/math/Matrix.hpp>
+#include <gpx/math/SparseMatrix.hpp>
 
 namespace gpx {
 namespace phy2d {
@@ -22,16 +23,27 @@ namespace pmepp2_s {
  * they are calculated for (and attached to, in case of impulses). Collision points are
  * given collision indices, which can be used to identify impulses Fdt_i and velocities
  * b_v, therefore defining placement of matrix element a_vi. Mapper class provides a standard
- * way for the user classes to put their additions into matrix A.
+ * way for the user classes to put their additions into matrix A. Matrix A may be either
+ * dense or sparse.
  */
 class GPX_API ACoefsMapper
 {
 	public:
+		/**
+		 * Constructor.
+		 * @param a dense matrix. Matrix should be resized and zeroed beforehand.
+		 */
 		ACoefsMapper(math::Matrix<> & a);
 
+		/**
+		 * Constructor.
+		 * @param a sparse matrix. Matrix should be in assembly phase.
+		 */
+		ACoefsMapper(math::SparseMatrix<> & a);
+
 	public:
 		/**
-		 * Add value to an existing matrix element.
+		 * Add value to matrix element.
 		 * @param v iterator pointing to collision index of point for which velocity
 		 * b_v has been found.
 		 * @param i iterator pointing to collision index of point for which collision
@@ -51,7 +63,8 @@ class GPX_API ACoefsMapper
 		real_t get(std::size_t v, std::size_t i) const;
 
 	private:
-		math::Matrix<> & m_a;
+		math::Matrix<> * m_a;
+		math::SparseMatrix<> * m_sparseA;
 };
 
 }
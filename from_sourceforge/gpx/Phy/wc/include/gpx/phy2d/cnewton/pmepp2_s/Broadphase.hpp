@@ -0,0 +1,250 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_Phy2d_CNEWTON_PMEPP2_S_BROADPHASE_HPP_
+#define GPX_Phy2d_CNEWTON_PMEPP2_S_BROADPHASE_HPP_
+
+#include "../../../phy_config.hpp"
+#include "ICMovable.hpp"
+
+#include <gpx/platform.hpp>
+
+#include <vector>
+#include <utility>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+/**
+ * Broadphase. Broadphase discards pairs of objects, which can not collide, before
+ * collider performs expensive segment tests. Each registered object is bounded by
+ * an axis-aligned box, which encloses circles of bounding radius (ICPoly::boundr())
+ * placed at object's pre- and post-collision positions. Pairs of objects with
+ * overlapping boxes are candidate pairs. Pairs of fixed objects are never reported.
+ *
+ * Objects are identified by handles, which are assigned by the caller (collider).
+ * Handles should be small integers, which are reused after objects are removed, as
+ * broadphase uses them to index its proxies directly. Candidate lists contain
+ * handles as well.
+ *
+ * Derived classes only have to find overlapping pairs (findPairs()). Candidate lists
+ * are sorted in order in which objects have been added, so that collider visits
+ * candidates in the same order regardless of broadphase implementation.
+ */
+class GPX_API Broadphase
+{
+	public:
+		typedef std::size_t handle_t;
+		typedef std::vector<handle_t> HandlesContainer;
+		typedef std::pair<const ICFixed *, const ICFixed *> Pair;
+		typedef std::vector<Pair> PairsContainer;
+
+	public:
+		virtual ~Broadphase();
+
+	public:
+		/**
+		 * Add fixed object. Bounds of fixed objects are calculated only once.
+		 * @param obj object to add.
+		 * @param handle handle of an object.
+		 */
+		void addFixed(ICFixed * obj, handle_t handle);
+
+		/**
+		 * Remove fixed object.
+		 * @param handle handle of an object to remove.
+		 */
+		void removeFixed(handle_t handle);
+
+		/**
+		 * Add movable object.
+		 * @param obj object to add.
+		 * @param handle handle of an object.
+		 */
+		void addMovable(ICMovable * obj, handle_t handle);
+
+		/**
+		 * Remove movable object.
+		 * @param handle handle of an object to remove.
+		 */
+		void removeMovable(handle_t handle);
+
+		/**
+		 * Refit fixed object. Bounds of fixed objects are calculated only once, when
+		 * object is added. If fixed object has been repositioned, this function has to
+		 * be called to recalculate its bounds.
+		 * @param handle handle of fixed object.
+		 */
+		void refitFixed(handle_t handle);
+
+		/**
+		 * Set bounding radius of an object. Bounding radius is calculated by broadphase
+		 * only when object is added or refitFixed() is called. Owner, which tracks bounding
+		 * radii of objects anyway (e.g. shape-shifting movables), should pass them with this
+		 * function before calling update(), so that radii are not calculated twice per frame.
+		 * Same radius is used for pre- and post-collision positions of movable objects.
+		 * @param handle handle of an object.
+		 * @param boundr bounding radius.
+		 */
+		void setBoundr(handle_t handle, real_t boundr);
+
+		/**
+		 * Update bounds of movable objects and find candidate pairs.
+		 *
+		 * @warning buffers of movable objects are swapped back and forth to obtain
+		 * pre-collision positions. Function has to be called, when all movables are
+		 * in post-collision state.
+		 */
+		void update();
+
+		/**
+		 * Refit movable object. Recalculates bounds of an object, which has been moved
+		 * after update(), and its candidates, without updating remaining objects. Object
+		 * is also added to or removed from candidate lists of other objects, but pairs()
+		 * still reflect state from the last update(). Candidates are found by testing
+		 * all registered objects, so refitting is cheaper than update() only as long as
+		 * a small fraction of objects is refitted.
+		 * @param handle handle of movable object.
+		 *
+		 * @warning same as with update(), object has to be in post-collision state.
+		 */
+		void refit(handle_t handle);
+
+		/**
+		 * Get movable candidates.
+		 * @param handle handle of registered object.
+		 * @return handles of movable objects, which may collide with given object.
+		 */
+		const HandlesContainer & movables(handle_t handle) const;
+
+		/**
+		 * Get fixed candidates.
+		 * @param handle handle of registered object.
+		 * @return handles of fixed objects, which may collide with given object.
+		 */
+		const HandlesContainer & fixed(handle_t handle) const;
+
+		/**
+		 * Test pair of objects.
+		 * @param first handle of first registered object.
+		 * @param second handle of second registered object.
+		 * @return @p true if bounds of objects overlap, @p false otherwise.
+		 */
+		bool test(handle_t first, handle_t second) const;
+
+		/**
+		 * Get candidate pairs. Each pair is stored once, with object added earlier as
+		 * the first member of a pair. Pairs are sorted in order in which objects have
+		 * been added. This is meant mainly for comparisons between implementations.
+		 * @param pairs container to which pairs will be appended.
+		 */
+		void pairs(PairsContainer & pairs) const;
+
+	protected:
+		struct Proxy
+		{
+			ICFixed * fix;			///< Object.
+			ICMovable * mov;		///< Movable object or null pointer if object is fixed.
+			handle_t handle;		///< Object handle.
+			std::size_t serial;		///< Serial number. Reflects order in which objects have been added.
+			real_t boundr;			///< Bounding radius.
+			real_t min[2];			///< Bounding box minimal coordinates.
+			real_t max[2];			///< Bounding box maximal coordinates.
+			HandlesContainer movables;	///< Movable candidates.
+			HandlesContainer fixed;		///< Fixed candidates.
+
+			Proxy(ICFixed * p_fix, ICMovable * p_mov, handle_t p_handle, std::size_t p_serial);
+
+			bool overlaps(const Proxy & other) const;
+		};
+
+		typedef std::pair<Proxy *, Proxy *> ProxyPair;
+		typedef std::vector<ProxyPair> ProxyPairsContainer;
+
+	protected:
+		Broadphase();
+
+		/**
+		 * Find overlapping pairs. Implementation shall append to @a pairs all pairs of
+		 * proxies with overlapping bounds (Proxy::overlaps()), except pairs of fixed
+		 * objects. Each pair should be reported once. Order of proxies within pair and
+		 * order of pairs does not matter.
+		 * @param pairs pairs container.
+		 */
+		virtual void findPairs(ProxyPairsContainer & pairs) = 0;
+
+		/**
+		 * Proxy added. Called after proxy has been created and its bounds have been
+		 * calculated.
+		 * @param proxy new proxy.
+		 */
+		virtual void proxyAdded(Proxy * proxy) = 0;
+
+		/**
+		 * Proxy removed. Called before proxy is destroyed.
+		 * @param proxy proxy to be removed.
+		 */
+		virtual void proxyRemoved(Proxy * proxy) = 0;
+
+		/**
+		 * Refit proxy of a fixed object. Implementation shall recalculate proxy bounds
+		 * with updateBounds() and update its own structures. Default implementation
+		 * calls proxyRemoved(), then recalculates bounds and calls proxyAdded().
+		 * @param proxy proxy to be refitted.
+		 */
+		virtual void proxyRefit(Proxy * proxy);
+
+		/**
+		 * Update proxy bounds. Cached bounding radius (Proxy::boundr) is used.
+		 * @param proxy proxy.
+		 */
+		void updateBounds(Proxy & proxy);
+
+		/**
+		 * Calculate bounding radius of an object.
+		 * @param obj object.
+		 * @return maximal bounding radius of object's elements.
+		 */
+		static real_t Boundr(const ICFixed & obj);
+
+	private:
+		typedef std::vector<Proxy *> ProxiesContainer;
+		typedef std::vector<Proxy *> MovableProxiesContainer;
+
+		static bool SerialLess(const ProxyPair & first, const ProxyPair & second);
+
+		/**
+		 * Insert candidate into candidate list, keeping the list sorted by serial numbers.
+		 * @param candidates candidate list.
+		 * @param candidate candidate proxy.
+		 */
+		void insertCandidate(HandlesContainer & candidates, const Proxy & candidate) const;
+
+		Proxy * addProxy(ICFixed * fix, ICMovable * mov, handle_t handle);
+
+		void removeProxy(handle_t handle);
+
+		const Proxy & proxy(handle_t handle) const;
+
+	private:
+		std::size_t m_serial;
+		ProxiesContainer m_proxies;	///< Proxies indexed by handles.
+		MovableProxiesContainer m_movableProxies;
+		ProxyPairsContainer m_pairs;
+};
+
+}
+}
+}
+}
+
+#endif /* GPX_Phy2d_CNEWTON_PMEPP2_S_BROADPHASE_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
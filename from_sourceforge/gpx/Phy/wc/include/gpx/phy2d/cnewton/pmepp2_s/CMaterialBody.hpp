@@ -28,11 +28,14 @@ class GPX_API CMaterialBody : public phy2d::MaterialBody,
 
 	public:
 		//ICFixed
-		void aCoefs(const DetectionData & dData, math::Matrix<> & a) const;
+		void aCoefs(const DetectionData & dData, ACoefsMapper & a) const;
 
 		//ICFixed
 		void bCoefs(const DetectionData & dData, math::Vector<> & b) const;
 
+		//ICFixed
+		bool symmetricACoefs() const;
+
 //		phy::material_t material() const;
 //
 //		void setMaterial(phy::material_t material);
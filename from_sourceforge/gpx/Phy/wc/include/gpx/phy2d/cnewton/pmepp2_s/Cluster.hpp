@@ -45,6 +45,16 @@ struct DetectionData
 		cluster(& p_cluster)
 	{
 	}
+
+	/**
+	 * Constructor. Creates detection data, which is not yet assigned to any cluster.
+	 */
+	DetectionData(ICFixed & p_fix, ICMovable * p_mov):
+		fix(& p_fix),
+		mov(p_mov),
+		cluster(0)
+	{
+	}
 };
 
 typedef std::vector<DetectionData> DetectionDataContainer;
@@ -54,6 +64,7 @@ struct Cluster
 	real_t dt;				///< Collision time.
 	std::size_t endIndex;	///< End index. Equivalent to total number of contacts.
 	DetectionDataContainer detections;
+	std::vector<std::size_t> bodies;	///< Collider indices of movable objects in order of their detections.
 
 	Cluster(real_t p_dt):
 		dt(p_dt),
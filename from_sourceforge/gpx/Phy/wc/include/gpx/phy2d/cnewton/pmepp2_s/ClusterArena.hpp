@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_Phy2d_CNEWTON_PMEPP2_S_CLUSTERARENA_HPP_
+#define GPX_Phy2d_CNEWTON_PMEPP2_S_CLUSTERARENA_HPP_
+
+#include "Cluster.hpp"
+
+#include <gpx/platform.hpp>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+/**
+ * Cluster arena. Recycles clusters and contact containers across frames. Clusters
+ * acquired during a frame are released all at once by releaseClusters(). Released
+ * clusters keep capacity of their detection containers and contact containers of
+ * their detections are moved to a pool of spare containers, from which they are
+ * handed out again by acquireContacts(). Once arena has warmed up, clusters,
+ * detections and contacts do not cause heap allocations.
+ */
+class GPX_API ClusterArena
+{
+	public:
+		static const std::size_t INITIAL_CONTACTS = 8;	///< Capacity reserved for newly allocated contact containers.
+
+	public:
+		ClusterArena();
+
+		~ClusterArena();
+
+	public:
+		/**
+		 * Acquire cluster.
+		 * @param dt collision time.
+		 * @return empty cluster. Cluster remains valid until releaseClusters() is called.
+		 */
+		Cluster * acquireCluster(real_t dt);
+
+		/**
+		 * Release all acquired clusters. Contact containers of detections are moved to
+		 * the pool of spare containers.
+		 */
+		void releaseClusters();
+
+		/**
+		 * Acquire contacts container. Spare container is swapped with @a contacts. If
+		 * there are no spare containers, storage for @ref INITIAL_CONTACTS contacts is
+		 * reserved.
+		 * @param contacts empty container, which will obtain storage.
+		 */
+		void acquireContacts(ContactDataContainer & contacts);
+
+		/**
+		 * Release contacts container. Storage of @a contacts is moved to the pool of
+		 * spare containers.
+		 * @param contacts container to release. It will be left empty.
+		 */
+		void releaseContacts(ContactDataContainer & contacts);
+
+		/**
+		 * Move detection to the cluster. Detection is appended to cluster's detections
+		 * without copying contacts - storage of contacts container is moved instead.
+		 * @param cluster target cluster.
+		 * @param detection detection data. Its contacts container will be left empty.
+		 */
+		static void MoveDetection(Cluster & cluster, DetectionData & detection);
+
+		/**
+		 * Get number of clusters owned by arena.
+		 * @return number of clusters allocated so far.
+		 */
+		std::size_t clusters() const;
+
+		/**
+		 * Get number of clusters in use.
+		 * @return number of clusters acquired since last releaseClusters() call.
+		 */
+		std::size_t clustersInUse() const;
+
+		/**
+		 * Get detections capacity.
+		 * @return total capacity of detection containers of all clusters.
+		 */
+		std::size_t detectionsCapacity() const;
+
+		/**
+		 * Get number of spare contact containers.
+		 * @return number of contact containers in the pool.
+		 */
+		std::size_t spareContacts() const;
+
+		/**
+		 * Get contacts capacity.
+		 * @return total capacity of spare contact containers.
+		 */
+		std::size_t contactsCapacity() const;
+
+		/**
+		 * Get number of misses. Miss occurs whenever new cluster or new contacts
+		 * container has to be allocated. In steady state this number should not grow.
+		 * @return number of misses.
+		 */
+		std::size_t misses() const;
+
+	private:
+		typedef std::vector<ContactDataContainer> SpareContactsContainer;
+
+		ClustersContainer m_clusters;
+		std::size_t m_clustersInUse;
+		SpareContactsContainer m_spareContacts;
+		std::size_t m_misses;
+};
+
+}
+}
+}
+}
+
+#endif /* GPX_Phy2d_CNEWTON_PMEPP2_S_CLUSTERARENA_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -9,12 +9,22 @@
 #include "../../../phy_config.hpp"
 #include "../../../phy/NewtonPlasticityTable.hpp"
 #include "BasicExecutor.hpp"
+#include "Broadphase.hpp"
+#include "ClusterArena.hpp"
+#include "ContactCache.hpp"
+#include "IslandBuilder.hpp"
 #include "Introspector.hpp"	//@todo wrap inside ifndfef NDEBUG condition perhaps
 
 //#include <gpx/utils/DynamicArray.hpp>
 #include <gpx/utils/functions.hpp>
 #include <gpx/ext/UnorderedMap.hpp>
-#include <gpx/ext/UnorderedSet.hpp>
+#include <gpx/math/NNSolver.hpp>
+#include <gpx/math/LCPSolver.hpp>
+#include <gpx/math/SparseMatrix.hpp>
+#include <gpx/math/SparseLCPSolver.hpp>
+#include <gpx/utils/ThreadPool.hpp>
+
+#include <mutex>
 
 namespace gpx {
 namespace phy2d {
@@ -33,15 +43,45 @@ class GPX_API Collider
 		static const std::size_t INITIAL_SUBSEQUENT_COLLISION_LIMIT = 2;
 		static const std::size_t INITIAL_OBJECTS_PER_COLLISION = 8;	///< Expected maximal number of objects per collision (this is for memory reservation only, not a strict limit).
 		static const std::size_t INITIAL_CPOINTS_PER_OBJECT = 32;	///< Expected maximal number of collision points per object (this is for memory reservation only, not a strict limit).
+		static const std::size_t INITIAL_PGS_ITERATIONS = 64;	///< Initial iteration limit of projected Gauss-Seidel solver.
 
 	public:
 		typedef class ACoefsMapper ACoefsMapper;
 		typedef class BCoefsMapper BCoefsMapper;
+		typedef Broadphase::handle_t handle_t;
+
+		/**
+		 * Broadphase types, which can be selected during construction.
+		 */
+		enum broadphase_t {
+			SWEEP_AND_PRUNE,	///< SweepAndPruneBroadphase.
+			SPATIAL_HASH,		///< SpatialHashBroadphase with auto-tuned cell size.
+			BRUTE_FORCE			///< BruteForceBroadphase.
+		};
+
+		/**
+		 * Solvers of contact impulses.
+		 */
+		enum solver_t {
+			NN_SOLVER,			///< Non-negative linear equation solver (math::NNSolver), which clips equations with negative impulses and solves system again.
+			PGS_SOLVER,			///< Projected Gauss-Seidel linear complementarity solver (math::SparseLCPSolver). Equations are assembled into sparse matrix.
+			DANTZIG_SOLVER		///< Dantzig principal pivoting linear complementarity solver (math::LCPSolver). Exact, suitable for small clusters. Clusters with non-symmetric matrices are solved with NN_SOLVER.
+		};
 
 	public:
 		Collider(BasicExecutor & collisionContractor = DefaultCollisionContractor(),
 				 phy::NewtonPlasticityTable & m_plasticityTable = phy::NewtonPlasticityTable::Instance());
 
+		/**
+		 * Constructor.
+		 * @param broadphase type of broadphase to be used by collider.
+		 * @param collisionContractor collision contractor.
+		 * @param m_plasticityTable plasticity table.
+		 */
+		explicit Collider(broadphase_t broadphase,
+						  BasicExecutor & collisionContractor = DefaultCollisionContractor(),
+						  phy::NewtonPlasticityTable & m_plasticityTable = phy::NewtonPlasticityTable::Instance());
+
 		virtual ~Collider();
 
 	public:
@@ -57,6 +97,37 @@ class GPX_API Collider
 		 */
 		void setIntrospector(Introspector & introspector);
 
+		/**
+		 * Get cluster arena. Arena recycles clusters, detections and contacts across
+		 * frames. It may be inspected to obtain capacity statistics.
+		 * @return cluster arena.
+		 */
+		const ClusterArena & clusterArena() const;
+
+		/**
+		 * Get broadphase.
+		 * @return broadphase used by collider.
+		 */
+		const Broadphase & broadphase() const;
+
+		/**
+		 * Get broadphase.
+		 * @return broadphase used by collider.
+		 */
+		Broadphase & broadphase();
+
+		/**
+		 * Set broadphase. Broadphase created during construction (by default
+		 * SweepAndPruneBroadphase) can be replaced with custom object. Objects
+		 * already added to the collider are moved from previous broadphase to the new
+		 * one.
+		 * @param broadphase broadphase object. It must not be shared with other
+		 * colliders.
+		 *
+		 * @warning do not set broadphase during update().
+		 */
+		void setBroadphase(Broadphase & broadphase);
+
 		/**
 		 * Get subsequent collision limit.
 		 * @return current subsequent collision limit.
@@ -69,6 +140,110 @@ class GPX_API Collider
 		 */
 		void setSubsequentCollisionLimit(int limit);
 
+		/**
+		 * Get solver.
+		 * @return solver of contact impulses, used by default for all clusters.
+		 */
+		solver_t solver() const;
+
+		/**
+		 * Set solver. Solver can also be selected for each cluster separately by
+		 * overriding clusterSolver().
+		 * @param solver solver of contact impulses, used by default for all clusters.
+		 */
+		void setSolver(solver_t solver);
+
+		/**
+		 * Get iteration limit of projected Gauss-Seidel solver.
+		 * @return maximal number of iterations per cluster.
+		 */
+		std::size_t pgsIterations() const;
+
+		/**
+		 * Set iteration limit of projected Gauss-Seidel solver.
+		 * @param iterations maximal number of iterations per cluster.
+		 */
+		void setPGSIterations(std::size_t iterations);
+
+		/**
+		 * Get tolerance of projected Gauss-Seidel solver.
+		 * @return tolerance, relative to largest velocity, which has to be cancelled.
+		 */
+		real_t pgsTolerance() const;
+
+		/**
+		 * Set tolerance of projected Gauss-Seidel solver.
+		 * @param tolerance tolerance, relative to largest velocity, which has to be
+		 * cancelled.
+		 */
+		void setPGSTolerance(real_t tolerance);
+
+		/**
+		 * Check whether warm starting is enabled.
+		 * @return @p true if projected Gauss-Seidel solver starts from impulses found
+		 * in previous frames, @p false if it starts from zero.
+		 */
+		bool warmStarting() const;
+
+		/**
+		 * Enable or disable warm starting. Impulses of contacts are kept in contact
+		 * cache and used as initial guess of projected Gauss-Seidel solver in next
+		 * frames. This reduces number of iterations for stable contacts (e.g. resting
+		 * stacks).
+		 * @param warmStarting @p true to enable warm starting, @p false to disable it.
+		 */
+		void setWarmStarting(bool warmStarting);
+
+		/**
+		 * Get contact cache.
+		 * @return contact cache used by warm starting.
+		 */
+		ContactCache & contactCache();
+
+		/**
+		 * Get contact cache (const version).
+		 * @return contact cache used by warm starting.
+		 */
+		const ContactCache & contactCache() const;
+
+		/**
+		 * Get number of threads solving clusters.
+		 * @return number of threads solving clusters.
+		 */
+		std::size_t threads() const;
+
+		/**
+		 * Set number of threads solving clusters. Clusters are independent, so they can
+		 * be solved in parallel. Each thread uses its own matrix workspace and clusters
+		 * are scheduled largest-first. By default clusters are solved serially on the
+		 * thread calling update().
+		 * @param threads number of threads including the thread calling update(). If 1,
+		 * clusters are solved serially. If 0, number of hardware threads is used.
+		 *
+		 * @warning clusterSolver() and aCoefs(), bCoefs() functions of objects are
+		 * called concurrently in parallel mode.
+		 *
+		 * @warning do not set number of threads during update().
+		 */
+		void setThreads(std::size_t threads);
+
+		/**
+		 * Check whether parallel solving is deterministic.
+		 * @return @p true if parallel solving is deterministic, @p false otherwise.
+		 */
+		bool deterministic() const;
+
+		/**
+		 * Enable or disable deterministic parallel solving. Impulses are always bitwise
+		 * identical to these found by serial solving, because each cluster is solved by
+		 * a single thread. In deterministic mode impulses are applied, contact cache is
+		 * updated and introspector is notified after all clusters have been solved, in
+		 * the same order as in serial mode. Otherwise this is done by worker threads as
+		 * soon as they finish solving a cluster. Deterministic mode is enabled by default.
+		 * @param deterministic @p true to enable deterministic mode, @p false to disable it.
+		 */
+		void setDeterministic(bool deterministic);
+
 		/**
 		 * Add fixed object.
 		 * @param obj object to add.
@@ -85,6 +260,15 @@ class GPX_API Collider
 		 */
 		void removeFixed(ICFixed * obj);
 
+		/**
+		 * Refit fixed object. Broadphase calculates bounds of fixed objects only once,
+		 * so this function has to be called whenever fixed object is repositioned.
+		 * @param obj object to refit.
+		 *
+		 * @warning do not refit objects during update().
+		 */
+		void refitFixed(ICFixed * obj);
+
 		/**
 		 * Add movable object.
 		 * @param obj object to add.
@@ -105,24 +289,147 @@ class GPX_API Collider
 		void update(real_t dt);
 
 	protected:
+		/**
+		 * Bounding circles of an object. Circles are centered at the origin of object's
+		 * local coordinates.
+		 */
+		struct BoundingCircles
+		{
+			real_t radius;					///< Bounding radius of an object (maximal bounding radius of its elements).
+			std::vector<real_t> elements;	///< Bounding radii of elements.
+		};
+
+		/**
+		 * Transformation between local coordinates of two objects. Transformation is
+		 * captured from mapping functions of objects, which are assumed to be affine, so
+		 * that points can be transformed without virtual calls.
+		 */
+		struct FrameTransform
+		{
+			real_t m[6];	///< Linear part (column-major 2x2 matrix) followed by translation.
+
+			/**
+			 * Capture transformation.
+			 * @param from object, which local coordinates are source of transformation.
+			 * @param to object, which local coordinates are target of transformation.
+			 */
+			void capture(const ICFixed & from, const ICFixed & to);
+
+			/**
+			 * Map point.
+			 * @param point coordinates of a point.
+			 * @param result coordinates of transformed point.
+			 */
+			void map(const real_t * point, real_t * result) const;
+		};
+
+		/**
+		 * Bounding circles statistics of a test of seek contact state. Statistics are
+		 * buffered, so that introspector is notified by one thread only.
+		 */
+		struct CircleReport
+		{
+			std::size_t tests;		///< Number of tests of bounding circles.
+			std::size_t rejections;	///< Number of rejections by bounding circles.
+		};
+
+		typedef std::vector<CircleReport> CircleReportsContainer;
+
+		/**
+		 * Narrowphase workspace. Scratch storage of pair tests. Each thread testing pairs
+		 * has its own workspace.
+		 */
+		struct NarrowphaseWorkspace
+		{
+			std::vector<real_t> futureVertices;		///< C-vertices of wedge element transformed to bumper coordinates in post-collision state.
+			std::vector<real_t> pastVertices;		///< C-vertices of wedge element transformed to bumper coordinates in pre-collision state.
+			ContactDataContainer firstContacts;		///< Contacts of first objects of pairs tested in parallel.
+			ContactDataContainer secondContacts;	///< Contacts of second objects of pairs tested in parallel.
+			CircleReportsContainer circleReports;	///< Bounding circles statistics of pair tests, which are waiting to be reported.
+		};
+
 		/**
 		 * Point iteration state. Helper structure to ease iteration through all elements of
-		 * wedge and bumper with wedge vertices.
+		 * wedge and bumper with wedge vertices. Pairs of elements, which bounding circles
+		 * are not reached by the path of wedge, are skipped.
 		 */
 		struct SeekContactState
 		{
 			const ICFixed & wedge;
 			const ICFixed & bumper;
+			const BoundingCircles & wedgeCircles;
+			const BoundingCircles & bumperCircles;
+			NarrowphaseWorkspace & workspace;				///< Workspace of thread performing the test.
+			FrameTransform future;							///< Transformation from wedge to bumper coordinates in post-collision state.
+			FrameTransform past;							///< Transformation from wedge to bumper coordinates in pre-collision state.
+			real_t distance;								///< Distance between origin of bumper and the path of wedge origin, expressed in bumper coordinates.
+			bool transformed;								///< Whether c-vertices of current wedge element have been transformed.
+			std::size_t circleTests;						///< Number of tests of bounding circles.
+			std::size_t circleRejections;					///< Number of rejections by bounding circles.
 			cdetect::interseg::ICPolyGroup::element_t wi;	///< Wedge element index.
 			cdetect::interseg::ICPolyGroup::element_t bi;	///< Bumper element index.
 			const model::VertexData<2> * vertices;			///< Actual set of c-vertices.
 			model::VertexData<2>::const_iterator vertIt;	///< Vertex iterator.
 
-			SeekContactState(const ICFixed * const p_wedge, const ICFixed * const p_bumper);
+			SeekContactState(const ICFixed * const p_wedge, const BoundingCircles & p_wedgeCircles, const ICFixed * const p_bumper, const BoundingCircles & p_bumperCircles, NarrowphaseWorkspace & p_workspace);
+
+			/**
+			 * Begin iteration. Transformations and distance have to be set before.
+			 * @return @p false if objects are too distant to collide, @p true otherwise.
+			 */
+			bool begin();
 
 			bool isValid();
 
 			void inc();
+
+			/**
+			 * Check whether bounding circles of current pair of elements may overlap.
+			 * @return @p true if bounding circles may overlap, @p false otherwise.
+			 */
+			bool overlap();
+
+			/**
+			 * Move to the next pair of elements, which bounding circles may overlap.
+			 */
+			void nextElements();
+		};
+
+		/**
+		 * Solver workspace. Matrices used to assemble and solve the A Fdt = B system of
+		 * a cluster. Each thread solving clusters has its own workspace.
+		 */
+		struct SolverWorkspace
+		{
+			math::Matrix<> a;			///< Equation matrix for the A Fdt = B system.
+			math::SparseMatrix<> sparseA;	///< Sparse equation matrix for the A Fdt = B system.
+			math::Matrix<> aWC;			///< Working copy of matrix A.
+			math::Vector<> b;			///< Equation vector for the A Fdt = B system.
+			math::Vector<> bWC;			///< Working copy of vector B.
+			math::NNSolverWorkspace<> nnWorkspace;	///< Scratch storage of NN solver kept across frames.
+			math::LCPSolverWorkspace<> lcpWorkspace;	///< Scratch storage of Dantzig solver kept across frames.
+			math::SparseLCPSolverWorkspace<> pgsWorkspace;	///< Scratch storage of PGS solver kept across frames.
+
+			SolverWorkspace();
+		};
+
+		/**
+		 * Solution of a cluster. Besides impulses it holds everything, which has to be
+		 * reported once cluster is solved.
+		 */
+		struct ClusterSolution
+		{
+			solver_t solver;			///< Solver selected for a cluster.
+			solver_t lcpSolver;			///< Linear complementarity solver, which has been used or NN_SOLVER if none.
+			std::size_t lcpIterations;	///< Iterations (pivots) of linear complementarity solver.
+			real_t lcpResidual;			///< Residual of linear complementarity solver.
+			bool lcpSolved;				///< Whether linear complementarity solver has succeeded.
+			bool fallback;				///< Whether NN solver has been used, because linear complementarity solver failed.
+			bool negativeImpulse;		///< Whether NN solver could not remove negative impulse.
+			math::Vector<> warmImpulses;	///< Initial guess for warm started solver.
+			math::Vector<> impulses;	///< Solution of the A Fdt = B system.
+
+			ClusterSolution();
 		};
 
 		struct DoubleBufferSwapper
@@ -135,61 +442,304 @@ class GPX_API Collider
 			void swapBuffers();
 		};
 
-		struct MovableData
+		typedef std::vector<ICFixed *> FixedContainer;
+		typedef std::vector<ICMovable *> MovablesContainer;
+
+	protected:
+		phy::NewtonPlasticityTable & plasticityTable();
+
+		/**
+		 * Get fixed objects.
+		 * @return fixed objects stored contiguously. Order of objects changes, when
+		 * objects are removed.
+		 */
+		const FixedContainer & fixed() const;
+
+		/**
+		 * Get movable objects.
+		 * @return movable objects stored contiguously. Order of objects changes, when
+		 * objects are removed.
+		 */
+		const MovablesContainer & movables() const;
+
+	private:
+		typedef std::vector<std::size_t> IndicesContainer;
+		typedef std::vector<handle_t> HandlesContainer;
+		typedef ext::UnorderedMap<const ICFixed *, handle_t> ObjectHandlesContainer;
+		typedef IndicesContainer DislocMovablesContainer;
+		typedef IndicesContainer IslandStackContainer;
+		typedef std::vector<BoundingCircles> BoundingCirclesContainer;
+		typedef std::vector<SolverWorkspace *> SolverWorkspacesContainer;
+		typedef std::vector<ClusterSolution> ClusterSolutionsContainer;
+
+		/**
+		 * Candidate pair of narrowphase. First object is always a body.
+		 */
+		struct CandidatePair
+		{
+			std::size_t first;			///< Index of first body.
+			std::size_t second;			///< Index of second body or IslandBuilder::NO_BODY if second object is fixed.
+			handle_t secondHandle;		///< Handle of second object.
+			std::size_t round;			///< Round in which pair is tested.
+			std::size_t thread;			///< Index of thread, which has tested the pair.
+			std::size_t contactsBegin;	///< Position of contacts in workspace of thread.
+			std::size_t contacts;		///< Number of contacts per object.
+			std::size_t reportsBegin;	///< Position of bounding circles statistics in workspace of thread.
+
+			CandidatePair(std::size_t p_first, std::size_t p_second, handle_t p_secondHandle);
+		};
+
+		typedef std::vector<NarrowphaseWorkspace *> NarrowphaseWorkspacesContainer;
+		typedef std::vector<CandidatePair> CandidatePairsContainer;
+		typedef std::vector<unsigned long long> RoundMasksContainer;
+
+		static const std::size_t PARALLEL_ROUNDS = 64;	///< Number of parallel rounds of pair tests (bits of round mask). Pairs, which do not fit, are tested serially.
+
+		/**
+		 * Comparison of clusters by number of contacts. Used to schedule clusters
+		 * largest-first.
+		 */
+		struct LargerCluster
 		{
-			bool checked;
+			const ClustersContainer & clusters;
+
+			LargerCluster(const ClustersContainer & p_clusters);
 
-			MovableData():
-				checked(false)
-			{
-			}
+			bool operator()(std::size_t first, std::size_t second) const;
 		};
 
-		typedef typename ext::UnorderedSet<ICFixed *> FixedContainer;
-		typedef typename ext::UnorderedMap<ICMovable *, MovableData *> MovablesContainer;
+		static Broadphase * CreateBroadphase(broadphase_t broadphase);
 
-	protected:
-		phy::NewtonPlasticityTable & plasticityTable();
+		/**
+		 * Acquire handle for an object.
+		 * @param obj object.
+		 * @param index dense index of an object.
+		 * @return handle. Handles of removed objects are reused.
+		 */
+		handle_t acquireHandle(const ICFixed * obj, std::size_t index);
 
-		const FixedContainer & fixed() const;
+		/**
+		 * Release handle of an object.
+		 * @param obj object.
+		 * @return released handle.
+		 */
+		handle_t releaseHandle(const ICFixed * obj);
 
-		FixedContainer & fixed();
+		/**
+		 * Update bounding circles of an object.
+		 * @param handle handle of an object.
+		 * @param obj object.
+		 */
+		void updateCircles(handle_t handle, const ICFixed & obj);
 
-		const MovablesContainer & movables() const;
+		/**
+		 * Calculate distance between origin of bumper and the path, which origin of
+		 * wedge travels between pre- and post-collision states. Distance is expressed
+		 * in bumper coordinates, so that it can be compared against bounding circles.
+		 * @param future transformation from wedge to bumper coordinates in post-collision state.
+		 * @param past transformation from wedge to bumper coordinates in pre-collision state.
+		 * @return distance between origin of bumper and the path of wedge origin.
+		 */
+		static real_t PathDistance(const FrameTransform & future, const FrameTransform & past);
 
-		MovablesContainer & movables();
+		/**
+		 * Get dislocation threshold relative to the magnitude of body position. Threshold is
+		 * specified explicitly for each floating point type. Double precision follows EPS.
+		 * Single precision EPS amounts to millimetres at positions of a few metres, which
+		 * visibly lifts resting bodies, so threshold of @p float is set to a few ulps.
+		 * @return relative threshold.
+		 */
+		template <typename T>
+		static T RelativeDislocationThreshold();
 
-	private:
-		typedef std::vector<ICMovable *> DislocMovablesContainer;
+		/**
+		 * Get dislocation threshold. Shorter dislocations could be lost to rounding, when
+		 * added to position of a body, or be taken for zero by approximate comparisons, so
+		 * they are extended to the threshold.
+		 * @param pos position of a body.
+		 * @return minimal length of dislocation vector.
+		 *
+		 * @see RelativeDislocationThreshold().
+		 */
+		static real_t DislocationThreshold(math::const_PointRef<2> pos);
 
-		void fillCluster(Cluster & cluster, DetectionData & firstData);
+		/**
+		 * Capture transformations from wedge to bumper coordinates in both states and
+		 * calculate distance between origin of bumper and the path of wedge origin.
+		 * Already transformed c-vertices are invalidated.
+		 * @param s seek contact state.
+		 * @param b double buffer swapper.
+		 */
+		static void CaptureFrames(SeekContactState & s, DoubleBufferSwapper & b);
+
+		/**
+		 * Transform c-vertices of current wedge element to bumper coordinates. Vertices
+		 * are transformed in one pass for both states and stored contiguously in
+		 * workspace of seek contact state. Function has to be called in post-collision
+		 * state.
+		 * @param s seek contact state.
+		 * @param b double buffer swapper.
+		 */
+		void transformVertices(SeekContactState & s, DoubleBufferSwapper & b) const;
+
+		/**
+		 * Begin iteration of seek contact state. Bounding circles statistics of the
+		 * state should be reported once iteration is over, no matter whether it has
+		 * begun.
+		 * @param s seek contact state.
+		 * @param b double buffer swapper.
+		 * @return @p false if objects are too distant to collide, @p true otherwise.
+		 */
+		bool approach(SeekContactState & s, DoubleBufferSwapper & b) const;
+
+		/**
+		 * Report bounding circles statistics of seek contact state to the introspector.
+		 * @param s seek contact state.
+		 */
+		void reportCircles(const SeekContactState & s);
+
+		/**
+		 * Report buffered bounding circles statistics to the introspector.
+		 * @param begin iterator pointing to first report.
+		 * @param end iterator pointing past the last report.
+		 */
+		void reportCircles(CircleReportsContainer::const_iterator begin, CircleReportsContainer::const_iterator end);
+
+		/**
+		 * Fill islands. Each pair of potentially colliding objects is tested once and
+		 * contacts are passed to island builder. If thread pool is available, pairs are
+		 * tested in parallel (see fillIslandsParallel()).
+		 */
+		void fillIslands();
+
+		/**
+		 * Fill islands in parallel. Candidate pairs are collected in the same order, in
+		 * which serial fillIslands() tests them. Pair tests temporarily swap buffers of
+		 * bodies, so pairs are split into rounds, in which each body participates in
+		 * at most one pair. Pairs of each round are tested in parallel and contacts are
+		 * written to per-thread workspaces. Contacts are then passed to island builder
+		 * and bounding circles statistics are reported in the original order of pairs,
+		 * so that islands are identical to those built by serial fillIslands().
+		 */
+		void fillIslandsParallel();
+
+		/**
+		 * Test candidate pair. Contacts and bounding circles statistics are appended to
+		 * workspace.
+		 * @param pair candidate pair.
+		 * @param workspace narrowphase workspace of calling thread.
+		 */
+		void testPair(CandidatePair & pair, NarrowphaseWorkspace & workspace) const;
+
+		/**
+		 * Merge candidate pair. Reports bounding circles statistics and passes contacts
+		 * to island builder.
+		 * @param pair tested candidate pair.
+		 */
+		void mergePair(const CandidatePair & pair);
 
 		void moveBackClusters(ClustersContainer & clusters) const;
 
-		void fulfillClusters(ClustersContainer & clusters);
+		/**
+		 * Fulfill islands. Bodies in contact are moved back to the past and remaining
+		 * bodies, which overlap with them, are attached to their islands.
+		 */
+		void fulfillIslands();
 
-		void fulfillCluster(Cluster & cluster, DetectionData & firstData);
+		/**
+		 * Test pair of objects and pass contacts to island builder.
+		 * @param first index of first body.
+		 * @param firstMov first body or 0 if it should act as fixed object.
+		 * @param second index of second body or IslandBuilder::NO_BODY if second object is fixed.
+		 * @param secondFix second object.
+		 * @param secondMov second body or 0 if second object is fixed.
+		 * @param secondHandle handle of second object.
+		 * @return @p true if objects are in contact, @p false otherwise.
+		 */
+		bool testPairIsland(std::size_t first, ICMovable * firstMov, std::size_t second, ICFixed & secondFix, ICMovable * secondMov, handle_t secondHandle);
 
 		/**
 		 * Test pair of objects for collision.
 		 * @param startIndex value of index to start with.
 		 * @param firstData data to be filled for first potentially colliding object.
+		 * @param firstCircles bounding circles of first object.
 		 * @param secondData data to be filled for second potentially colliding object.
+		 * @param secondCircles bounding circles of second object.
+		 * @param workspace narrowphase workspace. Bounding circles statistics of both
+		 * tested cases are appended to its reports.
 		 * @return last index. If objects are not colliding returned value is equal to
 		 * @a startIndex. Otherwise it will be @a startIndex incremented by a number
 		 * of contacts.
 		 */
-		std::size_t testPairCollect(std::size_t startIndex, DetectionData & firstData, DetectionData & secondData);
+		std::size_t testPairCollect(std::size_t startIndex, DetectionData & firstData, const BoundingCircles & firstCircles, DetectionData & secondData, const BoundingCircles & secondCircles, NarrowphaseWorkspace & workspace) const;
+
+		/**
+		 * Seek contact. C-vertices of wedge are transformed to bumper coordinates in
+		 * batches, one element at a time. If GPX_NO_BATCH_TRANSFORM macro is defined,
+		 * each vertex is mapped separately through mapping functions of objects instead
+		 * (reference path for debugging).
+		 * @param s seek contact state.
+		 * @param b double buffer swapper.
+		 * @param wedgeData contact data of wedge to be filled.
+		 * @param bumperData contact data of bumper to be filled.
+		 * @return @p true if contact has been found, @p false if there are no more contacts.
+		 */
+		bool seekContactCollect(SeekContactState & s, DoubleBufferSwapper & b, ContactData & wedgeData, ContactData & bumperData) const;
 
-		bool seekContactCollect(SeekContactState & s, DoubleBufferSwapper & b, ContactData & wedgeData, ContactData & bumperData);
+		/**
+		 * Select solver for a cluster. Default implementation returns solver set with
+		 * setSolver().
+		 * @param cluster cluster, which is going to be solved.
+		 * @return solver of contact impulses to be used for @a cluster.
+		 */
+		virtual solver_t clusterSolver(const Cluster & cluster) const;
 
 		void handleCollisions(ClustersContainer & clusters);
 
+		/**
+		 * Prepare cluster for solving. Selects solver and fetches initial guess from
+		 * contact cache.
+		 * @param cluster cluster.
+		 * @param solution solution to be prepared.
+		 */
+		void prepareCluster(const Cluster & cluster, ClusterSolution & solution);
+
+		/**
+		 * Solve cluster. Function does not modify collider nor objects, so that
+		 * clusters can be solved concurrently.
+		 * @param cluster cluster.
+		 * @param workspace solver workspace.
+		 * @param solution prepared solution, which obtains impulses.
+		 */
+		void solveCluster(const Cluster & cluster, SolverWorkspace & workspace, ClusterSolution & solution) const;
+
+		/**
+		 * Commit solved cluster. Reports cluster and applies impulses.
+		 * @param cluster cluster.
+		 * @param solution solution of the cluster.
+		 */
+		void commitCluster(const Cluster & cluster, const ClusterSolution & solution);
+
+		/**
+		 * Report solved cluster. Updates contact cache and notifies introspector. Must be
+		 * called by calling thread only.
+		 * @param cluster cluster.
+		 * @param solution solution of the cluster.
+		 */
+		void reportCluster(const Cluster & cluster, const ClusterSolution & solution);
+
+		/**
+		 * Apply impulses found by solver to movables of the cluster.
+		 * @param cluster cluster.
+		 * @param solution solution of the cluster.
+		 */
+		void applyImpulses(const Cluster & cluster, const ClusterSolution & solution) const;
+
 		void updateClusters(ClustersContainer & clusters, real_t dt);
 
 		void dislocateMovables(DislocMovablesContainer & in, DislocMovablesContainer & out);
 
-		bool testPairDislocate(ICMovable & mov, const ICFixed & passive, ICMovable * passiveMov);
+		bool testPairDislocate(ICMovable & mov, const BoundingCircles & movCircles, const ICFixed & passive, const BoundingCircles & passiveCircles, ICMovable * passiveMov);
 
 		bool seekContactDislocate(SeekContactState & s, DoubleBufferSwapper & b, math::Vector<2> & normal, math::Vector<2> & dsp);
 
@@ -201,12 +751,40 @@ class GPX_API Collider
 		BasicExecutor & m_collisionContractor;
 		phy::NewtonPlasticityTable & m_plasticityTable;
 		int m_subsequentCollisionLimit;
-		math::Matrix<> m_a; //equation matrix for the A Fdt = B system.
-		math::Matrix<> m_aWC; //working copy of matrix A.
-		math::Vector<> m_b; //equation vector for the A Fdt = B system.
-		math::Vector<> m_bWC; //working copy of vector B.
-		FixedContainer m_fixed;
-		MovablesContainer m_movables;
+		solver_t m_solver;
+		std::size_t m_pgsIterations;
+		real_t m_pgsTolerance;
+		bool m_warmStarting;
+		ContactCache m_contactCache;
+		bool m_deterministic;
+		utils::ThreadPool * m_threadPool;	///< Thread pool solving clusters or 0 if clusters are solved serially.
+		SolverWorkspacesContainer m_workspaces;	///< Solver workspaces indexed by thread indices.
+		ClusterSolutionsContainer m_solutions;	///< Solutions indexed by cluster indices.
+		IndicesContainer m_schedule;		///< Indices of clusters in order of solving.
+		std::mutex m_commitMutex;	///< Serializes application of impulses by thread pool workers.
+		FixedContainer m_fixed;				///< Fixed objects indexed by dense indices.
+		HandlesContainer m_fixedHandles;	///< Handles of fixed objects indexed by dense indices.
+		MovablesContainer m_movables;		///< Movable objects indexed by dense indices.
+		HandlesContainer m_movableHandles;	///< Handles of movable objects indexed by dense indices.
+		IndicesContainer m_handleIndices;	///< Dense indices of objects indexed by handles.
+		HandlesContainer m_freeHandles;
+		BoundingCirclesContainer m_circles;	///< Bounding circles indexed by handles.
+		NarrowphaseWorkspacesContainer m_narrowphaseWorkspaces;	///< Narrowphase workspaces indexed by thread indices.
+		CandidatePairsContainer m_pairs;	///< Candidate pairs in order of serial testing.
+		IndicesContainer m_pairOrder;		///< Indices of candidate pairs sorted by rounds.
+		IndicesContainer m_roundEnds;		///< End positions of rounds within pair order.
+		RoundMasksContainer m_roundMasks;	///< Rounds occupied by bodies, indexed by dense indices of bodies.
+		ContactDataContainer m_mergeFirstContacts;
+		ContactDataContainer m_mergeSecondContacts;
+		ObjectHandlesContainer m_objectHandles;
+		Broadphase * m_broadphaseInstance;
+		Broadphase * m_broadphase;
+		ClusterArena m_clusterArena;
+		IslandBuilder m_islandBuilder;
+		IslandStackContainer m_islandStack;
+		ClustersContainer m_clusters;
+		DislocMovablesContainer m_dislocIn;
+		DislocMovablesContainer m_dislocOut;
 #ifndef GPX_NO_INTROSPECT
 		Introspector m_introspectorInstance;
 		Introspector * m_introspector;
@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_Phy2d_CNEWTON_PMEPP2_S_CONTACTCACHE_HPP_
+#define GPX_Phy2d_CNEWTON_PMEPP2_S_CONTACTCACHE_HPP_
+
+#include "../../../phy_config.hpp"
+#include "Cluster.hpp"
+
+#include <gpx/platform.hpp>
+#include <gpx/math/structures.hpp>
+#include <gpx/ext/UnorderedMap.hpp>
+
+#include <vector>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+/**
+ * Contact cache. Keeps impulses of contacts between frames, so that solver can be
+ * warm started with impulses found in previous frame. Contacts are identified by
+ * objects acting as a wedge and a bumper, their colliding elements and index of wedge
+ * c-vertex. Each frame entries age and those, which have not been refreshed for more
+ * than maxAge() frames, expire. Expired entries are no longer fetched, but their storage
+ * is kept for contacts, which come back (resting contacts tend to flicker), so that
+ * the cache does not allocate memory in steady state. Expired entries are evicted
+ * once they outnumber live ones.
+ */
+class GPX_API ContactCache
+{
+	public:
+		static const unsigned int INITIAL_MAX_AGE = 2;	///< Initial maximal age of entries.
+
+	public:
+		ContactCache();
+
+	public:
+		/**
+		 * Get maximal age.
+		 * @return maximal number of frames an entry survives without being refreshed.
+		 */
+		unsigned int maxAge() const;
+
+		/**
+		 * Set maximal age.
+		 * @param maxAge maximal number of frames an entry survives without being
+		 * refreshed.
+		 */
+		void setMaxAge(unsigned int maxAge);
+
+		/**
+		 * Get number of cached contacts.
+		 * @return number of live (not expired) entries.
+		 */
+		std::size_t size() const;
+
+		/**
+		 * Get number of contacts found in cache by fetch().
+		 * @return number of hits since last call to resetStats().
+		 */
+		std::size_t hitCount() const;
+
+		/**
+		 * Get number of contacts not found in cache by fetch().
+		 * @return number of misses since last call to resetStats().
+		 */
+		std::size_t missCount() const;
+
+		/**
+		 * Reset hit and miss counters.
+		 */
+		void resetStats();
+
+		/**
+		 * Remove all entries.
+		 */
+		void clear();
+
+		/**
+		 * Age entries. Should be called once per frame. Entries older than maxAge()
+		 * expire. Expired entries are evicted if they outnumber live ones.
+		 */
+		void age();
+
+		/**
+		 * Remove entries referring to an object. Should be called when object is
+		 * removed from collider, since its address may be reused.
+		 * @param obj object.
+		 */
+		void remove(const ICFixed * obj);
+
+		/**
+		 * Fetch impulses of cluster contacts.
+		 * @param cluster cluster.
+		 * @param impulses vector, which obtains cached impulses indexed by contact
+		 * indices. Contacts, which are not present in cache, obtain zero. Vector is
+		 * resized to the number of contacts.
+		 */
+		void fetch(const Cluster & cluster, math::Vector<> & impulses);
+
+		/**
+		 * Store impulses of cluster contacts. Stored entries are refreshed. Function
+		 * uses keys found by preceding fetch() call with the same cluster.
+		 * @param impulses impulses indexed by contact indices.
+		 */
+		void store(math::const_VectorRef<> impulses);
+
+		/**
+		 * Store impulses of cluster contacts. Unlike store(math::const_VectorRef<>), this
+		 * function does not depend on preceding fetch() call, so clusters may be stored
+		 * in different order than they were fetched.
+		 * @param cluster cluster.
+		 * @param impulses impulses indexed by contact indices.
+		 */
+		void store(const Cluster & cluster, math::const_VectorRef<> impulses);
+
+	private:
+		struct Key
+		{
+			const ICFixed * wedge;
+			const ICFixed * bumper;
+			cdetect::interseg::ICPolyGroup::element_t wedgeElement;
+			cdetect::interseg::ICPolyGroup::element_t bumperElement;
+			std::size_t cvertex;	///< Index of wedge c-vertex.
+
+			Key();
+
+			bool operator ==(const Key & other) const;
+
+			bool operator <(const Key & other) const;
+		};
+
+		struct KeyHash
+		{
+			std::size_t operator()(const Key & key) const;
+		};
+
+		struct Entry
+		{
+			real_t impulse;
+			unsigned int age;
+		};
+
+		typedef ext::UnorderedMap<Key, Entry, KeyHash> EntriesContainer;
+		typedef std::vector<Key> KeysContainer;
+
+	private:
+		/**
+		 * Collect keys of cluster contacts.
+		 * @param cluster cluster.
+		 */
+		void collectKeys(const Cluster & cluster);
+
+	private:
+		unsigned int m_maxAge;
+		std::size_t m_size;	///< Number of live entries.
+		std::size_t m_hits;
+		std::size_t m_misses;
+		EntriesContainer m_entries;
+		KeysContainer m_keys;	///< Keys of contacts of last fetched cluster.
+};
+
+}
+}
+}
+}
+
+#endif /* GPX_Phy2d_CNEWTON_PMEPP2_S_CONTACTCACHE_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
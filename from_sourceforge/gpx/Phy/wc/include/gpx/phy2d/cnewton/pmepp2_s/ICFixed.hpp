@@ -27,9 +27,10 @@ class ICFixed : public virtual ILocalFrame,
 		/**
 		 * Get "a" coefficients. These are coefficients in form aFdt=b, where Fdt is an impulse.
 		 * They have to be given in global coordinates. Separate paper shall explain how to
-		 * calculate them.
+		 * calculate them. Coefficients have to be added through mapper, which hides
+		 * whether matrix is stored in dense or sparse format.
 		 */
-		virtual void aCoefs(const DetectionData & dData, math::Matrix<> & a) const = 0;
+		virtual void aCoefs(const DetectionData & dData, ACoefsMapper & a) const = 0;
 
 		/**
 		 * Get "b" coefficients. These are coefficients in form aFdt=b, where Fdt is an impulse.
@@ -38,6 +39,20 @@ class ICFixed : public virtual ILocalFrame,
 		 */
 		virtual void bCoefs(const DetectionData & dData, math::Vector<> & b) const = 0;
 
+		/**
+		 * Check whether "a" coefficients are filled symmetrically. Function should return
+		 * @p true, if each value added by aCoefs() to element a_vi is also added to element
+		 * a_iv. If all objects within a cluster report symmetric fill, collider solves
+		 * system of equations with solver dedicated to symmetric matrices.
+		 * @return @p true if aCoefs() fills matrix symmetrically, @p false otherwise.
+		 *
+		 * @note default implementation returns @p false.
+		 */
+		virtual bool symmetricACoefs() const
+		{
+			return false;
+		}
+
 		/**
 		 * Get material id.
 		 * @param element element index.
@@ -39,11 +39,91 @@ class GPX_API Introspector
 
 		virtual void playdown(const ICFixed & fixed);
 
+		/**
+		 * Report tests of bounding circles. Collider calls this function after it has
+		 * finished testing a pair of objects. Default implementation accumulates
+		 * statistics.
+		 * @param tests number of tests of bounding circles.
+		 * @param rejections number of tests, which rejected a pair of objects or elements.
+		 */
+		virtual void circleTests(std::size_t tests, std::size_t rejections);
+
+		/**
+		 * Get accumulated number of tests of bounding circles.
+		 * @return number of tests of bounding circles.
+		 */
+		std::size_t circleTestCount() const;
+
+		/**
+		 * Get accumulated number of rejections by bounding circles.
+		 * @return number of rejections by bounding circles.
+		 */
+		std::size_t circleRejectionCount() const;
+
+		/**
+		 * Get hit rate of bounding circles.
+		 * @return ratio of rejections to tests or 0 if no tests have been performed.
+		 */
+		real_t circleHitRate() const;
+
+		/**
+		 * Reset statistics of bounding circles.
+		 */
+		void resetCircleStats();
+
+		/**
+		 * Report solution of linear complementarity problem. Collider calls this function
+		 * after it has solved system of equations of a cluster with LCP solver.
+		 * Default implementation accumulates statistics.
+		 * @param cluster cluster, which has been solved.
+		 * @param iterations number of iterations (or pivots in case of pivoting
+		 * solver) performed by solver.
+		 * @param residual residual of the solution.
+		 * @param converged @p true if residual has dropped below tolerance (or
+		 * pivoting solver has succeeded), @p false otherwise.
+		 */
+		virtual void lcpSolved(const Cluster & cluster, std::size_t iterations, real_t residual, bool converged);
+
+		/**
+		 * Get accumulated number of solved linear complementarity problems.
+		 * @return number of solved problems.
+		 */
+		std::size_t lcpSolveCount() const;
+
+		/**
+		 * Get accumulated number of iterations of linear complementarity solver.
+		 * @return number of iterations.
+		 */
+		std::size_t lcpIterationCount() const;
+
+		/**
+		 * Get number of linear complementarity problems, which have not converged.
+		 * @return number of problems, for which iteration limit has been reached.
+		 */
+		std::size_t lcpNonConvergedCount() const;
+
+		/**
+		 * Get maximal residual of linear complementarity problems.
+		 * @return maximal residual.
+		 */
+		real_t lcpMaxResidual() const;
+
+		/**
+		 * Reset statistics of linear complementarity problems.
+		 */
+		void resetLCPStats();
+
 	private:
 		static const char * DEFAULT_ERROR_MSG;
 
 		bool m_error;
 		const char * m_errorMsg;
+		std::size_t m_circleTests;
+		std::size_t m_circleRejections;
+		std::size_t m_lcpSolves;
+		std::size_t m_lcpIterations;
+		std::size_t m_lcpNonConverged;
+		real_t m_lcpMaxResidual;
 };
 
 }
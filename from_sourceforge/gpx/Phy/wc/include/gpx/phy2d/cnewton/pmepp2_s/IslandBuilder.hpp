@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_Phy2d_CNEWTON_PMEPP2_S_ISLANDBUILDER_HPP_
+#define GPX_Phy2d_CNEWTON_PMEPP2_S_ISLANDBUILDER_HPP_
+
+#include "Cluster.hpp"
+
+#include <gpx/platform.hpp>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+class ClusterArena;
+
+/**
+ * Island builder. Builds clusters from a contact graph. Bodies are given dense
+ * indices by addBody(). Contacts found between pairs of objects form edges of the
+ * graph. Islands (connected components of the graph) are maintained with disjoint-set
+ * union, so that adding contacts between bodies from different islands merges these
+ * islands. Fixed objects do not join islands. Once all contacts are known,
+ * buildClusters() turns each island into a cluster.
+ */
+class GPX_API IslandBuilder
+{
+	public:
+		static const std::size_t NO_BODY = static_cast<std::size_t>(-1);	///< Index indicating lack of body.
+
+	public:
+		IslandBuilder();
+
+	public:
+		/**
+		 * Clear builder. Removes all bodies and contacts. Storage is retained.
+		 */
+		void clear();
+
+		/**
+		 * Add body. Body forms its own island.
+		 * @param body movable object.
+		 * @return dense index of a body. Bodies are indexed in order of addition.
+		 */
+		std::size_t addBody(ICMovable * body);
+
+		/**
+		 * Get number of bodies.
+		 * @return number of bodies added since last clear().
+		 */
+		std::size_t bodies() const;
+
+		/**
+		 * Get body.
+		 * @param index index of a body.
+		 * @return body with given index.
+		 */
+		ICMovable * body(std::size_t index) const;
+
+		/**
+		 * Check if body is in contact with any object.
+		 * @param index index of a body.
+		 * @return @p true if contacts have been added for given body, @p false otherwise.
+		 */
+		bool touching(std::size_t index) const;
+
+		/**
+		 * Find island.
+		 * @param index index of a body.
+		 * @return index of a body, which represents island of given body.
+		 */
+		std::size_t find(std::size_t index);
+
+		/**
+		 * Join islands of two bodies.
+		 * @param first index of first body.
+		 * @param second index of second body.
+		 * @return @p true if islands have been merged, @p false if bodies were already
+		 * within the same island.
+		 */
+		bool join(std::size_t first, std::size_t second);
+
+		/**
+		 * Add contacts between two bodies. Islands of bodies are joined.
+		 * @param first index of first body.
+		 * @param firstContacts contacts of first body.
+		 * @param second index of second body.
+		 * @param secondContacts contacts of second body.
+		 *
+		 * @note contact indices should be relative to the pair (that is they should
+		 * start from 0). They are remapped to cluster indices by buildClusters().
+		 */
+		void addContacts(std::size_t first, const ContactDataContainer & firstContacts, std::size_t second, const ContactDataContainer & secondContacts);
+
+		/**
+		 * Add contacts between body and fixed object.
+		 * @param first index of a body.
+		 * @param firstContacts contacts of a body.
+		 * @param fix fixed object.
+		 * @param fixContacts contacts of fixed object.
+		 *
+		 * @note contact indices should be relative to the pair (that is they should
+		 * start from 0). They are remapped to cluster indices by buildClusters().
+		 */
+		void addContacts(std::size_t first, const ContactDataContainer & firstContacts, ICFixed & fix, const ContactDataContainer & fixContacts);
+
+		/**
+		 * Get number of edges.
+		 * @return number of pairs, for which contacts have been added.
+		 */
+		std::size_t edges() const;
+
+		/**
+		 * Build clusters. Each island, which contains contacts, becomes a cluster.
+		 * Clusters are ordered by their lowest body index. Each body obtains one
+		 * detection in a cluster and its index is appended to Cluster::bodies, while
+		 * fixed objects obtain one detection per pair.
+		 * @param dt collision time.
+		 * @param arena arena, which provides clusters and contact containers.
+		 * @param clusters container to which clusters are appended.
+		 */
+		void buildClusters(real_t dt, ClusterArena & arena, ClustersContainer & clusters);
+
+	private:
+		static const std::size_t NO_DETECTION = static_cast<std::size_t>(-1);
+
+		struct Edge
+		{
+			std::size_t first;		///< Index of first body.
+			std::size_t second;		///< Index of second body or NO_BODY if second object is fixed.
+			ICFixed * fix;			///< Fixed object if second object is fixed, 0 otherwise.
+			std::size_t begin;		///< Position of first contacts. Contacts of second object follow them.
+			std::size_t count;		///< Number of contacts per object.
+
+			Edge(std::size_t p_first, std::size_t p_second, ICFixed * p_fix, std::size_t p_begin, std::size_t p_count):
+				first(p_first),
+				second(p_second),
+				fix(p_fix),
+				begin(p_begin),
+				count(p_count)
+			{
+			}
+		};
+
+		typedef std::vector<ICMovable *> BodiesContainer;
+		typedef std::vector<std::size_t> IndicesContainer;
+		typedef std::vector<unsigned char> FlagsContainer;
+		typedef std::vector<Edge> EdgesContainer;
+
+		void addEdge(std::size_t first, const ContactDataContainer & firstContacts, std::size_t second, ICFixed * fix, const ContactDataContainer & secondContacts);
+
+		std::size_t bodyDetection(Cluster & cluster, std::size_t index, ClusterArena & arena);
+
+		static std::size_t PushDetection(Cluster & cluster, ICFixed & fix, ICMovable * mov, ClusterArena & arena);
+
+		static void AppendContacts(ContactDataContainer & contacts, ContactDataContainer::const_iterator begin, ContactDataContainer::const_iterator end, std::size_t offset);
+
+	private:
+		BodiesContainer m_bodies;
+		IndicesContainer m_parents;
+		IndicesContainer m_ranks;
+		FlagsContainer m_touching;
+		EdgesContainer m_edges;
+		ContactDataContainer m_contacts;	///< Contacts of all edges.
+		ClustersContainer m_islandClusters;	///< Clusters indexed by island representatives.
+		IndicesContainer m_detections;		///< Body detection positions within clusters.
+};
+
+}
+}
+}
+}
+
+#endif /* GPX_Phy2d_CNEWTON_PMEPP2_S_ISLANDBUILDER_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
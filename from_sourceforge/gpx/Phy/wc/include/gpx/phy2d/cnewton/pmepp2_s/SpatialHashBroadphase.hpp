@@ -0,0 +1,148 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_Phy2d_CNEWTON_PMEPP2_S_SPATIALHASHBROADPHASE_HPP_
+#define GPX_Phy2d_CNEWTON_PMEPP2_S_SPATIALHASHBROADPHASE_HPP_
+
+#include "Broadphase.hpp"
+
+#include <gpx/ext/UnorderedMap.hpp>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+/**
+ * Spatial hash broadphase. Space is divided into uniform grid of square cells, which
+ * are stored in a hash map. Bounding boxes are inserted into all the cells they cover
+ * and only objects sharing a cell are tested against each other. This broadphase works
+ * best for large number of similar-sized objects.
+ *
+ * Fixed objects are hashed once, when they are added (or when cell size changes).
+ * Movables are re-hashed on each update. Unbounded objects and objects covering too
+ * many cells are not hashed - they are tested against all other objects instead.
+ */
+class GPX_API SpatialHashBroadphase : public Broadphase
+{
+	public:
+		static const std::size_t MAX_CELLS_PER_OBJECT = 64;	///< Objects covering more cells than this limit are not hashed.
+		static const real_t AUTO_CELL_SIZE_MULT;			///< Multiplier applied to average bounding radius by cell size auto-tuning.
+
+	public:
+		/**
+		 * Constructor.
+		 * @param cellSize cell size. If value is not positive, cell size will be
+		 * auto-tuned.
+		 */
+		SpatialHashBroadphase(real_t cellSize = 0.0);
+
+		virtual ~SpatialHashBroadphase();
+
+	public:
+		/**
+		 * Get cell size.
+		 * @return cell size. Zero is returned if cell size is going to be auto-tuned,
+		 * but it has not been tuned yet.
+		 */
+		real_t cellSize() const;
+
+		/**
+		 * Set cell size. Changing cell size causes fixed objects to be re-hashed.
+		 * @param cellSize cell size. If value is not positive, cell size will be
+		 * auto-tuned on next update. Auto-tuning sets cell size to average bounding
+		 * radius of bounded movables multiplied by @ref AUTO_CELL_SIZE_MULT.
+		 */
+		void setCellSize(real_t cellSize);
+
+	protected:
+		//Broadphase
+		void findPairs(ProxyPairsContainer & pairs);
+
+		//Broadphase
+		void proxyAdded(Proxy * proxy);
+
+		//Broadphase
+		void proxyRemoved(Proxy * proxy);
+
+	private:
+		struct CellKey
+		{
+			int x;
+			int y;
+
+			CellKey(int p_x, int p_y);
+
+			bool operator ==(const CellKey & other) const;
+
+			bool operator <(const CellKey & other) const;
+		};
+
+		struct CellKeyHash
+		{
+			std::size_t operator()(const CellKey & key) const;
+		};
+
+		struct CellRange
+		{
+			int minX;
+			int minY;
+			int maxX;
+			int maxY;
+		};
+
+		struct Cell
+		{
+			std::vector<Proxy *> fixed;
+			std::vector<Proxy *> movables;
+		};
+
+		typedef ext::UnorderedMap<CellKey, Cell, CellKeyHash> CellsContainer;
+		typedef std::vector<Proxy *> ProxiesContainer;
+		typedef std::vector<CellKey> CellKeysContainer;
+
+		void tune();
+
+		void hashFixed();
+
+		void hashFixed(Proxy * proxy);
+
+		void unhashFixed(Proxy * proxy);
+
+		void hashMovables();
+
+		void unhashMovables();
+
+		bool cellRange(const Proxy & proxy, CellRange & range) const;
+
+		CellKey cellKey(real_t x, real_t y) const;
+
+		bool reportCell(const Proxy & first, const Proxy & second, const CellKey & key) const;
+
+		static void TestAll(Proxy * proxy, const ProxiesContainer & proxies, ProxyPairsContainer & pairs);
+
+	private:
+		real_t m_cellSize;
+		CellsContainer m_cells;
+		ProxiesContainer m_fixed;			///< All fixed objects.
+		ProxiesContainer m_movables;		///< All movable objects.
+		ProxiesContainer m_hashedFixed;		///< Fixed objects stored in cells.
+		ProxiesContainer m_globalFixed;		///< Fixed objects, which are not stored in cells.
+		ProxiesContainer m_hashedMovables;	///< Movable objects stored in cells during last update.
+		ProxiesContainer m_globalMovables;	///< Movable objects, which were not stored in cells during last update.
+		CellKeysContainer m_movableCells;	///< Keys of cells, which contain movables.
+};
+
+}
+}
+}
+}
+
+#endif /* GPX_Phy2d_CNEWTON_PMEPP2_S_SPATIALHASHBROADPHASE_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
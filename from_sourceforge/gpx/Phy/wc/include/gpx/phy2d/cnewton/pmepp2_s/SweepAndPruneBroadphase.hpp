@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_Phy2d_CNEWTON_PMEPP2_S_SWEEPANDPRUNEBROADPHASE_HPP_
+#define GPX_Phy2d_CNEWTON_PMEPP2_S_SWEEPANDPRUNEBROADPHASE_HPP_
+
+#include "Broadphase.hpp"
+#include "AABBTree.hpp"
+
+#include <gpx/utils/functions.hpp>
+#include <gpx/ext/UnorderedMap.hpp>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+/**
+ * Sweep and prune broadphase. Bounding box endpoints are kept sorted along x axis.
+ * Since objects move only slightly between subsequent frames, endpoints are re-sorted
+ * incrementally with insertion sort, which runs in nearly linear time. Sorted endpoints
+ * are then swept and only boxes with overlapping x intervals are tested against each
+ * other.
+ *
+ * Fixed objects do not take part in the sweep. They are stored in AABBTree, which is
+ * queried with bounding box of each movable, so that cost of static geometry grows
+ * logarithmically with number of fixed objects. Unbounded fixed objects are tested
+ * against all movables.
+ */
+class GPX_API SweepAndPruneBroadphase : public Broadphase
+{
+	public:
+		SweepAndPruneBroadphase();
+
+		virtual ~SweepAndPruneBroadphase();
+
+	protected:
+		//Broadphase
+		void findPairs(ProxyPairsContainer & pairs);
+
+		//Broadphase
+		void proxyAdded(Proxy * proxy);
+
+		//Broadphase
+		void proxyRemoved(Proxy * proxy);
+
+		//Broadphase
+		void proxyRefit(Proxy * proxy);
+
+	private:
+		struct Endpoint
+		{
+			real_t value;	///< Coordinate.
+			Proxy * proxy;	///< Proxy owning the endpoint.
+			bool min;		///< Indicates whether endpoint is minimal or maximal coordinate of a bounding box.
+
+			Endpoint(Proxy * p_proxy, bool p_min);
+
+			/**
+			 * Ordering predicate. In case of equal values minimal endpoints go first, so
+			 * that touching boxes are considered as overlapping.
+			 */
+			bool operator <(const Endpoint & other) const;
+		};
+
+		/**
+		 * Fixed tree query callback. Appends pairs of movable and fixed objects.
+		 */
+		struct FixedCollector
+		{
+			Proxy * mov;
+			ProxyPairsContainer * pairs;
+
+			FixedCollector(Proxy * p_mov, ProxyPairsContainer * p_pairs);
+
+			void operator()(Proxy * fix);
+		};
+
+		typedef std::vector<Endpoint> EndpointsContainer;
+		typedef std::vector<Proxy *> ProxiesContainer;
+		typedef AABBTree<Proxy *> FixedTree;
+		typedef ext::UnorderedMap<const Proxy *, FixedTree::node_t, utils::hash<const Proxy *> > FixedNodesContainer;
+
+		static bool Bounded(const Proxy & proxy);
+
+		void sortEndpoints();
+
+		void insertFixed(Proxy * proxy);
+
+		void removeFixed(Proxy * proxy);
+
+	private:
+		EndpointsContainer m_endpoints;		///< Endpoints of movables.
+		ProxiesContainer m_active;
+		ProxiesContainer m_movables;
+		FixedTree m_fixedTree;
+		FixedNodesContainer m_fixedNodes;	///< Tree leaves of bounded fixed objects.
+		ProxiesContainer m_unboundedFixed;
+};
+
+}
+}
+}
+}
+
+#endif /* GPX_Phy2d_CNEWTON_PMEPP2_S_SWEEPANDPRUNEBROADPHASE_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -5,15 +5,14 @@
 
 #include "../../../include/gpx/phy2d/MovableObject.hpp"
 #include "../../../include/gpx/phy/RecordableFloatPoint.hpp"
-#include "../../../include/gpx/phy/RecordableFloatMatrix.hpp"
 
 namespace gpx {
 namespace phy2d {
 
 MovableObject::MovableObject():
 	m_pos(m_doubleBufferController),
-	m_tMatrix(m_doubleBufferController),
-	m_tMatrixInv(m_doubleBufferController)
+	m_transform(m_doubleBufferController),
+	m_transformInv(m_doubleBufferController)
 //	m_updateTMatrix(m_doubleBufferController, true, false)	//update active matrix
 {
 	updateTMatricesB();
@@ -54,24 +53,44 @@ void MovableObject::setPos(real_t x, real_t y)
 	setPos(math::Point<2>(x, y));
 }
 
-const phy::TransformationMatrix & MovableObject::tMatrix() const
+const RigidTransform & MovableObject::transform() const
 {
-	return m_tMatrix.active();
+	return m_transform.active();
 }
 
-const phy::TransformationMatrix & MovableObject::tMatrixInv() const
+const RigidTransform & MovableObject::transformInv() const
 {
-	return m_tMatrixInv.active();
+	return m_transformInv.active();
+}
+
+phy::TransformationMatrix MovableObject::tMatrix() const
+{
+	return transform().matrix();
+}
+
+phy::TransformationMatrix MovableObject::tMatrixInv() const
+{
+	return transformInv().matrix();
 }
 
 math::Point<2> MovableObject::mapToLocal(math::const_PointRef<2> point) const
 {
-	return tMatrixInv().prod(point);
+	return transformInv().prod(point);
 }
 
 math::Point<2> MovableObject::mapToGlobal(math::const_PointRef<2> point) const
 {
-	return tMatrix().prod(point);
+	return transform().prod(point);
+}
+
+void MovableObject::mapToLocal(const real_t * points, std::size_t count, real_t * result) const
+{
+	transformInv().prod(points, count, result);
+}
+
+void MovableObject::mapToGlobal(const real_t * points, std::size_t count, real_t * result) const
+{
+	transform().prod(points, count, result);
 }
 
 std::size_t MovableObject::snapshotSize() const
@@ -79,10 +98,10 @@ std::size_t MovableObject::snapshotSize() const
 	std::size_t result = 0;
 	//pos A + pos B
 	result += 2 * phy::RecordableFloatPoint<2>::SnapshotSize();
-	//tMatrix A + tMatrix B
-	result += 2 * phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
-	//tMatrixInv A + tMatrixInv B
-	result += 2 * phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
+	//transform A + transform B
+	result += 2 * phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
+	//transformInv A + transformInv B
+	result += 2 * phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
 	return result;
 }
 
@@ -93,16 +112,16 @@ void MovableObject::store(char * snapshot) const
 	snapshot += phy::RecordableFloatPoint<2>::SnapshotSize();
 	phy::RecordableFloatPoint<2>::Store(snapshot, posB());
 	snapshot += phy::RecordableFloatPoint<2>::SnapshotSize();
-	//store tMatrix
-	phy::RecordableFloatMatrix<4, 4>::Store(snapshot, m_tMatrix.active());
-	snapshot += phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
-	phy::RecordableFloatMatrix<4, 4>::Store(snapshot, m_tMatrix.background());
-	snapshot += phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
-	//store tMatrixInv
-	phy::RecordableFloatMatrix<4, 4>::Store(snapshot, m_tMatrixInv.active());
-	snapshot += phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
-	phy::RecordableFloatMatrix<4, 4>::Store(snapshot, m_tMatrixInv.background());
-	snapshot += phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
+	//store transform (parameters are stored as a point)
+	phy::RecordableFloatPoint<RigidTransform::SIZE>::Store(snapshot, math::const_PointRef<RigidTransform::SIZE>(m_transform.active().ptr()));
+	snapshot += phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
+	phy::RecordableFloatPoint<RigidTransform::SIZE>::Store(snapshot, math::const_PointRef<RigidTransform::SIZE>(m_transform.background().ptr()));
+	snapshot += phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
+	//store transformInv
+	phy::RecordableFloatPoint<RigidTransform::SIZE>::Store(snapshot, math::const_PointRef<RigidTransform::SIZE>(m_transformInv.active().ptr()));
+	snapshot += phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
+	phy::RecordableFloatPoint<RigidTransform::SIZE>::Store(snapshot, math::const_PointRef<RigidTransform::SIZE>(m_transformInv.background().ptr()));
+	snapshot += phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
 }
 
 void MovableObject::restore(char * snapshot)
@@ -112,16 +131,16 @@ void MovableObject::restore(char * snapshot)
 	snapshot += phy::RecordableFloatPoint<2>::SnapshotSize();
 	phy::RecordableFloatPoint<2>::Restore(snapshot, m_pos.background());
 	snapshot += phy::RecordableFloatPoint<2>::SnapshotSize();
-	//restore tMatrix
-	phy::RecordableFloatMatrix<4, 4>::Restore(snapshot, m_tMatrix.active());
-	snapshot += phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
-	phy::RecordableFloatMatrix<4, 4>::Restore(snapshot, m_tMatrix.background());
-	snapshot += phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
-	//restore tMatrixInv
-	phy::RecordableFloatMatrix<4, 4>::Restore(snapshot, m_tMatrixInv.active());
-	snapshot += phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
-	phy::RecordableFloatMatrix<4, 4>::Restore(snapshot, m_tMatrixInv.background());
-	snapshot += phy::RecordableFloatMatrix<4, 4>::SnapshotSize();
+	//restore transform
+	phy::RecordableFloatPoint<RigidTransform::SIZE>::Restore(snapshot, math::PointRef<RigidTransform::SIZE>(m_transform.active().ptr()));
+	snapshot += phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
+	phy::RecordableFloatPoint<RigidTransform::SIZE>::Restore(snapshot, math::PointRef<RigidTransform::SIZE>(m_transform.background().ptr()));
+	snapshot += phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
+	//restore transformInv
+	phy::RecordableFloatPoint<RigidTransform::SIZE>::Restore(snapshot, math::PointRef<RigidTransform::SIZE>(m_transformInv.active().ptr()));
+	snapshot += phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
+	phy::RecordableFloatPoint<RigidTransform::SIZE>::Restore(snapshot, math::PointRef<RigidTransform::SIZE>(m_transformInv.background().ptr()));
+	snapshot += phy::RecordableFloatPoint<RigidTransform::SIZE>::SnapshotSize();
 }
 
 
@@ -164,20 +183,18 @@ void MovableObject::setPosB(real_t x, real_t y)
 void MovableObject::updateTMatricesB()
 {
 	//currently instant calls are made
-	constructTMatrix(m_tMatrix.background());
-	constructTMatrixInv(m_tMatrixInv.background());
+	constructTMatrix(m_transform.background());
+	constructTMatrixInv(m_transformInv.background());
 }
 
-void MovableObject::constructTMatrix(phy::TransformationMatrix & tMatrix)
+void MovableObject::constructTMatrix(RigidTransform & transform)
 {
-	tMatrix(0,3) = posB(0);
-	tMatrix(1,3) = posB(1);
+	transform.setTranslation(posB(0), posB(1));
 }
 
-void MovableObject::constructTMatrixInv(phy::TransformationMatrix & tMatrixInv)
+void MovableObject::constructTMatrixInv(RigidTransform & transformInv)
 {
-	tMatrixInv(0,3) = -posB(0);
-	tMatrixInv(1,3) = -posB(1);
+	transformInv.setTranslation(-posB(0), -posB(1));
 }
 
 }
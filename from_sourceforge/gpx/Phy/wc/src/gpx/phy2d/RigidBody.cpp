@@ -251,30 +251,17 @@ real_t RigidBody::resultantMoment() const
 	return resMoment;
 }
 
-void RigidBody::constructTMatrix(phy::TransformationMatrix & tMatrix)
+void RigidBody::constructTMatrix(RigidTransform & transform)
 {
-	tMatrix(0,3) = posB(0);
-	tMatrix(1,3) = posB(1);
-
-	//multiply by rotation matrix (effective equivalent of matrix multiplication)
-	tMatrix(0,0) = angleCosB();
-	tMatrix(1,0) = angleSinB();
-	tMatrix(0,1) = -angleSinB();
-	tMatrix(1,1) = angleCosB();
+	transform.set(angleCosB(), angleSinB(), posB(0), posB(1));
 }
 
-void RigidBody::constructTMatrixInv(phy::TransformationMatrix & tInvMatrix)
+void RigidBody::constructTMatrixInv(RigidTransform & transformInv)
 {
-	//inverted rotation matrix
-	tInvMatrix(0,0) = angleCosB();
-	tInvMatrix(1,0) = -angleSinB();
-	tInvMatrix(0,1) = angleSinB();
-	tInvMatrix(1,1) = angleCosB();
-
-	//multiply inverted translation matrix by inverted rotation matrix to obtain inverted
-	//transformation matrix (inv translation matrix has negated tMatrix(0,3) and tMatrix(1,3))
-	tInvMatrix(0,3) = (-posB(0) * angleCosB()) - (posB(1) * angleSinB());
-	tInvMatrix(1,3) = ( posB(0) * angleSinB()) - (posB(1) * angleCosB());
+	//inverted rotation followed by inverted translation, which is rotated backwards
+	transformInv.set(angleCosB(), -angleSinB(),
+					 (-posB(0) * angleCosB()) - (posB(1) * angleSinB()),
+					 ( posB(0) * angleSinB()) - (posB(1) * angleCosB()));
 }
 
 }
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#include "../../../include/gpx/phy2d/RigidTransform.hpp"
+
+namespace gpx {
+namespace phy2d {
+
+RigidTransform::RigidTransform()
+{
+	set(1.0, 0.0, 0.0, 0.0);
+}
+
+RigidTransform::RigidTransform(real_t cos, real_t sin, real_t tx, real_t ty)
+{
+	set(cos, sin, tx, ty);
+}
+
+void RigidTransform::set(real_t cos, real_t sin, real_t tx, real_t ty)
+{
+	m_data[0] = cos;
+	m_data[1] = sin;
+	m_data[2] = tx;
+	m_data[3] = ty;
+}
+
+void RigidTransform::setTranslation(real_t tx, real_t ty)
+{
+	m_data[2] = tx;
+	m_data[3] = ty;
+}
+
+const real_t * RigidTransform::ptr() const
+{
+	return m_data;
+}
+
+real_t * RigidTransform::ptr()
+{
+	return m_data;
+}
+
+math::Vector<2> RigidTransform::prod(math::const_VectorRef<2> vec) const
+{
+	return math::Vector<2>(m_data[0] * vec[0] + -m_data[1] * vec[1],
+						   m_data[1] * vec[0] + m_data[0] * vec[1]);
+}
+
+math::Vector<2> RigidTransform::operator *(math::const_VectorRef<2> vec) const
+{
+	return prod(vec);
+}
+
+void RigidTransform::prod(const real_t * points, std::size_t count, real_t * result) const
+{
+	real_t c = m_data[0];
+	real_t s = m_data[1];
+	real_t tx = m_data[2];
+	real_t ty = m_data[3];
+	for (const real_t * end = points + 2 * count; points != end; points += 2, result += 2) {
+		real_t x = points[0];
+		real_t y = points[1];
+		result[0] = tx + c * x + -s * y;
+		result[1] = ty + s * x + c * y;
+	}
+}
+
+RigidTransform RigidTransform::prod(const RigidTransform & other) const
+{
+	math::Point<2> translation(prod(math::const_PointRef<2>(other.m_data + 2)));
+	return RigidTransform(m_data[0] * other.m_data[0] - m_data[1] * other.m_data[1],
+						  m_data[1] * other.m_data[0] + m_data[0] * other.m_data[1],
+						  translation[0], translation[1]);
+}
+
+RigidTransform RigidTransform::operator *(const RigidTransform & other) const
+{
+	return prod(other);
+}
+
+RigidTransform RigidTransform::inverted() const
+{
+	//inverted rotation is a transposition, translation is rotated backwards and negated
+	return RigidTransform(m_data[0], -m_data[1],
+						  (-m_data[2] * m_data[0]) - (m_data[3] * m_data[1]),
+						  (m_data[2] * m_data[1]) - (m_data[3] * m_data[0]));
+}
+
+phy::TransformationMatrix RigidTransform::matrix() const
+{
+	phy::TransformationMatrix result;
+	toMatrix(result);
+	return result;
+}
+
+void RigidTransform::toMatrix(phy::TransformationMatrix & matrix) const
+{
+	matrix(0, 0) = m_data[0];
+	matrix(1, 0) = m_data[1];
+	matrix(0, 1) = -m_data[1];
+	matrix(1, 1) = m_data[0];
+	matrix(0, 3) = m_data[2];
+	matrix(1, 3) = m_data[3];
+}
+
+}
+}
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -11,20 +11,17 @@ namespace phy2d {
 
 StaticObject::StaticObject()
 {
-	constructTMatrix(m_tMatrix, m_tMatrixInv);
+	constructTMatrix(m_transform, m_transformInv);
 }
 
 StaticObject::~StaticObject()
 {
 }
 
-void StaticObject::constructTMatrix(phy::TransformationMatrix & tMatrix, phy::TransformationMatrix & tMatrixInv)
+void StaticObject::constructTMatrix(RigidTransform & transform, RigidTransform & transformInv)
 {
-	tMatrix(0,3) = m_pos(0);
-	tMatrix(1,3) = m_pos(1);
-
-	tMatrixInv(0,3) = -m_pos(0);
-	tMatrixInv(1,3) = -m_pos(1);
+	transform.setTranslation(m_pos(0), m_pos(1));
+	transformInv.setTranslation(-m_pos(0), -m_pos(1));
 }
 
 math::const_PointRef<2> StaticObject::pos() const
@@ -36,7 +33,7 @@ void StaticObject::setPos(math::const_PointRef<2> pos)
 {
 	m_pos = pos;
 
-	constructTMatrix(m_tMatrix, m_tMatrixInv);
+	constructTMatrix(m_transform, m_transformInv);
 }
 
 void StaticObject::setPos(real_t x, real_t y)
@@ -64,19 +61,24 @@ void StaticObject::setY(real_t y)
 	setPos(math::Point<2>(m_pos(0), y));
 }
 
-const phy::TransformationMatrix & StaticObject::tMatrix() const
+const RigidTransform & StaticObject::transform() const
+{
+	return m_transform;
+}
+
+phy::TransformationMatrix StaticObject::tMatrix() const
 {
-	return m_tMatrix;
+	return m_transform.matrix();
 }
 
 math::Point<2> StaticObject::mapToLocal(math::const_PointRef<2> point) const
 {
-	return m_tMatrixInv.prod(point);
+	return m_transformInv.prod(point);
 }
 
 math::Point<2> StaticObject::mapToGlobal(math::const_PointRef<2> point) const
 {
-	return m_tMatrix.prod(point);
+	return m_transform.prod(point);
 }
 
 
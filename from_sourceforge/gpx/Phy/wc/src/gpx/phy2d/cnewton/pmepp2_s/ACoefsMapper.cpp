@@ -11,18 +11,30 @@ namespace cnewton {
 namespace pmepp2_s {
 
 ACoefsMapper::ACoefsMapper(math::Matrix<> & a):
-		m_a(a)
+		m_a(& a),
+		m_sparseA(0)
+{
+}
+
+ACoefsMapper::ACoefsMapper(math::SparseMatrix<> & a):
+		m_a(0),
+		m_sparseA(& a)
 {
 }
 
 void ACoefsMapper::add(std::size_t v, std::size_t i, real_t val)
 {
-	m_a(v, i) += val;
+	if (m_sparseA)
+		m_sparseA->add(v, i, val);
+	else
+		(*m_a)(v, i) += val;
 }
 
 real_t ACoefsMapper::get(std::size_t v, std::size_t i) const
 {
-	return m_a(v, i);
+	if (m_sparseA)
+		return m_sparseA->get(v, i);
+	return (*m_a)(v, i);
 }
 
 }
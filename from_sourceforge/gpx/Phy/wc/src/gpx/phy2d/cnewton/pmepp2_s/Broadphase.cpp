@@ -0,0 +1,252 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/Broadphase.hpp"
+
+#include <algorithm>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+Broadphase::Broadphase():
+	m_serial(0)
+{
+}
+
+Broadphase::~Broadphase()
+{
+	for (ProxiesContainer::iterator i = m_proxies.begin(); i != m_proxies.end(); ++i)
+		delete *i;
+}
+
+void Broadphase::addFixed(ICFixed * obj, handle_t handle)
+{
+	Proxy * proxy = addProxy(obj, 0, handle);
+	updateBounds(*proxy);
+	proxyAdded(proxy);
+}
+
+void Broadphase::removeFixed(handle_t handle)
+{
+	removeProxy(handle);
+}
+
+void Broadphase::addMovable(ICMovable * obj, handle_t handle)
+{
+	Proxy * proxy = addProxy(obj, obj, handle);
+	updateBounds(*proxy);
+	m_movableProxies.push_back(proxy);
+	proxyAdded(proxy);
+}
+
+void Broadphase::removeMovable(handle_t handle)
+{
+	MovableProxiesContainer::iterator i = std::find(m_movableProxies.begin(), m_movableProxies.end(), & proxy(handle));
+	*i = m_movableProxies.back();
+	m_movableProxies.pop_back();
+	removeProxy(handle);
+}
+
+void Broadphase::refitFixed(handle_t handle)
+{
+	GPX_ASSERT(proxy(handle).mov == 0, "element is not fixed");
+	m_proxies[handle]->boundr = Boundr(*m_proxies[handle]->fix);
+	proxyRefit(m_proxies[handle]);
+}
+
+void Broadphase::setBoundr(handle_t handle, real_t boundr)
+{
+	GPX_ASSERT(handle < m_proxies.size() && m_proxies[handle] != 0, "element does not exist");
+	m_proxies[handle]->boundr = boundr;
+}
+
+void Broadphase::update()
+{
+	for (MovableProxiesContainer::iterator proxy = m_movableProxies.begin(); proxy != m_movableProxies.end(); ++proxy)
+		updateBounds(**proxy);
+
+	for (ProxiesContainer::iterator i = m_proxies.begin(); i != m_proxies.end(); ++i)
+		if (*i) {
+			(*i)->movables.clear();
+			(*i)->fixed.clear();
+		}
+
+	m_pairs.clear();
+	findPairs(m_pairs);
+
+	//sorting pairs by serial numbers of their members results in sorted candidate lists
+	for (ProxyPairsContainer::iterator pair = m_pairs.begin(); pair != m_pairs.end(); ++pair)
+		if (pair->first->serial > pair->second->serial)
+			std::swap(pair->first, pair->second);
+	std::sort(m_pairs.begin(), m_pairs.end(), SerialLess);
+
+	for (ProxyPairsContainer::const_iterator pair = m_pairs.begin(); pair != m_pairs.end(); ++pair) {
+		if (pair->second->mov)
+			pair->first->movables.push_back(pair->second->handle);
+		else
+			pair->first->fixed.push_back(pair->second->handle);
+		if (pair->first->mov)
+			pair->second->movables.push_back(pair->first->handle);
+		else
+			pair->second->fixed.push_back(pair->first->handle);
+	}
+}
+
+void Broadphase::refit(handle_t handle)
+{
+	GPX_ASSERT(proxy(handle).mov != 0, "element is not movable");
+	Proxy * refitted = m_proxies[handle];
+
+	//refitted object is movable, so it is listed among movable candidates of other objects
+	for (HandlesContainer::const_iterator i = refitted->movables.begin(); i != refitted->movables.end(); ++i) {
+		HandlesContainer & candidates = m_proxies[*i]->movables;
+		candidates.erase(std::find(candidates.begin(), candidates.end(), handle));
+	}
+	for (HandlesContainer::const_iterator i = refitted->fixed.begin(); i != refitted->fixed.end(); ++i) {
+		HandlesContainer & candidates = m_proxies[*i]->movables;
+		candidates.erase(std::find(candidates.begin(), candidates.end(), handle));
+	}
+	refitted->movables.clear();
+	refitted->fixed.clear();
+
+	updateBounds(*refitted);
+	for (ProxiesContainer::const_iterator i = m_proxies.begin(); i != m_proxies.end(); ++i)
+		if (*i && (*i != refitted) && refitted->overlaps(**i)) {
+			insertCandidate((*i)->mov ? refitted->movables : refitted->fixed, **i);
+			insertCandidate((*i)->movables, *refitted);
+		}
+}
+
+const Broadphase::HandlesContainer & Broadphase::movables(handle_t handle) const
+{
+	return proxy(handle).movables;
+}
+
+const Broadphase::HandlesContainer & Broadphase::fixed(handle_t handle) const
+{
+	return proxy(handle).fixed;
+}
+
+bool Broadphase::test(handle_t first, handle_t second) const
+{
+	return proxy(first).overlaps(proxy(second));
+}
+
+void Broadphase::pairs(PairsContainer & pairs) const
+{
+	for (ProxyPairsContainer::const_iterator pair = m_pairs.begin(); pair != m_pairs.end(); ++pair)
+		pairs.push_back(Pair(pair->first->fix, pair->second->fix));
+}
+
+void Broadphase::proxyRefit(Proxy * proxy)
+{
+	proxyRemoved(proxy);
+	updateBounds(*proxy);
+	proxyAdded(proxy);
+}
+
+real_t Broadphase::Boundr(const ICFixed & obj)
+{
+	real_t result = 0.0;
+	for (cdetect::interseg::ICPolyGroup::element_t i = 0; i < obj.elements(); i++)
+		result = std::max(result, obj.element(i)->boundr());
+	return result;
+}
+
+bool Broadphase::SerialLess(const ProxyPair & first, const ProxyPair & second)
+{
+	if (first.first->serial != second.first->serial)
+		return first.first->serial < second.first->serial;
+	return first.second->serial < second.second->serial;
+}
+
+void Broadphase::insertCandidate(HandlesContainer & candidates, const Proxy & candidate) const
+{
+	HandlesContainer::iterator pos = candidates.begin();
+	while ((pos != candidates.end()) && (m_proxies[*pos]->serial < candidate.serial))
+		++pos;
+	candidates.insert(pos, candidate.handle);
+}
+
+Broadphase::Proxy * Broadphase::addProxy(ICFixed * fix, ICMovable * mov, handle_t handle)
+{
+	if (handle >= m_proxies.size())
+		m_proxies.resize(handle + 1, 0);
+	GPX_ASSERT(m_proxies[handle] == 0, "element already exists");
+	Proxy * proxy = new Proxy(fix, mov, handle, m_serial++);
+	proxy->boundr = Boundr(*fix);
+	m_proxies[handle] = proxy;
+	return proxy;
+}
+
+void Broadphase::removeProxy(handle_t handle)
+{
+	GPX_ASSERT(handle < m_proxies.size() && m_proxies[handle] != 0, "element does not exist");
+	proxyRemoved(m_proxies[handle]);
+
+	//candidate lists are rebuilt by update(), drop them to avoid dangling handles
+	for (ProxiesContainer::iterator i = m_proxies.begin(); i != m_proxies.end(); ++i)
+		if (*i) {
+			(*i)->movables.clear();
+			(*i)->fixed.clear();
+		}
+	m_pairs.clear();
+
+	delete m_proxies[handle];
+	m_proxies[handle] = 0;
+}
+
+const Broadphase::Proxy & Broadphase::proxy(handle_t handle) const
+{
+	GPX_ASSERT(handle < m_proxies.size() && m_proxies[handle] != 0, "element does not exist");
+	return *m_proxies[handle];
+}
+
+void Broadphase::updateBounds(Proxy & proxy)
+{
+	real_t r = proxy.boundr;
+	math::Point<2> center(proxy.fix->mapToGlobal(math::Point<2>()));
+	for (std::size_t i = 0; i < 2; i++) {
+		proxy.min[i] = center[i] - r;
+		proxy.max[i] = center[i] + r;
+	}
+	if (proxy.mov) {
+		proxy.mov->swapBuffers(); //swap to pre-collision
+		center = proxy.fix->mapToGlobal(math::Point<2>());
+		proxy.mov->swapBuffers(); //back to the future
+		for (std::size_t i = 0; i < 2; i++) {
+			proxy.min[i] = std::min(proxy.min[i], center[i] - r);
+			proxy.max[i] = std::max(proxy.max[i], center[i] + r);
+		}
+	}
+}
+
+
+Broadphase::Proxy::Proxy(ICFixed * p_fix, ICMovable * p_mov, handle_t p_handle, std::size_t p_serial):
+	fix(p_fix),
+	mov(p_mov),
+	handle(p_handle),
+	serial(p_serial),
+	boundr(0.0)
+{
+}
+
+bool Broadphase::Proxy::overlaps(const Proxy & other) const
+{
+	return (min[0] <= other.max[0]) && (other.min[0] <= max[0])
+			&& (min[1] <= other.max[1]) && (other.min[1] <= max[1]);
+}
+
+}
+}
+}
+}
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
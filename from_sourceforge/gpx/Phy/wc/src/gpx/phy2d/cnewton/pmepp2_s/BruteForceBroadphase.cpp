@@ -0,0 +1,52 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/BruteForceBroadphase.hpp"
+
+#include <algorithm>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+BruteForceBroadphase::BruteForceBroadphase()
+{
+}
+
+BruteForceBroadphase::~BruteForceBroadphase()
+{
+}
+
+void BruteForceBroadphase::findPairs(ProxyPairsContainer & pairs)
+{
+	for (ProxiesContainer::const_iterator first = m_proxies.begin(); first != m_proxies.end(); ++first)
+		for (ProxiesContainer::const_iterator second = first + 1; second != m_proxies.end(); ++second) {
+			if (!(*first)->mov && !(*second)->mov)
+				continue;	//fixed objects do not collide with each other
+			if ((*first)->overlaps(**second))
+				pairs.push_back(ProxyPair(*first, *second));
+		}
+}
+
+void BruteForceBroadphase::proxyAdded(Proxy * proxy)
+{
+	m_proxies.push_back(proxy);
+}
+
+void BruteForceBroadphase::proxyRemoved(Proxy * proxy)
+{
+	m_proxies.erase(std::find(m_proxies.begin(), m_proxies.end(), proxy));
+}
+
+}
+}
+}
+}
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -20,11 +20,11 @@ CMaterialBody::~CMaterialBody()
 {
 }
 
-void CMaterialBody::aCoefs(const DetectionData & dData, math::Matrix<> & a) const
+void CMaterialBody::aCoefs(const DetectionData & dData, ACoefsMapper & a) const
 {
 	for (ContactDataContainer::const_iterator v = dData.contacts.begin(); v != dData.contacts.end(); ++v)
 		for (ContactDataContainer::const_iterator i = dData.contacts.begin(); i != dData.contacts.end(); ++i)
-			a(v->index, i->index) += v->normal.dot(i->normal) / m();
+			a.add(v->index, i->index, v->normal.dot(i->normal) / m());
 }
 
 void CMaterialBody::bCoefs(const DetectionData & dData, math::Vector<> & b) const
@@ -33,6 +33,11 @@ void CMaterialBody::bCoefs(const DetectionData & dData, math::Vector<> & b) cons
 		b(v->index) += pB().dot(v->normal) / m();
 }
 
+bool CMaterialBody::symmetricACoefs() const
+{
+	return true;
+}
+
 //phy::material_t CMaterialBody::material() const
 //{
 //	return m_material;
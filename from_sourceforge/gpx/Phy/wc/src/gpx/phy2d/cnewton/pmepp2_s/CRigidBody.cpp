@@ -22,7 +22,7 @@ CRigidBody::~CRigidBody()
 {
 }
 
-void CRigidBody::aCoefs(const DetectionData & dData, math::Matrix<> & a) const
+void CRigidBody::aCoefs(const DetectionData & dData, ACoefsMapper & a) const
 {
 	for (ContactDataContainer::const_iterator v = dData.contacts.begin(); v != dData.contacts.end(); ++v) {
 		const math::Vector<2> & nv = v->normal;
@@ -33,7 +33,7 @@ void CRigidBody::aCoefs(const DetectionData & dData, math::Matrix<> & a) const
 			const math::Vector<2> & ni = i->normal;
 			math::Vector<2> ri = i->pre.diff();
 			rotateToGlobal(ri);
-			a(v->index, i->index) += (detRvNv * ri.det(ni)) / I() + nv.dot(ni) / m();
+			a.add(v->index, i->index, (detRvNv * ri.det(ni)) / I() + nv.dot(ni) / m());
 		}
 	}
 }
@@ -52,6 +52,11 @@ void CRigidBody::bCoefs(const DetectionData & dData, math::Vector<> & b) const
 	}
 }
 
+bool CRigidBody::symmetricACoefs() const
+{
+	return true;
+}
+
 //phy::material_t CRigidBody::material() const
 //{
 //	return m_material;
@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/ClusterArena.hpp"
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+ClusterArena::ClusterArena():
+	m_clustersInUse(0),
+	m_misses(0)
+{
+}
+
+ClusterArena::~ClusterArena()
+{
+	for (ClustersContainer::iterator cluster = m_clusters.begin(); cluster != m_clusters.end(); ++cluster)
+		delete *cluster;
+}
+
+Cluster * ClusterArena::acquireCluster(real_t dt)
+{
+	if (m_clustersInUse == m_clusters.size()) {
+		m_clusters.push_back(new Cluster(dt));
+		m_misses++;
+	}
+	Cluster * cluster = m_clusters[m_clustersInUse++];
+	cluster->dt = dt;
+	cluster->endIndex = 0;
+	return cluster;
+}
+
+void ClusterArena::releaseClusters()
+{
+	for (std::size_t i = 0; i < m_clustersInUse; i++) {
+		DetectionDataContainer & detections = m_clusters[i]->detections;
+		for (DetectionDataContainer::iterator detection = detections.begin(); detection != detections.end(); ++detection)
+			releaseContacts(detection->contacts);
+		detections.clear();
+		m_clusters[i]->bodies.clear();
+	}
+	m_clustersInUse = 0;
+}
+
+void ClusterArena::acquireContacts(ContactDataContainer & contacts)
+{
+	GPX_ASSERT(contacts.empty(), "contacts container is not empty");
+	if (m_spareContacts.empty()) {
+		contacts.reserve(INITIAL_CONTACTS);
+		m_misses++;
+		return;
+	}
+	contacts.swap(m_spareContacts.back());
+	m_spareContacts.pop_back();
+}
+
+void ClusterArena::releaseContacts(ContactDataContainer & contacts)
+{
+	if (contacts.capacity() == 0)
+		return;	//nothing worth keeping
+	contacts.clear();
+	m_spareContacts.push_back(ContactDataContainer());
+	m_spareContacts.back().swap(contacts);
+}
+
+void ClusterArena::MoveDetection(Cluster & cluster, DetectionData & detection)
+{
+	cluster.detections.push_back(DetectionData(*detection.fix, detection.mov, cluster));
+	cluster.detections.back().contacts.swap(detection.contacts);
+}
+
+std::size_t ClusterArena::clusters() const
+{
+	return m_clusters.size();
+}
+
+std::size_t ClusterArena::clustersInUse() const
+{
+	return m_clustersInUse;
+}
+
+std::size_t ClusterArena::detectionsCapacity() const
+{
+	std::size_t result = 0;
+	for (ClustersContainer::const_iterator cluster = m_clusters.begin(); cluster != m_clusters.end(); ++cluster)
+		result += (*cluster)->detections.capacity();
+	return result;
+}
+
+std::size_t ClusterArena::spareContacts() const
+{
+	return m_spareContacts.size();
+}
+
+std::size_t ClusterArena::contactsCapacity() const
+{
+	std::size_t result = 0;
+	for (SpareContactsContainer::const_iterator contacts = m_spareContacts.begin(); contacts != m_spareContacts.end(); ++contacts)
+		result += contacts->capacity();
+	return result;
+}
+
+std::size_t ClusterArena::misses() const
+{
+	return m_misses;
+}
+
+}
+}
+}
+}
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -5,11 +5,17 @@
 
 #include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/Collider.hpp"
 #include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/Cluster.hpp"
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/SweepAndPruneBroadphase.hpp"
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/SpatialHashBroadphase.hpp"
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/BruteForceBroadphase.hpp"
 #include "../../../../../include/gpx/phy2d/PhyObject.hpp"
 
 #include <vector>
+#include <algorithm>
 #include <gpx/math/Solver.hpp>
 #include <gpx/math/NNSolver.hpp>
+#include <gpx/math/LCPSolver.hpp>
+#include <gpx/math/SparseLCPSolver.hpp>
 
 namespace gpx {
 namespace phy2d {
@@ -20,10 +26,38 @@ Collider::Collider(BasicExecutor & collisionContractor, phy::NewtonPlasticityTab
 		m_collisionContractor(collisionContractor),
 		m_plasticityTable(plasticityTable),
 		m_subsequentCollisionLimit(INITIAL_SUBSEQUENT_COLLISION_LIMIT),
-		m_a(0u, 0u, INITIAL_CPOINTS_PER_OBJECT * INITIAL_CPOINTS_PER_OBJECT),
-		m_aWC(0u, 0u, INITIAL_CPOINTS_PER_OBJECT * INITIAL_CPOINTS_PER_OBJECT),
-		m_b(0u, INITIAL_CPOINTS_PER_OBJECT),
-		m_bWC(0u, INITIAL_CPOINTS_PER_OBJECT)
+		m_solver(NN_SOLVER),
+		m_pgsIterations(INITIAL_PGS_ITERATIONS),
+		m_pgsTolerance(1.0e-6),
+		m_warmStarting(true),
+		m_deterministic(true),
+		m_threadPool(0),
+		m_workspaces(1, new SolverWorkspace),
+		m_solutions(1),
+		m_narrowphaseWorkspaces(1, new NarrowphaseWorkspace),
+		m_broadphaseInstance(CreateBroadphase(SWEEP_AND_PRUNE)),
+		m_broadphase(m_broadphaseInstance)
+{
+#ifndef GPX_NO_INTROSPECT
+	m_introspector = & m_introspectorInstance;
+#endif
+}
+
+Collider::Collider(broadphase_t broadphase, BasicExecutor & collisionContractor, phy::NewtonPlasticityTable & plasticityTable):
+		m_collisionContractor(collisionContractor),
+		m_plasticityTable(plasticityTable),
+		m_subsequentCollisionLimit(INITIAL_SUBSEQUENT_COLLISION_LIMIT),
+		m_solver(NN_SOLVER),
+		m_pgsIterations(INITIAL_PGS_ITERATIONS),
+		m_pgsTolerance(1.0e-6),
+		m_warmStarting(true),
+		m_deterministic(true),
+		m_threadPool(0),
+		m_workspaces(1, new SolverWorkspace),
+		m_solutions(1),
+		m_narrowphaseWorkspaces(1, new NarrowphaseWorkspace),
+		m_broadphaseInstance(CreateBroadphase(broadphase)),
+		m_broadphase(m_broadphaseInstance)
 {
 #ifndef GPX_NO_INTROSPECT
 	m_introspector = & m_introspectorInstance;
@@ -32,9 +66,12 @@ Collider::Collider(BasicExecutor & collisionContractor, phy::NewtonPlasticityTab
 
 Collider::~Collider()
 {
-	// Delete movables wrappers, which are allocated on a heap by addMovable().
-	for (MovablesContainer::iterator mov = movables().begin(); mov != movables().end(); ++mov)
-		delete mov->second;
+	delete m_threadPool;
+	for (SolverWorkspacesContainer::iterator workspace = m_workspaces.begin(); workspace != m_workspaces.end(); ++workspace)
+		delete *workspace;
+	for (NarrowphaseWorkspacesContainer::iterator workspace = m_narrowphaseWorkspaces.begin(); workspace != m_narrowphaseWorkspaces.end(); ++workspace)
+		delete *workspace;
+	delete m_broadphaseInstance;
 }
 
 BasicExecutor & Collider::DefaultCollisionContractor()
@@ -50,6 +87,34 @@ void Collider::setIntrospector(Introspector & introspector)
 #endif
 }
 
+const ClusterArena & Collider::clusterArena() const
+{
+	return m_clusterArena;
+}
+
+const Broadphase & Collider::broadphase() const
+{
+	return *m_broadphase;
+}
+
+Broadphase & Collider::broadphase()
+{
+	return *m_broadphase;
+}
+
+void Collider::setBroadphase(Broadphase & broadphase)
+{
+	for (std::size_t i = 0; i < m_fixed.size(); ++i) {
+		m_broadphase->removeFixed(m_fixedHandles[i]);
+		broadphase.addFixed(m_fixed[i], m_fixedHandles[i]);
+	}
+	for (std::size_t i = 0; i < m_movables.size(); ++i) {
+		m_broadphase->removeMovable(m_movableHandles[i]);
+		broadphase.addMovable(m_movables[i], m_movableHandles[i]);
+	}
+	m_broadphase = & broadphase;
+}
+
 int Collider::subsequentCollisionLimit() const
 {
 	return m_subsequentCollisionLimit;
@@ -60,66 +125,188 @@ void Collider::setSubsequentCollisionLimit(int limit)
 	m_subsequentCollisionLimit = limit;
 }
 
+Collider::solver_t Collider::solver() const
+{
+	return m_solver;
+}
+
+void Collider::setSolver(solver_t solver)
+{
+	m_solver = solver;
+}
+
+std::size_t Collider::pgsIterations() const
+{
+	return m_pgsIterations;
+}
+
+void Collider::setPGSIterations(std::size_t iterations)
+{
+	m_pgsIterations = iterations;
+}
+
+real_t Collider::pgsTolerance() const
+{
+	return m_pgsTolerance;
+}
+
+void Collider::setPGSTolerance(real_t tolerance)
+{
+	m_pgsTolerance = tolerance;
+}
+
+bool Collider::warmStarting() const
+{
+	return m_warmStarting;
+}
+
+void Collider::setWarmStarting(bool warmStarting)
+{
+	m_warmStarting = warmStarting;
+	if (!warmStarting)
+		m_contactCache.clear();
+}
+
+ContactCache & Collider::contactCache()
+{
+	return m_contactCache;
+}
+
+const ContactCache & Collider::contactCache() const
+{
+	return m_contactCache;
+}
+
+std::size_t Collider::threads() const
+{
+	return m_threadPool ? m_threadPool->threads() : 1;
+}
+
+void Collider::setThreads(std::size_t threads)
+{
+	delete m_threadPool;
+	m_threadPool = 0;
+	if (threads != 1) {
+		m_threadPool = new utils::ThreadPool(threads);
+		threads = m_threadPool->threads();
+		if (threads < 2) {
+			delete m_threadPool;
+			m_threadPool = 0;
+			threads = 1;
+		}
+	}
+
+	while (m_workspaces.size() > threads) {
+		delete m_workspaces.back();
+		m_workspaces.pop_back();
+	}
+	while (m_workspaces.size() < threads)
+		m_workspaces.push_back(new SolverWorkspace);
+	while (m_narrowphaseWorkspaces.size() > threads) {
+		delete m_narrowphaseWorkspaces.back();
+		m_narrowphaseWorkspaces.pop_back();
+	}
+	while (m_narrowphaseWorkspaces.size() < threads)
+		m_narrowphaseWorkspaces.push_back(new NarrowphaseWorkspace);
+}
+
+bool Collider::deterministic() const
+{
+	return m_deterministic;
+}
+
+void Collider::setDeterministic(bool deterministic)
+{
+	m_deterministic = deterministic;
+}
+
 void Collider::addFixed(ICFixed * obj)
 {
-	m_fixed.insert(obj);
+	handle_t handle = acquireHandle(obj, m_fixed.size());
+	m_fixed.push_back(obj);
+	m_fixedHandles.push_back(handle);
+	updateCircles(handle, *obj);
+	m_broadphase->addFixed(obj, handle);
 }
 
 void Collider::removeFixed(ICFixed * obj)
 {
-	GPX_ASSERT(m_fixed.find(obj) != m_fixed.end(), "element does not exist");
-	m_fixed.erase(obj);
+	handle_t handle = releaseHandle(obj);
+	m_broadphase->removeFixed(handle);
+	m_contactCache.remove(obj);
+
+	//swap and pop
+	std::size_t index = m_handleIndices[handle];
+	m_fixed[index] = m_fixed.back();
+	m_fixedHandles[index] = m_fixedHandles.back();
+	m_handleIndices[m_fixedHandles[index]] = index;
+	m_fixed.pop_back();
+	m_fixedHandles.pop_back();
+}
+
+void Collider::refitFixed(ICFixed * obj)
+{
+	ObjectHandlesContainer::const_iterator i = m_objectHandles.find(obj);
+	GPX_ASSERT(i != m_objectHandles.end(), "element does not exist");
+	updateCircles(i->second, *obj);
+	m_broadphase->refitFixed(i->second);
 }
 
 void Collider::addMovable(ICMovable * obj)
 {
-	m_movables[obj] = new MovableData;
+	handle_t handle = acquireHandle(obj, m_movables.size());
+	m_movables.push_back(obj);
+	m_movableHandles.push_back(handle);
+	updateCircles(handle, *obj);
+	m_broadphase->addMovable(obj, handle);
 }
 
 void Collider::removeMovable(ICMovable * obj)
 {
-	GPX_ASSERT(m_movables.find(obj) != m_movables.end(), "element does not exist");
-	MovablesContainer::iterator i = m_movables.find(obj);
-	delete i->second;
-	m_movables.erase(i);
+	handle_t handle = releaseHandle(obj);
+	m_broadphase->removeMovable(handle);
+	m_contactCache.remove(obj);
+
+	//swap and pop
+	std::size_t index = m_handleIndices[handle];
+	m_movables[index] = m_movables.back();
+	m_movableHandles[index] = m_movableHandles.back();
+	m_handleIndices[m_movableHandles[index]] = index;
+	m_movables.pop_back();
+	m_movableHandles.pop_back();
 }
 
 void Collider::update(real_t dt)
 {
-	ClustersContainer clusters;
-	Cluster * cluster = new Cluster(dt);	//@todo possible optimization: preallocate clusters, detection data and other structures.
-//	bool collision;
+	ClustersContainer & clusters = m_clusters;
 //	int pass = 0;
 
 	//update positions
-	for (MovablesContainer::iterator mov = movables().begin(); mov != movables().end(); ++mov) {
-		mov->second->checked = false;	//set check flag to false
-		mov->first->update(dt);
-		mov->first->swapBuffers();	//swap to new position
+	//island builder indices are equal to dense indices of movables
+	m_islandBuilder.clear();
+	for (std::size_t i = 0; i < m_movables.size(); ++i) {
+		m_movables[i]->update(dt);
+		m_movables[i]->swapBuffers();	//swap to new position
+		real_t preRadius = m_circles[m_movableHandles[i]].radius;
+		updateCircles(m_movableHandles[i], *m_movables[i]);	//c-vertices of shape-shifting bodies may change
+		//broadphase box has to enclose bounding circles at pre- and post-collision positions
+		m_broadphase->setBoundr(m_movableHandles[i], std::max(preRadius, m_circles[m_movableHandles[i]].radius));
+		m_islandBuilder.addBody(m_movables[i]);
 	}
+	m_broadphase->update();
+	if (m_warmStarting)
+		m_contactCache.age();
 
 	GPX_DEBUG("-------------------------------------------------------------------");
-	for (MovablesContainer::iterator mov = movables().begin(); mov != movables().end(); ++mov) {
-		DetectionData movData(*(mov->first), mov->first, *cluster);
-//		collision = false;
-		if (mov->second->checked)
-			continue;	//already checked
-		mov->second->checked = true;	//mark as being checked
-		fillCluster(*cluster, movData);
-		if (cluster->endIndex > 0) {
-			clusters.push_back(cluster);
-			cluster = new Cluster(dt);
-		}
-	}
-	if (!clusters.empty()) {
-		fulfillClusters(clusters);
+	fillIslands();
+	if (m_islandBuilder.edges() > 0) {
+		fulfillIslands();
+		m_islandBuilder.buildClusters(dt, m_clusterArena, clusters);
 		handleCollisions(clusters);
 		updateClusters(clusters, dt);
 	} else
 		GPX_DEBUG("no collision");
-	for (ClustersContainer::iterator i = clusters.begin(); i != clusters.end(); ++i)
-		delete *i;
-	delete cluster;
+	m_clusterArena.releaseClusters();
 	clusters.clear();
 }
 
@@ -133,46 +320,295 @@ const Collider::FixedContainer & Collider::fixed() const
 	return m_fixed;
 }
 
-Collider::FixedContainer & Collider::fixed()
+const Collider::MovablesContainer & Collider::movables() const
 {
-	return m_fixed;
+	return m_movables;
 }
 
-const Collider::MovablesContainer & Collider::movables() const
+Broadphase * Collider::CreateBroadphase(broadphase_t broadphase)
 {
-	return m_movables;
+	switch (broadphase) {
+		case SPATIAL_HASH:
+			return new SpatialHashBroadphase;
+		case BRUTE_FORCE:
+			return new BruteForceBroadphase;
+		default:
+			return new SweepAndPruneBroadphase;
+	}
 }
 
-Collider::MovablesContainer & Collider::movables()
+Collider::handle_t Collider::acquireHandle(const ICFixed * obj, std::size_t index)
 {
-	return m_movables;
+	GPX_ASSERT(m_objectHandles.find(obj) == m_objectHandles.end(), "element already exists");
+	handle_t handle;
+	if (m_freeHandles.empty()) {
+		handle = m_handleIndices.size();
+		m_handleIndices.push_back(index);
+		m_circles.push_back(BoundingCircles());
+	} else {
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+		m_handleIndices[handle] = index;
+	}
+	m_objectHandles[obj] = handle;
+	return handle;
+}
+
+Collider::handle_t Collider::releaseHandle(const ICFixed * obj)
+{
+	ObjectHandlesContainer::iterator i = m_objectHandles.find(obj);
+	GPX_ASSERT(i != m_objectHandles.end(), "element does not exist");
+	handle_t handle = i->second;
+	m_objectHandles.erase(i);
+	m_freeHandles.push_back(handle);
+	return handle;
+}
+
+void Collider::updateCircles(handle_t handle, const ICFixed & obj)
+{
+	BoundingCircles & circles = m_circles[handle];
+	circles.elements.resize(obj.elements());
+	circles.radius = 0.0;
+	for (cdetect::interseg::ICPolyGroup::element_t i = 0; i < obj.elements(); i++) {
+		circles.elements[i] = obj.element(i)->boundr();
+		circles.radius = std::max(circles.radius, circles.elements[i]);
+	}
+}
+
+real_t Collider::PathDistance(const FrameTransform & future, const FrameTransform & past)
+{
+	//bounding circles are centered at origins of local coordinates, so it is sufficient to check how close origin of
+	//wedge passes by the origin of bumper; frames are assumed to preserve distances
+	const real_t * post = future.m + 4;	//translation is an image of wedge origin
+	const real_t * pre = past.m + 4;
+
+	//find point of segment pre-post closest to the origin
+	real_t v[2] = {post[0] - pre[0], post[1] - pre[1]};
+	real_t vv = v[0] * v[0] + v[1] * v[1];
+	real_t t = vv > 0.0 ? -(pre[0] * v[0] + pre[1] * v[1]) / vv : 0.0;
+	t = std::max(real_t(0.0), std::min(real_t(1.0), t));
+	real_t x = pre[0] + t * v[0];
+	real_t y = pre[1] + t * v[1];
+	return std::sqrt(x * x + y * y);
+}
+
+template <typename T>
+T Collider::RelativeDislocationThreshold()
+{
+	return epsilon<T>();
+}
+
+template <>
+float Collider::RelativeDislocationThreshold<float>()
+{
+	return 16.0f * std::numeric_limits<float>::epsilon();
+}
+
+template <>
+double Collider::RelativeDislocationThreshold<double>()
+{
+	return epsilon<double>();
+}
+
+real_t Collider::DislocationThreshold(math::const_PointRef<2> pos)
+{
+	return RelativeDislocationThreshold<real_t>() * std::max(real_t(1.0), std::max(std::abs(pos[0]), std::abs(pos[1])));
+}
+
+void Collider::CaptureFrames(SeekContactState & s, DoubleBufferSwapper & b)
+{
+	s.future.capture(s.wedge, s.bumper);
+	b.swapBuffers(); //swap to pre-collision
+	s.past.capture(s.wedge, s.bumper);
+	b.swapBuffers(); //back to the future
+	s.distance = PathDistance(s.future, s.past);
+	s.transformed = false;
+}
+
+void Collider::transformVertices(SeekContactState & s, DoubleBufferSwapper & b) const
+{
+	//iteration may have reached current element in pre-collision state, so iterator is rebased onto post-collision vertices
+	std::size_t vi = s.vertices->distance(s.vertIt);
+	s.vertices = & s.wedge.element(s.wi)->cvertices();
+	s.vertIt = s.vertices->begin() + vi;
+
+	const model::VertexData<2> & futureVertices = *s.vertices;
+	std::vector<real_t> & transformedFuture = s.workspace.futureVertices;
+	transformedFuture.resize(futureVertices.size());
+	for (std::size_t i = 0; i < futureVertices.size(); i += 2)
+		s.future.map(futureVertices.data() + i, & transformedFuture[i]);
+
+	b.swapBuffers(); //swap to pre-collision
+	//get pre-collision vertices (however they may differ only for shape-shifting, double buffered objects)
+	const model::VertexData<2> & pastVertices = s.wedge.element(s.wi)->cvertices();
+	std::vector<real_t> & transformedPast = s.workspace.pastVertices;
+	transformedPast.resize(pastVertices.size());
+	for (std::size_t i = 0; i < pastVertices.size(); i += 2)
+		s.past.map(pastVertices.data() + i, & transformedPast[i]);
+	b.swapBuffers(); //back to the future
+
+	s.transformed = true;
+}
+
+bool Collider::approach(SeekContactState & s, DoubleBufferSwapper & b) const
+{
+	CaptureFrames(s, b);
+	return s.begin();
+}
+
+void Collider::reportCircles(const SeekContactState & s)
+{
+#ifndef GPX_NO_INTROSPECT
+	m_introspector->circleTests(s.circleTests, s.circleRejections);
+#else
+	GPX_UNUSED(s);
+#endif
 }
 
-void Collider::fillCluster(Cluster & cluster, DetectionData & firstData)
+void Collider::reportCircles(CircleReportsContainer::const_iterator begin, CircleReportsContainer::const_iterator end)
 {
-	for (MovablesContainer::iterator mov = movables().begin(); mov != movables().end(); ++mov) {
-		if (mov->second->checked)
-			continue;	//already checked or checking
-		DetectionData secondData(*(mov->first), mov->first, cluster);
-		std::size_t newIndex = testPairCollect(cluster.endIndex, firstData, secondData);
-		if (newIndex > cluster.endIndex) {
-			cluster.endIndex = newIndex;
-			mov->second->checked = true;	//mark as being checked
-			fillCluster(cluster, secondData);
+#ifndef GPX_NO_INTROSPECT
+	for (CircleReportsContainer::const_iterator report = begin; report != end; ++report)
+		m_introspector->circleTests(report->tests, report->rejections);
+#else
+	GPX_UNUSED(begin);
+	GPX_UNUSED(end);
+#endif
+}
+
+void Collider::fillIslands()
+{
+	if (m_threadPool) {
+		fillIslandsParallel();
+		return;
+	}
+
+	for (std::size_t first = 0; first < m_movables.size(); ++first) {
+		ICMovable * body = m_movables[first];
+
+		const Broadphase::HandlesContainer & candidateMovables = m_broadphase->movables(m_movableHandles[first]);
+		for (Broadphase::HandlesContainer::const_iterator mov = candidateMovables.begin(); mov != candidateMovables.end(); ++mov) {
+			std::size_t second = m_handleIndices[*mov];
+			if (second < first)
+				continue;	//pair has been already tested by second body
+			testPairIsland(first, body, second, *m_movables[second], m_movables[second], *mov);
 		}
+
+		const Broadphase::HandlesContainer & candidateFixed = m_broadphase->fixed(m_movableHandles[first]);
+		for (Broadphase::HandlesContainer::const_iterator pas = candidateFixed.begin(); pas != candidateFixed.end(); ++pas)
+			testPairIsland(first, body, IslandBuilder::NO_BODY, *m_fixed[m_handleIndices[*pas]], 0, *pas);
 	}
+}
 
-	for (FixedContainer::iterator pas = fixed().begin(); pas != fixed().end(); ++pas) {
-		DetectionData secondData(**pas, 0, cluster);
-		std::size_t newIndex = testPairCollect(cluster.endIndex, firstData, secondData);
-		if (newIndex > cluster.endIndex) {
-			cluster.endIndex = newIndex;
-			cluster.detections.push_back(secondData);
+void Collider::fillIslandsParallel()
+{
+	//collect candidate pairs in order of serial fillIslands()
+	m_pairs.clear();
+	for (std::size_t first = 0; first < m_movables.size(); ++first) {
+		const Broadphase::HandlesContainer & candidateMovables = m_broadphase->movables(m_movableHandles[first]);
+		for (Broadphase::HandlesContainer::const_iterator mov = candidateMovables.begin(); mov != candidateMovables.end(); ++mov) {
+			std::size_t second = m_handleIndices[*mov];
+			if (second < first)
+				continue;	//pair has been already collected by second body
+			m_pairs.push_back(CandidatePair(first, second, *mov));
 		}
+
+		const Broadphase::HandlesContainer & candidateFixed = m_broadphase->fixed(m_movableHandles[first]);
+		for (Broadphase::HandlesContainer::const_iterator pas = candidateFixed.begin(); pas != candidateFixed.end(); ++pas)
+			m_pairs.push_back(CandidatePair(first, IslandBuilder::NO_BODY, *pas));
+	}
+
+	//assign pairs to rounds (first fit), so that each body swaps its buffers in at most one pair per round
+	m_roundMasks.assign(m_movables.size(), 0);
+	m_roundEnds.assign(PARALLEL_ROUNDS + 1, 0);
+	for (CandidatePairsContainer::iterator pair = m_pairs.begin(); pair != m_pairs.end(); ++pair) {
+		unsigned long long occupied = m_roundMasks[pair->first];
+		if (pair->second != IslandBuilder::NO_BODY)
+			occupied |= m_roundMasks[pair->second];
+		pair->round = 0;
+		while (pair->round < PARALLEL_ROUNDS && (occupied & (1ull << pair->round)))
+			pair->round++;
+		if (pair->round < PARALLEL_ROUNDS) {
+			m_roundMasks[pair->first] |= 1ull << pair->round;
+			if (pair->second != IslandBuilder::NO_BODY)
+				m_roundMasks[pair->second] |= 1ull << pair->round;
+		}	//otherwise pair goes to last round, which is tested serially
+		m_roundEnds[pair->round]++;
+	}
+	for (std::size_t round = 1; round <= PARALLEL_ROUNDS; ++round)
+		m_roundEnds[round] += m_roundEnds[round - 1];
+	m_pairOrder.resize(m_pairs.size());
+	for (std::size_t i = m_pairs.size(); i > 0; --i)
+		m_pairOrder[--m_roundEnds[m_pairs[i - 1].round]] = i - 1;
+	//round ends have been shifted to round beginnings by counting sort
+	for (std::size_t round = 0; round < PARALLEL_ROUNDS; ++round)
+		m_roundEnds[round] = m_roundEnds[round + 1];
+	m_roundEnds[PARALLEL_ROUNDS] = m_pairs.size();
+
+	for (NarrowphaseWorkspacesContainer::iterator workspace = m_narrowphaseWorkspaces.begin(); workspace != m_narrowphaseWorkspaces.end(); ++workspace) {
+		(*workspace)->firstContacts.clear();
+		(*workspace)->secondContacts.clear();
+		(*workspace)->circleReports.clear();
+	}
+
+	//test pairs
+	std::size_t begin = 0;
+	for (std::size_t round = 0; round <= PARALLEL_ROUNDS && begin < m_pairs.size(); ++round) {
+		std::size_t end = m_roundEnds[round];
+		if (round < PARALLEL_ROUNDS)
+			m_threadPool->run(end - begin, [this, begin](std::size_t task, std::size_t thread) {
+				CandidatePair & pair = m_pairs[m_pairOrder[begin + task]];
+				pair.thread = thread;
+				testPair(pair, *m_narrowphaseWorkspaces[thread]);
+			});
+		else
+			for (std::size_t i = begin; i < end; ++i) {
+				CandidatePair & pair = m_pairs[m_pairOrder[i]];
+				pair.thread = 0;
+				testPair(pair, *m_narrowphaseWorkspaces.front());
+			}
+		begin = end;
 	}
 
-	if (!firstData.contacts.empty())
-		cluster.detections.push_back(firstData);
+	//merge results in order of serial fillIslands()
+	for (CandidatePairsContainer::const_iterator pair = m_pairs.begin(); pair != m_pairs.end(); ++pair)
+		mergePair(*pair);
+}
+
+void Collider::testPair(CandidatePair & pair, NarrowphaseWorkspace & workspace) const
+{
+	ICMovable * firstMov = m_movables[pair.first];
+	ICMovable * secondMov = pair.second != IslandBuilder::NO_BODY ? m_movables[pair.second] : 0;
+	ICFixed * secondFix = secondMov ? secondMov : m_fixed[m_handleIndices[pair.secondHandle]];
+
+	//contacts are appended directly to containers of workspace
+	DetectionData firstData(*firstMov, firstMov);
+	DetectionData secondData(*secondFix, secondMov);
+	firstData.contacts.swap(workspace.firstContacts);
+	secondData.contacts.swap(workspace.secondContacts);
+	pair.contactsBegin = firstData.contacts.size();
+	pair.reportsBegin = workspace.circleReports.size();
+	pair.contacts = testPairCollect(0, firstData, m_circles[m_movableHandles[pair.first]], secondData, m_circles[pair.secondHandle], workspace);
+	firstData.contacts.swap(workspace.firstContacts);
+	secondData.contacts.swap(workspace.secondContacts);
+}
+
+void Collider::mergePair(const CandidatePair & pair)
+{
+	const NarrowphaseWorkspace & workspace = *m_narrowphaseWorkspaces[pair.thread];
+	CircleReportsContainer::const_iterator reports = workspace.circleReports.begin() + pair.reportsBegin;
+	reportCircles(reports, reports + 2);
+	if (pair.contacts == 0)
+		return;
+
+	ContactDataContainer::const_iterator firstContacts = workspace.firstContacts.begin() + pair.contactsBegin;
+	ContactDataContainer::const_iterator secondContacts = workspace.secondContacts.begin() + pair.contactsBegin;
+	m_mergeFirstContacts.assign(firstContacts, firstContacts + pair.contacts);
+	m_mergeSecondContacts.assign(secondContacts, secondContacts + pair.contacts);
+	if (pair.second == IslandBuilder::NO_BODY)
+		m_islandBuilder.addContacts(pair.first, m_mergeFirstContacts, *m_fixed[m_handleIndices[pair.secondHandle]], m_mergeSecondContacts);
+	else
+		m_islandBuilder.addContacts(pair.first, m_mergeFirstContacts, pair.second, m_mergeSecondContacts);
 }
 
 void Collider::moveBackClusters(ClustersContainer & clusters) const
@@ -184,106 +620,136 @@ void Collider::moveBackClusters(ClustersContainer & clusters) const
 				detection->mov->swapBuffers();	//move back to the past
 }
 
-void Collider::fulfillClusters(ClustersContainer & clusters)
+void Collider::fulfillIslands()
 {
-	//move back objects in cluster and set their check flag to false
-	for (ClustersContainer::iterator cluster = clusters.begin(); cluster != clusters.end(); ++cluster)
-		for (DetectionDataContainer::const_iterator detection = (*cluster)->detections.begin(); detection != (*cluster)->detections.end(); ++detection) {
-			if (detection->mov) {
-				detection->mov->swapBuffers();	//move back to the past
-				movables()[detection->mov]->checked = false;	//@todo possible optimization: hash map may be replaced by wrapping structure to avoid lookups, although currently this is not a big deal.
-			}
+	//move back bodies, which are in contact
+	for (std::size_t i = 0; i < m_movables.size(); ++i)
+		if (m_islandBuilder.touching(i))
+			m_movables[i]->swapBuffers();	//move back to the past
+
+	//Bodies, which are not in contact, are tested against bodies moved back to the past. Body, which
+	//touches bodies from different islands, joins these islands together. Fresh members of islands
+	//are moved to the past as well, so they are then tested against remaining bodies.
+	m_islandStack.clear();
+	for (std::size_t fresh = 0; fresh < m_movables.size(); ++fresh) {
+		if (m_islandBuilder.touching(fresh))
+			continue;	//already in island
+		ICMovable * body = m_movables[fresh];
+		const Broadphase::HandlesContainer & candidateMovables = m_broadphase->movables(m_movableHandles[fresh]);
+		for (Broadphase::HandlesContainer::const_iterator mov = candidateMovables.begin(); mov != candidateMovables.end(); ++mov) {
+			std::size_t member = m_handleIndices[*mov];
+			if (!m_islandBuilder.touching(member))
+				continue;	//not in island
+			testPairIsland(member, 0, fresh, *body, body, m_movableHandles[fresh]);	//member acts as fixed
 		}
-
-	//Currently during fulfill object can be attached to one cluster even if it falls on two or more.
-	//Implementation is also not very elegant. Symmetry between fillCluster and fulfillCluster should be exploited.
-	//todo this probably should be done better with some graph structure providing joins of clusters etc.
-	//probably it would be better to swap back
-
-	for (ClustersContainer::iterator cluster = clusters.begin(); cluster != clusters.end(); ++cluster)
-		for (MovablesContainer::iterator mov = movables().begin(); mov != movables().end(); ++mov) {
-			if (!mov->second->checked)
-				continue;	//already in cluster
-			DetectionData movData(*(mov->first), mov->first, **cluster);
-			for (DetectionDataContainer::iterator oldData = (*cluster)->detections.begin(); oldData != (*cluster)->detections.end(); ++oldData) {
-				ICMovable * saveMov = oldData->mov;
-				oldData->mov = 0;	//act as fixed
-				(*cluster)->endIndex = testPairCollect((*cluster)->endIndex, *oldData, movData);
-				oldData->mov = saveMov;
-			}
-			if (!movData.contacts.empty()) {
-				mov->second->checked = false;
-				mov->first->swapBuffers(); //move fresh member of cluster to the past
-				fulfillCluster(**cluster, movData);
+		if (!m_islandBuilder.touching(fresh))
+			continue;
+		body->swapBuffers(); //move fresh member of island to the past
+		m_islandStack.push_back(fresh);
+
+		while (!m_islandStack.empty()) {
+			std::size_t member = m_islandStack.back();
+			m_islandStack.pop_back();
+			const Broadphase::HandlesContainer & memberCandidates = m_broadphase->movables(m_movableHandles[member]);
+			for (Broadphase::HandlesContainer::const_iterator mov = memberCandidates.begin(); mov != memberCandidates.end(); ++mov) {
+				std::size_t second = m_handleIndices[*mov];
+				if (m_islandBuilder.touching(second))
+					continue;	//already in island
+				if (testPairIsland(member, 0, second, *m_movables[second], m_movables[second], *mov)) {	//member acts as fixed
+					m_movables[second]->swapBuffers(); //move fresh member of island to the past
+					m_islandStack.push_back(second);
+				}
 			}
 		}
+	}
 }
 
-void Collider::fulfillCluster(Cluster & cluster, DetectionData & firstData)
-{
-	ICMovable * saveMov = firstData.mov;
-	firstData.mov = 0;
-	for (MovablesContainer::iterator mov = movables().begin(); mov != movables().end(); ++mov) {
-		if (!mov->second->checked)
-			continue;	//already in cluster or just being added
-		DetectionData secondData(*(mov->first), mov->first, cluster);
-		std::size_t newIndex = testPairCollect(cluster.endIndex, firstData, secondData);
-		if (newIndex > cluster.endIndex) {
-			cluster.endIndex = newIndex;
-			mov->second->checked = false;
-			mov->first->swapBuffers(); //move fresh member of cluster to the past
-			fulfillCluster(cluster, secondData);
-		}
+bool Collider::testPairIsland(std::size_t first, ICMovable * firstMov, std::size_t second, ICFixed & secondFix, ICMovable * secondMov, handle_t secondHandle)
+{
+	DetectionData firstData(*m_movables[first], firstMov);
+	DetectionData secondData(secondFix, secondMov);
+	m_clusterArena.acquireContacts(firstData.contacts);
+	m_clusterArena.acquireContacts(secondData.contacts);
+	NarrowphaseWorkspace & workspace = *m_narrowphaseWorkspaces.front();
+	std::size_t reportsBegin = workspace.circleReports.size();	//workspace may still hold reports of parallel pair tests
+	bool result = testPairCollect(0, firstData, m_circles[m_movableHandles[first]], secondData, m_circles[secondHandle], workspace) > 0;
+	reportCircles(workspace.circleReports.begin() + reportsBegin, workspace.circleReports.end());
+	workspace.circleReports.resize(reportsBegin);
+	if (result) {
+		if (second == IslandBuilder::NO_BODY)
+			m_islandBuilder.addContacts(first, firstData.contacts, secondFix, secondData.contacts);
+		else
+			m_islandBuilder.addContacts(first, firstData.contacts, second, secondData.contacts);
 	}
-	firstData.mov = saveMov;
-	cluster.detections.push_back(firstData);
+	m_clusterArena.releaseContacts(firstData.contacts);
+	m_clusterArena.releaseContacts(secondData.contacts);
+	return result;
 }
 
-std::size_t Collider::testPairCollect(std::size_t startIndex, DetectionData & firstData, DetectionData & secondData)
+std::size_t Collider::testPairCollect(std::size_t startIndex, DetectionData & firstData, const BoundingCircles & firstCircles, DetectionData & secondData, const BoundingCircles & secondCircles, NarrowphaseWorkspace & workspace) const
 {
 	ContactData cFirst, cSecond;
 	DoubleBufferSwapper bSwapper(firstData.mov, secondData.mov);
 
 	//case 1: first is a wedge, second is a bumper
-	SeekContactState stateA(firstData.fix, secondData.fix);
-	while (seekContactCollect(stateA, bSwapper, cFirst, cSecond)) {
-		cFirst.index = startIndex;
-		cSecond.index = startIndex;
-		firstData.contacts.push_back(cFirst);
-		secondData.contacts.push_back(cSecond);
-		startIndex++;
-	}
+	SeekContactState stateA(firstData.fix, firstCircles, secondData.fix, secondCircles, workspace);
+	if (approach(stateA, bSwapper))
+		while (seekContactCollect(stateA, bSwapper, cFirst, cSecond)) {
+			cFirst.index = startIndex;
+			cSecond.index = startIndex;
+			firstData.contacts.push_back(cFirst);
+			secondData.contacts.push_back(cSecond);
+			startIndex++;
+		}
+	CircleReport reportA = {stateA.circleTests, stateA.circleRejections};
+	workspace.circleReports.push_back(reportA);
 
 	//case 2: second is a wedge, first is a bumper
-	SeekContactState stateB(secondData.fix, firstData.fix);
-	while (seekContactCollect(stateB, bSwapper, cSecond, cFirst)) {
-		cFirst.index = startIndex;
-		cSecond.index = startIndex;
-		firstData.contacts.push_back(cFirst);
-		secondData.contacts.push_back(cSecond);
-		startIndex++;
-	}
+	SeekContactState stateB(secondData.fix, secondCircles, firstData.fix, firstCircles, workspace);
+	if (approach(stateB, bSwapper))
+		while (seekContactCollect(stateB, bSwapper, cSecond, cFirst)) {
+			cFirst.index = startIndex;
+			cSecond.index = startIndex;
+			firstData.contacts.push_back(cFirst);
+			secondData.contacts.push_back(cSecond);
+			startIndex++;
+		}
+	CircleReport reportB = {stateB.circleTests, stateB.circleRejections};
+	workspace.circleReports.push_back(reportB);
 
 	return startIndex;
 }
 
-bool Collider::seekContactCollect(SeekContactState & s, DoubleBufferSwapper & b, ContactData & wedgeData, ContactData & bumperData)
+bool Collider::seekContactCollect(SeekContactState & s, DoubleBufferSwapper & b, ContactData & wedgeData, ContactData & bumperData) const
 {
-	while (s.isValid()) {
-		//bumper.pre = wedge.post
-		bumperData.pre = s.bumper.mapToLocal(s.wedge.mapToGlobal(*s.vertIt));
+	cdetect::interseg::ICPoly::Intersection intersection;
+	bool result = false;
 
+	//normals have to be obtained in pre-collision state and segment tests do not depend on state, so search is performed there
+	b.swapBuffers(); //swap to pre-collision
+	while (!result && s.isValid()) {
+		std::size_t vi = s.vertices->distance(s.vertIt);
+#ifndef GPX_NO_BATCH_TRANSFORM
+		if (!s.transformed) {
+			b.swapBuffers(); //back to the future
+			transformVertices(s, b);
+			b.swapBuffers(); //swap to pre-collision
+		}
+		//bumper.pre = wedge.post
+		bumperData.pre = math::const_PointRef<2>(& s.workspace.futureVertices[2 * vi]);
+		//bumper.post = wedge.pre
+		bumperData.post = math::const_PointRef<2>(& s.workspace.pastVertices[2 * vi]);
+#else
+		b.swapBuffers(); //back to the future
+		//bumper.pre = wedge.post
+		bumperData.pre = s.bumper.mapToLocal(s.wedge.mapToGlobal(s.wedge.element(s.wi)->cvertices()[vi]));
 		b.swapBuffers(); //swap to pre-collision
-		//wedge.post = bumper.pre
-		wedgeData.post = s.wedge.mapToLocal(s.bumper.mapToGlobal(bumperData.pre));
 		//bumper.post = wedge.pre
 		//get pre-collision vertices (however they may differ only for shape-shifting, double buffered objects)
-		const model::VertexData<2> & preVertices = s.wedge.element(s.wi)->cvertices();
-		wedgeData.pre = preVertices[s.vertices->distance(s.vertIt)];
-		bumperData.post = s.bumper.mapToLocal(s.wedge.mapToGlobal(wedgeData.pre));
-		b.swapBuffers(); //back to the future
+		bumperData.post = s.bumper.mapToLocal(s.wedge.mapToGlobal(s.wedge.element(s.wi)->cvertices()[vi]));
+#endif
 
-		if (s.bumper.element(s.bi)->test(bumperData.pre, bumperData.post)) {
+		if (s.bumper.element(s.bi)->query(bumperData.pre, bumperData.post, intersection)) {
 			wedgeData.wedge = true;
 			wedgeData.cvertIt = s.vertIt;
 			bumperData.wedge = false;
@@ -292,18 +758,24 @@ bool Collider::seekContactCollect(SeekContactState & s, DoubleBufferSwapper & b,
 			wedgeData.element = s.wi;
 			bumperData.element = s.bi;
 
-			//obtain normals
-			b.swapBuffers(); //swap to pre-collision
-			bumperData.normal = s.bumper.element(s.bi)->normal(bumperData.pre, bumperData.post);
-			wedgeData.normal = bumperData.normal.inverse();
-			b.swapBuffers(); //back to the future
+			//wedge.post = bumper.pre
+			wedgeData.post = s.wedge.mapToLocal(s.bumper.mapToGlobal(bumperData.pre));
+			//wedge.pre is a pre-collision vertex
+			wedgeData.pre = s.wedge.element(s.wi)->cvertices()[vi];
 
-			s.inc();
-			return true;
+			bumperData.normal = intersection.normal;
+			wedgeData.normal = bumperData.normal.inverse();
+			result = true;
 		}
 		s.inc();
 	}
-	return false;
+	b.swapBuffers(); //back to the future
+	return result;
+}
+
+Collider::solver_t Collider::clusterSolver(const Cluster & ) const
+{
+	return m_solver;
 }
 
 void Collider::handleCollisions(ClustersContainer & clusters)
@@ -314,92 +786,42 @@ void Collider::handleCollisions(ClustersContainer & clusters)
 //	for (MovablesContainer::iterator mov = movables().begin(); mov != movables().end(); ++mov)
 //		mov->first->swapBuffers();
 
-	for (ClustersContainer::iterator cluster = clusters.begin(); cluster != clusters.end(); ++cluster) {
-
-		//collect coefficients
-		std::size_t numContacts = (*cluster)->endIndex;
-		GPX_DEBUG("Contacts in cluster: " << numContacts);
-
-		m_a.resize(numContacts, numContacts);
-		m_a.zero();
-
-		m_b.resize(numContacts);
-		m_b.zero();
-
-		for (DetectionDataContainer::const_iterator detection = (*cluster)->detections.begin(); detection != (*cluster)->detections.end(); ++detection) {
-			GPX_DEBUG("colliding object: "  << *dynamic_cast<PhyObject *>(detection->fix));
-			//tmp
-			for (ContactDataContainer::const_iterator contact = detection->contacts.begin(); contact != detection->contacts.end(); ++contact) {
-				GPX_DEBUG("index -> pre: " << contact->index << " -> " << contact->pre);
-				GPX_DEBUG("index -> normal: " << contact->index << " -> " << contact->normal);
-			}
-			GPX_DEBUG("--");
-			//endtmp
-			detection->fix->aCoefs(*detection, m_a);
-			detection->fix->bCoefs(*detection, m_b);
+	if (m_threadPool == 0 || clusters.size() < 2) {
+		ClusterSolution & solution = m_solutions.front();
+		for (ClustersContainer::iterator cluster = clusters.begin(); cluster != clusters.end(); ++cluster) {
+			prepareCluster(**cluster, solution);
+			solveCluster(**cluster, *m_workspaces.front(), solution);
+			commitCluster(**cluster, solution);
 		}
+		return;
+	}
 
-		GPX_DEBUG("A: " << std::endl << m_a);
-		GPX_DEBUG("b: " << std::endl << m_b);
-
-		//remove points with negative velocity
-		for (std::size_t i = 0; i < m_b.size(); ++i)
-			if (m_b(i) < 0.0) {
-				for (std::size_t col = 0; col < m_a.cols(); ++col)
-					m_a(i, col) = 0.0;
-				for (std::size_t row = 0; row < m_a.rows(); ++row)
-					m_a(row, i) = 0.0;
-				m_b(i) = 0.0;
-			}
-		GPX_DEBUG("A: " << std::endl << m_a);
-		GPX_DEBUG("b: " << std::endl << m_b);
-
-		//calculate impulses
-		//@todo current method for cancellation of negative imps based on recalculations of whole system is slow.
-		math::Vector<> normalProjs(0u);
-		bool negativeProjs;
-		do {
-			negativeProjs = false;
-			m_aWC = m_a;
-			m_bWC = m_b;
-
-			//@todo possible optimization: matrix is symmetric and in many cases sparse.
-//			math::Solver<math::EQ_GENERAL> solver(m_aWC);
-			math::NNSolver<math::EQ_GENERAL> solver(m_aWC);
-			normalProjs = solver.solve(m_bWC);
-
-			#pragma message("temporary code")
-			for (std::size_t i = 0; i < normalProjs.size(); ++i)
-				if (gpx::math::cgt(real_t(), normalProjs(i))) {
-					m_introspector->triggerError("solver could not remove negative impulse");
-					m_introspector->breakpoint();
-				}
-			//end tmp
-
-//			GPX_DEBUG("normal projs: " << normalProjs);
-
-			//remove negative impulses
-//			for (std::size_t i = 0; i < normalProjs.size(); ++i)
-//				if (normalProjs(i) < 0.0) {
-//					negativeProjs = true;
-//					for (std::size_t col = 0; col < m_a.cols(); ++col)
-//						m_a(i, col) = 0.0;
-//					for (std::size_t row = 0; row < m_a.rows(); ++row)
-//						m_a(row, i) = 0.0;
-//					m_b(i) = 0.0;
-//				}
-		} while (negativeProjs);
-
-		//apply impulses
-		for (DetectionDataContainer::const_iterator detection = (*cluster)->detections.begin(); detection != (*cluster)->detections.end(); ++detection)
-			if (detection->mov)
-				for (ContactDataContainer::const_iterator contact = detection->contacts.begin(); contact != detection->contacts.end(); ++contact) {
-					math::Vector<2> Fdt = contact->normal.inverse() * normalProjs(contact->index);
-					detection->mov->applyImpulse(Fdt, contact->pre);
-					GPX_DEBUG("Apply impulse to " << *dynamic_cast<PhyObject *>(detection->fix) << " at point: " << contact->pre);
-					GPX_DEBUG("Fdt: " << Fdt);
-				}
+	//contact cache, introspector and clusterSolver() are accessed by calling thread only
+	if (m_solutions.size() < clusters.size())
+		m_solutions.resize(clusters.size());
+	m_schedule.clear();
+	for (std::size_t i = 0; i < clusters.size(); ++i) {
+		prepareCluster(*clusters[i], m_solutions[i]);
+		m_schedule.push_back(i);
 	}
+	//largest clusters are solved first, so that they do not leave remaining threads idle at the end
+	std::stable_sort(m_schedule.begin(), m_schedule.end(), LargerCluster(clusters));
+
+	m_threadPool->run(clusters.size(), [this, & clusters](std::size_t task, std::size_t thread) {
+		std::size_t i = m_schedule[task];
+		solveCluster(*clusters[i], *m_workspaces[thread], m_solutions[i]);
+		if (!m_deterministic) {
+			std::lock_guard<std::mutex> lock(m_commitMutex);
+			applyImpulses(*clusters[i], m_solutions[i]);
+		}
+	});
+
+	if (m_deterministic)
+		for (std::size_t i = 0; i < clusters.size(); ++i)
+			commitCluster(*clusters[i], m_solutions[i]);
+	else
+		for (std::size_t i = 0; i < clusters.size(); ++i)
+			reportCluster(*clusters[i], m_solutions[i]);
 
 //	movDetections->collectACoefs(m_a);
 //	GPX_DEBUG("A: " << std::endl << m_a);
@@ -437,17 +859,202 @@ void Collider::handleCollisions(ClustersContainer & clusters)
 //	movDetections->applyNormalImps(normalProjs);
 }
 
+void Collider::prepareCluster(const Cluster & cluster, ClusterSolution & solution)
+{
+	solution.solver = clusterSolver(cluster);
+	if (solution.solver == PGS_SOLVER && m_warmStarting)
+		m_contactCache.fetch(cluster, solution.warmImpulses);
+}
+
+void Collider::solveCluster(const Cluster & cluster, SolverWorkspace & workspace, ClusterSolution & solution) const
+{
+	//collect coefficients
+	std::size_t numContacts = cluster.endIndex;
+
+	//sparse matrix is assembled for solvers, which are able to consume it
+	solver_t method = solution.solver;
+	bool sparse = method == PGS_SOLVER;
+	if (sparse)
+		workspace.sparseA.resize(numContacts, numContacts);
+	else {
+		workspace.a.resize(numContacts, numContacts);
+		workspace.a.zero();
+	}
+	ACoefsMapper aMapper = sparse ? ACoefsMapper(workspace.sparseA) : ACoefsMapper(workspace.a);
+
+	workspace.b.resize(numContacts);
+	workspace.b.zero();
+
+	bool symmetric = true;
+	for (DetectionDataContainer::const_iterator detection = cluster.detections.begin(); detection != cluster.detections.end(); ++detection) {
+		detection->fix->aCoefs(*detection, aMapper);
+		detection->fix->bCoefs(*detection, workspace.b);
+		symmetric = symmetric && detection->fix->symmetricACoefs();
+	}
+	if (sparse)
+		workspace.sparseA.compress();
+	else
+		GPX_TRACE("A: " << std::endl << workspace.a);
+	GPX_TRACE("b: " << std::endl << workspace.b);
+
+	//remove points with negative velocity
+	for (std::size_t i = 0; i < workspace.b.size(); ++i)
+		if (workspace.b(i) < 0.0) {
+			if (sparse) {
+				workspace.sparseA.zeroRow(i);
+				workspace.sparseA.zeroCol(i);
+			} else {
+				for (std::size_t col = 0; col < workspace.a.cols(); ++col)
+					workspace.a(i, col) = 0.0;
+				for (std::size_t row = 0; row < workspace.a.rows(); ++row)
+					workspace.a(row, i) = 0.0;
+			}
+			workspace.b(i) = 0.0;
+		}
+	if (!sparse)
+		GPX_TRACE("A: " << std::endl << workspace.a);
+	GPX_TRACE("b: " << std::endl << workspace.b);
+
+	//calculate impulses
+	math::Vector<> & normalProjs = solution.impulses;
+	solution.lcpSolver = NN_SOLVER;
+	solution.fallback = false;
+	solution.negativeImpulse = false;
+	if (method == DANTZIG_SOLVER && !symmetric)
+		method = NN_SOLVER;
+	if (method == DANTZIG_SOLVER) {
+		math::LCPSolver<math::LCP_DANTZIG> lcp(workspace.a, workspace.lcpWorkspace);
+		normalProjs.resize(workspace.b.size());
+		lcp.solve(workspace.b, normalProjs);
+		solution.lcpSolver = DANTZIG_SOLVER;
+		solution.lcpIterations = lcp.pivots();
+		solution.lcpResidual = lcp.residual();
+		solution.lcpSolved = lcp.solved();
+		if (!lcp.solved()) {
+			solution.fallback = true;
+			method = NN_SOLVER;
+		}
+	} else if (method == PGS_SOLVER) {
+		math::SparseLCPSolver<math::LCP_PGS> lcp(workspace.sparseA, workspace.pgsWorkspace);
+		lcp.setMaxIterations(m_pgsIterations);
+		lcp.setTolerance(m_pgsTolerance);
+		normalProjs.resize(workspace.b.size());
+		if (m_warmStarting)
+			lcp.solve(workspace.b, solution.warmImpulses, normalProjs);
+		else
+			lcp.solve(workspace.b, normalProjs);
+		solution.lcpSolver = PGS_SOLVER;
+		solution.lcpIterations = lcp.iterations();
+		solution.lcpResidual = lcp.residual();
+		solution.lcpSolved = lcp.converged();
+	}
+	if (method == NN_SOLVER) {
+		//@todo current method for cancellation of negative imps based on recalculations of whole system is slow.
+		bool negativeProjs;
+		do {
+			negativeProjs = false;
+			workspace.aWC = workspace.a;
+			workspace.bWC = workspace.b;
+
+			//@todo possible optimization: matrix is in many cases sparse.
+//			math::Solver<math::EQ_GENERAL> solver(workspace.aWC);
+			normalProjs.resize(workspace.bWC.size());
+			if (symmetric) {
+				math::NNSolver<math::EQ_SYMMETRIC> solver(workspace.aWC, workspace.nnWorkspace);
+				solver.solve(workspace.bWC, normalProjs);
+			} else {
+				math::NNSolver<math::EQ_GENERAL> solver(workspace.aWC, workspace.nnWorkspace);
+				solver.solve(workspace.bWC, normalProjs);
+			}
+
+			#pragma message("temporary code")
+			for (std::size_t i = 0; i < normalProjs.size(); ++i)
+				if (gpx::math::cgt(real_t(), normalProjs(i)))
+					solution.negativeImpulse = true;
+			//end tmp
+
+//			GPX_DEBUG("normal projs: " << normalProjs);
+
+			//remove negative impulses
+//			for (std::size_t i = 0; i < normalProjs.size(); ++i)
+//				if (normalProjs(i) < 0.0) {
+//					negativeProjs = true;
+//					for (std::size_t col = 0; col < workspace.a.cols(); ++col)
+//						workspace.a(i, col) = 0.0;
+//					for (std::size_t row = 0; row < workspace.a.rows(); ++row)
+//						workspace.a(row, i) = 0.0;
+//					workspace.b(i) = 0.0;
+//				}
+		} while (negativeProjs);
+	}
+}
+
+void Collider::commitCluster(const Cluster & cluster, const ClusterSolution & solution)
+{
+	reportCluster(cluster, solution);
+	applyImpulses(cluster, solution);
+}
+
+void Collider::reportCluster(const Cluster & cluster, const ClusterSolution & solution)
+{
+	GPX_DEBUG("Contacts in cluster: " << cluster.endIndex);
+	for (DetectionDataContainer::const_iterator detection = cluster.detections.begin(); detection != cluster.detections.end(); ++detection) {
+		GPX_DEBUG("colliding object: "  << *dynamic_cast<PhyObject *>(detection->fix));
+		//tmp
+		for (ContactDataContainer::const_iterator contact = detection->contacts.begin(); contact != detection->contacts.end(); ++contact) {
+			GPX_DEBUG("index -> pre: " << contact->index << " -> " << contact->pre);
+			GPX_DEBUG("index -> normal: " << contact->index << " -> " << contact->normal);
+		}
+		GPX_DEBUG("--");
+		//endtmp
+	}
+
+	const math::Vector<> & normalProjs = solution.impulses;
+	if (solution.lcpSolver == DANTZIG_SOLVER) {
+		GPX_DEBUG("Dantzig pivots: " << solution.lcpIterations << " residual: " << solution.lcpResidual);
+#ifndef GPX_NO_INTROSPECT
+		m_introspector->lcpSolved(cluster, solution.lcpIterations, solution.lcpResidual, solution.lcpSolved);
+#endif
+		if (solution.fallback)
+			GPX_WARN("Dantzig solver failed, falling back to NN solver");
+	} else if (solution.lcpSolver == PGS_SOLVER) {
+		if (m_warmStarting)
+			m_contactCache.store(cluster, normalProjs);
+		GPX_DEBUG("PGS iterations: " << solution.lcpIterations << " residual: " << solution.lcpResidual);
+#ifndef GPX_NO_INTROSPECT
+		m_introspector->lcpSolved(cluster, solution.lcpIterations, solution.lcpResidual, solution.lcpSolved);
+#endif
+	}
+#ifndef GPX_NO_INTROSPECT
+	if (solution.negativeImpulse) {
+		m_introspector->triggerError("solver could not remove negative impulse");
+		m_introspector->breakpoint();
+	}
+#endif
+}
+
+void Collider::applyImpulses(const Cluster & cluster, const ClusterSolution & solution) const
+{
+	const math::Vector<> & normalProjs = solution.impulses;
+	for (DetectionDataContainer::const_iterator detection = cluster.detections.begin(); detection != cluster.detections.end(); ++detection)
+		if (detection->mov)
+			for (ContactDataContainer::const_iterator contact = detection->contacts.begin(); contact != detection->contacts.end(); ++contact) {
+				math::Vector<2> Fdt = contact->normal.inverse() * normalProjs(contact->index);
+				detection->mov->applyImpulse(Fdt, contact->pre);
+				GPX_DEBUG("Apply impulse to " << *dynamic_cast<PhyObject *>(detection->fix) << " at point: " << contact->pre);
+				GPX_DEBUG("Fdt: " << Fdt);
+			}
+}
+
 void Collider::updateClusters(ClustersContainer & clusters, real_t dt)
 {
 //	ClustersContainer reposClusters;
 
 	//move objects in clusters
 	for (ClustersContainer::iterator cluster = clusters.begin(); cluster != clusters.end(); ++cluster)
-		for (DetectionDataContainer::const_iterator detection = (*cluster)->detections.begin(); detection != (*cluster)->detections.end(); ++detection) {
-			if (detection->mov) {
-				detection->mov->update(dt);
-				detection->mov->swapBuffers();	//move to new position
-			}
+		for (IndicesContainer::const_iterator body = (*cluster)->bodies.begin(); body != (*cluster)->bodies.end(); ++body) {
+			m_movables[*body]->update(dt);
+			m_movables[*body]->swapBuffers();	//move to new position
 		}
 
 	//tmp
@@ -474,22 +1081,24 @@ void Collider::updateClusters(ClustersContainer & clusters, real_t dt)
 	//endtmp
 
 	GPX_DEBUG("========= dislocating clusters =========");
+	m_broadphase->update();	//bodies of all clusters have been moved
 	for (ClustersContainer::iterator cluster = clusters.begin(); cluster != clusters.end(); ++cluster) {
 #ifndef GPX_NO_INTROSPECT
 		for (DetectionDataContainer::const_iterator detection = (*cluster)->detections.begin(); detection != (*cluster)->detections.end(); ++detection)
 			m_introspector->light(*detection->fix);
 		m_introspector->breakpoint();
 #endif
-		DislocMovablesContainer initialInputContainer;
-		for (DetectionDataContainer::const_iterator detection = (*cluster)->detections.begin(); detection != (*cluster)->detections.end(); ++detection)
-			if (detection->mov)
-				initialInputContainer.push_back(detection->mov);
-		DislocMovablesContainer * inContainer = & initialInputContainer;
-		DislocMovablesContainer initialOutputContainer;
-		DislocMovablesContainer * outContainer = & initialOutputContainer;
+		DislocMovablesContainer * inContainer = & m_dislocIn;
+		DislocMovablesContainer * outContainer = & m_dislocOut;
+		inContainer->assign((*cluster)->bodies.begin(), (*cluster)->bodies.end());
+		outContainer->clear();
 		int pass = 0;
 		while (inContainer->size() > 0) {
 			GPX_DEBUG("dislocating cluster (pass: " << pass << ")");
+			//bounds have to follow dislocated objects, which are exactly those passed to next pass
+			if (pass > 0)
+				for (DislocMovablesContainer::const_iterator index = inContainer->begin(); index != inContainer->end(); ++index)
+					m_broadphase->refit(m_movableHandles[*index]);
 			dislocateMovables(*inContainer, *outContainer);
 			//swap input with output
 			DislocMovablesContainer * tmp = outContainer;
@@ -517,22 +1126,26 @@ void Collider::dislocateMovables(DislocMovablesContainer & in, DislocMovablesCon
 //		m_introspector->light(**clusterMov);
 //	m_introspector->breakpoint();
 
-	for (DislocMovablesContainer::iterator inMov = in.begin(); inMov != in.end(); ++inMov) {
+	for (DislocMovablesContainer::iterator inIndex = in.begin(); inIndex != in.end(); ++inIndex) {
+		ICMovable * inMov = m_movables[*inIndex];
 		bool dislocWithFixed = false;
-		for (FixedContainer::iterator fix = fixed().begin(); fix != fixed().end(); ++fix) {
-			if (testPairDislocate(**inMov, **fix, 0)) {
+		const Broadphase::HandlesContainer & candidateFixed = m_broadphase->fixed(m_movableHandles[*inIndex]);
+		for (Broadphase::HandlesContainer::const_iterator fixHandle = candidateFixed.begin(); fixHandle != candidateFixed.end(); ++fixHandle) {
+			ICFixed * fix = m_fixed[m_handleIndices[*fixHandle]];
+			if (testPairDislocate(*inMov, m_circles[m_movableHandles[*inIndex]], *fix, m_circles[*fixHandle], 0)) {
 				dislocWithFixed = true;
-				GPX_DEBUG(*dynamic_cast<PhyObject *>(*inMov) << ": added to container after collision with fixed: " << *dynamic_cast<PhyObject *>(*fix));
+				GPX_DEBUG(*dynamic_cast<PhyObject *>(inMov) << ": added to container after collision with fixed: " << *dynamic_cast<PhyObject *>(fix));
 			}
 		}
 		if (dislocWithFixed)
-			out.push_back(*inMov);
-		for (MovablesContainer::iterator mov = movables().begin(); mov != movables().end(); ++mov) {
-			if (*inMov == mov->first)
-				continue;
-			if (testPairDislocate(*(mov->first), **inMov, *inMov)) {
-				out.push_back(mov->first);
-				GPX_DEBUG(*dynamic_cast<PhyObject *>(*inMov) << ": added to container after collision with movable: " << *dynamic_cast<PhyObject *>(mov->first));
+			out.push_back(*inIndex);
+		const Broadphase::HandlesContainer & candidateMovables = m_broadphase->movables(m_movableHandles[*inIndex]);
+		for (Broadphase::HandlesContainer::const_iterator movHandle = candidateMovables.begin(); movHandle != candidateMovables.end(); ++movHandle) {
+			std::size_t movIndex = m_handleIndices[*movHandle];
+			ICMovable * mov = m_movables[movIndex];
+			if (testPairDislocate(*mov, m_circles[*movHandle], *inMov, m_circles[m_movableHandles[*inIndex]], inMov)) {
+				out.push_back(movIndex);
+				GPX_DEBUG(*dynamic_cast<PhyObject *>(inMov) << ": added to container after collision with movable: " << *dynamic_cast<PhyObject *>(mov));
 			}
 		}
 	}
@@ -541,7 +1154,7 @@ void Collider::dislocateMovables(DislocMovablesContainer & in, DislocMovablesCon
 //		m_introspector->off(**clusterMov);
 }
 
-bool Collider::testPairDislocate(ICMovable & mov, const ICFixed & passive, ICMovable * passiveMov)
+bool Collider::testPairDislocate(ICMovable & mov, const BoundingCircles & movCircles, const ICFixed & passive, const BoundingCircles & passiveCircles, ICMovable * passiveMov)
 {
 	bool result = false;
 	math::Vector<2> normal;
@@ -549,27 +1162,43 @@ bool Collider::testPairDislocate(ICMovable & mov, const ICFixed & passive, ICMov
 	DoubleBufferSwapper bSwapper(& mov, passiveMov);
 
 	//case 1: mov is a wedge, passive is a bumper
-	SeekContactState stateA(& mov, & passive);
-	while (seekContactDislocate(stateA, bSwapper, normal, dsp)) {
-		//need to invert, since normal is taken from bumper
-		normal.invert();
-		dislocateMovable(mov, normal, dsp);
-		result = true;
-	}
+	SeekContactState stateA(& mov, movCircles, & passive, passiveCircles, *m_narrowphaseWorkspaces.front());
+	if (approach(stateA, bSwapper))
+		while (seekContactDislocate(stateA, bSwapper, normal, dsp)) {
+			//need to invert, since normal is taken from bumper
+			normal.invert();
+			dislocateMovable(mov, normal, dsp);
+			CaptureFrames(stateA, bSwapper);	//wedge has been moved
+			result = true;
+		}
+	reportCircles(stateA);
 
 	//case 2: passive is a wedge, mov is a bumper
-	SeekContactState stateB(& passive, & mov);
-	while (seekContactDislocate(stateB, bSwapper, normal, dsp)) {
-		dislocateMovable(mov, normal, dsp);
-		result = true;
-	}
+	SeekContactState stateB(& passive, passiveCircles, & mov, movCircles, *m_narrowphaseWorkspaces.front());
+	if (approach(stateB, bSwapper))
+		while (seekContactDislocate(stateB, bSwapper, normal, dsp)) {
+			dislocateMovable(mov, normal, dsp);
+			CaptureFrames(stateB, bSwapper);	//bumper has been moved
+			result = true;
+		}
+	reportCircles(stateB);
 
 	return result;
 }
 
 bool Collider::seekContactDislocate(SeekContactState & s, DoubleBufferSwapper & b, math::Vector<2> & normal, math::Vector<2> & dsp)
 {
+	cdetect::interseg::ICPoly::Intersection intersection;
 	while (s.isValid()) {
+#ifndef GPX_NO_BATCH_TRANSFORM
+		if (!s.transformed)
+			transformVertices(s, b);
+		std::size_t vi = s.vertices->distance(s.vertIt);
+		//bumper.pre = wedge.post
+		math::const_PointRef<2> bumperPre(& s.workspace.futureVertices[2 * vi]);
+		//bumper.post = wedge.pre
+		math::const_PointRef<2> bumperPost(& s.workspace.pastVertices[2 * vi]);
+#else
 		//bumper.pre = wedge.post
 		math::Point<2> bumperPre = s.bumper.mapToLocal(s.wedge.mapToGlobal(*s.vertIt));
 
@@ -579,10 +1208,11 @@ bool Collider::seekContactDislocate(SeekContactState & s, DoubleBufferSwapper &
 		const model::VertexData<2> & preVertices = s.wedge.element(s.wi)->cvertices();
 		math::Point<2> bumperPost = s.bumper.mapToLocal(s.wedge.mapToGlobal(preVertices[s.vertices->distance(s.vertIt)]));
 		b.swapBuffers(); //back to the future
+#endif
 
-		if (s.bumper.element(s.bi)->test(bumperPre, bumperPost)) {
+		if (s.bumper.element(s.bi)->query(bumperPre, bumperPost, intersection)) {
 			dsp = s.bumper.mapToGlobal(bumperPre) - s.bumper.mapToGlobal(bumperPost);
-			normal = s.bumper.element(s.bi)->normal(bumperPre, bumperPost);
+			normal = intersection.normal;
 			s.inc();
 			return true;
 		}
@@ -600,7 +1230,7 @@ void Collider::dislocateMovable(ICMovable & mov, const math::Vector<2> & normal,
 	math::Vector<2> dislocVector(normal);
 	//While displacement depends on direction of motion, normals always point
 	//outwards the body, therefore absolute value must be taken from dot product.
-	dislocVector *= -std::abs(normal.dot(dsp));
+	dislocVector *= -std::max(std::abs(normal.dot(dsp)), DislocationThreshold(mov.mapToGlobal(math::Point<2>())));
 	if (!mov.dislocate(dislocVector)) {
 		GPX_DEBUG("dislocation unsuccessful, performing second attempt with higher values");
 		math::Vector<2> minVector(normal);
@@ -668,6 +1298,49 @@ void Collider::dislocateMovable(ICMovable & mov, const math::Vector<2> & normal,
 //}
 
 
+Collider::SolverWorkspace::SolverWorkspace():
+	a(std::size_t(0), std::size_t(0), INITIAL_CPOINTS_PER_OBJECT * INITIAL_CPOINTS_PER_OBJECT),
+	aWC(std::size_t(0), std::size_t(0), INITIAL_CPOINTS_PER_OBJECT * INITIAL_CPOINTS_PER_OBJECT),
+	b(std::size_t(0), INITIAL_CPOINTS_PER_OBJECT),
+	bWC(std::size_t(0), INITIAL_CPOINTS_PER_OBJECT)
+{
+}
+
+Collider::ClusterSolution::ClusterSolution():
+	solver(NN_SOLVER),
+	lcpSolver(NN_SOLVER),
+	lcpIterations(0),
+	lcpResidual(0.0),
+	lcpSolved(false),
+	fallback(false),
+	negativeImpulse(false),
+	warmImpulses(std::size_t(0), INITIAL_CPOINTS_PER_OBJECT),
+	impulses(std::size_t(0), INITIAL_CPOINTS_PER_OBJECT)
+{
+}
+
+Collider::CandidatePair::CandidatePair(std::size_t p_first, std::size_t p_second, handle_t p_secondHandle):
+	first(p_first),
+	second(p_second),
+	secondHandle(p_secondHandle),
+	round(0),
+	thread(0),
+	contactsBegin(0),
+	contacts(0),
+	reportsBegin(0)
+{
+}
+
+Collider::LargerCluster::LargerCluster(const ClustersContainer & p_clusters):
+	clusters(p_clusters)
+{
+}
+
+bool Collider::LargerCluster::operator()(std::size_t first, std::size_t second) const
+{
+	return clusters[first]->endIndex > clusters[second]->endIndex;
+}
+
 Collider::DoubleBufferSwapper::DoubleBufferSwapper(ICMovable * p_firstMov, ICMovable * p_secondMov):
 	firstMov(p_firstMov),
 	secondMov(p_secondMov)
@@ -683,9 +1356,36 @@ void Collider::DoubleBufferSwapper::swapBuffers()
 }
 
 
-Collider::SeekContactState::SeekContactState(const ICFixed * const p_wedge, const ICFixed * const p_bumper):
+void Collider::FrameTransform::capture(const ICFixed & from, const ICFixed & to)
+{
+	//origin, unit x and unit y points mapped in one pass by each object
+	real_t points[6] = {0.0, 0.0, 1.0, 0.0, 0.0, 1.0};
+	from.mapToGlobal(points, 3, points);
+	to.mapToLocal(points, 3, points);
+	m[0] = points[2] - points[0];
+	m[1] = points[3] - points[1];
+	m[2] = points[4] - points[0];
+	m[3] = points[5] - points[1];
+	m[4] = points[0];
+	m[5] = points[1];
+}
+
+void Collider::FrameTransform::map(const real_t * point, real_t * result) const
+{
+	result[0] = m[0] * point[0] + m[2] * point[1] + m[4];
+	result[1] = m[1] * point[0] + m[3] * point[1] + m[5];
+}
+
+Collider::SeekContactState::SeekContactState(const ICFixed * const p_wedge, const BoundingCircles & p_wedgeCircles, const ICFixed * const p_bumper, const BoundingCircles & p_bumperCircles, NarrowphaseWorkspace & p_workspace):
 		wedge(*p_wedge),
 		bumper(*p_bumper),
+		wedgeCircles(p_wedgeCircles),
+		bumperCircles(p_bumperCircles),
+		workspace(p_workspace),
+		distance(0.0),
+		transformed(false),
+		circleTests(0),
+		circleRejections(0),
 		wi(0),
 		bi(0),
 		vertices(& wedge.element(0)->cvertices()),
@@ -693,6 +1393,19 @@ Collider::SeekContactState::SeekContactState(const ICFixed * const p_wedge, cons
 {
 }
 
+bool Collider::SeekContactState::begin()
+{
+	circleTests++;
+	if (math::cgt(distance, wedgeCircles.radius + bumperCircles.radius)) {
+		circleRejections++;
+		vertIt = vertices->end();
+		return false;
+	}
+	if (!overlap())
+		nextElements();
+	return true;
+}
+
 bool Collider::SeekContactState::isValid()
 {
 	return vertIt != vertices->end();
@@ -701,18 +1414,38 @@ bool Collider::SeekContactState::isValid()
 void Collider::SeekContactState::inc()
 {
 	++vertIt;
-	if (vertIt == vertices->end()) {
+	if (vertIt == vertices->end())
+		nextElements();
+}
+
+bool Collider::SeekContactState::overlap()
+{
+	if (bumper.elements() == 1 && wedge.elements() == 1)
+		return true;	//already tested against bounding circles of objects
+	circleTests++;
+	if (math::cgt(distance, wedgeCircles.elements[wi] + bumperCircles.elements[bi])) {
+		circleRejections++;
+		return false;
+	}
+	return true;
+}
+
+void Collider::SeekContactState::nextElements()
+{
+	do {
 		bi++;
 		if (bi >= bumper.elements()) {
 			wi++;
-			if (wi < wedge.elements()) {
-				bi = 0;
-				vertices = & wedge.element(wi)->cvertices();
-				vertIt = vertices->begin();
+			if (wi >= wedge.elements()) {
+				vertIt = vertices->end();
+				return;
 			}
-		} else
-			vertIt = vertices->begin();
-	}
+			bi = 0;
+			vertices = & wedge.element(wi)->cvertices();
+			transformed = false;
+		}
+	} while (!overlap());
+	vertIt = vertices->begin();
 }
 
 }
@@ -0,0 +1,200 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/ContactCache.hpp"
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/ICFixed.hpp"
+
+#include <gpx/utils/functions.hpp>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+const unsigned int ContactCache::INITIAL_MAX_AGE;
+
+ContactCache::ContactCache():
+	m_maxAge(INITIAL_MAX_AGE),
+	m_size(0),
+	m_hits(0),
+	m_misses(0)
+{
+}
+
+unsigned int ContactCache::maxAge() const
+{
+	return m_maxAge;
+}
+
+void ContactCache::setMaxAge(unsigned int maxAge)
+{
+	m_maxAge = maxAge;
+	m_size = 0;
+	for (EntriesContainer::const_iterator i = m_entries.begin(); i != m_entries.end(); ++i)
+		if (i->second.age <= m_maxAge)
+			m_size++;
+}
+
+std::size_t ContactCache::size() const
+{
+	return m_size;
+}
+
+std::size_t ContactCache::hitCount() const
+{
+	return m_hits;
+}
+
+std::size_t ContactCache::missCount() const
+{
+	return m_misses;
+}
+
+void ContactCache::resetStats()
+{
+	m_hits = 0;
+	m_misses = 0;
+}
+
+void ContactCache::clear()
+{
+	m_entries.clear();
+	m_keys.clear();
+	m_size = 0;
+}
+
+void ContactCache::age()
+{
+	//expired entries stop aging at m_maxAge + 1
+	m_size = 0;
+	for (EntriesContainer::iterator i = m_entries.begin(); i != m_entries.end(); ++i)
+		if (i->second.age <= m_maxAge && ++i->second.age <= m_maxAge)
+			m_size++;
+
+	if (m_entries.size() - m_size > m_size)
+		for (EntriesContainer::iterator i = m_entries.begin(); i != m_entries.end();)
+			if (i->second.age > m_maxAge)
+				m_entries.erase(i++);
+			else
+				++i;
+}
+
+void ContactCache::remove(const ICFixed * obj)
+{
+	for (EntriesContainer::iterator i = m_entries.begin(); i != m_entries.end();)
+		if (i->first.wedge == obj || i->first.bumper == obj) {
+			if (i->second.age <= m_maxAge)
+				m_size--;
+			m_entries.erase(i++);
+		} else
+			++i;
+	m_keys.clear();
+}
+
+void ContactCache::fetch(const Cluster & cluster, math::Vector<> & impulses)
+{
+	collectKeys(cluster);
+
+	impulses.resize(cluster.endIndex);
+	for (std::size_t i = 0; i < m_keys.size(); i++) {
+		EntriesContainer::const_iterator entry = m_entries.find(m_keys[i]);
+		if (entry != m_entries.end() && entry->second.age <= m_maxAge) {
+			impulses(i) = entry->second.impulse;
+			m_hits++;
+		} else {
+			impulses(i) = 0.0;
+			m_misses++;
+		}
+	}
+}
+
+void ContactCache::store(math::const_VectorRef<> impulses)
+{
+	GPX_ASSERT(impulses.size() == m_keys.size(), "impulses do not match keys of fetched cluster");
+
+	for (std::size_t i = 0; i < m_keys.size(); i++) {
+		EntriesContainer::iterator entry = m_entries.find(m_keys[i]);
+		if (entry == m_entries.end()) {
+			entry = m_entries.insert(EntriesContainer::value_type(m_keys[i], Entry())).first;
+			m_size++;
+		} else if (entry->second.age > m_maxAge)
+			m_size++;
+		entry->second.impulse = impulses(i);
+		entry->second.age = 0;
+	}
+}
+
+void ContactCache::store(const Cluster & cluster, math::const_VectorRef<> impulses)
+{
+	collectKeys(cluster);
+	store(impulses);
+}
+
+void ContactCache::collectKeys(const Cluster & cluster)
+{
+	//each contact index is shared by contact data of a wedge and contact data of a bumper
+	m_keys.assign(cluster.endIndex, Key());
+	for (DetectionDataContainer::const_iterator detection = cluster.detections.begin(); detection != cluster.detections.end(); ++detection)
+		for (ContactDataContainer::const_iterator contact = detection->contacts.begin(); contact != detection->contacts.end(); ++contact) {
+			Key & key = m_keys[contact->index];
+			if (contact->wedge) {
+				key.wedge = detection->fix;
+				key.wedgeElement = contact->element;
+				key.cvertex = detection->fix->element(contact->element)->cvertices().distance(contact->cvertIt);
+			} else {
+				key.bumper = detection->fix;
+				key.bumperElement = contact->element;
+			}
+		}
+}
+
+ContactCache::Key::Key():
+	wedge(0),
+	bumper(0),
+	wedgeElement(0),
+	bumperElement(0),
+	cvertex(0)
+{
+}
+
+bool ContactCache::Key::operator ==(const Key & other) const
+{
+	return (wedge == other.wedge) && (bumper == other.bumper) && (wedgeElement == other.wedgeElement)
+			&& (bumperElement == other.bumperElement) && (cvertex == other.cvertex);
+}
+
+bool ContactCache::Key::operator <(const Key & other) const
+{
+	if (wedge != other.wedge)
+		return wedge < other.wedge;
+	if (bumper != other.bumper)
+		return bumper < other.bumper;
+	if (wedgeElement != other.wedgeElement)
+		return wedgeElement < other.wedgeElement;
+	if (bumperElement != other.bumperElement)
+		return bumperElement < other.bumperElement;
+	return cvertex < other.cvertex;
+}
+
+std::size_t ContactCache::KeyHash::operator()(const Key & key) const
+{
+	utils::hash<const ICFixed *> ptrHash;
+	std::size_t result = ptrHash(key.wedge);
+	result = result * 31u + ptrHash(key.bumper);
+	result = result * 31u + static_cast<std::size_t>(key.wedgeElement);
+	result = result * 31u + static_cast<std::size_t>(key.bumperElement);
+	result = result * 31u + key.cvertex;
+	return result;
+}
+
+}
+}
+}
+}
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
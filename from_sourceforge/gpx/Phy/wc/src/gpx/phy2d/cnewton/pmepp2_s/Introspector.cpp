@@ -1,5 +1,7 @@
 #include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/Introspector.hpp"
 
+#include <algorithm>
+
 namespace gpx {
 namespace phy2d {
 namespace cnewton {
@@ -9,7 +11,13 @@ const char * Introspector::DEFAULT_ERROR_MSG = "no error";
 
 Introspector::Introspector():
 	m_error(false),
-	m_errorMsg(DEFAULT_ERROR_MSG)
+	m_errorMsg(DEFAULT_ERROR_MSG),
+	m_circleTests(0),
+	m_circleRejections(0),
+	m_lcpSolves(0),
+	m_lcpIterations(0),
+	m_lcpNonConverged(0),
+	m_lcpMaxResidual(0.0)
 {
 }
 
@@ -59,6 +67,72 @@ void Introspector::playdown(const ICFixed & )
 {
 }
 
+void Introspector::circleTests(std::size_t tests, std::size_t rejections)
+{
+	m_circleTests += tests;
+	m_circleRejections += rejections;
+}
+
+std::size_t Introspector::circleTestCount() const
+{
+	return m_circleTests;
+}
+
+std::size_t Introspector::circleRejectionCount() const
+{
+	return m_circleRejections;
+}
+
+real_t Introspector::circleHitRate() const
+{
+	if (m_circleTests == 0)
+		return 0.0;
+	return static_cast<real_t>(m_circleRejections) / static_cast<real_t>(m_circleTests);
+}
+
+void Introspector::resetCircleStats()
+{
+	m_circleTests = 0;
+	m_circleRejections = 0;
+}
+
+void Introspector::lcpSolved(const Cluster & , std::size_t iterations, real_t residual, bool converged)
+{
+	m_lcpSolves++;
+	m_lcpIterations += iterations;
+	if (!converged)
+		m_lcpNonConverged++;
+	m_lcpMaxResidual = std::max(m_lcpMaxResidual, residual);
+}
+
+std::size_t Introspector::lcpSolveCount() const
+{
+	return m_lcpSolves;
+}
+
+std::size_t Introspector::lcpIterationCount() const
+{
+	return m_lcpIterations;
+}
+
+std::size_t Introspector::lcpNonConvergedCount() const
+{
+	return m_lcpNonConverged;
+}
+
+real_t Introspector::lcpMaxResidual() const
+{
+	return m_lcpMaxResidual;
+}
+
+void Introspector::resetLCPStats()
+{
+	m_lcpSolves = 0;
+	m_lcpIterations = 0;
+	m_lcpNonConverged = 0;
+	m_lcpMaxResidual = 0.0;
+}
+
 }
 }
 }
@@ -0,0 +1,175 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/IslandBuilder.hpp"
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/ClusterArena.hpp"
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/ICMovable.hpp"
+
+#include <algorithm>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+const std::size_t IslandBuilder::NO_BODY;
+const std::size_t IslandBuilder::NO_DETECTION;
+
+IslandBuilder::IslandBuilder()
+{
+}
+
+void IslandBuilder::clear()
+{
+	m_bodies.clear();
+	m_parents.clear();
+	m_ranks.clear();
+	m_touching.clear();
+	m_edges.clear();
+	m_contacts.clear();
+}
+
+std::size_t IslandBuilder::addBody(ICMovable * body)
+{
+	std::size_t index = m_bodies.size();
+	m_bodies.push_back(body);
+	m_parents.push_back(index);
+	m_ranks.push_back(0);
+	m_touching.push_back(false);
+	return index;
+}
+
+std::size_t IslandBuilder::bodies() const
+{
+	return m_bodies.size();
+}
+
+ICMovable * IslandBuilder::body(std::size_t index) const
+{
+	return m_bodies[index];
+}
+
+bool IslandBuilder::touching(std::size_t index) const
+{
+	return m_touching[index];
+}
+
+std::size_t IslandBuilder::find(std::size_t index)
+{
+	//path halving
+	while (m_parents[index] != index) {
+		m_parents[index] = m_parents[m_parents[index]];
+		index = m_parents[index];
+	}
+	return index;
+}
+
+bool IslandBuilder::join(std::size_t first, std::size_t second)
+{
+	first = find(first);
+	second = find(second);
+	if (first == second)
+		return false;
+
+	//union by rank
+	if (m_ranks[first] < m_ranks[second])
+		std::swap(first, second);
+	m_parents[second] = first;
+	if (m_ranks[first] == m_ranks[second])
+		m_ranks[first]++;
+	return true;
+}
+
+void IslandBuilder::addContacts(std::size_t first, const ContactDataContainer & firstContacts, std::size_t second, const ContactDataContainer & secondContacts)
+{
+	addEdge(first, firstContacts, second, 0, secondContacts);
+	m_touching[second] = true;
+	join(first, second);
+}
+
+void IslandBuilder::addContacts(std::size_t first, const ContactDataContainer & firstContacts, ICFixed & fix, const ContactDataContainer & fixContacts)
+{
+	addEdge(first, firstContacts, NO_BODY, & fix, fixContacts);
+}
+
+std::size_t IslandBuilder::edges() const
+{
+	return m_edges.size();
+}
+
+void IslandBuilder::buildClusters(real_t dt, ClusterArena & arena, ClustersContainer & clusters)
+{
+	m_islandClusters.assign(m_bodies.size(), 0);
+	m_detections.assign(m_bodies.size(), NO_DETECTION);
+	for (EdgesContainer::const_iterator edge = m_edges.begin(); edge != m_edges.end(); ++edge) {
+		std::size_t island = find(edge->first);
+		Cluster * cluster = m_islandClusters[island];
+		if (cluster == 0) {
+			cluster = arena.acquireCluster(dt);
+			m_islandClusters[island] = cluster;
+			clusters.push_back(cluster);
+		}
+
+		//detections have to be created before obtaining references, because container may reallocate
+		std::size_t firstDetection = bodyDetection(*cluster, edge->first, arena);
+		std::size_t secondDetection;
+		if (edge->fix)
+			secondDetection = PushDetection(*cluster, *edge->fix, 0, arena);
+		else
+			secondDetection = bodyDetection(*cluster, edge->second, arena);
+
+		ContactDataContainer::const_iterator firstBegin = m_contacts.begin() + edge->begin;
+		ContactDataContainer::const_iterator secondBegin = firstBegin + edge->count;
+		AppendContacts(cluster->detections[firstDetection].contacts, firstBegin, secondBegin, cluster->endIndex);
+		AppendContacts(cluster->detections[secondDetection].contacts, secondBegin, secondBegin + edge->count, cluster->endIndex);
+		cluster->endIndex += edge->count;
+	}
+}
+
+void IslandBuilder::addEdge(std::size_t first, const ContactDataContainer & firstContacts, std::size_t second, ICFixed * fix, const ContactDataContainer & secondContacts)
+{
+	GPX_ASSERT(firstContacts.size() == secondContacts.size(), "number of contacts should be equal for both objects");
+
+	std::size_t begin = m_contacts.size();
+	m_contacts.insert(m_contacts.end(), firstContacts.begin(), firstContacts.end());
+	m_contacts.insert(m_contacts.end(), secondContacts.begin(), secondContacts.end());
+	m_edges.push_back(Edge(first, second, fix, begin, firstContacts.size()));
+	m_touching[first] = true;
+}
+
+std::size_t IslandBuilder::bodyDetection(Cluster & cluster, std::size_t index, ClusterArena & arena)
+{
+	if (m_detections[index] == NO_DETECTION) {
+		m_detections[index] = PushDetection(cluster, *m_bodies[index], m_bodies[index], arena);
+		cluster.bodies.push_back(index);
+	}
+	return m_detections[index];
+}
+
+std::size_t IslandBuilder::PushDetection(Cluster & cluster, ICFixed & fix, ICMovable * mov, ClusterArena & arena)
+{
+	DetectionData detection(fix, mov, cluster);
+	arena.acquireContacts(detection.contacts);
+	ClusterArena::MoveDetection(cluster, detection);
+	return cluster.detections.size() - 1;
+}
+
+void IslandBuilder::AppendContacts(ContactDataContainer & contacts, ContactDataContainer::const_iterator begin, ContactDataContainer::const_iterator end, std::size_t offset)
+{
+	for (ContactDataContainer::const_iterator contact = begin; contact != end; ++contact) {
+		contacts.push_back(*contact);
+		contacts.back().index += offset;
+	}
+}
+
+}
+}
+}
+}
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
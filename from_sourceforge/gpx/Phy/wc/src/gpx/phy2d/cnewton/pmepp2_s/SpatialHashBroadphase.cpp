@@ -0,0 +1,272 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/SpatialHashBroadphase.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+const real_t SpatialHashBroadphase::AUTO_CELL_SIZE_MULT = 2.0;
+
+SpatialHashBroadphase::SpatialHashBroadphase(real_t cellSize):
+	m_cellSize(cellSize > 0.0 ? cellSize : 0.0)
+{
+}
+
+SpatialHashBroadphase::~SpatialHashBroadphase()
+{
+}
+
+real_t SpatialHashBroadphase::cellSize() const
+{
+	return m_cellSize;
+}
+
+void SpatialHashBroadphase::setCellSize(real_t cellSize)
+{
+	m_cellSize = cellSize > 0.0 ? cellSize : 0.0;
+	hashFixed();
+}
+
+void SpatialHashBroadphase::findPairs(ProxyPairsContainer & pairs)
+{
+	if (m_cellSize == 0.0) {
+		tune();
+		hashFixed();
+	}
+	unhashMovables();
+	hashMovables();
+
+	//hashed movables against objects sharing cells with them
+	for (ProxiesContainer::const_iterator proxy = m_hashedMovables.begin(); proxy != m_hashedMovables.end(); ++proxy) {
+		CellRange range;
+		cellRange(**proxy, range);
+		for (int x = range.minX; x <= range.maxX; x++)
+			for (int y = range.minY; y <= range.maxY; y++) {
+				CellKey key(x, y);
+				const Cell & cell = m_cells.find(key)->second;
+				for (ProxiesContainer::const_iterator other = cell.fixed.begin(); other != cell.fixed.end(); ++other)
+					if ((*proxy)->overlaps(**other) && reportCell(**proxy, **other, key))
+						pairs.push_back(ProxyPair(*proxy, *other));
+				for (ProxiesContainer::const_iterator other = cell.movables.begin(); other != cell.movables.end(); ++other)
+					if (((*proxy)->serial < (*other)->serial) && (*proxy)->overlaps(**other) && reportCell(**proxy, **other, key))
+						pairs.push_back(ProxyPair(*proxy, *other));
+			}
+	}
+
+	//objects, which are not hashed, against all other objects
+	for (ProxiesContainer::const_iterator proxy = m_globalMovables.begin(); proxy != m_globalMovables.end(); ++proxy) {
+		TestAll(*proxy, m_hashedFixed, pairs);
+		TestAll(*proxy, m_globalFixed, pairs);
+		TestAll(*proxy, m_hashedMovables, pairs);
+		for (ProxiesContainer::const_iterator other = proxy + 1; other != m_globalMovables.end(); ++other)
+			if ((*proxy)->overlaps(**other))
+				pairs.push_back(ProxyPair(*proxy, *other));
+	}
+	for (ProxiesContainer::const_iterator proxy = m_globalFixed.begin(); proxy != m_globalFixed.end(); ++proxy)
+		TestAll(*proxy, m_hashedMovables, pairs);
+}
+
+void SpatialHashBroadphase::proxyAdded(Proxy * proxy)
+{
+	if (proxy->mov)
+		m_movables.push_back(proxy);
+	else {
+		m_fixed.push_back(proxy);
+		hashFixed(proxy);
+	}
+}
+
+void SpatialHashBroadphase::proxyRemoved(Proxy * proxy)
+{
+	if (proxy->mov) {
+		m_movables.erase(std::find(m_movables.begin(), m_movables.end(), proxy));
+		//cells are cleared by unhashMovables(), but proxy must not be reachable from now on
+		unhashMovables();
+	} else {
+		unhashFixed(proxy);
+		m_fixed.erase(std::find(m_fixed.begin(), m_fixed.end(), proxy));
+	}
+}
+
+void SpatialHashBroadphase::tune()
+{
+	real_t sum = 0.0;
+	std::size_t count = 0;
+	for (ProxiesContainer::const_iterator proxy = m_movables.begin(); proxy != m_movables.end(); ++proxy) {
+		real_t r = (*proxy)->boundr;
+		if ((r > 0.0) && (r < std::numeric_limits<real_t>::infinity())) {
+			sum += r;
+			count++;
+		}
+	}
+	if (count > 0) {
+		m_cellSize = AUTO_CELL_SIZE_MULT * sum / static_cast<real_t>(count);
+		GPX_DEBUG("spatial hash cell size tuned to: " << m_cellSize);
+	}
+}
+
+void SpatialHashBroadphase::hashFixed()
+{
+	for (CellsContainer::iterator cell = m_cells.begin(); cell != m_cells.end(); )
+		if (cell->second.movables.empty())
+			m_cells.erase(cell++);
+		else {
+			cell->second.fixed.clear();
+			++cell;
+		}
+	m_hashedFixed.clear();
+	m_globalFixed.clear();
+	for (ProxiesContainer::const_iterator proxy = m_fixed.begin(); proxy != m_fixed.end(); ++proxy)
+		hashFixed(*proxy);
+}
+
+void SpatialHashBroadphase::hashFixed(Proxy * proxy)
+{
+	CellRange range;
+	if (!cellRange(*proxy, range)) {
+		m_globalFixed.push_back(proxy);
+		return;
+	}
+	for (int x = range.minX; x <= range.maxX; x++)
+		for (int y = range.minY; y <= range.maxY; y++)
+			m_cells[CellKey(x, y)].fixed.push_back(proxy);
+	m_hashedFixed.push_back(proxy);
+}
+
+void SpatialHashBroadphase::unhashFixed(Proxy * proxy)
+{
+	ProxiesContainer::iterator global = std::find(m_globalFixed.begin(), m_globalFixed.end(), proxy);
+	if (global != m_globalFixed.end()) {
+		m_globalFixed.erase(global);
+		return;
+	}
+	//bounds of fixed objects are not updated, so range is the same as during insertion
+	CellRange range;
+	cellRange(*proxy, range);
+	for (int x = range.minX; x <= range.maxX; x++)
+		for (int y = range.minY; y <= range.maxY; y++) {
+			CellsContainer::iterator cell = m_cells.find(CellKey(x, y));
+			cell->second.fixed.erase(std::find(cell->second.fixed.begin(), cell->second.fixed.end(), proxy));
+			if (cell->second.fixed.empty() && cell->second.movables.empty())
+				m_cells.erase(cell);
+		}
+	m_hashedFixed.erase(std::find(m_hashedFixed.begin(), m_hashedFixed.end(), proxy));
+}
+
+void SpatialHashBroadphase::hashMovables()
+{
+	for (ProxiesContainer::const_iterator proxy = m_movables.begin(); proxy != m_movables.end(); ++proxy) {
+		CellRange range;
+		if (!cellRange(**proxy, range)) {
+			m_globalMovables.push_back(*proxy);
+			continue;
+		}
+		for (int x = range.minX; x <= range.maxX; x++)
+			for (int y = range.minY; y <= range.maxY; y++) {
+				CellKey key(x, y);
+				Cell & cell = m_cells[key];
+				if (cell.movables.empty())
+					m_movableCells.push_back(key);
+				cell.movables.push_back(*proxy);
+			}
+		m_hashedMovables.push_back(*proxy);
+	}
+}
+
+void SpatialHashBroadphase::unhashMovables()
+{
+	for (CellKeysContainer::const_iterator key = m_movableCells.begin(); key != m_movableCells.end(); ++key) {
+		CellsContainer::iterator cell = m_cells.find(*key);
+		if (cell->second.fixed.empty())
+			m_cells.erase(cell);
+		else
+			cell->second.movables.clear();
+	}
+	m_movableCells.clear();
+	m_hashedMovables.clear();
+	m_globalMovables.clear();
+}
+
+bool SpatialHashBroadphase::cellRange(const Proxy & proxy, CellRange & range) const
+{
+	//limit keeps cell coordinates far away from integer overflow
+	static const real_t COORD_LIMIT = static_cast<real_t>(std::numeric_limits<int>::max() / 2);
+
+	if (m_cellSize == 0.0)
+		return false;
+
+	real_t minX = std::floor(proxy.min[0] / m_cellSize);
+	real_t minY = std::floor(proxy.min[1] / m_cellSize);
+	real_t maxX = std::floor(proxy.max[0] / m_cellSize);
+	real_t maxY = std::floor(proxy.max[1] / m_cellSize);
+	//negated conditions reject infinite bounds as well
+	if (!((minX > -COORD_LIMIT) && (minY > -COORD_LIMIT) && (maxX < COORD_LIMIT) && (maxY < COORD_LIMIT)))
+		return false;
+	if (!((maxX - minX + 1.0) * (maxY - minY + 1.0) <= static_cast<real_t>(MAX_CELLS_PER_OBJECT)))
+		return false;
+
+	range.minX = static_cast<int>(minX);
+	range.minY = static_cast<int>(minY);
+	range.maxX = static_cast<int>(maxX);
+	range.maxY = static_cast<int>(maxY);
+	return true;
+}
+
+SpatialHashBroadphase::CellKey SpatialHashBroadphase::cellKey(real_t x, real_t y) const
+{
+	return CellKey(static_cast<int>(std::floor(x / m_cellSize)), static_cast<int>(std::floor(y / m_cellSize)));
+}
+
+bool SpatialHashBroadphase::reportCell(const Proxy & first, const Proxy & second, const CellKey & key) const
+{
+	//pair is reported only by the cell containing minimal corner of boxes intersection
+	return cellKey(std::max(first.min[0], second.min[0]), std::max(first.min[1], second.min[1])) == key;
+}
+
+void SpatialHashBroadphase::TestAll(Proxy * proxy, const ProxiesContainer & proxies, ProxyPairsContainer & pairs)
+{
+	for (ProxiesContainer::const_iterator other = proxies.begin(); other != proxies.end(); ++other)
+		if (proxy->overlaps(**other))
+			pairs.push_back(ProxyPair(proxy, *other));
+}
+
+
+SpatialHashBroadphase::CellKey::CellKey(int p_x, int p_y):
+	x(p_x),
+	y(p_y)
+{
+}
+
+bool SpatialHashBroadphase::CellKey::operator ==(const CellKey & other) const
+{
+	return (x == other.x) && (y == other.y);
+}
+
+bool SpatialHashBroadphase::CellKey::operator <(const CellKey & other) const
+{
+	return (x < other.x) || ((x == other.x) && (y < other.y));
+}
+
+std::size_t SpatialHashBroadphase::CellKeyHash::operator()(const CellKey & key) const
+{
+	return (static_cast<std::size_t>(key.x) * 73856093u) ^ (static_cast<std::size_t>(key.y) * 19349663u);
+}
+
+}
+}
+}
+}
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -0,0 +1,164 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#include "../../../../../include/gpx/phy2d/cnewton/pmepp2_s/SweepAndPruneBroadphase.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace gpx {
+namespace phy2d {
+namespace cnewton {
+namespace pmepp2_s {
+
+SweepAndPruneBroadphase::SweepAndPruneBroadphase()
+{
+}
+
+SweepAndPruneBroadphase::~SweepAndPruneBroadphase()
+{
+}
+
+void SweepAndPruneBroadphase::findPairs(ProxyPairsContainer & pairs)
+{
+	sortEndpoints();
+
+	m_active.clear();
+	for (EndpointsContainer::const_iterator endpoint = m_endpoints.begin(); endpoint != m_endpoints.end(); ++endpoint) {
+		Proxy * proxy = endpoint->proxy;
+		if (endpoint->min) {
+			for (ProxiesContainer::const_iterator active = m_active.begin(); active != m_active.end(); ++active)
+				if (proxy->overlaps(**active))
+					pairs.push_back(ProxyPair(*active, proxy));
+			m_active.push_back(proxy);
+		} else {
+			ProxiesContainer::iterator active = std::find(m_active.begin(), m_active.end(), proxy);
+			*active = m_active.back();
+			m_active.pop_back();
+		}
+	}
+
+	for (ProxiesContainer::const_iterator mov = m_movables.begin(); mov != m_movables.end(); ++mov) {
+		FixedCollector collector(*mov, & pairs);
+		m_fixedTree.query((*mov)->min, (*mov)->max, collector);
+		for (ProxiesContainer::const_iterator fix = m_unboundedFixed.begin(); fix != m_unboundedFixed.end(); ++fix)
+			if ((*mov)->overlaps(**fix))
+				pairs.push_back(ProxyPair(*mov, *fix));
+	}
+}
+
+void SweepAndPruneBroadphase::proxyAdded(Proxy * proxy)
+{
+	if (proxy->mov) {
+		//new endpoints will be moved to their places by sortEndpoints()
+		m_endpoints.push_back(Endpoint(proxy, true));
+		m_endpoints.push_back(Endpoint(proxy, false));
+		m_movables.push_back(proxy);
+	} else
+		insertFixed(proxy);
+}
+
+void SweepAndPruneBroadphase::proxyRemoved(Proxy * proxy)
+{
+	if (proxy->mov) {
+		EndpointsContainer::iterator end = m_endpoints.begin();
+		for (EndpointsContainer::iterator endpoint = m_endpoints.begin(); endpoint != m_endpoints.end(); ++endpoint)
+			if (endpoint->proxy != proxy)
+				*end++ = *endpoint;
+		m_endpoints.erase(end, m_endpoints.end());
+		m_movables.erase(std::find(m_movables.begin(), m_movables.end(), proxy));
+	} else
+		removeFixed(proxy);
+}
+
+void SweepAndPruneBroadphase::proxyRefit(Proxy * proxy)
+{
+	FixedNodesContainer::iterator node = m_fixedNodes.find(proxy);
+	updateBounds(*proxy);
+	if ((node != m_fixedNodes.end()) && Bounded(*proxy))
+		m_fixedTree.refit(node->second, proxy->min, proxy->max);
+	else {
+		removeFixed(proxy);
+		insertFixed(proxy);
+	}
+}
+
+bool SweepAndPruneBroadphase::Bounded(const Proxy & proxy)
+{
+	//comparisons with NaN are false, so NaNs are treated as unbounded
+	return (proxy.max[0] - proxy.min[0] < std::numeric_limits<real_t>::infinity())
+			&& (proxy.max[1] - proxy.min[1] < std::numeric_limits<real_t>::infinity());
+}
+
+void SweepAndPruneBroadphase::sortEndpoints()
+{
+	for (EndpointsContainer::iterator endpoint = m_endpoints.begin(); endpoint != m_endpoints.end(); ++endpoint)
+		endpoint->value = endpoint->min ? endpoint->proxy->min[0] : endpoint->proxy->max[0];
+
+	//insertion sort; endpoints are almost sorted due to temporal coherence
+	for (std::size_t i = 1; i < m_endpoints.size(); i++) {
+		Endpoint key = m_endpoints[i];
+		std::size_t j = i;
+		for (; (j > 0) && (key < m_endpoints[j - 1]); j--)
+			m_endpoints[j] = m_endpoints[j - 1];
+		m_endpoints[j] = key;
+	}
+}
+
+void SweepAndPruneBroadphase::insertFixed(Proxy * proxy)
+{
+	if (Bounded(*proxy))
+		m_fixedNodes[proxy] = m_fixedTree.insert(proxy->min, proxy->max, proxy);
+	else
+		m_unboundedFixed.push_back(proxy);
+}
+
+void SweepAndPruneBroadphase::removeFixed(Proxy * proxy)
+{
+	FixedNodesContainer::iterator node = m_fixedNodes.find(proxy);
+	if (node != m_fixedNodes.end()) {
+		m_fixedTree.remove(node->second);
+		m_fixedNodes.erase(node);
+	} else
+		m_unboundedFixed.erase(std::find(m_unboundedFixed.begin(), m_unboundedFixed.end(), proxy));
+}
+
+
+SweepAndPruneBroadphase::Endpoint::Endpoint(Proxy * p_proxy, bool p_min):
+	value(p_min ? p_proxy->min[0] : p_proxy->max[0]),
+	proxy(p_proxy),
+	min(p_min)
+{
+}
+
+bool SweepAndPruneBroadphase::Endpoint::operator <(const Endpoint & other) const
+{
+	if (value != other.value)
+		return value < other.value;
+	return min && !other.min;
+}
+
+
+SweepAndPruneBroadphase::FixedCollector::FixedCollector(Proxy * p_mov, ProxyPairsContainer * p_pairs):
+	mov(p_mov),
+	pairs(p_pairs)
+{
+}
+
+void SweepAndPruneBroadphase::FixedCollector::operator()(Proxy * fix)
+{
+	//leaf boxes are the same as proxy bounds, so no further test is required
+	pairs->push_back(ProxyPair(mov, fix));
+}
+
+}
+}
+}
+}
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -2,6 +2,9 @@ TARGET = libgpx-phy
 TEMPLATE = lib
 CONFIG -= qt
 CONFIG += object_parallel_to_source
+QMAKE_CXXFLAGS += -std=c++11
+unix: QMAKE_CXXFLAGS += -pthread
+unix: LIBS += -pthread
 
 DEFINES += GPX_BUILD
 
@@ -16,6 +19,10 @@ CONFIG += shared
 INCLUDEPATH += $$PWD/../../X/wc/include
 DEPENDPATH += $$PWD/../../X/wc/include
 
+#Eigen (required by eigen math backend only)
+INCLUDEPATH += $$PWD/../../../Eigen/include
+DEPENDPATH += $$PWD/../../../Eigen/include
+
 SOURCES += \
     src/gpx/phy/NewtonFrictionTable.cpp \
     src/gpx/phy/NewtonPlasticityTable.cpp \
@@ -24,18 +31,26 @@ SOURCES += \
     src/gpx/phy2d/cnewton/pmepp2_s/ACoefsMapper.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/BasicExecutor.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/BCoefsMapper.cpp \
+    src/gpx/phy2d/cnewton/pmepp2_s/Broadphase.cpp \
+    src/gpx/phy2d/cnewton/pmepp2_s/BruteForceBroadphase.cpp \
+    src/gpx/phy2d/cnewton/pmepp2_s/ClusterArena.cpp \
+    src/gpx/phy2d/cnewton/pmepp2_s/ContactCache.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/CMaterialBody.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/Collider.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/CRigidBody.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/DetectionDataContainer.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/FixedWrapper.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/Introspector.cpp \
+    src/gpx/phy2d/cnewton/pmepp2_s/IslandBuilder.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/MovableWrapper.cpp \
     src/gpx/phy2d/cnewton/pmepp2_s/PassiveWrapper.cpp \
+    src/gpx/phy2d/cnewton/pmepp2_s/SpatialHashBroadphase.cpp \
+    src/gpx/phy2d/cnewton/pmepp2_s/SweepAndPruneBroadphase.cpp \
     src/gpx/phy2d/MaterialBody.cpp \
     src/gpx/phy2d/MovableObject.cpp \
     src/gpx/phy2d/PhyObject.cpp \
     src/gpx/phy2d/RigidBody.cpp \
+    src/gpx/phy2d/RigidTransform.cpp \
     src/gpx/phy2d/StaticObject.cpp
 
 HEADERS += \
@@ -50,10 +65,15 @@ HEADERS += \
     include/gpx/phy2d/cdetect/interseg/CPoly.hpp \
     include/gpx/phy2d/cdetect/interseg/ICPoly.hpp \
     include/gpx/phy2d/cdetect/interseg/ICPolyGroup.hpp \
+    include/gpx/phy2d/cnewton/pmepp2_s/AABBTree.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/ACoefsMapper.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/BasicExecutor.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/BCoefsMapper.hpp \
+    include/gpx/phy2d/cnewton/pmepp2_s/Broadphase.hpp \
+    include/gpx/phy2d/cnewton/pmepp2_s/BruteForceBroadphase.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/Cluster.hpp \
+    include/gpx/phy2d/cnewton/pmepp2_s/ClusterArena.hpp \
+    include/gpx/phy2d/cnewton/pmepp2_s/ContactCache.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/CMaterialBody.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/Collider.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/CRigidBody.hpp \
@@ -62,12 +82,16 @@ HEADERS += \
     include/gpx/phy2d/cnewton/pmepp2_s/ICFixed.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/ICMovable.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/Introspector.hpp \
+    include/gpx/phy2d/cnewton/pmepp2_s/IslandBuilder.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/MovableWrapper.hpp \
     include/gpx/phy2d/cnewton/pmepp2_s/PassiveWrapper.hpp \
+    include/gpx/phy2d/cnewton/pmepp2_s/SpatialHashBroadphase.hpp \
+    include/gpx/phy2d/cnewton/pmepp2_s/SweepAndPruneBroadphase.hpp \
     include/gpx/phy2d/MaterialBody.hpp \
     include/gpx/phy2d/MovableObject.hpp \
     include/gpx/phy2d/PhyObject.hpp \
     include/gpx/phy2d/RigidBody.hpp \
+    include/gpx/phy2d/RigidTransform.hpp \
     include/gpx/phy2d/StaticObject.hpp \
     include/gpx/phy_config.hpp \
     include/gpx/phy_version.hpp \
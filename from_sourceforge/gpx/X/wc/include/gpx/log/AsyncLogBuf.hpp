@@ -0,0 +1,385 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_LOG_ASYNCLOGBUF_HPP_
+#define GPX_X_LOG_ASYNCLOGBUF_HPP_
+
+#include "Log.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+/**
+ * Log initialization function. Attaches combined stream to std::cout through
+ * asynchronous buffer (see gpx::log::AsyncLogBuf).
+ * @param Log log instance.
+ */
+void gpx_log_initFuncAsyncCout(gpx::log::Log * log);
+
+namespace gpx {
+namespace log {
+
+/**
+ * Asynchronous log buffer. Characters are collected into records, which are put into
+ * bounded ring buffer and written to attached buffers by background thread. Record is
+ * completed on sync (e.g. std::endl) or when it exceeds RECORD_SIZE characters. Thus
+ * writing to the log costs a copy of formatted message, while slow devices (files,
+ * console) are served by drain thread.
+ *
+ * Ring buffer is lock-free single producer, single consumer queue. Like other log
+ * buffers, AsyncLogBuf must not be written by multiple threads simultaneously. When the
+ * queue is full, record is either dropped or producer waits for free slot, depending on
+ * overflow policy.
+ *
+ * To route log output through asynchronous buffer attach it to one of Log streams
+ * (e.g. combined stream) and attach physical devices to asynchronous buffer:
+ * @code
+ * static gpx::log::AsyncLogBuf asyncBuf;
+ * asyncBuf.attachStream(file);
+ * gpx::log::Log::Instance().combinedStream().attachBuffer(& asyncBuf);
+ * @endcode
+ *
+ * Records queued so far are written out by flush(). Log::flush() reaches asynchronous
+ * buffers attached to Log streams, so GPX_FATAL and GPX_CRITICAL messages are not lost.
+ */
+class AsyncLogBuf: public LogBuf
+{
+	public:
+		static const std::size_t RECORD_SIZE = 256;			///< Maximal number of characters in single record.
+		static const std::size_t DEFAULT_CAPACITY = 1024;	///< Default number of records in ring buffer.
+
+		enum OverflowPolicy {
+			DROP,	///< Drop record if ring buffer is full.
+			BLOCK	///< Wait until drain thread frees a slot.
+		};
+
+	public:
+		/**
+		 * Constructor. Starts drain thread.
+		 * @param capacity number of records, which can be queued. Rounded up to power of 2.
+		 * @param overflowPolicy overflow policy.
+		 */
+		AsyncLogBuf(std::size_t capacity = DEFAULT_CAPACITY, OverflowPolicy overflowPolicy = DROP);
+
+		/**
+		 * Destructor. Writes out queued records and stops drain thread.
+		 */
+		virtual ~AsyncLogBuf();
+
+	public:
+		/**
+		 * Get ring buffer capacity.
+		 * @return number of records, which can be queued.
+		 */
+		std::size_t capacity() const;
+
+		/**
+		 * Get overflow policy.
+		 * @return overflow policy.
+		 */
+		OverflowPolicy overflowPolicy() const;
+
+		/**
+		 * Set overflow policy.
+		 * @param overflowPolicy overflow policy.
+		 */
+		void setOverflowPolicy(OverflowPolicy overflowPolicy);
+
+		/**
+		 * Get number of dropped records.
+		 * @return number of records dropped due to full ring buffer.
+		 */
+		std::size_t droppedCount() const;
+
+		/**
+		 * Attach buffer. Attached buffers are written by drain thread.
+		 * @param buf pointer to std::streambuf object.
+		 */
+		void attachBuffer(std::streambuf * buf);
+
+		/**
+		 * Detach buffer.
+		 * @param buf pointer to std::streambuf object.
+		 */
+		void detachBuffer(std::streambuf * buf);
+
+		/**
+		 * Attach stream 's buffer. Defined for convenience.
+		 * @param stream stream to attach.
+		 */
+		void attachStream(std::ostream & stream);
+
+		/**
+		 * Detach stream 's buffer.
+		 * @param stream stream to detach.
+		 */
+		void detachStream(std::ostream & stream);
+
+		/**
+		 * Flush buffer. Current record is queued and function waits until drain thread
+		 * writes all queued records and flushes attached buffers.
+		 */
+		virtual void flush();
+
+	protected:
+		//std::streambuf
+		virtual int sync();
+
+		//std::streambuf
+		virtual int_type overflow(int_type c);
+
+		//std::streambuf
+		virtual std::streamsize xsputn(const char_type * s, std::streamsize n);
+
+	private:
+		struct Record
+		{
+			std::size_t size;
+			char data[RECORD_SIZE];
+		};
+
+	private:
+		void commit();
+
+		void push(const char * data, std::size_t size);
+
+		void drain();
+
+		void wake();
+
+	private:
+		std::size_t m_mask;
+		Record * m_records;
+		char m_record[RECORD_SIZE];
+		std::atomic<std::size_t> m_head;	//written by producer
+		std::atomic<std::size_t> m_tail;	//written by drain thread
+		std::atomic<int> m_overflowPolicy;
+		std::atomic<std::size_t> m_dropped;
+		std::atomic<bool> m_sleeping;
+		std::mutex m_mutex;
+		std::mutex m_bufsMutex;
+		std::condition_variable m_drainCond;
+		std::condition_variable m_flushCond;
+		std::size_t m_flushed;	//guarded by m_mutex
+		bool m_stop;			//guarded by m_mutex
+		std::thread m_thread;
+};
+
+
+inline
+AsyncLogBuf::AsyncLogBuf(std::size_t capacity, OverflowPolicy overflowPolicy):
+	m_mask(0),
+	m_records(0),
+	m_head(0),
+	m_tail(0),
+	m_overflowPolicy(overflowPolicy),
+	m_dropped(0),
+	m_sleeping(false),
+	m_flushed(0),
+	m_stop(false)
+{
+	std::size_t size = 1;
+	while (size < capacity)
+		size <<= 1;
+	m_mask = size - 1;
+	m_records = new Record[size];
+	setp(m_record, m_record + RECORD_SIZE);
+	m_thread = std::thread(& AsyncLogBuf::drain, this);
+}
+
+inline
+AsyncLogBuf::~AsyncLogBuf()
+{
+	commit();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+		m_drainCond.notify_one();
+	}
+	m_thread.join();
+	delete[] m_records;
+}
+
+inline
+std::size_t AsyncLogBuf::capacity() const
+{
+	return m_mask + 1;
+}
+
+inline
+AsyncLogBuf::OverflowPolicy AsyncLogBuf::overflowPolicy() const
+{
+	return static_cast<OverflowPolicy>(m_overflowPolicy.load(std::memory_order_relaxed));
+}
+
+inline
+void AsyncLogBuf::setOverflowPolicy(OverflowPolicy overflowPolicy)
+{
+	m_overflowPolicy.store(overflowPolicy, std::memory_order_relaxed);
+}
+
+inline
+std::size_t AsyncLogBuf::droppedCount() const
+{
+	return m_dropped.load(std::memory_order_relaxed);
+}
+
+inline
+void AsyncLogBuf::attachBuffer(std::streambuf * buf)
+{
+	std::lock_guard<std::mutex> lock(m_bufsMutex);
+	LogBuf::attachBuffer(buf);
+}
+
+inline
+void AsyncLogBuf::detachBuffer(std::streambuf * buf)
+{
+	std::lock_guard<std::mutex> lock(m_bufsMutex);
+	LogBuf::detachBuffer(buf);
+}
+
+inline
+void AsyncLogBuf::attachStream(std::ostream & stream)
+{
+	attachBuffer(stream.rdbuf());
+}
+
+inline
+void AsyncLogBuf::detachStream(std::ostream & stream)
+{
+	detachBuffer(stream.rdbuf());
+}
+
+inline
+void AsyncLogBuf::flush()
+{
+	commit();
+	std::size_t target = m_head.load();
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_sleeping = false;
+	m_drainCond.notify_one();
+	while (m_flushed < target)
+		m_flushCond.wait(lock);
+}
+
+inline
+int AsyncLogBuf::sync()
+{
+	commit();
+	return 0;
+}
+
+inline
+AsyncLogBuf::int_type AsyncLogBuf::overflow(int_type c)
+{
+	commit();
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+inline
+std::streamsize AsyncLogBuf::xsputn(const char_type * s, std::streamsize n)
+{
+	//put area is used here, so bypass LogBuf implementation, which writes attached buffers directly
+	return std::streambuf::xsputn(s, n);
+}
+
+inline
+void AsyncLogBuf::commit()
+{
+	std::size_t size = static_cast<std::size_t>(pptr() - pbase());
+	if (size > 0)
+		push(pbase(), size);
+	setp(m_record, m_record + RECORD_SIZE);
+}
+
+inline
+void AsyncLogBuf::push(const char * data, std::size_t size)
+{
+	std::size_t head = m_head.load(std::memory_order_relaxed);
+	while (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+		if (overflowPolicy() == DROP) {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		wake();
+		std::this_thread::yield();
+	}
+	Record & record = m_records[head & m_mask];
+	std::memcpy(record.data, data, size);
+	record.size = size;
+	m_head.store(head + 1);
+	wake();
+}
+
+inline
+void AsyncLogBuf::wake()
+{
+	//drain thread sets the flag before it checks for new records, so either it sees the record or we see the flag
+	if (m_sleeping.load() && m_sleeping.exchange(false)) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_drainCond.notify_one();
+	}
+}
+
+inline
+void AsyncLogBuf::drain()
+{
+	std::size_t tail = m_tail.load(std::memory_order_relaxed);
+	bool written = false;
+	for (;;) {
+		std::size_t head = m_head.load(std::memory_order_acquire);
+		if (tail != head) {
+			std::lock_guard<std::mutex> bufsLock(m_bufsMutex);
+			for (; tail != head; tail++) {
+				const Record & record = m_records[tail & m_mask];
+				LogBuf::xsputn(record.data, static_cast<std::streamsize>(record.size));
+				m_tail.store(tail + 1, std::memory_order_release);
+			}
+			written = true;
+			continue;
+		}
+
+		if (written) {
+			std::lock_guard<std::mutex> bufsLock(m_bufsMutex);
+			LogBuf::flush();
+			written = false;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_flushed = tail;
+		m_flushCond.notify_all();
+		m_sleeping = true;
+		while (m_sleeping && !m_stop && m_head.load() == tail)
+			m_drainCond.wait(lock);
+		m_sleeping = false;
+		if (m_stop && m_head.load() == tail)
+			break;
+	}
+}
+
+}
+}
+
+inline
+void gpx_log_initFuncAsyncCout(gpx::log::Log * log)
+{
+	static gpx::log::AsyncLogBuf asyncBuf;
+	asyncBuf.attachStream(std::cout);
+	log->combinedStream().attachBuffer(& asyncBuf);
+}
+
+#endif /* GPX_X_LOG_ASYNCLOGBUF_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -9,8 +9,39 @@
 #include "../utils/NonCopyable.hpp"
 #include "LogStream.hpp"
 
+#include <mutex>
+#include <string>
+
 namespace gpx { namespace log { class Log; }}
 
+/*
+ * Log levels. Messages are ordered by their importance, from the least important
+ * trace messages to fatal and critical errors. Info messages share level with notes.
+ */
+#define GPX_LOG_LEVEL_TRACE 0		///< Trace level (GPX_TRACE).
+#define GPX_LOG_LEVEL_DEBUG 1		///< Debug level (GPX_DEBUG).
+#define GPX_LOG_LEVEL_NOTE 2		///< Note level (GPX_NOTE).
+#define GPX_LOG_LEVEL_INFO 2		///< Info level (GPX_INFO).
+#define GPX_LOG_LEVEL_WARN 3		///< Warning level (GPX_WARN).
+#define GPX_LOG_LEVEL_FATAL 4		///< Fatal error level (GPX_FATAL).
+#define GPX_LOG_LEVEL_CRITICAL 4	///< Critical error level (GPX_CRITICAL).
+#define GPX_LOG_LEVEL_NONE 5		///< Level above all other levels.
+
+/**
+ * Compile-time log level. Logging macros of lower level compile to nothing, thus their
+ * expressions are not even evaluated. Messages of fatal and critical errors are stripped
+ * as well, but GPX_FATAL and GPX_CRITICAL still terminate the program. By default debug
+ * level is used, or note level if NDEBUG is defined. Trace level must be requested
+ * explicitly.
+ */
+#ifndef GPX_LOG_LEVEL
+	#ifdef NDEBUG
+		#define GPX_LOG_LEVEL GPX_LOG_LEVEL_NOTE
+	#else
+		#define GPX_LOG_LEVEL GPX_LOG_LEVEL_DEBUG
+	#endif /* NDEBUG */
+#endif /* GPX_LOG_LEVEL */
+
 /**
  * Log initialization function. No stream is being attached.
  * @param Log log instance.
@@ -50,9 +81,9 @@ namespace log {
  * Log. Main class of GPX log facility.
  *
  * This class is a singleton and can not be instantiated directly. To obtain instance
- * use Instance() function. For convenient usage of this class six macros are defined,
- * in separate header, for logging purposes (GPX_DEBUG, GPX_NOTE, GPX_WARN, GPX_FATAL,
- * GPX_CRITICAL, GPX_INFO).
+ * use Instance() function. For convenient usage of this class seven macros are defined,
+ * in separate header, for logging purposes (GPX_TRACE, GPX_DEBUG, GPX_NOTE, GPX_WARN,
+ * GPX_FATAL, GPX_CRITICAL, GPX_INFO).
  *
  * Log class defines six streams which are instances of LogStream class. Each of them
  * may be attached to any number of other streams. For example, to bring debug output
@@ -70,6 +101,17 @@ namespace log {
  * Combined stream is already attached to six previously described streams. By attaching
  * std::cout to combined stream, all six streams will put the output, through combined
  * stream, to std::cout. Default attachment of streams is defined by GPX_LOG_INIT macro.
+ *
+ * Trace stream is a dedicated channel for verbose diagnostic dumps (e.g. matrices
+ * of solvers), used by GPX_TRACE macro. Obtain it by calling traceStream(). Trace
+ * stream is not attached to combined stream, so it has to be attached explicitly.
+ *
+ * Apart from compile-time level (GPX_LOG_LEVEL), messages are filtered by runtime
+ * level (see setLevel()). Messages of lower level are not formatted at all.
+ *
+ * Logging macros hold Log::Lock while message is being formatted, so that messages
+ * logged by different threads do not interleave. Code writing to Log streams directly
+ * should do the same.
  */
 class Log : utils::NonCopyable
 {
@@ -81,6 +123,60 @@ class Log : utils::NonCopyable
 		static Log & Instance();
 
 	public:
+		typedef int level_t;	///< Log level (one of GPX_LOG_LEVEL_* values).
+
+		/**
+		 * Log lock. Locks the log for the lifetime of the object. Lock is recursive,
+		 * so messages may be logged while formatting other message.
+		 */
+		class Lock : utils::NonCopyable
+		{
+			public:
+				/**
+				 * Constructor.
+				 * @param log log to lock.
+				 */
+				explicit Lock(Log & log);
+
+				/**
+				 * Destructor. Unlocks the log.
+				 */
+				~Lock();
+
+			private:
+				Log & m_log;
+		};
+
+	public:
+		/**
+		 * Get runtime level.
+		 * @return runtime level.
+		 */
+		level_t level() const;
+
+		/**
+		 * Set runtime level. Messages of lower level are discarded by logging macros.
+		 * Initially level is set to GPX_LOG_LEVEL_TRACE, so that only compile-time
+		 * level applies.
+		 * @param level new runtime level.
+		 */
+		void setLevel(level_t level);
+
+		/**
+		 * Check whether messages of given level pass runtime filter.
+		 * @param level level of messages.
+		 * @return @p true if messages of given level are accepted, @p false otherwise.
+		 */
+		bool enabled(level_t level) const;
+
+		/**
+		 * Get trace stream.
+		 * @return trace stream.
+		 *
+		 * @see GPX_TRACE.
+		 */
+		LogStream & traceStream();
+
 		/**
 		 * Get debug stream.
 		 * @return debug stream.
@@ -136,7 +232,7 @@ class Log : utils::NonCopyable
 		LogStream & combinedStream();
 
 		/**
-		 * Attach log. Attaches respectively six streams (without combined) of other log to
+		 * Attach log. Attaches respectively seven streams (without combined) of other log to
 		 * streams of this log.
 		 * @param other other log.
 		 *
@@ -147,7 +243,7 @@ class Log : utils::NonCopyable
 		void attachLog(Log & other);
 
 		/**
-		 * Detach log. Detaches respectively six streams (without combined) of other log
+		 * Detach log. Detaches respectively seven streams (without combined) of other log
 		 * from streams of this log.
 		 * @param other other log.
 		 *
@@ -155,6 +251,23 @@ class Log : utils::NonCopyable
 		 */
 		void detachLog(Log & other);
 
+		/**
+		 * Write message to a stream. Log is locked only while message is being written.
+		 * @param stream one of Log streams.
+		 * @param message formatted message.
+		 *
+		 * @see GPX_LOG_TERMINAL_MESSAGE.
+		 */
+		void write(LogStream & stream, const std::string & message);
+
+		/**
+		 * Flush all streams. Function returns after messages written so far have reached
+		 * their destination, including messages queued by asynchronous buffers
+		 * (see AsyncLogBuf). Called by GPX_FATAL and GPX_CRITICAL before program
+		 * termination.
+		 */
+		void flush();
+
 	private:
 		/**
 		 * Default constructor. This class is a singleton and can not be instantiated
@@ -163,7 +276,10 @@ class Log : utils::NonCopyable
 		Log();
 
 	private:
+		std::recursive_mutex m_mutex;
+		level_t m_level;
 		LogStream m_combinedStream;
+		LogStream m_traceStream;
 		LogStream m_debugStream;
 		LogStream m_noteStream;
 		LogStream m_warnStream;
@@ -179,6 +295,43 @@ Log & Log::Instance()
 	return instance;
 }
 
+inline
+Log::Lock::Lock(Log & log):
+	m_log(log)
+{
+	m_log.m_mutex.lock();
+}
+
+inline
+Log::Lock::~Lock()
+{
+	m_log.m_mutex.unlock();
+}
+
+inline
+Log::level_t Log::level() const
+{
+	return m_level;
+}
+
+inline
+void Log::setLevel(level_t level)
+{
+	m_level = level;
+}
+
+inline
+bool Log::enabled(level_t level) const
+{
+	return level >= m_level;
+}
+
+inline
+LogStream & Log::traceStream()
+{
+	return m_traceStream;
+}
+
 inline
 LogStream & Log::debugStream()
 {
@@ -224,6 +377,7 @@ LogStream & Log::combinedStream()
 inline
 void Log::attachLog(Log & other)
 {
+	m_traceStream.attachStream(other.traceStream());
 	m_debugStream.attachStream(other.debugStream());
 	m_noteStream.attachStream(other.noteStream());
 	m_warnStream.attachStream(other.warnStream());
@@ -235,6 +389,7 @@ void Log::attachLog(Log & other)
 inline
 void Log::detachLog(Log & other)
 {
+	m_traceStream.detachStream(other.traceStream());
 	m_debugStream.detachStream(other.debugStream());
 	m_noteStream.detachStream(other.noteStream());
 	m_warnStream.detachStream(other.warnStream());
@@ -244,7 +399,28 @@ void Log::detachLog(Log & other)
 }
 
 inline
-Log::Log()
+void Log::write(LogStream & stream, const std::string & message)
+{
+	Lock lock(*this);
+	stream << message;
+}
+
+inline
+void Log::flush()
+{
+	m_traceStream.rdbuf()->flush();
+	m_debugStream.rdbuf()->flush();
+	m_noteStream.rdbuf()->flush();
+	m_warnStream.rdbuf()->flush();
+	m_fatalStream.rdbuf()->flush();
+	m_criticalStream.rdbuf()->flush();
+	m_infoStream.rdbuf()->flush();
+	m_combinedStream.rdbuf()->flush();
+}
+
+inline
+Log::Log():
+	m_level(GPX_LOG_LEVEL_TRACE)
 {
 	m_debugStream.attachStream(m_combinedStream);
 	m_noteStream.attachStream(m_combinedStream);
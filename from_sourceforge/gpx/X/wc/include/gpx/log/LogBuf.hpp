@@ -45,6 +45,15 @@ class LogBuf: public std::streambuf
 		 */
 		void detachStream(std::ostream & stream);
 
+		/**
+		 * Flush buffer. Unlike pubsync(), which only forces attached buffers to sync,
+		 * this function returns after all the characters have reached their destination.
+		 * Attached log buffers are flushed recursively.
+		 *
+		 * @see AsyncLogBuf.
+		 */
+		virtual void flush();
+
 	protected:
 		typedef std::list<std::streambuf *> BufsContainer;
 
@@ -101,6 +110,18 @@ void LogBuf::detachStream(std::ostream & stream)
 	detachBuffer(stream.rdbuf());
 }
 
+inline
+void LogBuf::flush()
+{
+	for (BufsContainer::iterator i = m_bufs.begin(); i != m_bufs.end(); ++i) {
+		LogBuf * logBuf = dynamic_cast<LogBuf *>(*i);
+		if (logBuf)
+			logBuf->flush();
+		else
+			(*i)->pubsync();
+	}
+}
+
 inline
 LogBuf::BufsContainer & LogBuf::bufs()
 {
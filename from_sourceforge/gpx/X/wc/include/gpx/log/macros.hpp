@@ -8,25 +8,64 @@
 
 #include "Log.hpp"
 
+#include <sstream>
+
 #ifdef GPX_NO_LOG			///< Turns off all logging macros except of GPX_FATAL, GPX_CRITICAL and GPX_INFO.
 	#define GPX_NO_DEBUG	///< Turns off GPX_DEBUG macro.
 	#define GPX_NO_NOTE		///< Turns off GPX_NOTE macro.
 	#define GPX_NO_WARN		///< Turns off GPX_WARN macro.
+	#define GPX_NO_TRACE	///< Turns off GPX_TRACE macro.
 #endif /*GPX_NO_LOG*/
 
 /** @TODO this is rather temporary macro. Shall be replaced by manipulators */
 #define GPX_LOG_FLF " (file: " << __FILE__ << " line: " << __LINE__ << " function: " << __FUNCTION__ << ")"
 
+/**
+ * Log message of given level, if it passes runtime filter. Log is locked until the end
+ * of full expression.
+ * @param LEVEL level of message.
+ * @param STREAM_FUNC name of Log function returning target stream.
+ * @param EXPR expression injected into LogStream object.
+ */
+#define GPX_LOG_MESSAGE(LEVEL, STREAM_FUNC, EXPR) (::gpx::log::Log::Instance().enabled(LEVEL) ? (void)(::gpx::log::Log::Lock(::gpx::log::Log::Instance()), ::gpx::log::Log::Instance().STREAM_FUNC() << EXPR) : (void)0)
+
+/**
+ * Log message of given level, which is followed by program termination. Message is
+ * formatted without holding the lock and Log is locked only while message is being written
+ * (see Log::write()). Lock is thus released before Log is flushed and program terminates,
+ * so that threads logging during shutdown do not deadlock.
+ * @param LEVEL level of message.
+ * @param STREAM_FUNC name of Log function returning target stream.
+ * @param EXPR expression injected into std::ostringstream object.
+ */
+#define GPX_LOG_TERMINAL_MESSAGE(LEVEL, STREAM_FUNC, EXPR) (::gpx::log::Log::Instance().enabled(LEVEL) ? ::gpx::log::Log::Instance().write(::gpx::log::Log::Instance().STREAM_FUNC(), static_cast<std::ostringstream &>(std::ostringstream() << EXPR).str()) : (void)0)
+
+/**
+ * Trace message. Dedicated to verbose diagnostic dumps (e.g. intermediate matrices of
+ * solvers), which are too expensive to be formatted even in debug builds. Messages go
+ * to trace stream. Macro is compiled only if GPX_LOG_LEVEL is set to GPX_LOG_LEVEL_TRACE
+ * and GPX_NO_TRACE is not defined.
+ * @param EXPR expression containing trace message. Expression is injected into LogStream
+ * object thus standard ostream syntax may be used.
+ * @return (void)0.
+ */
+#if !defined(GPX_NO_TRACE) && GPX_LOG_LEVEL <= GPX_LOG_LEVEL_TRACE
+	#define GPX_TRACE(EXPR) GPX_LOG_MESSAGE(GPX_LOG_LEVEL_TRACE, traceStream, EXPR << std::endl)
+#else
+	#define GPX_TRACE(EXPR) (void)0
+#endif /*GPX_NO_TRACE*/
+
 /**
  * Debug message. This kind of messages are intended to be utilized during development.
  * This macro should be turned off for releases. It can be turned off by defining
- * GPX_NO_DEBUG before including this file.
+ * GPX_NO_DEBUG before including this file or by setting GPX_LOG_LEVEL above
+ * GPX_LOG_LEVEL_DEBUG.
  * @param EXPR expression containing debug message. Expression is injected into LogStream
  * object thus standard ostream syntax may be used.
- * @return reference to LogStream object or (void)0.
+ * @return (void)0.
  */
-#ifndef GPX_NO_DEBUG
-	#define GPX_DEBUG(EXPR) ::gpx::log::Log::Instance().debugStream() << "Debug message: " << EXPR << GPX_LOG_FLF << std::endl
+#if !defined(GPX_NO_DEBUG) && GPX_LOG_LEVEL <= GPX_LOG_LEVEL_DEBUG
+	#define GPX_DEBUG(EXPR) GPX_LOG_MESSAGE(GPX_LOG_LEVEL_DEBUG, debugStream, "Debug message: " << EXPR << GPX_LOG_FLF << std::endl)
 #else
 	#define GPX_DEBUG(EXPR) (void)0
 #endif /*GPX_NO_DEBUG*/
@@ -35,11 +74,12 @@
  * Notice. Indicate notable events, etc.
  * @param EXPR expression containing notice. Expression is injected into LogStream
  * object thus standard ostream syntax may be used. This macro can be turned off by
- * defining GPX_NO_NOTE before including this file.
- * @return reference to LogStream object or (void)0.
+ * defining GPX_NO_NOTE before including this file or by setting GPX_LOG_LEVEL above
+ * GPX_LOG_LEVEL_NOTE.
+ * @return (void)0.
  */
-#ifndef GPX_NO_NOTE
-	#define GPX_NOTE(EXPR) ::gpx::log::Log::Instance().noteStream() << "Note: " << EXPR << GPX_LOG_FLF << std::endl
+#if !defined(GPX_NO_NOTE) && GPX_LOG_LEVEL <= GPX_LOG_LEVEL_NOTE
+	#define GPX_NOTE(EXPR) GPX_LOG_MESSAGE(GPX_LOG_LEVEL_NOTE, noteStream, "Note: " << EXPR << GPX_LOG_FLF << std::endl)
 #else
 	#define GPX_NOTE(EXPR) (void)0
 #endif /*GPX_NO_NOTICE*/
@@ -49,31 +89,39 @@
  * turn off GPX_WARN macro completely and at least collect the data in the log file.
  * @param EXPR expression containing warning message. Expression is injected into LogStream
  * object thus standard ostream syntax may be used. This macro can be turned off by defining
- * GPX_NO_WARN before including this file.
- * @return reference to LogStream object or (void)0.
+ * GPX_NO_WARN before including this file or by setting GPX_LOG_LEVEL above
+ * GPX_LOG_LEVEL_WARN.
+ * @return (void)0.
  */
-#ifndef GPX_NO_WARN
-	#define GPX_WARN(EXPR) ::gpx::log::Log::Instance().warnStream() << "Warning: " << EXPR << GPX_LOG_FLF << std::endl
+#if !defined(GPX_NO_WARN) && GPX_LOG_LEVEL <= GPX_LOG_LEVEL_WARN
+	#define GPX_WARN(EXPR) GPX_LOG_MESSAGE(GPX_LOG_LEVEL_WARN, warnStream, "Warning: " << EXPR << GPX_LOG_FLF << std::endl)
 #else
 	#define GPX_WARN(EXPR) (void)0
 #endif /*GPX_NO_WARN*/
 
 /**
  * Fatal error. Sends fatal error message to LogStream and exits with EXIT_FAILURE code.
+ * Log is flushed before exiting (see Log::flush()).
  * This macro should never be turned off, however it can be turned off by defining
- * GPX_NO_FATAL before including this file.
+ * GPX_NO_FATAL before including this file. Setting GPX_LOG_LEVEL above
+ * GPX_LOG_LEVEL_FATAL strips the message only.
  * @param EXPR expression containing fatal error message. Expression is injected into LogStream
  * object thus standard ostream syntax may be used.
  * @return (void)0 or void.
  */
 #ifndef GPX_NO_FATAL
-	#define GPX_FATAL(EXPR) ::gpx::log::Log::Instance().fatalStream() << "Fatal error: " << EXPR << GPX_LOG_FLF << std::endl, std::exit(EXIT_FAILURE)
+	#if GPX_LOG_LEVEL <= GPX_LOG_LEVEL_FATAL
+		#define GPX_FATAL(EXPR) GPX_LOG_TERMINAL_MESSAGE(GPX_LOG_LEVEL_FATAL, fatalStream, "Fatal error: " << EXPR << GPX_LOG_FLF << std::endl), ::gpx::log::Log::Instance().flush(), std::exit(EXIT_FAILURE)
+	#else
+		#define GPX_FATAL(EXPR) ::gpx::log::Log::Instance().flush(), std::exit(EXIT_FAILURE)
+	#endif /* GPX_LOG_LEVEL */
 #else
 	#define GPX_FATAL(EXPR) (void)0
 #endif /*GPX_NO_FATAL*/
 
 /**
  * Critical error. Sends critical error message to LogStream and aborts execution.
+ * Log is flushed before aborting (see Log::flush()).
  * There are following differences between exit() (performed by GPX_FATAL) and abort():
  * 	- abort() sends SIGABRT signal.
  * 	- abort() will dump core, if core dump is enabled.
@@ -82,13 +130,18 @@
  * 		destructors	of neither objects are being called.
  * 	.
  * This macro should never be turned off, however it can be turned off by defining
- * GPX_NO_CRITICAL before including this file.
+ * GPX_NO_CRITICAL before including this file. Setting GPX_LOG_LEVEL above
+ * GPX_LOG_LEVEL_CRITICAL strips the message only.
  * @param EXPR expression containing fatal error message. Expression is injected into LogStream
  * object thus standard ostream syntax may be used.
  * @return (void)0 or void.
  */
 #ifndef GPX_NO_CRITICAL
-	#define GPX_CRITICAL(EXPR) ::gpx::log::Log::Instance().criticalStream() << "Critical error: " << EXPR << GPX_LOG_FLF << std::endl, std::abort()
+	#if GPX_LOG_LEVEL <= GPX_LOG_LEVEL_CRITICAL
+		#define GPX_CRITICAL(EXPR) GPX_LOG_TERMINAL_MESSAGE(GPX_LOG_LEVEL_CRITICAL, criticalStream, "Critical error: " << EXPR << GPX_LOG_FLF << std::endl), ::gpx::log::Log::Instance().flush(), std::abort()
+	#else
+		#define GPX_CRITICAL(EXPR) ::gpx::log::Log::Instance().flush(), std::abort()
+	#endif /* GPX_LOG_LEVEL */
 #else
 	#define GPX_CRITICAL(EXPR) (void)0
 #endif /*GPX_NO_FATAL*/
@@ -96,13 +149,14 @@
 /**
  * Information. Indicate informational data. Intended to operate on the same level of
  * importance as notice. In opposite to notice the output is clean, without prefix, file,
- * line or function name in it. Macro can be turned off by defining GPX_NO_INFO.
+ * line or function name in it. Macro can be turned off by defining GPX_NO_INFO or by
+ * setting GPX_LOG_LEVEL above GPX_LOG_LEVEL_INFO.
  * @param EXPR expression containing information. Expression is injected into LogStream
  * object thus standard ostream syntax may be used.
- * @return reference to LogStream object or (void)0.
+ * @return (void)0.
  */
-#ifndef GPX_NO_INFO
-	#define GPX_INFO(EXPR) ::gpx::log::Log::Instance().infoStream() << EXPR << std::endl
+#if !defined(GPX_NO_INFO) && GPX_LOG_LEVEL <= GPX_LOG_LEVEL_INFO
+	#define GPX_INFO(EXPR) GPX_LOG_MESSAGE(GPX_LOG_LEVEL_INFO, infoStream, EXPR << std::endl)
 #else
 	#define GPX_INFO(EXPR) (void)0
 #endif /*GPX_NO_INFO*/
@@ -0,0 +1,189 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_LCPSOLVER_HPP_
+#define GPX_X_MATH_LCPSOLVER_HPP_
+
+#include "structures.hpp"
+#include "../utils/NonCopyable.hpp"
+
+#include GPX_X_MATH_BACKEND_HEADER
+#include GPX_X_MATH_BACKEND_LCPSOLVER_HEADER
+
+namespace gpx {
+namespace math {
+
+/**
+ * Linear complementarity problem solver workspace. Workspace owns scratch storage used
+ * by LCPSolver. Storage grows monotonically with size of solved problems and it is never
+ * released until workspace is destroyed, so that solver, which is given a workspace
+ * kept across consecutive solutions, does not allocate memory once it has seen the
+ * largest problem.
+ * @param N problem size in terms of number of unknowns.
+ * @param T underlying type.
+ */
+template <std::size_t N = SIZE_DYNAMIC, typename T = real_t>
+class LCPSolverWorkspace : public GPX_X_MATH_BACKEND_NAMESPACE::LCPSolverWorkspace<N, T>
+{
+	typedef GPX_X_MATH_BACKEND_NAMESPACE::LCPSolverWorkspace<N, T> Parent;
+
+	public:
+		/**
+		 * Get capacity.
+		 * @return size of the largest problem (in terms of number of unknowns), which
+		 * can be solved without memory allocations.
+		 */
+		std::size_t capacity() const;
+
+		/**
+		 * Reserve storage. Capacity is never decreased.
+		 * @param size problem size in terms of number of unknowns.
+		 */
+		void reserve(std::size_t size);
+};
+
+/**
+ * Solver members initialization. Base-from-member idiom to initialize members
+ * before calling parent class constructor.
+ */
+template <int LCP_METHOD, std::size_t N = SIZE_DYNAMIC, typename T = real_t>
+class LCPSolverMembersInit : utils::NonCopyable
+{
+	protected:
+		LCPSolverMembersInit(LCPSolverWorkspace<N, T> * workspace);
+
+		~LCPSolverMembersInit();
+
+	protected:
+		LCPSolverWorkspace<N, T> * m_ownWorkspace;	///< Workspace owned by solver (if workspace has not been provided).
+		LCPSolverWorkspace<N, T> & m_workspace;
+};
+
+/**
+ * Linear complementarity problem solver. Solver finds vector x, such that x >= 0,
+ * w = ax - b >= 0 and x^T w = 0 (each unknown is either zero or its equation
+ * is satisfied). Results produced by this solver are non-negative by definition.
+ * Method specific options (e.g. iteration limit of iterative methods) are
+ * accessible through backend implementation.
+ * @param LCP_METHOD method used to solve problem.
+ * @param N problem size in terms of number of unknowns.
+ * @param T underlying type.
+ */
+template <int LCP_METHOD, std::size_t N = SIZE_DYNAMIC, typename T = real_t>
+class LCPSolver : private LCPSolverMembersInit<LCP_METHOD, N, T>,
+				  public GPX_X_MATH_BACKEND_NAMESPACE::LCPSolver<LCP_METHOD, N, T>
+{
+	typedef GPX_X_MATH_BACKEND_NAMESPACE::LCPSolver<LCP_METHOD, N, T> Parent;
+	typedef LCPSolverMembersInit<LCP_METHOD, N, T> MembersInit;
+
+	public:
+		/**
+		 * Constructor. Solver creates its own workspace.
+		 * @param a matrix representing left hand side of problem (w = ax - b).
+		 *
+		 * @warning matrix @a a should be accessible during whole solver lifetime.
+		 */
+		LCPSolver(const_MatrixRef<N, N, T> a);
+
+		/**
+		 * Constructor.
+		 * @param a matrix representing left hand side of problem (w = ax - b).
+		 * @param workspace workspace providing scratch storage.
+		 *
+		 * @warning matrix @a a and @a workspace should be accessible during whole
+		 * solver lifetime.
+		 */
+		LCPSolver(const_MatrixRef<N, N, T> a, LCPSolverWorkspace<N, T> & workspace);
+
+		/**
+		 * Solve.
+		 * @param b vector representing right hand side of problem (w = ax - b).
+		 * @return solution of the problem, which is a formerly unknown vector x.
+		 */
+		Vector<N, T> solve(const_VectorRef<N, T> b);
+
+		/**
+		 * Solve. This version does not allocate memory, provided that workspace capacity
+		 * is sufficient.
+		 * @param b vector representing right hand side of problem (w = ax - b).
+		 * @param x vector, which obtains solution of the problem. Vector size must match
+		 * size of vector @a b.
+		 */
+		void solve(const_VectorRef<N, T> b, VectorRef<N, T> x);
+};
+
+template <std::size_t N, typename T>
+inline
+std::size_t LCPSolverWorkspace<N, T>::capacity() const
+{
+	return Parent::capacity();
+}
+
+template <std::size_t N, typename T>
+inline
+void LCPSolverWorkspace<N, T>::reserve(std::size_t size)
+{
+	Parent::reserve(size);
+}
+
+template <int LCP_METHOD, std::size_t N, typename T>
+inline
+LCPSolverMembersInit<LCP_METHOD, N, T>::LCPSolverMembersInit(LCPSolverWorkspace<N, T> * workspace):
+	m_ownWorkspace(workspace ? 0 : new LCPSolverWorkspace<N, T>),
+	m_workspace(workspace ? *workspace : *m_ownWorkspace)
+{
+}
+
+template <int LCP_METHOD, std::size_t N, typename T>
+inline
+LCPSolverMembersInit<LCP_METHOD, N, T>::~LCPSolverMembersInit()
+{
+	delete m_ownWorkspace;
+}
+
+template <int LCP_METHOD, std::size_t N, typename T>
+inline
+LCPSolver<LCP_METHOD, N, T>::LCPSolver(const_MatrixRef<N, N, T> a):
+	MembersInit(0),
+	Parent(a, MembersInit::m_workspace)
+{
+}
+
+template <int LCP_METHOD, std::size_t N, typename T>
+inline
+LCPSolver<LCP_METHOD, N, T>::LCPSolver(const_MatrixRef<N, N, T> a, LCPSolverWorkspace<N, T> & workspace):
+	MembersInit(& workspace),
+	Parent(a, workspace)
+{
+}
+
+template <int LCP_METHOD, std::size_t N, typename T>
+inline
+Vector<N, T> LCPSolver<LCP_METHOD, N, T>::solve(const_VectorRef<N, T> b)
+{
+	Vector<N, T> result(T(), b.size());
+	solve(b, result);
+	return result;
+}
+
+template <int LCP_METHOD, std::size_t N, typename T>
+inline
+void LCPSolver<LCP_METHOD, N, T>::solve(const_VectorRef<N, T> b, VectorRef<N, T> x)
+{
+	GPX_ASSERT(x.size() == b.size(), "size of solution vector must match size of right hand side vector");
+
+	MembersInit::m_workspace.reserve(b.size());
+	Parent::solve(b, x);
+}
+
+}
+}
+
+#endif /* GPX_X_MATH_LCPSOLVER_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -7,6 +7,7 @@
 #define GPX_X_MATH_NNSOLVER_HPP_
 
 #include "structures.hpp"
+#include "../utils/NonCopyable.hpp"
 
 #include GPX_X_MATH_BACKEND_HEADER
 #include GPX_X_MATH_BACKEND_NNSOLVER_HEADER
@@ -14,20 +15,65 @@
 namespace gpx {
 namespace math {
 
+/**
+ * Non-negative linear equation solver workspace. Workspace owns scratch storage used
+ * by NNSolver. Storage grows monotonically with size of solved systems and it is never
+ * released until workspace is destroyed, so that solver, which is given a workspace
+ * kept across consecutive solutions, does not allocate memory once it has seen the
+ * largest system.
+ * @param N linear system size in terms of number of equations.
+ * @param T underlying type.
+ */
+template <std::size_t N = SIZE_DYNAMIC, typename T = real_t>
+class NNSolverWorkspace : public GPX_X_MATH_BACKEND_NAMESPACE::NNSolverWorkspace<N, T>
+{
+	typedef GPX_X_MATH_BACKEND_NAMESPACE::NNSolverWorkspace<N, T> Parent;
+
+	template <int, std::size_t, typename>
+	friend class NNSolverMembersInit;
+
+	template <int, std::size_t, typename>
+	friend class NNSolver;
+
+	public:
+		NNSolverWorkspace();
+
+	public:
+		/**
+		 * Get capacity.
+		 * @return size of the largest system (in terms of number of equations), which
+		 * can be solved without memory allocations.
+		 */
+		std::size_t capacity() const;
+
+		/**
+		 * Reserve storage. Capacity is never decreased.
+		 * @param size system size in terms of number of equations.
+		 */
+		void reserve(std::size_t size);
+
+#ifndef NDEBUG
+	private:
+		Matrix<N, N, T> m_aCopy;	///< Untouched copy of matrix A for solution check.
+		Vector<N, T> m_bCopy;	///< Untouched copy of vector b for solution check.
+#endif /* NDEBUG */
+};
+
 /**
  * Solver members initialization. Base-from-member idiom to initialize members
  * before calling parent class constructor.
  */
 template <int EQ_FLAGS, std::size_t N = SIZE_DYNAMIC, typename T = real_t>
-class NNSolverMembersInit
+class NNSolverMembersInit : utils::NonCopyable
 {
 	protected:
-		NNSolverMembersInit(const_MatrixRef<N, N, T> a);
+		NNSolverMembersInit(const_MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> * workspace);
+
+		~NNSolverMembersInit();
 
-#ifndef NDEBUG
 	protected:
-		Matrix<N, N, T> m_aCopy;	///< Untouched copy of matrix A for solution check.
-#endif /* NDEBUG */
+		NNSolverWorkspace<N, T> * m_ownWorkspace;	///< Workspace owned by solver (if workspace has not been provided).
+		NNSolverWorkspace<N, T> & m_workspace;
 };
 
 /**
@@ -43,10 +89,11 @@ class NNSolver : private NNSolverMembersInit<EQ_FLAGS, N, T>,
 				 public GPX_X_MATH_BACKEND_NAMESPACE::NNSolver<EQ_FLAGS, N, T>
 {
 	typedef GPX_X_MATH_BACKEND_NAMESPACE::NNSolver<EQ_FLAGS, N, T> Parent;
+	typedef NNSolverMembersInit<EQ_FLAGS, N, T> MembersInit;
 
 	public:
 		/**
-		 * Constructor.
+		 * Constructor. Solver creates its own workspace.
 		 * @param a matrix representing left hand side of equation system (ax = b).
 		 *
 		 * @warning matrix @a a should be accessible during whole solver lifetime.
@@ -54,6 +101,16 @@ class NNSolver : private NNSolverMembersInit<EQ_FLAGS, N, T>,
 		 */
 		NNSolver(MatrixRef<N, N, T> a);
 
+		/**
+		 * Constructor.
+		 * @param a matrix representing left hand side of equation system (ax = b).
+		 * @param workspace workspace providing scratch storage.
+		 *
+		 * @warning matrix @a a and @a workspace should be accessible during whole
+		 * solver lifetime. Solver is free to modify matrix.
+		 */
+		NNSolver(MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace);
+
 		/**
 		 * Solve. Finds solution of equation system given in form ax = b.
 		 * @param b vector representing right hand side of equation system.
@@ -62,22 +119,82 @@ class NNSolver : private NNSolverMembersInit<EQ_FLAGS, N, T>,
 		 * @warning solver is free to modify @a b vector.
 		 */
 		Vector<N, T> solve(VectorRef<N, T> b);
+
+		/**
+		 * Solve. Finds solution of equation system given in form ax = b. This version
+		 * does not allocate memory, provided that workspace capacity is sufficient.
+		 * @param b vector representing right hand side of equation system.
+		 * @param x vector, which obtains solution of equation system. Vector size
+		 * must match size of vector @a b.
+		 *
+		 * @warning solver is free to modify @a b vector.
+		 */
+		void solve(VectorRef<N, T> b, VectorRef<N, T> x);
 };
 
+template <std::size_t N, typename T>
+inline
+NNSolverWorkspace<N, T>::NNSolverWorkspace()
+#ifndef NDEBUG
+	: m_aCopy(N, N),
+	m_bCopy(N)
+#endif /* NDEBUG */
+{
+}
+
+template <std::size_t N, typename T>
+inline
+std::size_t NNSolverWorkspace<N, T>::capacity() const
+{
+	return Parent::capacity();
+}
+
+template <std::size_t N, typename T>
+inline
+void NNSolverWorkspace<N, T>::reserve(std::size_t size)
+{
+	if (size <= capacity())
+		return;
+
+#ifndef NDEBUG
+	Parent::Reserve(m_aCopy, size * size);
+	Parent::Reserve(m_bCopy, size);
+#endif /* NDEBUG */
+	Parent::reserve(size);
+}
+
 template <int EQ_FLAGS, std::size_t N, typename T>
 inline
-NNSolverMembersInit<EQ_FLAGS, N, T>::NNSolverMembersInit(const_MatrixRef<N, N, T> a)
+NNSolverMembersInit<EQ_FLAGS, N, T>::NNSolverMembersInit(const_MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> * workspace):
+	m_ownWorkspace(workspace ? 0 : new NNSolverWorkspace<N, T>),
+	m_workspace(workspace ? *workspace : *m_ownWorkspace)
+{
+	m_workspace.reserve(a.rows());
 #ifndef NDEBUG
-	: m_aCopy(a)
+	m_workspace.m_aCopy = a;
 #endif /* NDEBUG */
+}
+
+template <int EQ_FLAGS, std::size_t N, typename T>
+inline
+NNSolverMembersInit<EQ_FLAGS, N, T>::~NNSolverMembersInit()
 {
+	delete m_ownWorkspace;
 }
 
 template <int EQ_FLAGS, std::size_t N, typename T>
 inline
 NNSolver<EQ_FLAGS, N, T>::NNSolver(MatrixRef<N, N, T> a):
-	NNSolverMembersInit<EQ_FLAGS, N, T>(a),
-	Parent(a)
+	MembersInit(a, 0),
+	Parent(a, MembersInit::m_workspace)
+{
+}
+
+template <int EQ_FLAGS, std::size_t N, typename T>
+inline
+NNSolver<EQ_FLAGS, N, T>::NNSolver(MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace):
+	MembersInit(a, & workspace),
+	Parent(a, workspace)
 {
 }
 
@@ -85,19 +202,33 @@ template <int EQ_FLAGS, std::size_t N, typename T>
 inline
 Vector<N, T> NNSolver<EQ_FLAGS, N, T>::solve(VectorRef<N, T> b)
 {
+	Vector<N, T> result(T(), b.size());
+	solve(b, result);
+	return result;
+}
+
+template <int EQ_FLAGS, std::size_t N, typename T>
+inline
+void NNSolver<EQ_FLAGS, N, T>::solve(VectorRef<N, T> b, VectorRef<N, T> x)
+{
+	GPX_ASSERT(x.size() == b.size(), "size of solution vector must match size of right hand side vector");
+
+	MembersInit::m_workspace.reserve(b.size());
 #ifndef NDEBUG
 	//check solution
-	const Vector<N, T> bCopy(b);
-	const Vector<N, T> result = Parent::solve(b);
-	const Vector<N, T> ax = NNSolverMembersInit<EQ_FLAGS, N, T>::m_aCopy.prod(result);
-//	GPX_INFO("bcopy: " << bCopy);
-//	GPX_INFO("ax: " << ax);
-	for (std::size_t i = 0; i < bCopy.size(); i++)
-		if (!ape(bCopy(i) - ax(i), T()))
-			GPX_WARN("solution Ax(" << i << ")=" << ax(i) << " does not match right hand side b=" << bCopy(i) << " of Ax = b system");
-	return result;
+	const Matrix<N, N, T> & aCopy = MembersInit::m_workspace.m_aCopy;
+	Vector<N, T> & bCopy = MembersInit::m_workspace.m_bCopy;
+	bCopy = b;
+	Parent::solve(b, x);
+	for (std::size_t i = 0; i < bCopy.size(); i++) {
+		T ax = T();
+		for (std::size_t j = 0; j < x.size(); j++)
+			ax += aCopy(i, j) * x(j);
+		if (!ape(bCopy(i) - ax, T()))
+			GPX_WARN("solution Ax(" << i << ")=" << ax << " does not match right hand side b=" << bCopy(i) << " of Ax = b system");
+	}
 #else
-	return Parent::solve(b);
+	Parent::solve(b, x);
 #endif /* NDEBUG */
 }
 
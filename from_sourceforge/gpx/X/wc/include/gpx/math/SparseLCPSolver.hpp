@@ -0,0 +1,447 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_SPARSELCPSOLVER_HPP_
+#define GPX_X_MATH_SPARSELCPSOLVER_HPP_
+
+#include "SparseMatrix.hpp"
+#include "../utils/NonCopyable.hpp"
+
+#include GPX_X_MATH_BACKEND_HEADER
+#include GPX_X_MATH_BACKEND_SPARSESOLVER_HEADER
+
+#include <algorithm>
+#include <vector>
+
+namespace gpx {
+namespace math {
+
+/**
+ * Sparse linear complementarity problem solver. Solver finds vector x, such that
+ * x >= 0, w = ax - b >= 0 and x^T w = 0, where matrix @a a is given in sparse
+ * format. Implementations are provided as specializations for each method.
+ * @param LCP_METHOD method used to solve problem.
+ * @param T underlying type.
+ */
+template <int LCP_METHOD, typename T = real_t>
+class SparseLCPSolver;
+
+/**
+ * Sparse linear complementarity problem solver workspace. Workspace owns scratch storage
+ * used by SparseLCPSolver, including sparse direct solver of math backend. Storage grows
+ * with size of solved problems and it is kept until workspace is destroyed, so that
+ * solver, which is given a workspace kept across consecutive solutions, does not
+ * allocate memory once it has seen the largest problem. Factorization performed by
+ * sparse direct solvers of some backends (e.g. Eigen) may still allocate internally.
+ * @param T underlying type.
+ */
+template <typename T = real_t>
+class SparseLCPSolverWorkspace
+{
+	template <int, typename>
+	friend class SparseLCPSolver;
+
+	public:
+		/**
+		 * Default constructor.
+		 */
+		SparseLCPSolverWorkspace();
+
+		/**
+		 * Get capacity.
+		 * @return size of the largest problem (in terms of number of unknowns), which
+		 * can be solved without memory allocations.
+		 */
+		std::size_t capacity() const;
+
+		/**
+		 * Reserve storage. Capacity is never decreased.
+		 * @param size problem size in terms of number of unknowns.
+		 */
+		void reserve(std::size_t size);
+
+	private:
+		typedef std::vector<T> ValuesContainer;
+
+	private:
+		std::size_t m_capacity;
+		ValuesContainer m_diag;
+		Vector<SIZE_DYNAMIC, T> m_xDirect;
+		GPX_X_MATH_BACKEND_NAMESPACE::SparseSolver<T> m_sparseSolver;
+};
+
+template <typename T>
+SparseLCPSolverWorkspace<T>::SparseLCPSolverWorkspace():
+	m_capacity(0),
+	m_xDirect(0)
+{
+}
+
+template <typename T>
+std::size_t SparseLCPSolverWorkspace<T>::capacity() const
+{
+	return m_capacity;
+}
+
+template <typename T>
+void SparseLCPSolverWorkspace<T>::reserve(std::size_t size)
+{
+	if (size <= m_capacity)
+		return;
+
+	m_diag.reserve(size);
+	m_xDirect.reserve(size);
+	m_capacity = size;
+}
+
+/**
+ * Sparse linear complementarity problem solver (projected Gauss-Seidel specialization).
+ * Method is the same as in case of LCPSolver<LCP_PGS>, but each sweep visits only
+ * stored elements of matrix, so that its cost is proportional to the number of
+ * non-zero elements rather than square of problem size. Given the same matrix, both
+ * solvers produce identical results.
+ *
+ * If math backend provides sparse direct solver (e.g. Eigen backend), system is first
+ * solved directly as if there were no constraints. If all unknowns turn out to be
+ * non-negative, then w = 0 and solution is accepted without iterating. Otherwise
+ * projected Gauss-Seidel method takes over from its usual starting point.
+ * @param T underlying type.
+ */
+template <typename T>
+class SparseLCPSolver<LCP_PGS, T> : utils::NonCopyable
+{
+	public:
+		static const std::size_t INITIAL_MAX_ITERATIONS = 64;	///< Initial iteration limit.
+
+	public:
+		/**
+		 * Constructor. Solver creates its own workspace.
+		 * @param a compressed sparse matrix representing left hand side of problem
+		 * (w = ax - b).
+		 *
+		 * @warning matrix @a a should be accessible during whole solver lifetime.
+		 */
+		SparseLCPSolver(const SparseMatrix<T> & a);
+
+		/**
+		 * Constructor.
+		 * @param a compressed sparse matrix representing left hand side of problem
+		 * (w = ax - b).
+		 * @param workspace workspace providing scratch storage.
+		 *
+		 * @warning matrix @a a and @a workspace should be accessible during whole
+		 * solver lifetime.
+		 */
+		SparseLCPSolver(const SparseMatrix<T> & a, SparseLCPSolverWorkspace<T> & workspace);
+
+		/**
+		 * Destructor.
+		 */
+		~SparseLCPSolver();
+
+		/**
+		 * Get iteration limit.
+		 * @return maximal number of iterations.
+		 */
+		std::size_t maxIterations() const;
+
+		/**
+		 * Set iteration limit.
+		 * @param maxIterations maximal number of iterations.
+		 */
+		void setMaxIterations(std::size_t maxIterations);
+
+		/**
+		 * Get tolerance.
+		 * @return tolerance, relative to largest absolute value of @a b vector.
+		 */
+		T tolerance() const;
+
+		/**
+		 * Set tolerance.
+		 * @param tolerance tolerance, relative to largest absolute value of @a b vector.
+		 */
+		void setTolerance(T tolerance);
+
+		/**
+		 * Get number of iterations performed by last call to solve().
+		 * @return number of iterations.
+		 */
+		std::size_t iterations() const;
+
+		/**
+		 * Get residual of last call to solve().
+		 * @return residual.
+		 *
+		 * @see LCPSolver<LCP_PGS>::residual().
+		 */
+		T residual() const;
+
+		/**
+		 * Check if last call to solve() has converged.
+		 * @return @p true if residual dropped below tolerance, @p false if iteration
+		 * limit has been reached.
+		 */
+		bool converged() const;
+
+		/**
+		 * Check if last call to solve() has been resolved by sparse direct solver of
+		 * math backend.
+		 * @return @p true if solution has been obtained by direct solver, @p false if
+		 * projected Gauss-Seidel iterations have been performed.
+		 */
+		bool direct() const;
+
+		/**
+		 * Solve.
+		 * @param b vector representing right hand side of problem (w = ax - b).
+		 * @return solution of the problem, which is a formerly unknown vector x.
+		 */
+		Vector<SIZE_DYNAMIC, T> solve(const_VectorRef<SIZE_DYNAMIC, T> b);
+
+		/**
+		 * Solve. This version does not allocate memory, provided that workspace capacity
+		 * is sufficient.
+		 * @param b vector representing right hand side of problem (w = ax - b).
+		 * @param x vector, which obtains solution of the problem. Vector size must match
+		 * size of vector @a b.
+		 */
+		void solve(const_VectorRef<SIZE_DYNAMIC, T> b, VectorRef<SIZE_DYNAMIC, T> x);
+
+		/**
+		 * Solve starting from initial guess (warm start). Good initial guess (e.g.
+		 * solution of similar problem from previous frame) reduces number of iterations.
+		 * This version does not allocate memory, provided that workspace capacity is
+		 * sufficient.
+		 * @param b vector representing right hand side of problem (w = ax - b).
+		 * @param x0 initial guess. Negative values are clamped to zero. Initial guess
+		 * may refer to the same vector as @a x.
+		 * @param x vector, which obtains solution of the problem. Vector size must match
+		 * size of vector @a b.
+		 */
+		void solve(const_VectorRef<SIZE_DYNAMIC, T> b, const_VectorRef<SIZE_DYNAMIC, T> x0, VectorRef<SIZE_DYNAMIC, T> x);
+
+	private:
+		bool solveDirect(const_VectorRef<SIZE_DYNAMIC, T> b, T scale, VectorRef<SIZE_DYNAMIC, T> x);
+
+		void iterate(const_VectorRef<SIZE_DYNAMIC, T> b, VectorRef<SIZE_DYNAMIC, T> x);
+
+	private:
+		const SparseMatrix<T> & m_a;
+		SparseLCPSolverWorkspace<T> * m_ownWorkspace;	///< Workspace owned by solver (if workspace has not been provided).
+		SparseLCPSolverWorkspace<T> & m_workspace;
+		std::size_t m_maxIterations;
+		T m_tolerance;
+		std::size_t m_iterations;
+		T m_residual;
+		bool m_converged;
+		bool m_direct;
+};
+
+template <typename T>
+const std::size_t SparseLCPSolver<LCP_PGS, T>::INITIAL_MAX_ITERATIONS;
+
+template <typename T>
+SparseLCPSolver<LCP_PGS, T>::SparseLCPSolver(const SparseMatrix<T> & a):
+	m_a(a),
+	m_ownWorkspace(new SparseLCPSolverWorkspace<T>),
+	m_workspace(*m_ownWorkspace),
+	m_maxIterations(INITIAL_MAX_ITERATIONS),
+	m_tolerance(static_cast<T>(1.0e-6)),
+	m_iterations(0),
+	m_residual(T()),
+	m_converged(true),
+	m_direct(false)
+{
+	GPX_ASSERT(a.compressed(), "matrix has to be compressed");
+}
+
+template <typename T>
+SparseLCPSolver<LCP_PGS, T>::SparseLCPSolver(const SparseMatrix<T> & a, SparseLCPSolverWorkspace<T> & workspace):
+	m_a(a),
+	m_ownWorkspace(0),
+	m_workspace(workspace),
+	m_maxIterations(INITIAL_MAX_ITERATIONS),
+	m_tolerance(static_cast<T>(1.0e-6)),
+	m_iterations(0),
+	m_residual(T()),
+	m_converged(true),
+	m_direct(false)
+{
+	GPX_ASSERT(a.compressed(), "matrix has to be compressed");
+}
+
+template <typename T>
+SparseLCPSolver<LCP_PGS, T>::~SparseLCPSolver()
+{
+	delete m_ownWorkspace;
+}
+
+template <typename T>
+std::size_t SparseLCPSolver<LCP_PGS, T>::maxIterations() const
+{
+	return m_maxIterations;
+}
+
+template <typename T>
+void SparseLCPSolver<LCP_PGS, T>::setMaxIterations(std::size_t maxIterations)
+{
+	m_maxIterations = maxIterations;
+}
+
+template <typename T>
+T SparseLCPSolver<LCP_PGS, T>::tolerance() const
+{
+	return m_tolerance;
+}
+
+template <typename T>
+void SparseLCPSolver<LCP_PGS, T>::setTolerance(T tolerance)
+{
+	m_tolerance = tolerance;
+}
+
+template <typename T>
+std::size_t SparseLCPSolver<LCP_PGS, T>::iterations() const
+{
+	return m_iterations;
+}
+
+template <typename T>
+T SparseLCPSolver<LCP_PGS, T>::residual() const
+{
+	return m_residual;
+}
+
+template <typename T>
+bool SparseLCPSolver<LCP_PGS, T>::converged() const
+{
+	return m_converged;
+}
+
+template <typename T>
+bool SparseLCPSolver<LCP_PGS, T>::direct() const
+{
+	return m_direct;
+}
+
+template <typename T>
+Vector<SIZE_DYNAMIC, T> SparseLCPSolver<LCP_PGS, T>::solve(const_VectorRef<SIZE_DYNAMIC, T> b)
+{
+	Vector<SIZE_DYNAMIC, T> x(T(), b.size());
+	solve(b, x);
+	return x;
+}
+
+template <typename T>
+void SparseLCPSolver<LCP_PGS, T>::solve(const_VectorRef<SIZE_DYNAMIC, T> b, VectorRef<SIZE_DYNAMIC, T> x)
+{
+	GPX_ASSERT(x.size() == b.size(), "size of solution vector must match size of right hand side vector");
+
+	x.zero();
+	iterate(b, x);
+}
+
+template <typename T>
+void SparseLCPSolver<LCP_PGS, T>::solve(const_VectorRef<SIZE_DYNAMIC, T> b, const_VectorRef<SIZE_DYNAMIC, T> x0, VectorRef<SIZE_DYNAMIC, T> x)
+{
+	GPX_ASSERT(x.size() == b.size(), "size of solution vector must match size of right hand side vector");
+	GPX_ASSERT(x0.size() == b.size(), "size of initial guess must match size of right hand side vector");
+
+	for (std::size_t i = 0; i < b.size(); i++)
+		x(i) = std::max(T(), x0(i));
+	iterate(b, x);
+}
+
+template <typename T>
+bool SparseLCPSolver<LCP_PGS, T>::solveDirect(const_VectorRef<SIZE_DYNAMIC, T> b, T scale, VectorRef<SIZE_DYNAMIC, T> x)
+{
+	if (!m_workspace.m_sparseSolver.factorize(m_a))
+		return false;
+
+	Vector<SIZE_DYNAMIC, T> & xDirect = m_workspace.m_xDirect;
+	xDirect.resize(b.size());
+	m_workspace.m_sparseSolver.solve(b, xDirect);
+	for (std::size_t i = 0; i < b.size(); i++)
+		if (!(xDirect(i) >= T()))	//negative or NaN
+			return false;
+
+	//check residual of equations, which have not been removed
+	T residual = T();
+	for (std::size_t i = 0; i < b.size(); i++) {
+		if (m_a.get(i, i) <= T())
+			continue;
+		T w = -b(i);
+		for (std::size_t k = m_a.rowBegin(i); k < m_a.rowEnd(i); k++)
+			w += m_a.val(k) * xDirect(m_a.col(k));
+		residual = std::max(residual, std::abs(w));
+	}
+	if (!(residual <= m_tolerance * scale))
+		return false;
+
+	m_residual = residual;
+	x = xDirect;
+	return true;
+}
+
+template <typename T>
+void SparseLCPSolver<LCP_PGS, T>::iterate(const_VectorRef<SIZE_DYNAMIC, T> b, VectorRef<SIZE_DYNAMIC, T> x)
+{
+	m_iterations = 0;
+	m_residual = T();
+	m_converged = true;
+	m_direct = false;
+
+	m_workspace.reserve(b.size());
+	typename SparseLCPSolverWorkspace<T>::ValuesContainer & diag = m_workspace.m_diag;
+	diag.resize(b.size());
+	for (std::size_t i = 0; i < b.size(); i++) {
+		diag[i] = m_a.get(i, i);
+		if (diag[i] <= T())
+			x(i) = T();	//unknown does not affect its own equation (e.g. equation has been removed), leave it zero
+	}
+
+	T scale = T();
+	for (std::size_t i = 0; i < b.size(); i++)
+		scale = std::max(scale, std::abs(b(i)));
+	if (scale == T()) {
+		x.zero();
+		return;
+	}
+
+	if (solveDirect(b, scale, x)) {
+		m_direct = true;
+		return;
+	}
+
+	while (m_iterations < m_maxIterations) {
+		m_iterations++;
+		m_residual = T();
+		for (std::size_t i = 0; i < b.size(); i++) {
+			T aii = diag[i];
+			if (aii <= T())
+				continue;
+			T w = -b(i);
+			for (std::size_t k = m_a.rowBegin(i); k < m_a.rowEnd(i); k++)
+				w += m_a.val(k) * x(m_a.col(k));
+			T xi = std::max(T(), x(i) - w / aii);
+			m_residual = std::max(m_residual, std::abs(xi - x(i)) * aii);
+			x(i) = xi;
+		}
+		if (m_residual <= m_tolerance * scale)
+			return;
+	}
+	m_converged = false;
+}
+
+}
+}
+
+#endif /* GPX_X_MATH_SPARSELCPSOLVER_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
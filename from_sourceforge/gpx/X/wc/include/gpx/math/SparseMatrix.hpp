@@ -0,0 +1,331 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_SPARSEMATRIX_HPP_
+#define GPX_X_MATH_SPARSEMATRIX_HPP_
+
+#include "structures.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace gpx {
+namespace math {
+
+/**
+ * Sparse matrix in compressed sparse row (CSR) format. Matrix is assembled in two
+ * phases. During assembly phase elements are accumulated with add(). Then compress()
+ * packs rows into CSR arrays, which are consumed by sparse solvers. Only elements
+ * which have been touched during assembly phase are stored, thus memory and time
+ * needed to process matrix scale with the number of non-zero elements. Buffers are
+ * retained between assemblies, so that matrix can be refilled repeatedly without
+ * memory allocations.
+ * @param T underlying type.
+ */
+template <typename T = real_t>
+class SparseMatrix
+{
+	public:
+		/**
+		 * Constructor.
+		 * @param rows number of rows.
+		 * @param cols number of columns.
+		 */
+		SparseMatrix(std::size_t rows = 0, std::size_t cols = 0);
+
+		/**
+		 * Get number of rows.
+		 * @return number of rows.
+		 */
+		std::size_t rows() const;
+
+		/**
+		 * Get number of columns.
+		 * @return number of columns.
+		 */
+		std::size_t cols() const;
+
+		/**
+		 * Get number of stored elements. Valid after compress().
+		 * @return number of stored elements.
+		 */
+		std::size_t nonZeros() const;
+
+		/**
+		 * Check whether matrix has been compressed.
+		 * @return @p true if matrix is in CSR format, @p false during assembly phase.
+		 */
+		bool compressed() const;
+
+		/**
+		 * Resize matrix. All elements are removed and matrix enters assembly phase.
+		 * @param rows number of rows.
+		 * @param cols number of columns.
+		 */
+		void resize(std::size_t rows, std::size_t cols);
+
+		/**
+		 * Add value to matrix element. Element is created if it does not exist.
+		 * Function can be used only during assembly phase.
+		 * @param row row index.
+		 * @param col column index.
+		 * @param val value to be added.
+		 */
+		void add(std::size_t row, std::size_t col, T val);
+
+		/**
+		 * Compress matrix. Rows are packed into CSR arrays with columns sorted in
+		 * ascending order.
+		 */
+		void compress();
+
+		/**
+		 * Get value of matrix element.
+		 * @param row row index.
+		 * @param col column index.
+		 * @return value of element or zero if element is not stored.
+		 */
+		T get(std::size_t row, std::size_t col) const;
+
+		/**
+		 * Zero all stored elements of a row. Valid after compress().
+		 * @param row row index.
+		 */
+		void zeroRow(std::size_t row);
+
+		/**
+		 * Zero all stored elements of a column. Valid after compress().
+		 * @param col column index.
+		 */
+		void zeroCol(std::size_t col);
+
+		/**
+		 * Multiply matrix by vector. Valid after compress().
+		 * @param x vector.
+		 * @return product.
+		 */
+		Vector<SIZE_DYNAMIC, T> prod(const_VectorRef<SIZE_DYNAMIC, T> x) const;
+
+		/**
+		 * Get offset of first element of a row within col() and val() arrays.
+		 * Valid after compress().
+		 * @param row row index.
+		 * @return offset of first element of a row.
+		 */
+		std::size_t rowBegin(std::size_t row) const;
+
+		/**
+		 * Get offset of an element following last element of a row within col() and
+		 * val() arrays. Valid after compress().
+		 * @param row row index.
+		 * @return end offset of a row.
+		 */
+		std::size_t rowEnd(std::size_t row) const;
+
+		/**
+		 * Get column index of stored element. Valid after compress().
+		 * @param k element offset.
+		 * @return column index.
+		 */
+		std::size_t col(std::size_t k) const;
+
+		/**
+		 * Get value of stored element. Valid after compress().
+		 * @param k element offset.
+		 * @return value.
+		 */
+		T val(std::size_t k) const;
+
+	private:
+		typedef std::vector<std::pair<std::size_t, T> > RowContainer;
+		typedef std::vector<RowContainer> RowsContainer;
+
+	private:
+		std::size_t m_rows;
+		std::size_t m_cols;
+		bool m_compressed;
+		RowsContainer m_assembly;	///< Rows accumulated during assembly phase.
+		std::vector<std::size_t> m_rowPtr;
+		std::vector<std::size_t> m_colInd;
+		std::vector<T> m_vals;
+};
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(std::size_t rows, std::size_t cols):
+	m_rows(0),
+	m_cols(0),
+	m_compressed(false)
+{
+	resize(rows, cols);
+}
+
+template <typename T>
+inline
+std::size_t SparseMatrix<T>::rows() const
+{
+	return m_rows;
+}
+
+template <typename T>
+inline
+std::size_t SparseMatrix<T>::cols() const
+{
+	return m_cols;
+}
+
+template <typename T>
+inline
+std::size_t SparseMatrix<T>::nonZeros() const
+{
+	return m_vals.size();
+}
+
+template <typename T>
+inline
+bool SparseMatrix<T>::compressed() const
+{
+	return m_compressed;
+}
+
+template <typename T>
+void SparseMatrix<T>::resize(std::size_t rows, std::size_t cols)
+{
+	m_rows = rows;
+	m_cols = cols;
+	m_compressed = false;
+	if (m_assembly.size() < rows)
+		m_assembly.resize(rows);
+	for (std::size_t i = 0; i < rows; i++)
+		m_assembly[i].clear();
+	m_rowPtr.assign(rows + 1, 0);
+	m_colInd.clear();
+	m_vals.clear();
+}
+
+template <typename T>
+void SparseMatrix<T>::add(std::size_t row, std::size_t col, T val)
+{
+	GPX_ASSERT(!m_compressed, "can not add elements to compressed matrix");
+	GPX_ASSERT(row < m_rows && col < m_cols, "SparseMatrix(" << row << ", " << col << ") is out of bounds");
+
+	//rows are expected to be short (elements are coupled only through shared bodies), so linear search is fine
+	RowContainer & r = m_assembly[row];
+	for (typename RowContainer::iterator i = r.begin(); i != r.end(); ++i)
+		if (i->first == col) {
+			i->second += val;
+			return;
+		}
+	r.push_back(std::make_pair(col, val));
+}
+
+template <typename T>
+void SparseMatrix<T>::compress()
+{
+	m_colInd.clear();
+	m_vals.clear();
+	for (std::size_t row = 0; row < m_rows; row++) {
+		RowContainer & r = m_assembly[row];
+		std::sort(r.begin(), r.end());
+		m_rowPtr[row] = m_vals.size();
+		for (typename RowContainer::const_iterator i = r.begin(); i != r.end(); ++i) {
+			m_colInd.push_back(i->first);
+			m_vals.push_back(i->second);
+		}
+	}
+	m_rowPtr[m_rows] = m_vals.size();
+	m_compressed = true;
+}
+
+template <typename T>
+T SparseMatrix<T>::get(std::size_t row, std::size_t col) const
+{
+	GPX_ASSERT(row < m_rows && col < m_cols, "SparseMatrix(" << row << ", " << col << ") is out of bounds");
+
+	if (!m_compressed) {
+		const RowContainer & r = m_assembly[row];
+		for (typename RowContainer::const_iterator i = r.begin(); i != r.end(); ++i)
+			if (i->first == col)
+				return i->second;
+		return T();
+	}
+	std::vector<std::size_t>::const_iterator end = m_colInd.begin() + m_rowPtr[row + 1];
+	std::vector<std::size_t>::const_iterator i = std::lower_bound(m_colInd.begin() + m_rowPtr[row], end, col);
+	if (i != end && *i == col)
+		return m_vals[i - m_colInd.begin()];
+	return T();
+}
+
+template <typename T>
+void SparseMatrix<T>::zeroRow(std::size_t row)
+{
+	GPX_ASSERT(m_compressed, "matrix has to be compressed");
+
+	for (std::size_t k = m_rowPtr[row]; k < m_rowPtr[row + 1]; k++)
+		m_vals[k] = T();
+}
+
+template <typename T>
+void SparseMatrix<T>::zeroCol(std::size_t col)
+{
+	GPX_ASSERT(m_compressed, "matrix has to be compressed");
+
+	for (std::size_t row = 0; row < m_rows; row++) {
+		std::vector<std::size_t>::iterator end = m_colInd.begin() + m_rowPtr[row + 1];
+		std::vector<std::size_t>::iterator i = std::lower_bound(m_colInd.begin() + m_rowPtr[row], end, col);
+		if (i != end && *i == col)
+			m_vals[i - m_colInd.begin()] = T();
+	}
+}
+
+template <typename T>
+Vector<SIZE_DYNAMIC, T> SparseMatrix<T>::prod(const_VectorRef<SIZE_DYNAMIC, T> x) const
+{
+	GPX_ASSERT(m_compressed, "matrix has to be compressed");
+
+	Vector<SIZE_DYNAMIC, T> result(T(), m_rows);
+	for (std::size_t row = 0; row < m_rows; row++)
+		for (std::size_t k = m_rowPtr[row]; k < m_rowPtr[row + 1]; k++)
+			result(row) += m_vals[k] * x(m_colInd[k]);
+	return result;
+}
+
+template <typename T>
+inline
+std::size_t SparseMatrix<T>::rowBegin(std::size_t row) const
+{
+	return m_rowPtr[row];
+}
+
+template <typename T>
+inline
+std::size_t SparseMatrix<T>::rowEnd(std::size_t row) const
+{
+	return m_rowPtr[row + 1];
+}
+
+template <typename T>
+inline
+std::size_t SparseMatrix<T>::col(std::size_t k) const
+{
+	return m_colInd[k];
+}
+
+template <typename T>
+inline
+T SparseMatrix<T>::val(std::size_t k) const
+{
+	return m_vals[k];
+}
+
+}
+}
+
+#endif /* GPX_X_MATH_SPARSEMATRIX_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
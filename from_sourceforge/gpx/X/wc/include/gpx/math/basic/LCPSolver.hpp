@@ -0,0 +1,593 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_BASIC_LCPSOLVER_HPP_
+#define GPX_X_MATH_BASIC_LCPSOLVER_HPP_
+
+#include "../structures.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace gpx {
+namespace math {
+namespace basic {
+
+/**
+ * Linear complementarity problem solver workspace. Holds scratch storage of the solvers.
+ * @param N problem size in terms of number of unknowns.
+ * @param T underlying type.
+ */
+template <std::size_t N, typename T>
+class LCPSolverWorkspace
+{
+	template <int, std::size_t, typename>
+	friend class LCPSolver;
+
+	protected:
+		LCPSolverWorkspace();
+
+		std::size_t capacity() const;
+
+		void reserve(std::size_t size);
+
+	private:
+		typedef std::vector<std::size_t> IndicesContainer;
+		typedef std::vector<T> ValuesContainer;
+		typedef std::vector<int> StatesContainer;
+
+	private:
+		std::size_t m_capacity;
+		ValuesContainer m_w;
+		ValuesContainer m_dw;
+		ValuesContainer m_dx;
+		ValuesContainer m_z;
+		ValuesContainer m_l;
+		ValuesContainer m_d;
+		IndicesContainer m_clamped;
+		StatesContainer m_state;
+};
+
+template <std::size_t N, typename T>
+LCPSolverWorkspace<N, T>::LCPSolverWorkspace():
+	m_capacity(0)
+{
+	reserve(N);
+}
+
+template <std::size_t N, typename T>
+std::size_t LCPSolverWorkspace<N, T>::capacity() const
+{
+	return m_capacity;
+}
+
+template <std::size_t N, typename T>
+void LCPSolverWorkspace<N, T>::reserve(std::size_t size)
+{
+	if (size <= m_capacity)
+		return;
+
+	m_w.reserve(size);
+	m_dw.reserve(size);
+	m_dx.reserve(size);
+	m_z.reserve(size);
+	m_l.reserve(size * size);
+	m_d.reserve(size);
+	m_clamped.reserve(size);
+	m_state.reserve(size);
+	m_capacity = size;
+}
+
+/**
+ * Linear complementarity problem solver. Basic implementations are provided as
+ * specializations for each method.
+ * @param LCP_METHOD method used to solve problem.
+ * @param N problem size in terms of number of unknowns.
+ * @param T underlying type.
+ */
+template <int LCP_METHOD, std::size_t N, typename T>
+class LCPSolver;
+
+/**
+ * Linear complementarity problem solver (projected Gauss-Seidel specialization).
+ * Each iteration sweeps through unknowns, solving one equation at a time and
+ * projecting the result onto non-negative values. Method is iterative, thus results
+ * are approximate. Iterations stop when residual drops below tolerance or iteration
+ * limit is reached.
+ * @param N problem size in terms of number of unknowns.
+ * @param T underlying type.
+ */
+template <std::size_t N, typename T>
+class LCPSolver<gpx::math::LCP_PGS, N, T>
+{
+	public:
+		static const std::size_t INITIAL_MAX_ITERATIONS = 64;	///< Initial iteration limit.
+
+	public:
+		/**
+		 * Get iteration limit.
+		 * @return maximal number of iterations.
+		 */
+		std::size_t maxIterations() const;
+
+		/**
+		 * Set iteration limit.
+		 * @param maxIterations maximal number of iterations.
+		 */
+		void setMaxIterations(std::size_t maxIterations);
+
+		/**
+		 * Get tolerance.
+		 * @return tolerance, relative to largest absolute value of @a b vector.
+		 */
+		T tolerance() const;
+
+		/**
+		 * Set tolerance.
+		 * @param tolerance tolerance, relative to largest absolute value of @a b vector.
+		 */
+		void setTolerance(T tolerance);
+
+		/**
+		 * Get number of iterations performed by last call to solve().
+		 * @return number of iterations.
+		 */
+		std::size_t iterations() const;
+
+		/**
+		 * Get residual of last call to solve(). Residual is a largest change of a single
+		 * unknown during last iteration, scaled by corresponding diagonal element of
+		 * matrix @a a, so that it is expressed in units of @a b vector.
+		 * @return residual.
+		 */
+		T residual() const;
+
+		/**
+		 * Check if last call to solve() has converged.
+		 * @return @p true if residual dropped below tolerance, @p false if iteration
+		 * limit has been reached.
+		 */
+		bool converged() const;
+
+	protected:
+		LCPSolver(gpx::math::const_MatrixRef<N, N, T> a, LCPSolverWorkspace<N, T> & workspace);
+
+		void solve(gpx::math::const_VectorRef<N, T> b, gpx::math::VectorRef<N, T> x);
+
+	private:
+		gpx::math::const_MatrixRef<N, N, T> m_a;
+		std::size_t m_maxIterations;
+		T m_tolerance;
+		std::size_t m_iterations;
+		T m_residual;
+		bool m_converged;
+};
+
+template <std::size_t N, typename T>
+const std::size_t LCPSolver<gpx::math::LCP_PGS, N, T>::INITIAL_MAX_ITERATIONS;
+
+template <std::size_t N, typename T>
+LCPSolver<gpx::math::LCP_PGS, N, T>::LCPSolver(gpx::math::const_MatrixRef<N, N, T> a, LCPSolverWorkspace<N, T> & ):
+	m_a(a),
+	m_maxIterations(INITIAL_MAX_ITERATIONS),
+	m_tolerance(static_cast<T>(1.0e-6)),
+	m_iterations(0),
+	m_residual(T()),
+	m_converged(true)
+{
+}
+
+template <std::size_t N, typename T>
+std::size_t LCPSolver<gpx::math::LCP_PGS, N, T>::maxIterations() const
+{
+	return m_maxIterations;
+}
+
+template <std::size_t N, typename T>
+void LCPSolver<gpx::math::LCP_PGS, N, T>::setMaxIterations(std::size_t maxIterations)
+{
+	m_maxIterations = maxIterations;
+}
+
+template <std::size_t N, typename T>
+T LCPSolver<gpx::math::LCP_PGS, N, T>::tolerance() const
+{
+	return m_tolerance;
+}
+
+template <std::size_t N, typename T>
+void LCPSolver<gpx::math::LCP_PGS, N, T>::setTolerance(T tolerance)
+{
+	m_tolerance = tolerance;
+}
+
+template <std::size_t N, typename T>
+std::size_t LCPSolver<gpx::math::LCP_PGS, N, T>::iterations() const
+{
+	return m_iterations;
+}
+
+template <std::size_t N, typename T>
+T LCPSolver<gpx::math::LCP_PGS, N, T>::residual() const
+{
+	return m_residual;
+}
+
+template <std::size_t N, typename T>
+bool LCPSolver<gpx::math::LCP_PGS, N, T>::converged() const
+{
+	return m_converged;
+}
+
+template <std::size_t N, typename T>
+void LCPSolver<gpx::math::LCP_PGS, N, T>::solve(gpx::math::const_VectorRef<N, T> b, gpx::math::VectorRef<N, T> x)
+{
+	x.zero();
+	m_iterations = 0;
+	m_residual = T();
+	m_converged = true;
+
+	T scale = T();
+	for (std::size_t i = 0; i < b.size(); i++)
+		scale = std::max(scale, std::abs(b(i)));
+	if (scale == T())
+		return;
+
+	while (m_iterations < m_maxIterations) {
+		m_iterations++;
+		m_residual = T();
+		for (std::size_t i = 0; i < b.size(); i++) {
+			T aii = m_a(i, i);
+			if (aii <= T())
+				continue;	//unknown does not affect its own equation (e.g. equation has been removed), leave it zero
+			T w = -b(i);
+			for (std::size_t j = 0; j < b.size(); j++)
+				w += m_a(i, j) * x(j);
+			T xi = std::max(T(), x(i) - w / aii);
+			m_residual = std::max(m_residual, std::abs(xi - x(i)) * aii);
+			x(i) = xi;
+		}
+		if (m_residual <= m_tolerance * scale)
+			return;
+	}
+	m_converged = false;
+}
+
+/**
+ * Linear complementarity problem solver (Dantzig principal pivoting specialization).
+ * Unknowns are processed one by one. Each unknown, whose equation is violated, is
+ * driven up until its equation is satisfied, while unknowns with satisfied equations
+ * are kept in the clamped set (unknown positive, equation satisfied exactly) or
+ * free set (unknown zero, equation satisfied with slack). Whenever one of the
+ * unknowns or equations blocks further increase, index is moved between the sets.
+ * LDL^T factors of clamped submatrix are updated incrementally as indices enter or
+ * leave the clamped set, so that each pivot costs O(n^2) operations rather than
+ * a new factorization. Method is exact (up to round-off errors). Matrix is
+ * expected to be symmetric positive semi-definite. If problem can not be solved
+ * (e.g. matrix is indefinite or problem is infeasible), solved() returns @p false
+ * and results of last pivot are returned.
+ * @param N problem size in terms of number of unknowns.
+ * @param T underlying type.
+ */
+template <std::size_t N, typename T>
+class LCPSolver<gpx::math::LCP_DANTZIG, N, T>
+{
+	public:
+		/**
+		 * Get number of pivots performed by last call to solve().
+		 * @return number of pivots.
+		 */
+		std::size_t pivots() const;
+
+		/**
+		 * Get residual of last call to solve(). Residual is a largest violation of
+		 * complementarity conditions, expressed in units of @a b vector (unknowns are
+		 * scaled by corresponding diagonal elements of matrix @a a).
+		 * @return residual.
+		 */
+		T residual() const;
+
+		/**
+		 * Check if last call to solve() has succeeded.
+		 * @return @p true if problem has been solved, @p false otherwise.
+		 */
+		bool solved() const;
+
+	protected:
+		LCPSolver(gpx::math::const_MatrixRef<N, N, T> a, LCPSolverWorkspace<N, T> & workspace);
+
+		void solve(gpx::math::const_VectorRef<N, T> b, gpx::math::VectorRef<N, T> x);
+
+	private:
+		enum state_t {
+			UNPROCESSED,
+			FREE,
+			CLAMPED
+		};
+
+		typedef typename LCPSolverWorkspace<N, T>::ValuesContainer ValuesContainer;
+
+	private:
+		/**
+		 * Append index to clamped set, extending LDL^T factors by one row.
+		 * @param index index of unknown.
+		 * @return @p true on success, @p false if extended submatrix is singular.
+		 */
+		bool append(std::size_t index);
+
+		/**
+		 * Remove index from clamped set. Factors are downdated by removing row and
+		 * column and applying rank-1 update to trailing part of factors.
+		 * @param pos position of index within clamped set.
+		 */
+		void remove(std::size_t pos);
+
+		/**
+		 * Solve clamped system using LDL^T factors.
+		 * @param x right hand side on input, solution on output (in clamped set order).
+		 */
+		void solveClamped(ValuesContainer & x) const;
+
+		T & l(std::size_t row, std::size_t col);
+
+		T l(std::size_t row, std::size_t col) const;
+
+	private:
+		gpx::math::const_MatrixRef<N, N, T> m_a;
+		LCPSolverWorkspace<N, T> & m_workspace;
+		std::size_t m_pivots;
+		T m_residual;
+		bool m_solved;
+		T m_tol;
+};
+
+template <std::size_t N, typename T>
+LCPSolver<gpx::math::LCP_DANTZIG, N, T>::LCPSolver(gpx::math::const_MatrixRef<N, N, T> a, LCPSolverWorkspace<N, T> & workspace):
+	m_a(a),
+	m_workspace(workspace),
+	m_pivots(0),
+	m_residual(T()),
+	m_solved(true),
+	m_tol(T())
+{
+}
+
+template <std::size_t N, typename T>
+std::size_t LCPSolver<gpx::math::LCP_DANTZIG, N, T>::pivots() const
+{
+	return m_pivots;
+}
+
+template <std::size_t N, typename T>
+T LCPSolver<gpx::math::LCP_DANTZIG, N, T>::residual() const
+{
+	return m_residual;
+}
+
+template <std::size_t N, typename T>
+bool LCPSolver<gpx::math::LCP_DANTZIG, N, T>::solved() const
+{
+	return m_solved;
+}
+
+template <std::size_t N, typename T>
+void LCPSolver<gpx::math::LCP_DANTZIG, N, T>::solve(gpx::math::const_VectorRef<N, T> b, gpx::math::VectorRef<N, T> x)
+{
+	std::size_t n = b.size();
+	ValuesContainer & w = m_workspace.m_w;
+	ValuesContainer & dw = m_workspace.m_dw;
+	ValuesContainer & dx = m_workspace.m_dx;
+	typename LCPSolverWorkspace<N, T>::IndicesContainer & clamped = m_workspace.m_clamped;
+	typename LCPSolverWorkspace<N, T>::StatesContainer & state = m_workspace.m_state;
+	x.zero();
+	w.assign(n, T());
+	dw.assign(n, T());
+	state.assign(n, UNPROCESSED);
+	m_pivots = 0;
+	m_residual = T();
+	m_solved = true;
+	clamped.clear();
+	m_workspace.m_l.assign(n * n, T());
+	m_workspace.m_d.assign(n, T());
+
+	T maxDiag = T();
+	T maxB = T();
+	for (std::size_t i = 0; i < n; i++) {
+		maxDiag = std::max(maxDiag, std::abs(m_a(i, i)));
+		maxB = std::max(maxB, std::abs(b(i)));
+		w[i] = -b(i);
+	}
+	m_tol = static_cast<T>(n) * gpx::math::absEps(maxDiag);
+	T wTol = static_cast<T>(n) * gpx::math::absEps(maxB);
+	//Dantzig's method is not guaranteed to terminate in polynomial time, but in practice it takes few pivots per unknown
+	std::size_t maxPivots = 4 * n * (n + 1);
+
+	for (std::size_t d = 0; d < n && m_solved; d++) {
+		//equations of unprocessed unknowns are not tracked during pivoting
+		w[d] = -b(d);
+		for (std::size_t j = 0; j < n; j++)
+			w[d] += m_a(d, j) * x(j);
+
+		//drive unknown d until its equation is satisfied
+		while (w[d] < -wTol) {
+			//direction: dx(d) = 1, clamped equations remain satisfied
+			dx.resize(clamped.size());
+			for (std::size_t k = 0; k < clamped.size(); k++)
+				dx[k] = -m_a(clamped[k], d);
+			solveClamped(dx);
+			for (std::size_t i = 0; i <= d; i++)
+				if (state[i] != CLAMPED) {
+					dw[i] = m_a(i, d);
+					for (std::size_t k = 0; k < clamped.size(); k++)
+						dw[i] += m_a(i, clamped[k]) * dx[k];
+				}
+
+			//find blocking index
+			T step = T();
+			std::size_t blocking = n;
+			if (dw[d] > m_tol) {
+				step = -w[d] / dw[d];
+				blocking = d;
+			}
+			for (std::size_t k = 0; k < clamped.size(); k++)
+				if (dx[k] < T()) {
+					T s = std::max(T(), -x(clamped[k]) / dx[k]);
+					if (blocking == n || s < step) {
+						step = s;
+						blocking = clamped[k];
+					}
+				}
+			for (std::size_t i = 0; i < d; i++)
+				if (state[i] == FREE && dw[i] < -m_tol) {
+					T s = std::max(T(), -w[i] / dw[i]);
+					if (blocking == n || s < step) {
+						step = s;
+						blocking = i;
+					}
+				}
+			if (blocking == n || m_pivots++ == maxPivots) {
+				GPX_DEBUG("could not find blocking index or pivot limit reached while driving unknown: " << d);
+				m_solved = false;
+				break;
+			}
+
+			//make a step
+			for (std::size_t k = 0; k < clamped.size(); k++)
+				x(clamped[k]) += step * dx[k];
+			x(d) += step;
+			for (std::size_t i = 0; i <= d; i++)
+				if (state[i] != CLAMPED)
+					w[i] += step * dw[i];
+
+			//pivot
+			if (state[blocking] == CLAMPED) {
+				std::size_t pos = std::find(clamped.begin(), clamped.end(), blocking) - clamped.begin();
+				remove(pos);
+				x(blocking) = T();
+				state[blocking] = FREE;
+				//recalculate equation of unclamped unknown (w is not tracked for clamped set)
+				w[blocking] = -b(blocking);
+				for (std::size_t j = 0; j < n; j++)
+					w[blocking] += m_a(blocking, j) * x(j);
+			} else {
+				w[blocking] = T();
+				if (!append(blocking)) {
+					GPX_DEBUG("clamped submatrix became singular while driving unknown: " << d);
+					m_solved = false;
+					break;
+				}
+				state[blocking] = CLAMPED;
+				if (blocking == d)
+					break;
+			}
+		}
+		if (state[d] == UNPROCESSED)
+			state[d] = FREE;
+	}
+
+	for (std::size_t i = 0; i < n; i++)
+		x(i) = std::max(T(), x(i));
+	for (std::size_t i = 0; i < n; i++) {
+		T wi = -b(i);
+		for (std::size_t j = 0; j < n; j++)
+			wi += m_a(i, j) * x(j);
+		m_residual = std::max(m_residual, std::abs(std::min(x(i) * std::abs(m_a(i, i)), wi)));
+	}
+}
+
+template <std::size_t N, typename T>
+bool LCPSolver<gpx::math::LCP_DANTZIG, N, T>::append(std::size_t index)
+{
+	std::size_t m = m_workspace.m_clamped.size();
+	//forward substitution (L y = a_Ci), l_i = y / D, d_i = a_ii - l_i y
+	T d = m_a(index, index);
+	for (std::size_t k = 0; k < m; k++) {
+		T y = m_a(m_workspace.m_clamped[k], index);
+		for (std::size_t c = 0; c < k; c++)
+			y -= l(k, c) * l(m, c) * m_workspace.m_d[c];
+		l(m, k) = y / m_workspace.m_d[k];
+		d -= l(m, k) * y;
+	}
+	if (d <= m_tol)
+		return false;
+	m_workspace.m_d[m] = d;
+	m_workspace.m_clamped.push_back(index);
+	return true;
+}
+
+template <std::size_t N, typename T>
+void LCPSolver<gpx::math::LCP_DANTZIG, N, T>::remove(std::size_t pos)
+{
+	std::size_t m = m_workspace.m_clamped.size();
+	//column of removed index contributes to trailing submatrix with rank-1 term
+	ValuesContainer & z = m_workspace.m_z;
+	z.resize(m - pos - 1);
+	for (std::size_t r = pos + 1; r < m; r++)
+		z[r - pos - 1] = l(r, pos);
+	T alpha = m_workspace.m_d[pos];
+
+	//remove row and column
+	for (std::size_t r = pos + 1; r < m; r++) {
+		for (std::size_t c = 0; c < pos; c++)
+			l(r - 1, c) = l(r, c);
+		for (std::size_t c = pos + 1; c < r; c++)
+			l(r - 1, c - 1) = l(r, c);
+		m_workspace.m_d[r - 1] = m_workspace.m_d[r];
+	}
+	m_workspace.m_clamped.erase(m_workspace.m_clamped.begin() + pos);
+	m--;
+
+	//rank-1 update of trailing factors
+	for (std::size_t j = pos; j < m; j++) {
+		T p = z[j - pos];
+		T d = m_workspace.m_d[j] + alpha * p * p;
+		T beta = p * alpha / d;
+		alpha = m_workspace.m_d[j] * alpha / d;
+		m_workspace.m_d[j] = d;
+		for (std::size_t r = j + 1; r < m; r++) {
+			z[r - pos] -= p * l(r, j);
+			l(r, j) += beta * z[r - pos];
+		}
+	}
+}
+
+template <std::size_t N, typename T>
+void LCPSolver<gpx::math::LCP_DANTZIG, N, T>::solveClamped(ValuesContainer & x) const
+{
+	std::size_t m = m_workspace.m_clamped.size();
+	for (std::size_t k = 0; k < m; k++)
+		for (std::size_t c = 0; c < k; c++)
+			x[k] -= l(k, c) * x[c];
+	for (std::size_t k = 0; k < m; k++)
+		x[k] /= m_workspace.m_d[k];
+	for (std::size_t k = m; k-- > 0;)
+		for (std::size_t r = k + 1; r < m; r++)
+			x[k] -= l(r, k) * x[r];
+}
+
+template <std::size_t N, typename T>
+inline
+T & LCPSolver<gpx::math::LCP_DANTZIG, N, T>::l(std::size_t row, std::size_t col)
+{
+	return m_workspace.m_l[row * m_workspace.m_d.size() + col];
+}
+
+template <std::size_t N, typename T>
+inline
+T LCPSolver<gpx::math::LCP_DANTZIG, N, T>::l(std::size_t row, std::size_t col) const
+{
+	return m_workspace.m_l[row * m_workspace.m_d.size() + col];
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_BASIC_LCPSOLVER_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
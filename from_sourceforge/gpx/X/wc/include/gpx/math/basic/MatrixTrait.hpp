@@ -1,6 +1,8 @@
 #ifndef GPX_X_MATH_BASIC_MATRIXTRAIT_HPP
 #define GPX_X_MATH_BASIC_MATRIXTRAIT_HPP
 
+#include "kernels.hpp"
+
 #include <algorithm>
 
 namespace gpx {
@@ -74,7 +76,7 @@ void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::Invert(DERIVED<N, N, T> & derived)
 	}
 	//copy column by column
 	for (std::size_t j = 0; j < derived.cols(); j++)
-		std::copy(I.ptr(0, index[j]), I.ptr(0, index[j]) + derived.rows(), derived.ptr(0, j));
+		std::copy(I.ptr() + index[j] * derived.rows(), I.ptr() + (index[j] + 1) * derived.rows(), derived.ptr() + j * derived.rows());
 }
 
 template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
@@ -94,6 +96,8 @@ void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::sub(gpx::math::const_MatrixRef<M, N
 template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
 void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::mul(gpx::math::const_MatrixRef<N, N, T> other)
 {
+	if (SmallMatrixKernels<M, N, T>::Mul(derived().ptr(), other.ptr()))
+		return;
 	Matrix<M, N, T> tmp(derived());	//temporal copy
 	for (std::size_t r = 0; r < derived().rows(); r++) {
 		for (std::size_t c = 0; c < derived().cols(); c++) {
@@ -142,7 +146,8 @@ void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::swapCols(std::size_t c1, std::size_
 template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
 DERIVED<M, N, T> & MatrixTrait<DERIVED, M, N, T, DIMSPEC>::derived()
 {
-	return static_cast<DERIVED<M, N, T> & >(*this);
+	//C-style cast, see const_VectorTrait::derived()
+	return (DERIVED<M, N, T> & )*this;
 }
 
 /**
@@ -158,6 +163,7 @@ class MatrixTrait<DERIVED, N, N, T, true> : public MatrixTrait<DERIVED, N, N, T,
 
 		/*
 		 * Basic implementation which uses Gauss-Jordan transformations with pivoting.
+		 * Matrices 2x2, 3x3 and 4x4 are inverted with closed-form formulas.
 		 * @warning if matrix is singular method will fail.
 		 */
 		void invert();
@@ -166,6 +172,8 @@ class MatrixTrait<DERIVED, N, N, T, true> : public MatrixTrait<DERIVED, N, N, T,
 template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t N, typename T>
 void MatrixTrait<DERIVED, N, N, T, true>::transpose()
 {
+	if (SmallMatrixKernels<N, N, T>::Transpose(Parent::derived().ptr()))
+		return;
 	for (std::size_t i = 0; i < Parent::derived().rows(); i++)
 		for(std::size_t j = i + 1; j < Parent::derived().cols(); j++)
 			std::swap(Parent::derived().element(i, j), Parent::derived().element(j, i));
@@ -174,6 +182,8 @@ void MatrixTrait<DERIVED, N, N, T, true>::transpose()
 template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t N, typename T>
 void MatrixTrait<DERIVED, N, N, T, true>::invert()
 {
+	if (SmallMatrixKernels<N, N, T>::Invert(Parent::derived().ptr()))
+		return;
 	Parent::Invert(Parent::derived());
 }
 
@@ -10,11 +10,123 @@
 
 #include <algorithm>
 #include <numeric>
+#include <vector>
 
 namespace gpx {
 namespace math {
 namespace basic {
 
+/**
+ * Non-negative linear equation solver workspace. Holds scratch storage of the solver.
+ * @param N linear system size in terms of number of equations.
+ * @param T underlying type.
+ */
+template <std::size_t N, typename T>
+class NNSolverWorkspace
+{
+	template <int, std::size_t, typename>
+	friend class NNSolver;
+
+	protected:
+		NNSolverWorkspace();
+
+		std::size_t capacity() const;
+
+		void reserve(std::size_t size);
+
+	private:
+		typedef std::vector<std::size_t> IndicesContainer;
+		typedef std::vector<bool> FlagsContainer;
+
+	protected:
+		template <std::size_t M>
+		static void Reserve(gpx::math::Matrix<M, M, T> & a, std::size_t size);
+
+		static void Reserve(gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> & a, std::size_t size);
+
+		template <std::size_t M>
+		static void Reserve(gpx::math::Vector<M, T> & v, std::size_t size);
+
+		static void Reserve(gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> & v, std::size_t size);
+
+	private:
+		std::size_t m_capacity;
+		gpx::math::Matrix<N, N, T> m_a;
+		gpx::math::Vector<N, T> m_bOrg;
+		gpx::math::Vector<N, T> m_divisors;
+		gpx::math::Vector<N, T> m_z;
+		IndicesContainer m_jWhat;
+		IndicesContainer m_iWhat;
+		IndicesContainer m_iWhere;
+		IndicesContainer m_perm;
+		FlagsContainer m_clipped;
+};
+
+template <std::size_t N, typename T>
+NNSolverWorkspace<N, T>::NNSolverWorkspace():
+	m_capacity(N),
+	m_a(N, N),
+	m_bOrg(N),
+	m_divisors(N),
+	m_z(N)
+{
+	m_jWhat.reserve(N);
+	m_iWhat.reserve(N);
+	m_iWhere.reserve(N);
+	m_perm.reserve(N);
+	m_clipped.reserve(N);
+}
+
+template <std::size_t N, typename T>
+std::size_t NNSolverWorkspace<N, T>::capacity() const
+{
+	return m_capacity;
+}
+
+template <std::size_t N, typename T>
+void NNSolverWorkspace<N, T>::reserve(std::size_t size)
+{
+	if (size <= m_capacity)
+		return;
+
+	Reserve(m_a, size * size);
+	Reserve(m_bOrg, size);
+	Reserve(m_divisors, size);
+	Reserve(m_z, size);
+	m_jWhat.reserve(size);
+	m_iWhat.reserve(size);
+	m_iWhere.reserve(size);
+	m_perm.reserve(size);
+	m_clipped.reserve(size);
+	m_capacity = size;
+}
+
+template <std::size_t N, typename T>
+template <std::size_t M>
+void NNSolverWorkspace<N, T>::Reserve(gpx::math::Matrix<M, M, T> & , std::size_t )
+{
+	//fixed size matrix
+}
+
+template <std::size_t N, typename T>
+void NNSolverWorkspace<N, T>::Reserve(gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> & a, std::size_t size)
+{
+	a.reserve(size);
+}
+
+template <std::size_t N, typename T>
+template <std::size_t M>
+void NNSolverWorkspace<N, T>::Reserve(gpx::math::Vector<M, T> & , std::size_t )
+{
+	//fixed size vector
+}
+
+template <std::size_t N, typename T>
+void NNSolverWorkspace<N, T>::Reserve(gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> & v, std::size_t size)
+{
+	v.reserve(size);
+}
+
 /**
  * Linear equation solver. Basic implementation, using Gaussian elimination with
  * pivoting.
@@ -25,36 +137,49 @@ namespace basic {
 template <int EQ_FLAGS, std::size_t N, typename T>
 class NNSolver
 {
+	template <int, std::size_t, typename>
+	friend class NNSolver;
+
 	protected:
-		NNSolver(gpx::math::MatrixRef<N, N, T> a);
+		NNSolver(gpx::math::MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace);
 
-		gpx::math::Vector<N, T> solve(gpx::math::VectorRef<N, T> b);
+		void solve(gpx::math::VectorRef<N, T> b, gpx::math::VectorRef<N, T> result);
 
 	private:
 		gpx::math::MatrixRef<N, N, T> m_a;
+		NNSolverWorkspace<N, T> & m_workspace;
 };
 
 template <int EQ_FLAGS, std::size_t N, typename T>
-NNSolver<EQ_FLAGS, N, T>::NNSolver(gpx::math::MatrixRef<N, N, T> a):
-	m_a(a)
+NNSolver<EQ_FLAGS, N, T>::NNSolver(gpx::math::MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace):
+	m_a(a),
+	m_workspace(workspace)
 {
 }
 
 
 template <int EQ_FLAGS, std::size_t N, typename T>
-gpx::math::Vector<N, T> NNSolver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N, T> b)
+void NNSolver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N, T> b, gpx::math::VectorRef<N, T> result)
 {
 	//Rough, fast written piece of code... although it solves systems of dependent equations.
 
-	gpx::math::Vector<N, T> result(T(), b.size());
+	m_workspace.reserve(b.size());
+	result.zero();
 #pragma message("temporary code")
-	gpx::math::Vector<> bOrg(b);
-	gpx::math::Vector<N, T> divisors(T(), b.size());	//tmp
+	gpx::math::Vector<N, T> & bOrg = m_workspace.m_bOrg;
+	bOrg = b;
+	gpx::math::Vector<N, T> & divisors = m_workspace.m_divisors;	//tmp
+	divisors = b;
+	divisors.zero();
 //end pragma
-	gpx::math::Matrix<N, N, T> a(m_a);
-	std::vector<std::size_t> jWhat(b.size(), 0u);	//what is under column j, e.g., jWhat[1] == 2 indicates that under column 1 lies former column 2
-	std::vector<std::size_t> iWhat(b.size(), 0u);
-	std::vector<std::size_t> iWhere(b.size(), 0u); //where row i has been moved, e.g., iWhere[1] == 2 indicates that former row 1 has been moved to row 2
+	gpx::math::Matrix<N, N, T> & a = m_workspace.m_a;
+	a = m_a;
+	std::vector<std::size_t> & jWhat = m_workspace.m_jWhat;	//what is under column j, e.g., jWhat[1] == 2 indicates that under column 1 lies former column 2
+	std::vector<std::size_t> & iWhat = m_workspace.m_iWhat;
+	std::vector<std::size_t> & iWhere = m_workspace.m_iWhere; //where row i has been moved, e.g., iWhere[1] == 2 indicates that former row 1 has been moved to row 2
+	jWhat.resize(b.size());
+	iWhat.resize(b.size());
+	iWhere.resize(b.size());
 
 	for (std::size_t init = 0; init < b.size(); init++) {
 		iWhat[init] = init;
@@ -127,8 +252,8 @@ gpx::math::Vector<N, T> NNSolver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N,
 	//					a(ii, jj) -= multiplier * a(i, jj);
 			}
 		}
-		GPX_INFO("m_a: " << std::endl << a);
-		GPX_INFO("m_b: " << std::endl << b);
+		GPX_TRACE("m_a: " << std::endl << a);
+		GPX_TRACE("m_b: " << std::endl << b);
 		i++;
 	}
 
@@ -148,8 +273,8 @@ gpx::math::Vector<N, T> NNSolver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N,
 		}
 
 		if (gpx::math::cgt(T(), result(jj))) {
-			GPX_INFO("removing negative result(" << jj << "): " << result);
-			GPX_INFO("b vector: " << b);
+			GPX_TRACE("removing negative result(" << jj << "): " << result);
+			GPX_TRACE("b vector: " << b);
 			std::size_t ii = iWhere[jj];
 			b(ii) -= result(jj) / a(i, ii);
 //			if (a(i, ii) )
@@ -162,19 +287,19 @@ gpx::math::Vector<N, T> NNSolver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N,
 
 	//			if (b(i) < T())
 	//				b(i) = T();
-			GPX_INFO("new b vector: " << b);
+			GPX_TRACE("new b vector: " << b);
 
 
 			#pragma message("temporary code")
 			for (std::size_t iTmp = 0; iTmp < b.size(); iTmp++)
 				result(iTmp) = b(iWhere[iTmp]) * divisors(iWhere[iTmp]);
-			GPX_INFO("b vector with original values: " << bOrg);
-			GPX_INFO("new b vector with original values: " << result);
+			GPX_TRACE("b vector with original values: " << bOrg);
+			GPX_TRACE("new b vector with original values: " << result);
 			result.zero();
 			for (std::size_t iTmp = 0; iTmp < a.rows(); iTmp++)
 				for (std::size_t jTmp = 0; jTmp < a.cols(); jTmp++)
 					result(jWhat[iTmp]) += a(iTmp, jTmp) * b(jTmp);
-			GPX_INFO("new result vector: " << result);
+			GPX_TRACE("new result vector: " << result);
 			//end #pragma message("temporary code")
 
 			result.zero();
@@ -183,7 +308,157 @@ gpx::math::Vector<N, T> NNSolver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N,
 		} else
 			i++;
 	}
-	return result;
+}
+
+/**
+ * Linear equation solver (symmetric specialization). Solver uses LDL^T factorization
+ * with diagonal pivoting, which takes roughly a third of the operations performed
+ * by Gaussian elimination. Matrix is expected to be symmetric positive semi-definite.
+ * Dependent equations of semi-definite systems are recognized during factorization
+ * and corresponding results are set to zero. If matrix turns out to be indefinite,
+ * solver falls back to general method. Negative results are eliminated by clipping
+ * corresponding equations from the system and solving remaining ones again.
+ * @param N linear system size in terms of number of equations.
+ * @param T underlying type.
+ */
+template <std::size_t N, typename T>
+class NNSolver<gpx::math::EQ_SYMMETRIC, N, T>
+{
+	protected:
+		NNSolver(gpx::math::MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace);
+
+		void solve(gpx::math::VectorRef<N, T> b, gpx::math::VectorRef<N, T> result);
+
+	private:
+		typedef std::vector<std::size_t> IndicesContainer;
+
+	private:
+		/**
+		 * Factorize. Performs LDL^T factorization of matrix composed of rows and
+		 * columns given by indices.
+		 * @param a matrix to be factorized. Factors are stored in place of matrix
+		 * elements (L below diagonal, D on diagonal), with respect to indices.
+		 * @param perm indices of rows and columns. On output indices are permuted
+		 * in pivoting order.
+		 * @param rank rank of factorized matrix.
+		 * @return @p true if factorization succeeded, @p false if matrix is not
+		 * positive semi-definite.
+		 */
+		static bool Factorize(gpx::math::Matrix<N, N, T> & a, IndicesContainer & perm, std::size_t & rank);
+
+	private:
+		gpx::math::MatrixRef<N, N, T> m_a;
+		NNSolverWorkspace<N, T> & m_workspace;
+};
+
+template <std::size_t N, typename T>
+NNSolver<gpx::math::EQ_SYMMETRIC, N, T>::NNSolver(gpx::math::MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace):
+	m_a(a),
+	m_workspace(workspace)
+{
+}
+
+template <std::size_t N, typename T>
+void NNSolver<gpx::math::EQ_SYMMETRIC, N, T>::solve(gpx::math::VectorRef<N, T> b, gpx::math::VectorRef<N, T> result)
+{
+	m_workspace.reserve(b.size());
+	result.zero();
+	std::vector<bool> & clipped = m_workspace.m_clipped;
+	clipped.assign(b.size(), false);
+	IndicesContainer & perm = m_workspace.m_perm;
+	gpx::math::Vector<N, T> & z = m_workspace.m_z;
+	z = b;
+	gpx::math::Matrix<N, N, T> & a = m_workspace.m_a;
+
+	//each pass clips at least one equation, so number of passes is limited by system size
+	for (std::size_t pass = 0; pass <= b.size(); pass++) {
+		perm.clear();
+		for (std::size_t i = 0; i < b.size(); i++)
+			if (!clipped[i])
+				perm.push_back(i);
+
+		a = m_a;
+		std::size_t rank;
+		if (!Factorize(a, perm, rank)) {
+			GPX_DEBUG("matrix is not positive semi-definite, falling back to general solver");
+			NNSolver<gpx::math::EQ_GENERAL, N, T> general(m_a, m_workspace);
+			general.solve(b, result);
+			return;
+		}
+
+		//forward substitution (L z = b) and division by D
+		for (std::size_t i = 0; i < rank; i++) {
+			z(i) = b(perm[i]);
+			for (std::size_t j = 0; j < i; j++)
+				z(i) -= a(perm[i], perm[j]) * z(j);
+		}
+		for (std::size_t i = 0; i < rank; i++)
+			z(i) /= a(perm[i], perm[i]);
+
+		//back substitution (L^T x = z), dependent equations yield zero
+		result.zero();
+		for (std::size_t i = rank; i-- > 0;) {
+			T x = z(i);
+			for (std::size_t j = i + 1; j < rank; j++)
+				x -= a(perm[j], perm[i]) * result(perm[j]);
+			result(perm[i]) = x;
+		}
+
+		//clip equations giving negative results
+		bool negative = false;
+		for (std::size_t i = 0; i < rank; i++)
+			if (gpx::math::cgt(T(), result(perm[i]))) {
+				GPX_DEBUG("removing negative result(" << perm[i] << "): " << result(perm[i]));
+				clipped[perm[i]] = true;
+				negative = true;
+			} else if (result(perm[i]) < T())
+				result(perm[i]) = T();
+		if (!negative)
+			return;
+		result.zero();
+	}
+	GPX_WARN("could not remove negative values");
+}
+
+template <std::size_t N, typename T>
+bool NNSolver<gpx::math::EQ_SYMMETRIC, N, T>::Factorize(gpx::math::Matrix<N, N, T> & a, IndicesContainer & perm, std::size_t & rank)
+{
+	std::size_t n = perm.size();
+	T maxDiag = T();
+	for (std::size_t i = 0; i < n; i++)
+		maxDiag = std::max(maxDiag, std::abs(a(perm[i], perm[i])));
+	T tol = static_cast<T>(n) * gpx::math::absEps(maxDiag);
+
+	for (rank = 0; rank < n; rank++) {
+		//pivot is the largest diagonal element of remaining submatrix
+		std::size_t pivot = rank;
+		for (std::size_t i = rank + 1; i < n; i++)
+			if (a(perm[i], perm[i]) > a(perm[pivot], perm[pivot]))
+				pivot = i;
+		std::swap(perm[rank], perm[pivot]);
+
+		std::size_t p = perm[rank];
+		T d = a(p, p);
+		if (d <= tol) {
+			//remaining submatrix of positive semi-definite matrix should vanish
+			for (std::size_t i = rank; i < n; i++)
+				for (std::size_t j = rank; j <= i; j++)
+					if (std::abs(a(perm[i], perm[j])) > tol)
+						return false;
+			return true;
+		}
+
+		for (std::size_t i = rank + 1; i < n; i++)
+			a(perm[i], p) /= d;
+		for (std::size_t i = rank + 1; i < n; i++) {
+			T ld = a(perm[i], p) * d;
+			for (std::size_t j = rank + 1; j <= i; j++) {
+				a(perm[i], perm[j]) -= ld * a(perm[j], p);
+				a(perm[j], perm[i]) = a(perm[i], perm[j]);
+			}
+		}
+	}
+	return true;
 }
 
 //template <int EQ_FLAGS, std::size_t N, typename T>
@@ -52,8 +52,8 @@ gpx::math::Vector<N, T> Solver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N, T>
 					a(ii, jj) -= a(ii, j) * a(i, jj);
 				b(ii) -= a(ii, j) * b(i);
 			}
-			GPX_INFO("m_a: " << std::endl << a);
-			GPX_INFO("m_b: " << std::endl << b);
+			GPX_TRACE("m_a: " << std::endl << a);
+			GPX_TRACE("m_b: " << std::endl << b);
 		}
 		i++;
 	}
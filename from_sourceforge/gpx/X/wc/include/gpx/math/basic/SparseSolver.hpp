@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_BASIC_SPARSESOLVER_HPP_
+#define GPX_X_MATH_BASIC_SPARSESOLVER_HPP_
+
+#include "../SparseMatrix.hpp"
+
+namespace gpx {
+namespace math {
+namespace basic {
+
+/**
+ * Sparse direct solver of symmetric positive definite systems. Basic backend does not
+ * provide sparse factorization, thus factorize() always fails and sparse solvers stick
+ * to iterative methods.
+ * @param T underlying type.
+ */
+template <typename T>
+class SparseSolver
+{
+	public:
+		/**
+		 * Factorize matrix. Rows with non-positive diagonal elements are treated as
+		 * removed equations. Their unknowns are fixed at zero.
+		 * @param a compressed symmetric matrix.
+		 * @return @p true if matrix has been factorized, @p false otherwise.
+		 */
+		bool factorize(const gpx::math::SparseMatrix<T> & a);
+
+		/**
+		 * Solve system factorized by last successful call to factorize().
+		 * @param b right hand side.
+		 * @param x solution.
+		 */
+		void solve(gpx::math::const_VectorRef<gpx::math::SIZE_DYNAMIC, T> b, gpx::math::VectorRef<gpx::math::SIZE_DYNAMIC, T> x);
+};
+
+template <typename T>
+bool SparseSolver<T>::factorize(const gpx::math::SparseMatrix<T> & )
+{
+	return false;
+}
+
+template <typename T>
+void SparseSolver<T>::solve(gpx::math::const_VectorRef<gpx::math::SIZE_DYNAMIC, T> , gpx::math::VectorRef<gpx::math::SIZE_DYNAMIC, T> )
+{
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_BASIC_SPARSESOLVER_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -162,7 +162,8 @@ void VectorTrait<DERIVED, N, T, DIMSPEC>::swap(std::size_t c1, std::size_t c2)
 template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
 DERIVED<N, T> & VectorTrait<DERIVED, N, T, DIMSPEC>::derived()
 {
-	return static_cast<DERIVED<N, T> & >(*this);
+	//C-style cast, see const_VectorTrait::derived()
+	return (DERIVED<N, T> & )*this;
 }
 
 /**
@@ -13,6 +13,8 @@
 #define GPX_X_MATH_BACKEND_MATRIXTRAIT_HEADER "basic/MatrixTrait.hpp"
 #define GPX_X_MATH_BACKEND_SOLVER_HEADER "basic/Solver.hpp"
 #define GPX_X_MATH_BACKEND_NNSOLVER_HEADER "basic/NNSolver.hpp"
+#define GPX_X_MATH_BACKEND_LCPSOLVER_HEADER "basic/LCPSolver.hpp"
+#define GPX_X_MATH_BACKEND_SPARSESOLVER_HEADER "basic/SparseSolver.hpp"
 
 /** @todo remove obsolete macros */
 #define GPX_X_MATH_BACKEND_BASE_VECTOR_HEADER "basic/base_Vector.hpp"
@@ -2,6 +2,7 @@
 #define GPX_X_MATH_BASIC_CONST_MATRIXTRAIT_HPP
 
 #include "traits.hpp"
+#include "kernels.hpp"
 
 #include <algorithm>
 
@@ -203,6 +204,8 @@ template <std::size_t ON>
 gpx::math::Matrix<M, ON, T> const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::prod(gpx::math::const_MatrixRef<N, ON, T> other) const
 {
 	gpx::math::Matrix<M, ON, T> result(T(), derived().rows(), other.cols());
+	if (SmallMatrixKernels<M, N, T>::Gemm(derived().ptr(), other.ptr(), other.cols(), result.ptr()))
+		return result;
 	for (std::size_t r = 0; r < derived().rows(); r++) {
 		for (std::size_t c = 0; c < other.cols(); c++) {
 			for (std::size_t cr = 0; cr < derived().cols(); cr++)
@@ -216,6 +219,8 @@ template <template <std::size_t, std::size_t, typename> class DERIVED, std::size
 gpx::math::Vector<M, T> const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::prod(gpx::math::const_VectorRef<N, T> vec) const
 {
 	gpx::math::Vector<M, T> result(derived().rows());
+	if (SmallMatrixKernels<M, N, T>::Gemv(derived().ptr(), vec.ptr(), result.ptr()))
+		return result;
 	const T * colPtr = derived().ptr();
 	for (std::size_t c = 0; c < derived().cols(); c++) {
 		for (std::size_t r = 0; r < derived().rows(); r++)
@@ -246,7 +251,8 @@ gpx::math::Matrix<N, M, T> const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::transpo
 template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
 const DERIVED<M, N, T> & const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::derived() const
 {
-	return static_cast<const DERIVED<M, N, T> & >(*this);
+	//C-style cast, see const_VectorTrait::derived()
+	return (const DERIVED<M, N, T> & )*this;
 }
 
 template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
@@ -285,6 +291,9 @@ class const_MatrixTrait<DERIVED, N, N, T, true> : public const_MatrixTrait<DERIV
 template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t N, typename T>
 T const_MatrixTrait<DERIVED, N, N, T, true>::det() const
 {
+	T result;
+	if (SmallMatrixKernels<N, N, T>::Det(Parent::derived().ptr(), result))
+		return result;
 	if (Parent::derived().size() == 1)
 		return Parent::derived().element(0);
 	return Parent::Det(Parent::derived().ptr(), Parent::derived().cols());
@@ -332,7 +332,8 @@ gpx::math::Vector<N, T> const_VectorTrait<DERIVED, N, T, DIMSPEC>::rotated(T ang
 template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
 const DERIVED<N, T> & const_VectorTrait<DERIVED, N, T, DIMSPEC>::derived() const
 {
-	return static_cast<const DERIVED<N, T> & >(*this);
+	//C-style cast ignores accessibility of private base, so that other backends can extend this class
+	return (const DERIVED<N, T> & )*this;
 }
 
 
@@ -0,0 +1,282 @@
+/**
+ * @file
+ * @brief Small matrix kernels of basic math backend.
+ */
+
+#ifndef GPX_X_MATH_BASIC_KERNELS_HPP_
+#define GPX_X_MATH_BASIC_KERNELS_HPP_
+
+#include <cstddef>
+#include <algorithm>
+
+namespace gpx {
+namespace math {
+namespace basic {
+
+/**
+ * Small matrix kernels. Generic version, which does not process anything. Each function
+ * returns @p true if it has computed the result, so that caller can fall back to generic
+ * loops otherwise. Specializations for 2x2, 3x3 and 4x4 matrices are fully unrolled and
+ * use closed-form formulas for determinants and inverses.
+ *
+ * Kernels operate on column-major arrays. Products perform exactly the same floating
+ * point operations in the same order as generic loops, so they give bit-identical results.
+ * Determinants of 2x2 and 3x3 matrices are calculated with the same cofactor expansion
+ * as const_MatrixTrait::Det(). Inverses are computed from adjugate matrix, so they may
+ * differ in the last bits from Gauss-Jordan elimination.
+ */
+template <std::size_t M, std::size_t N, typename T>
+struct SmallMatrixKernels
+{
+	static bool Gemm(const T * , const T * , std::size_t , T * ) { return false; }
+
+	static bool Gemv(const T * , const T * , T * ) { return false; }
+
+	static bool Mul(T * , const T * ) { return false; }
+
+	static bool Transpose(T * ) { return false; }
+
+	static bool Det(const T * , T & ) { return false; }
+
+	static bool Invert(T * ) { return false; }
+};
+
+/**
+ * Small matrix kernels. 2x2 matrices.
+ */
+template <typename T>
+struct SmallMatrixKernels<2, 2, T>
+{
+	/**
+	 * Matrix-matrix product. Computes c = a * b.
+	 * @param a 2x2 matrix.
+	 * @param b matrix with 2 rows.
+	 * @param cols number of columns of @a b.
+	 * @param c result matrix (must not alias @a a nor @a b).
+	 */
+	static bool Gemm(const T * a, const T * b, std::size_t cols, T * c)
+	{
+		for (std::size_t j = 0; j < cols; j++, b += 2, c += 2)
+			Gemv(a, b, c);
+		return true;
+	}
+
+	/**
+	 * Matrix-vector product. Computes y = a * x.
+	 * @param a 2x2 matrix.
+	 * @param x vector.
+	 * @param y result vector (must not alias @a x).
+	 */
+	static bool Gemv(const T * a, const T * x, T * y)
+	{
+		y[0] = a[0] * x[0] + a[2] * x[1];
+		y[1] = a[1] * x[0] + a[3] * x[1];
+		return true;
+	}
+
+	/**
+	 * In-place product. Computes a = a * b.
+	 */
+	static bool Mul(T * a, const T * b)
+	{
+		T tmp[4];
+		std::copy(a, a + 4, tmp);
+		return Gemm(tmp, b, 2, a);
+	}
+
+	static bool Transpose(T * a)
+	{
+		std::swap(a[1], a[2]);
+		return true;
+	}
+
+	static bool Det(const T * a, T & det)
+	{
+		det = a[0] * a[3] - (a[1] * a[2]);
+		return true;
+	}
+
+	/**
+	 * Invert matrix.
+	 * @warning if matrix is singular result is undefined.
+	 */
+	static bool Invert(T * a)
+	{
+		T invDet = static_cast<T>(1.0) / (a[0] * a[3] - (a[1] * a[2]));
+		T a0 = a[0];
+		a[0] = a[3] * invDet;
+		a[1] = -a[1] * invDet;
+		a[2] = -a[2] * invDet;
+		a[3] = a0 * invDet;
+		return true;
+	}
+};
+
+/**
+ * Small matrix kernels. 3x3 matrices.
+ */
+template <typename T>
+struct SmallMatrixKernels<3, 3, T>
+{
+	static bool Gemm(const T * a, const T * b, std::size_t cols, T * c)
+	{
+		for (std::size_t j = 0; j < cols; j++, b += 3, c += 3)
+			Gemv(a, b, c);
+		return true;
+	}
+
+	static bool Gemv(const T * a, const T * x, T * y)
+	{
+		y[0] = a[0] * x[0] + a[3] * x[1] + a[6] * x[2];
+		y[1] = a[1] * x[0] + a[4] * x[1] + a[7] * x[2];
+		y[2] = a[2] * x[0] + a[5] * x[1] + a[8] * x[2];
+		return true;
+	}
+
+	static bool Mul(T * a, const T * b)
+	{
+		T tmp[9];
+		std::copy(a, a + 9, tmp);
+		return Gemm(tmp, b, 3, a);
+	}
+
+	static bool Transpose(T * a)
+	{
+		std::swap(a[1], a[3]);
+		std::swap(a[2], a[6]);
+		std::swap(a[5], a[7]);
+		return true;
+	}
+
+	static bool Det(const T * a, T & det)
+	{
+		//cofactor expansion along first column
+		det = a[0] * (a[4] * a[8] - (a[5] * a[7])) - a[1] * (a[3] * a[8] - (a[5] * a[6])) + a[2] * (a[3] * a[7] - (a[4] * a[6]));
+		return true;
+	}
+
+	static bool Invert(T * a)
+	{
+		//inverse is a transposed matrix of cofactors divided by determinant
+		T c0 = a[4] * a[8] - (a[5] * a[7]);
+		T c1 = a[3] * a[8] - (a[5] * a[6]);
+		T c2 = a[3] * a[7] - (a[4] * a[6]);
+		T invDet = static_cast<T>(1.0) / (a[0] * c0 - a[1] * c1 + a[2] * c2);
+		T b[9];
+		b[0] = c0 * invDet;
+		b[1] = (a[2] * a[7] - a[1] * a[8]) * invDet;
+		b[2] = (a[1] * a[5] - a[2] * a[4]) * invDet;
+		b[3] = -c1 * invDet;
+		b[4] = (a[0] * a[8] - a[2] * a[6]) * invDet;
+		b[5] = (a[2] * a[3] - a[0] * a[5]) * invDet;
+		b[6] = c2 * invDet;
+		b[7] = (a[1] * a[6] - a[0] * a[7]) * invDet;
+		b[8] = (a[0] * a[4] - a[1] * a[3]) * invDet;
+		std::copy(b, b + 9, a);
+		return true;
+	}
+};
+
+/**
+ * Small matrix kernels. 4x4 matrices. Determinant and inverse are calculated with
+ * Laplace expansion along first two rows, which requires twelve 2x2 minors.
+ */
+template <typename T>
+struct SmallMatrixKernels<4, 4, T>
+{
+	static bool Gemm(const T * a, const T * b, std::size_t cols, T * c)
+	{
+		for (std::size_t j = 0; j < cols; j++, b += 4, c += 4)
+			Gemv(a, b, c);
+		return true;
+	}
+
+	static bool Gemv(const T * a, const T * x, T * y)
+	{
+		y[0] = a[0] * x[0] + a[4] * x[1] + a[8] * x[2] + a[12] * x[3];
+		y[1] = a[1] * x[0] + a[5] * x[1] + a[9] * x[2] + a[13] * x[3];
+		y[2] = a[2] * x[0] + a[6] * x[1] + a[10] * x[2] + a[14] * x[3];
+		y[3] = a[3] * x[0] + a[7] * x[1] + a[11] * x[2] + a[15] * x[3];
+		return true;
+	}
+
+	static bool Mul(T * a, const T * b)
+	{
+		T tmp[16];
+		std::copy(a, a + 16, tmp);
+		return Gemm(tmp, b, 4, a);
+	}
+
+	static bool Transpose(T * a)
+	{
+		std::swap(a[1], a[4]);
+		std::swap(a[2], a[8]);
+		std::swap(a[3], a[12]);
+		std::swap(a[6], a[9]);
+		std::swap(a[7], a[13]);
+		std::swap(a[11], a[14]);
+		return true;
+	}
+
+	static bool Det(const T * a, T & det)
+	{
+		T s[6];
+		T c[6];
+		Minors(a, s, c);
+		det = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+		return true;
+	}
+
+	static bool Invert(T * a)
+	{
+		T s[6];
+		T c[6];
+		Minors(a, s, c);
+		T invDet = static_cast<T>(1.0) / (s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0]);
+		T b[16];
+		b[0] = (a[5] * c[5] - a[9] * c[4] + a[13] * c[3]) * invDet;
+		b[4] = (-a[4] * c[5] + a[8] * c[4] - a[12] * c[3]) * invDet;
+		b[8] = (a[7] * s[5] - a[11] * s[4] + a[15] * s[3]) * invDet;
+		b[12] = (-a[6] * s[5] + a[10] * s[4] - a[14] * s[3]) * invDet;
+		b[1] = (-a[1] * c[5] + a[9] * c[2] - a[13] * c[1]) * invDet;
+		b[5] = (a[0] * c[5] - a[8] * c[2] + a[12] * c[1]) * invDet;
+		b[9] = (-a[3] * s[5] + a[11] * s[2] - a[15] * s[1]) * invDet;
+		b[13] = (a[2] * s[5] - a[10] * s[2] + a[14] * s[1]) * invDet;
+		b[2] = (a[1] * c[4] - a[5] * c[2] + a[13] * c[0]) * invDet;
+		b[6] = (-a[0] * c[4] + a[4] * c[2] - a[12] * c[0]) * invDet;
+		b[10] = (a[3] * s[4] - a[7] * s[2] + a[15] * s[0]) * invDet;
+		b[14] = (-a[2] * s[4] + a[6] * s[2] - a[14] * s[0]) * invDet;
+		b[3] = (-a[1] * c[3] + a[5] * c[1] - a[9] * c[0]) * invDet;
+		b[7] = (a[0] * c[3] - a[4] * c[1] + a[8] * c[0]) * invDet;
+		b[11] = (-a[3] * s[3] + a[7] * s[1] - a[11] * s[0]) * invDet;
+		b[15] = (a[2] * s[3] - a[6] * s[1] + a[10] * s[0]) * invDet;
+		std::copy(b, b + 16, a);
+		return true;
+	}
+
+	/**
+	 * Calculate 2x2 minors. Minors @a s are taken from first two rows, minors @a c
+	 * are taken from last two rows of matrix.
+	 */
+	static void Minors(const T * a, T * s, T * c)
+	{
+		s[0] = a[0] * a[5] - a[1] * a[4];
+		s[1] = a[0] * a[9] - a[1] * a[8];
+		s[2] = a[0] * a[13] - a[1] * a[12];
+		s[3] = a[4] * a[9] - a[5] * a[8];
+		s[4] = a[4] * a[13] - a[5] * a[12];
+		s[5] = a[8] * a[13] - a[9] * a[12];
+		c[0] = a[2] * a[7] - a[3] * a[6];
+		c[1] = a[2] * a[11] - a[3] * a[10];
+		c[2] = a[2] * a[15] - a[3] * a[14];
+		c[3] = a[6] * a[11] - a[7] * a[10];
+		c[4] = a[6] * a[15] - a[7] * a[14];
+		c[5] = a[10] * a[15] - a[11] * a[14];
+	}
+};
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_BASIC_KERNELS_HPP_ */
@@ -39,7 +39,7 @@ struct VectorTraits
 	static gpx::math::Vector<N, T> MakeUninitializedVector(std::size_t size)
 	{
 		GPX_UNUSED(size);
-		return gpx::math::Vector<N, T>(T(), 0);
+		return gpx::math::Vector<N, T>(T(), static_cast<std::size_t>(0));
 	}
 };
 
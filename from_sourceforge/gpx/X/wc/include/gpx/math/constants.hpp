@@ -23,7 +23,13 @@ namespace math {
 	};
 
 	enum eqFlagNames_t {
-		EQ_GENERAL = 0
+		EQ_GENERAL = 0,
+		EQ_SYMMETRIC = 1	///< Matrix is symmetric positive semi-definite.
+	};
+
+	enum lcpMethodNames_t {
+		LCP_PGS = 0,		///< Projected Gauss-Seidel.
+		LCP_DANTZIG = 1		///< Dantzig principal pivoting (matrix must be symmetric positive semi-definite).
 	};
 
 }
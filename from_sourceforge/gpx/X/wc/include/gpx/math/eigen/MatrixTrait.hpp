@@ -0,0 +1,75 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_EIGEN_MATRIXTRAIT_HPP_
+#define GPX_X_MATH_EIGEN_MATRIXTRAIT_HPP_
+
+#include "traits.hpp"
+#include "../basic/MatrixTrait.hpp"
+
+namespace gpx {
+namespace math {
+namespace eigen {
+
+/**
+ * Backend implementation of gpx::math::MatrixTrait<DERIVED, M, N, T, DIMSPEC>.
+ * Extends basic backend with Eigen arithmetic.
+ */
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+class MatrixTrait : public gpx::math::basic::MatrixTrait<DERIVED, M, N, T, DIMSPEC>
+{
+	typedef gpx::math::basic::MatrixTrait<DERIVED, M, N, T, DIMSPEC> Parent;
+	typedef typename MatrixMaps<T>::Map MatrixMap;
+	typedef typename MatrixMaps<T>::ConstMap ConstMatrixMap;
+
+	protected:
+		void add(gpx::math::const_MatrixRef<M, N, T> other);
+
+		void sub(gpx::math::const_MatrixRef<M, N, T> other);
+
+		void mul(gpx::math::const_MatrixRef<N, N, T> other);
+
+		void mul(T val);
+
+	private:
+		MatrixMap map();
+};
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::add(gpx::math::const_MatrixRef<M, N, T> other)
+{
+	map() += ConstMatrixMap(other.ptr(), other.rows(), other.cols());
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::sub(gpx::math::const_MatrixRef<M, N, T> other)
+{
+	map() -= ConstMatrixMap(other.ptr(), other.rows(), other.cols());
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::mul(gpx::math::const_MatrixRef<N, N, T> other)
+{
+	//product is evaluated into temporary, because of aliasing
+	map() = map() * ConstMatrixMap(other.ptr(), other.rows(), other.cols());
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::mul(T val)
+{
+	map() *= val;
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+typename MatrixTrait<DERIVED, M, N, T, DIMSPEC>::MatrixMap MatrixTrait<DERIVED, M, N, T, DIMSPEC>::map()
+{
+	return MatrixMap(Parent::derived().ptr(), Parent::derived().rows(), Parent::derived().cols());
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_EIGEN_MATRIXTRAIT_HPP_ */
@@ -0,0 +1,283 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_EIGEN_NNSOLVER_HPP_
+#define GPX_X_MATH_EIGEN_NNSOLVER_HPP_
+
+#include "Solver.hpp"
+#include "../structures.hpp"
+
+#include <vector>
+
+namespace gpx {
+namespace math {
+namespace eigen {
+
+/**
+ * Non-negative linear equation solver workspace. Holds scratch storage of the solver.
+ * Active system, right hand side and solution are kept in storage of workspace
+ * capacity. Note that Eigen decompositions resize their own storage whenever size of
+ * factorized system changes, so with this backend solver may allocate memory even if
+ * workspace capacity is sufficient.
+ * @param N linear system size in terms of number of equations.
+ * @param T underlying type.
+ */
+template <std::size_t N, typename T>
+class NNSolverWorkspace
+{
+	template <int, std::size_t, typename>
+	friend class NNSolver;
+
+	protected:
+		NNSolverWorkspace();
+
+		std::size_t capacity() const;
+
+		void reserve(std::size_t size);
+
+	private:
+		typedef std::vector<std::size_t> IndicesContainer;
+		typedef std::vector<bool> FlagsContainer;
+
+	protected:
+		template <std::size_t M>
+		static void Reserve(gpx::math::Matrix<M, M, T> & a, std::size_t size);
+
+		static void Reserve(gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> & a, std::size_t size);
+
+		template <std::size_t M>
+		static void Reserve(gpx::math::Vector<M, T> & v, std::size_t size);
+
+		static void Reserve(gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> & v, std::size_t size);
+
+	private:
+		std::size_t m_capacity;
+		typename Decompositions<T>::Plain m_a;
+		typename Decompositions<T>::PlainVector m_x;
+		typename Decompositions<T>::LDLT m_ldlt;
+		typename Decompositions<T>::LU m_lu;
+		IndicesContainer m_active;
+		FlagsContainer m_clipped;
+};
+
+template <std::size_t N, typename T>
+NNSolverWorkspace<N, T>::NNSolverWorkspace():
+	m_capacity(0)
+{
+	reserve(N);
+}
+
+template <std::size_t N, typename T>
+std::size_t NNSolverWorkspace<N, T>::capacity() const
+{
+	return m_capacity;
+}
+
+template <std::size_t N, typename T>
+void NNSolverWorkspace<N, T>::reserve(std::size_t size)
+{
+	if (size <= m_capacity)
+		return;
+
+	m_a.resize(size, size);
+	m_x.resize(size);
+	m_active.reserve(size);
+	m_clipped.reserve(size);
+	m_capacity = size;
+}
+
+template <std::size_t N, typename T>
+template <std::size_t M>
+void NNSolverWorkspace<N, T>::Reserve(gpx::math::Matrix<M, M, T> & , std::size_t )
+{
+	//fixed size matrix
+}
+
+template <std::size_t N, typename T>
+void NNSolverWorkspace<N, T>::Reserve(gpx::math::Matrix<gpx::math::SIZE_DYNAMIC, gpx::math::SIZE_DYNAMIC, T> & a, std::size_t size)
+{
+	a.reserve(size);
+}
+
+template <std::size_t N, typename T>
+template <std::size_t M>
+void NNSolverWorkspace<N, T>::Reserve(gpx::math::Vector<M, T> & , std::size_t )
+{
+	//fixed size vector
+}
+
+template <std::size_t N, typename T>
+void NNSolverWorkspace<N, T>::Reserve(gpx::math::Vector<gpx::math::SIZE_DYNAMIC, T> & v, std::size_t size)
+{
+	v.reserve(size);
+}
+
+/**
+ * Non-negative linear equation solver. Eigen implementation, using LU decomposition
+ * with complete pivoting. Equations, which give negative results, are clipped from
+ * the system and remaining ones are solved again.
+ * @param EQ_FLAGS flags indicating equation type.
+ * @param N linear system size in terms of number of equations.
+ * @param T underlying type.
+ */
+template <int EQ_FLAGS, std::size_t N, typename T>
+class NNSolver
+{
+	template <int, std::size_t, typename>
+	friend class NNSolver;
+
+	protected:
+		NNSolver(gpx::math::MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace);
+
+		void solve(gpx::math::VectorRef<N, T> b, gpx::math::VectorRef<N, T> result);
+
+	private:
+		gpx::math::MatrixRef<N, N, T> m_a;
+		NNSolverWorkspace<N, T> & m_workspace;
+};
+
+template <int EQ_FLAGS, std::size_t N, typename T>
+NNSolver<EQ_FLAGS, N, T>::NNSolver(gpx::math::MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace):
+	m_a(a),
+	m_workspace(workspace)
+{
+}
+
+template <int EQ_FLAGS, std::size_t N, typename T>
+void NNSolver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N, T> b, gpx::math::VectorRef<N, T> result)
+{
+	m_workspace.reserve(b.size());
+	std::vector<bool> & clipped = m_workspace.m_clipped;
+	clipped.assign(b.size(), false);
+	std::vector<std::size_t> & active = m_workspace.m_active;
+
+	//each pass clips at least one equation, so number of passes is limited by system size
+	for (std::size_t pass = 0; pass <= b.size(); pass++) {
+		active.clear();
+		for (std::size_t i = 0; i < b.size(); i++)
+			if (!clipped[i])
+				active.push_back(i);
+		Eigen::Index n = static_cast<Eigen::Index>(active.size());
+
+		for (Eigen::Index j = 0; j < n; j++) {
+			for (Eigen::Index i = 0; i < n; i++)
+				m_workspace.m_a(i, j) = m_a(active[i], active[j]);
+			m_workspace.m_x(j) = b(active[j]);
+		}
+		m_workspace.m_lu.compute(m_workspace.m_a.topLeftCorner(n, n));
+		m_workspace.m_x.head(n) = m_workspace.m_lu.solve(m_workspace.m_x.head(n));
+
+		//clip equations giving negative results
+		result.zero();
+		bool negative = false;
+		for (Eigen::Index i = 0; i < n; i++) {
+			result(active[i]) = m_workspace.m_x(i);
+			if (gpx::math::cgt(T(), result(active[i]))) {
+				GPX_DEBUG("removing negative result(" << active[i] << "): " << result(active[i]));
+				clipped[active[i]] = true;
+				negative = true;
+			} else if (result(active[i]) < T())
+				result(active[i]) = T();
+		}
+		if (!negative)
+			return;
+		result.zero();
+	}
+	GPX_WARN("could not remove negative values");
+}
+
+/**
+ * Non-negative linear equation solver (symmetric specialization). Solver uses Eigen's
+ * LDL^T factorization with diagonal pivoting. Matrix is expected to be symmetric positive
+ * semi-definite. Dependent equations of semi-definite systems yield zero results. If
+ * matrix turns out to be indefinite, solver falls back to general method. Negative
+ * results are eliminated by clipping corresponding equations from the system and
+ * solving remaining ones again.
+ * @param N linear system size in terms of number of equations.
+ * @param T underlying type.
+ */
+template <std::size_t N, typename T>
+class NNSolver<gpx::math::EQ_SYMMETRIC, N, T>
+{
+	protected:
+		NNSolver(gpx::math::MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace);
+
+		void solve(gpx::math::VectorRef<N, T> b, gpx::math::VectorRef<N, T> result);
+
+	private:
+		gpx::math::MatrixRef<N, N, T> m_a;
+		NNSolverWorkspace<N, T> & m_workspace;
+};
+
+template <std::size_t N, typename T>
+NNSolver<gpx::math::EQ_SYMMETRIC, N, T>::NNSolver(gpx::math::MatrixRef<N, N, T> a, NNSolverWorkspace<N, T> & workspace):
+	m_a(a),
+	m_workspace(workspace)
+{
+}
+
+template <std::size_t N, typename T>
+void NNSolver<gpx::math::EQ_SYMMETRIC, N, T>::solve(gpx::math::VectorRef<N, T> b, gpx::math::VectorRef<N, T> result)
+{
+	typedef Decompositions<T> D;
+
+	m_workspace.reserve(b.size());
+	std::vector<bool> & clipped = m_workspace.m_clipped;
+	clipped.assign(b.size(), false);
+	std::vector<std::size_t> & active = m_workspace.m_active;
+
+	//each pass clips at least one equation, so number of passes is limited by system size
+	for (std::size_t pass = 0; pass <= b.size(); pass++) {
+		active.clear();
+		for (std::size_t i = 0; i < b.size(); i++)
+			if (!clipped[i])
+				active.push_back(i);
+		Eigen::Index n = static_cast<Eigen::Index>(active.size());
+
+		//only lower triangle is referenced by factorization
+		for (Eigen::Index j = 0; j < n; j++) {
+			for (Eigen::Index i = j; i < n; i++)
+				m_workspace.m_a(i, j) = m_a(active[i], active[j]);
+			m_workspace.m_x(j) = b(active[j]);
+		}
+		m_workspace.m_ldlt.compute(m_workspace.m_a.topLeftCorner(n, n).template selfadjointView<Eigen::Lower>());
+		T tol = D::Tolerance(m_workspace.m_a.topLeftCorner(n, n));
+		if (m_workspace.m_ldlt.info() != Eigen::Success || !D::SemiDefinite(m_workspace.m_ldlt, tol)) {
+			GPX_DEBUG("matrix is not positive semi-definite, falling back to general solver");
+			NNSolver<gpx::math::EQ_GENERAL, N, T> general(m_a, m_workspace);
+			general.solve(b, result);
+			return;
+		}
+		D::Solve(m_workspace.m_ldlt, tol, m_workspace.m_x.head(n));
+
+		//clip equations giving negative results
+		result.zero();
+		bool negative = false;
+		for (Eigen::Index i = 0; i < n; i++) {
+			result(active[i]) = m_workspace.m_x(i);
+			if (gpx::math::cgt(T(), result(active[i]))) {
+				GPX_DEBUG("removing negative result(" << active[i] << "): " << result(active[i]));
+				clipped[active[i]] = true;
+				negative = true;
+			} else if (result(active[i]) < T())
+				result(active[i]) = T();
+		}
+		if (!negative)
+			return;
+		result.zero();
+	}
+	GPX_WARN("could not remove negative values");
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_EIGEN_NNSOLVER_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
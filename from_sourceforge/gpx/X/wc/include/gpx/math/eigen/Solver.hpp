@@ -0,0 +1,187 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_EIGEN_SOLVER_HPP_
+#define GPX_X_MATH_EIGEN_SOLVER_HPP_
+
+#include "traits.hpp"
+#include "../functions.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gpx {
+namespace math {
+namespace eigen {
+
+/**
+ * Eigen decompositions. Helper functions shared by solvers. Equations, which turn out
+ * to be dependent, yield zero results (the same way as in basic backend).
+ * @param T underlying type.
+ */
+template <typename T>
+struct Decompositions
+{
+	typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> Plain;
+	typedef Eigen::Matrix<T, Eigen::Dynamic, 1> PlainVector;
+	typedef Eigen::LDLT<Plain> LDLT;
+	typedef Eigen::FullPivLU<Plain> LU;
+
+	/**
+	 * Get tolerance. Diagonal elements of LDL^T factorization, which are within
+	 * tolerance, are treated as zeroes.
+	 * @param a factorized matrix.
+	 * @return tolerance for factorization of matrix @a a.
+	 */
+	template <class MATRIX>
+	static T Tolerance(const MATRIX & a);
+
+	/**
+	 * Check whether matrix is positive semi-definite.
+	 * @param ldlt LDL^T factorization of matrix.
+	 * @param tol tolerance obtained with Tolerance().
+	 * @return @p true if none of diagonal elements of factorization is negative
+	 * (within tolerance), @p false otherwise.
+	 */
+	static bool SemiDefinite(const LDLT & ldlt, T tol);
+
+	/**
+	 * Solve in place using LDL^T factorization of positive semi-definite matrix.
+	 * @param ldlt LDL^T factorization.
+	 * @param tol tolerance obtained with Tolerance().
+	 * @param x view (map or block) of a vector, which holds right hand side on input
+	 * and obtains solution on output.
+	 */
+	template <class VECTOR>
+	static void Solve(const LDLT & ldlt, T tol, VECTOR x);
+};
+
+template <typename T>
+template <class MATRIX>
+T Decompositions<T>::Tolerance(const MATRIX & a)
+{
+	T maxDiag = a.rows() ? a.diagonal().cwiseAbs().maxCoeff() : T();
+	return static_cast<T>(a.rows()) * static_cast<T>(gpx::math::absEps(maxDiag));
+}
+
+template <typename T>
+bool Decompositions<T>::SemiDefinite(const LDLT & ldlt, T tol)
+{
+	for (Eigen::Index i = 0; i < ldlt.vectorD().size(); i++)
+		if (ldlt.vectorD()(i) < -tol)
+			return false;
+	return true;
+}
+
+template <typename T>
+template <class VECTOR>
+void Decompositions<T>::Solve(const LDLT & ldlt, T tol, VECTOR x)
+{
+	//x = P b
+	for (Eigen::Index i = 0; i < x.size(); i++)
+		std::swap(x(i), x(ldlt.transpositionsP().coeff(i)));
+	ldlt.matrixL().solveInPlace(x);
+	//pseudo-inverse of D, so that dependent equations yield zero
+	for (Eigen::Index i = 0; i < x.size(); i++)
+		x(i) = (ldlt.vectorD()(i) > tol) ? x(i) / ldlt.vectorD()(i) : T();
+	ldlt.matrixU().solveInPlace(x);
+	//x = P^T x
+	for (Eigen::Index i = x.size(); i-- > 0;)
+		std::swap(x(i), x(ldlt.transpositionsP().coeff(i)));
+}
+
+/**
+ * Linear equation solver. Eigen implementation, using LU decomposition with complete
+ * pivoting.
+ * @param EQ_FLAGS flags indicating equation type.
+ * @param N linear system size in terms of number of equations.
+ * @param T underlying type.
+ */
+template <int EQ_FLAGS, std::size_t N, typename T>
+class Solver
+{
+	protected:
+		Solver(gpx::math::Matrix<N, N, T> & a);
+
+	protected:
+		gpx::math::Vector<N, T> solve(gpx::math::VectorRef<N, T> b);
+
+	private:
+		gpx::math::Matrix<N, N, T> & m_a;
+};
+
+template <int EQ_FLAGS, std::size_t N, typename T>
+Solver<EQ_FLAGS, N, T>::Solver(gpx::math::Matrix<N, N, T> & a):
+	m_a(a)
+{
+}
+
+template <int EQ_FLAGS, std::size_t N, typename T>
+gpx::math::Vector<N, T> Solver<EQ_FLAGS, N, T>::solve(gpx::math::VectorRef<N, T> b)
+{
+	typename Decompositions<T>::LU lu(typename MatrixMaps<T>::ConstMap(m_a.ptr(), m_a.rows(), m_a.cols()));
+	gpx::math::Vector<N, T> result(T(), b.size());
+	typename VectorMaps<N, T>::Map(result.ptr(), result.size()) = lu.solve(typename VectorMaps<N, T>::ConstMap(b.ptr(), b.size()));
+	return result;
+}
+
+/**
+ * Linear equation solver (symmetric specialization). Solver uses Eigen's LDL^T
+ * factorization with diagonal pivoting. Matrix is expected to be symmetric positive
+ * semi-definite. If matrix turns out to be indefinite, solver falls back to general
+ * method.
+ * @param N linear system size in terms of number of equations.
+ * @param T underlying type.
+ */
+template <std::size_t N, typename T>
+class Solver<gpx::math::EQ_SYMMETRIC, N, T>
+{
+	protected:
+		Solver(gpx::math::Matrix<N, N, T> & a);
+
+	protected:
+		gpx::math::Vector<N, T> solve(gpx::math::VectorRef<N, T> b);
+
+	private:
+		gpx::math::Matrix<N, N, T> & m_a;
+};
+
+template <std::size_t N, typename T>
+Solver<gpx::math::EQ_SYMMETRIC, N, T>::Solver(gpx::math::Matrix<N, N, T> & a):
+	m_a(a)
+{
+}
+
+template <std::size_t N, typename T>
+gpx::math::Vector<N, T> Solver<gpx::math::EQ_SYMMETRIC, N, T>::solve(gpx::math::VectorRef<N, T> b)
+{
+	typedef Decompositions<T> D;
+
+	typename MatrixMaps<T>::ConstMap a(m_a.ptr(), m_a.rows(), m_a.cols());
+	typename D::LDLT ldlt(a);
+	T tol = D::Tolerance(a);
+	gpx::math::Vector<N, T> result(b);
+	typename VectorMaps<N, T>::Map x(result.ptr(), result.size());
+	if (ldlt.info() == Eigen::Success && D::SemiDefinite(ldlt, tol))
+		D::Solve(ldlt, tol, x);
+	else {
+		GPX_DEBUG("matrix is not positive semi-definite, falling back to general solver");
+		x = typename D::LU(a).solve(typename VectorMaps<N, T>::ConstMap(b.ptr(), b.size()));
+	}
+	return result;
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_EIGEN_SOLVER_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_EIGEN_SPARSESOLVER_HPP_
+#define GPX_X_MATH_EIGEN_SPARSESOLVER_HPP_
+
+#include "../SparseMatrix.hpp"
+#include "../functions.hpp"
+
+#include <Eigen/SparseCore>
+#include <Eigen/SparseCholesky>
+
+#include <algorithm>
+#include <vector>
+
+namespace gpx {
+namespace math {
+namespace eigen {
+
+/**
+ * Sparse direct solver of symmetric positive definite systems. Eigen implementation,
+ * using simplicial LDL^T factorization (Eigen::SimplicialLDLT). Factorization fails if
+ * matrix is not symmetric or if any diagonal element of factorization is not positive
+ * (within tolerance), so that singular and indefinite systems are left to iterative
+ * methods.
+ * @param T underlying type.
+ */
+template <typename T>
+class SparseSolver
+{
+	public:
+		/**
+		 * Factorize matrix. Rows with non-positive diagonal elements are treated as
+		 * removed equations. Their unknowns are fixed at zero.
+		 * @param a compressed symmetric matrix.
+		 * @return @p true if matrix has been factorized, @p false otherwise.
+		 */
+		bool factorize(const gpx::math::SparseMatrix<T> & a);
+
+		/**
+		 * Solve system factorized by last successful call to factorize().
+		 * @param b right hand side.
+		 * @param x solution.
+		 */
+		void solve(gpx::math::const_VectorRef<gpx::math::SIZE_DYNAMIC, T> b, gpx::math::VectorRef<gpx::math::SIZE_DYNAMIC, T> x);
+
+	private:
+		typedef Eigen::SparseMatrix<T> Plain;
+		typedef Eigen::Matrix<T, Eigen::Dynamic, 1> PlainVector;
+		typedef Eigen::SimplicialLDLT<Plain> LDLT;
+		typedef std::vector<Eigen::Triplet<T> > TripletsContainer;
+		typedef std::vector<bool> FlagsContainer;
+
+	private:
+		Plain m_a;
+		PlainVector m_b;
+		PlainVector m_x;
+		LDLT m_ldlt;
+		TripletsContainer m_triplets;
+		FlagsContainer m_removed;
+};
+
+template <typename T>
+bool SparseSolver<T>::factorize(const gpx::math::SparseMatrix<T> & a)
+{
+	GPX_ASSERT(a.compressed(), "matrix has to be compressed");
+	GPX_ASSERT(a.rows() == a.cols(), "matrix has to be square");
+
+	std::size_t n = a.rows();
+	m_removed.assign(n, false);
+	T maxDiag = T();
+	for (std::size_t i = 0; i < n; i++) {
+		T aii = a.get(i, i);
+		m_removed[i] = aii <= T();
+		maxDiag = std::max(maxDiag, aii);
+	}
+
+	//removed equations are replaced by identity, so that their unknowns stay zero
+	m_triplets.clear();
+	for (std::size_t i = 0; i < n; i++) {
+		if (m_removed[i]) {
+			m_triplets.push_back(Eigen::Triplet<T>(static_cast<int>(i), static_cast<int>(i), static_cast<T>(1.0)));
+			continue;
+		}
+		for (std::size_t k = a.rowBegin(i); k < a.rowEnd(i); k++) {
+			std::size_t j = a.col(k);
+			if (m_removed[j])
+				continue;
+			if ((j > i) && (a.val(k) != a.get(j, i)))
+				return false;	//factorization reads lower triangle only, matrix has to be symmetric
+			m_triplets.push_back(Eigen::Triplet<T>(static_cast<int>(i), static_cast<int>(j), a.val(k)));
+		}
+	}
+	m_a.resize(static_cast<Eigen::Index>(n), static_cast<Eigen::Index>(n));
+	m_a.setFromTriplets(m_triplets.begin(), m_triplets.end());
+
+	m_ldlt.compute(m_a);
+	if (m_ldlt.info() != Eigen::Success)
+		return false;
+	T tol = static_cast<T>(n) * static_cast<T>(gpx::math::absEps(maxDiag));
+	for (Eigen::Index i = 0; i < m_ldlt.vectorD().size(); i++)
+		if (!(m_ldlt.vectorD()(i) > tol))
+			return false;
+	return true;
+}
+
+template <typename T>
+void SparseSolver<T>::solve(gpx::math::const_VectorRef<gpx::math::SIZE_DYNAMIC, T> b, gpx::math::VectorRef<gpx::math::SIZE_DYNAMIC, T> x)
+{
+	m_b.resize(static_cast<Eigen::Index>(b.size()));
+	for (std::size_t i = 0; i < b.size(); i++)
+		m_b(static_cast<Eigen::Index>(i)) = m_removed[i] ? T() : b(i);
+	m_x = m_ldlt.solve(m_b);
+	for (std::size_t i = 0; i < x.size(); i++)
+		x(i) = m_x(static_cast<Eigen::Index>(i));
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_EIGEN_SPARSESOLVER_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_EIGEN_VECTORTRAIT_HPP_
+#define GPX_X_MATH_EIGEN_VECTORTRAIT_HPP_
+
+#include "traits.hpp"
+#include "../basic/VectorTrait.hpp"
+
+namespace gpx {
+namespace math {
+namespace eigen {
+
+/**
+ * Backend implementation of gpx::math::VectorTrait<DERIVED, N, T, DIMSPEC>.
+ * Extends basic backend with Eigen arithmetic.
+ */
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+class VectorTrait : public gpx::math::basic::VectorTrait<DERIVED, N, T, DIMSPEC>
+{
+	typedef gpx::math::basic::VectorTrait<DERIVED, N, T, DIMSPEC> Parent;
+	typedef typename VectorMaps<N, T>::Map Map;
+	typedef typename VectorMaps<N, T>::ConstMap ConstMap;
+	typedef typename MatrixMaps<T>::ConstMap ConstMatrixMap;
+
+	protected:
+		void add(gpx::math::const_VectorRef<N, T> other);
+
+		void sub(gpx::math::const_VectorRef<N, T> other);
+
+		void mul(T scalar);
+
+		void mul(gpx::math::const_MatrixRef<N, N, T> matrix);
+
+		void div(T scalar);
+
+	private:
+		Map map();
+};
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::add(gpx::math::const_VectorRef<N, T> other)
+{
+	map() += ConstMap(other.ptr(), other.size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::sub(gpx::math::const_VectorRef<N, T> other)
+{
+	map() -= ConstMap(other.ptr(), other.size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::mul(T scalar)
+{
+	map() *= scalar;
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::mul(gpx::math::const_MatrixRef<N, N, T> matrix)
+{
+	//row vector times matrix (product is evaluated into temporary, because of aliasing)
+	map() = ConstMatrixMap(matrix.ptr(), matrix.rows(), matrix.cols()).transpose() * map();
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::div(T scalar)
+{
+	map() /= scalar;
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+typename VectorTrait<DERIVED, N, T, DIMSPEC>::Map VectorTrait<DERIVED, N, T, DIMSPEC>::map()
+{
+	return Map(Parent::derived().ptr(), Parent::derived().size());
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_EIGEN_VECTORTRAIT_HPP_ */
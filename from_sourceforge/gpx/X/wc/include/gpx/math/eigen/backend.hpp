@@ -0,0 +1,22 @@
+/**
+ * @file
+ * @brief .
+ *
+ * Eigen backend requires Eigen 3 headers (http://eigen.tuxfamily.org) to be available
+ * on include path. Eigen is shipped in Eigen/include directory next to gpx sources.
+ */
+
+#ifndef GPX_X_MATH_EIGEN_BACKEND_HPP_
+#define GPX_X_MATH_EIGEN_BACKEND_HPP_
+
+#define GPX_X_MATH_BACKEND_NAMESPACE gpx::math::eigen
+#define GPX_X_MATH_BACKEND_CONST_VECTORTRAIT_HEADER "eigen/const_VectorTrait.hpp"
+#define GPX_X_MATH_BACKEND_VECTORTRAIT_HEADER "eigen/VectorTrait.hpp"
+#define GPX_X_MATH_BACKEND_CONST_MATRIXTRAIT_HEADER "eigen/const_MatrixTrait.hpp"
+#define GPX_X_MATH_BACKEND_MATRIXTRAIT_HEADER "eigen/MatrixTrait.hpp"
+#define GPX_X_MATH_BACKEND_SOLVER_HEADER "eigen/Solver.hpp"
+#define GPX_X_MATH_BACKEND_NNSOLVER_HEADER "eigen/NNSolver.hpp"
+#define GPX_X_MATH_BACKEND_LCPSOLVER_HEADER "eigen/LCPSolver.hpp"
+#define GPX_X_MATH_BACKEND_SPARSESOLVER_HEADER "eigen/SparseSolver.hpp"
+
+#endif /* GPX_X_MATH_EIGEN_BACKEND_HPP_ */
@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_EIGEN_CONST_MATRIXTRAIT_HPP_
+#define GPX_X_MATH_EIGEN_CONST_MATRIXTRAIT_HPP_
+
+#include "traits.hpp"
+#include "../basic/const_MatrixTrait.hpp"
+
+namespace gpx {
+namespace math {
+namespace eigen {
+
+/**
+ * Backend implementation of gpx::math::const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>.
+ * Extends basic backend with Eigen matrix-vector and matrix-matrix products.
+ */
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+class const_MatrixTrait : public gpx::math::basic::const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>
+{
+	typedef gpx::math::basic::const_MatrixTrait<DERIVED, M, N, T, DIMSPEC> Parent;
+	typedef typename MatrixMaps<T>::Map MatrixMap;
+	typedef typename MatrixMaps<T>::ConstMap ConstMatrixMap;
+
+	protected:
+		using Parent::prod;
+
+		template <std::size_t ON>
+		gpx::math::Matrix<M, ON, T> prod(gpx::math::const_MatrixRef<N, ON, T> other) const;
+
+		gpx::math::Vector<M, T> prod(gpx::math::const_VectorRef<N, T> other) const;
+
+	private:
+		ConstMatrixMap map() const;
+};
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+template <std::size_t ON>
+gpx::math::Matrix<M, ON, T> const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::prod(gpx::math::const_MatrixRef<N, ON, T> other) const
+{
+	gpx::math::Matrix<M, ON, T> result = gpx::math::basic::MatrixTraits<M, ON, T>::MakeUninitializedMatrix(Parent::derived().rows(), other.cols());
+	MatrixMap(result.ptr(), result.rows(), result.cols()).noalias() = map() * ConstMatrixMap(other.ptr(), other.rows(), other.cols());
+	return result;
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+gpx::math::Vector<M, T> const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::prod(gpx::math::const_VectorRef<N, T> vec) const
+{
+	gpx::math::Vector<M, T> result = gpx::math::basic::VectorTraits<M, T>::MakeUninitializedVector(Parent::derived().rows());
+	typename VectorMaps<M, T>::Map(result.ptr(), result.size()).noalias() = map() * typename VectorMaps<N, T>::ConstMap(vec.ptr(), vec.size());
+	return result;
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+typename const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::ConstMatrixMap const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::map() const
+{
+	return ConstMatrixMap(Parent::derived().ptr(), Parent::derived().rows(), Parent::derived().cols());
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_EIGEN_CONST_MATRIXTRAIT_HPP_ */
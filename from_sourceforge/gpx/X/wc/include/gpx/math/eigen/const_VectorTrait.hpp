@@ -0,0 +1,56 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_EIGEN_CONST_VECTORTRAIT_HPP_
+#define GPX_X_MATH_EIGEN_CONST_VECTORTRAIT_HPP_
+
+#include "traits.hpp"
+#include "../basic/const_VectorTrait.hpp"
+
+namespace gpx {
+namespace math {
+namespace eigen {
+
+/**
+ * Backend implementation of gpx::math::const_VectorTrait<DERIVED, N, T, DIMSPEC>.
+ * Extends basic backend with Eigen dot product.
+ */
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+class const_VectorTrait : public gpx::math::basic::const_VectorTrait<DERIVED, N, T, DIMSPEC>
+{
+	typedef gpx::math::basic::const_VectorTrait<DERIVED, N, T, DIMSPEC> Parent;
+	typedef typename VectorMaps<N, T>::ConstMap ConstMap;
+
+	protected:
+		T dot(gpx::math::const_VectorRef<N, T> other) const;
+
+		T dot() const;
+
+		T length() const;
+};
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+T const_VectorTrait<DERIVED, N, T, DIMSPEC>::dot(gpx::math::const_VectorRef<N, T> other) const
+{
+	return ConstMap(Parent::derived().ptr(), Parent::derived().size()).dot(ConstMap(other.ptr(), other.size()));
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+T const_VectorTrait<DERIVED, N, T, DIMSPEC>::dot() const
+{
+	return ConstMap(Parent::derived().ptr(), Parent::derived().size()).squaredNorm();
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+T const_VectorTrait<DERIVED, N, T, DIMSPEC>::length() const
+{
+	return ConstMap(Parent::derived().ptr(), Parent::derived().size()).norm();
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_EIGEN_CONST_VECTORTRAIT_HPP_ */
@@ -0,0 +1,49 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_EIGEN_TRAITS_HPP_
+#define GPX_X_MATH_EIGEN_TRAITS_HPP_
+
+#include "../structures.hpp"
+
+#include <Eigen/Dense>
+
+namespace gpx {
+namespace math {
+namespace eigen {
+
+/**
+ * Eigen views of vectors. Vector coordinates are mapped without copying. Vectors of
+ * fixed size are mapped to fixed size Eigen vectors.
+ */
+template <std::size_t N, typename T>
+struct VectorMaps
+{
+	static const int SIZE = (N == gpx::math::SIZE_DYNAMIC) ? Eigen::Dynamic : static_cast<int>(N);
+
+	typedef Eigen::Matrix<T, SIZE, 1> Plain;
+	typedef Eigen::Map<const Plain> ConstMap;
+	typedef Eigen::Map<Plain> Map;
+};
+
+/**
+ * Eigen views of matrices. Matrix elements are mapped without copying. Both frontend
+ * and Eigen store matrices in column-major order. Matrices are always mapped to
+ * dynamic size Eigen matrices, because Eigen requires fixed size single row matrices
+ * to be stored in row-major order.
+ */
+template <typename T>
+struct MatrixMaps
+{
+	typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> Plain;
+	typedef Eigen::Map<const Plain> ConstMap;
+	typedef Eigen::Map<Plain> Map;
+};
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_EIGEN_TRAITS_HPP_ */
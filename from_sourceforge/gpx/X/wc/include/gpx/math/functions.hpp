@@ -80,6 +80,7 @@ void sincos(float angle, float & sina, float & cosa)
 }
 
 //FP comparison functions, based on Donald E. Knuth "Art of computer programming" [P 4.2.2 Vol2]
+//tolerances are derived from epsilon<T>(), so that each type is compared with respect to its own precision
 
 /**
  * Approximately equal. Compares real numbers @a r1, @a r2.
@@ -96,7 +97,7 @@ bool ape(T r1, T r2)
 	std::frexp(r1, & exp1);
 	std::frexp(r2, & exp2);
 
-	return std::abs(r2 - r1) <= std::ldexp(EPS, std::max(exp1, exp2));
+	return std::abs(r2 - r1) <= std::ldexp(epsilon<T>(), std::max(exp1, exp2));
 }
 
 /**
@@ -119,7 +120,7 @@ bool ale(T r1, T r2)
 	std::frexp(r1, & exp1);
 	std::frexp(r2, & exp2);
 
-	return std::abs(r2 - r1) <= std::ldexp(EPS, std::min(exp1, exp2));
+	return std::abs(r2 - r1) <= std::ldexp(epsilon<T>(), std::min(exp1, exp2));
 }
 
 /**
@@ -135,7 +136,7 @@ bool clt(T r1, T r2)
 	std::frexp(r1, & exp1);
 	std::frexp(r2, & exp2);
 
-	return r1 - r2 < std::ldexp(EPS, std::max(exp1, exp2));
+	return r1 - r2 < std::ldexp(epsilon<T>(), std::max(exp1, exp2));
 }
 
 /**
@@ -151,7 +152,7 @@ bool cgt(T r1, T r2)
 	std::frexp(r1, & exp1);
 	std::frexp(r2, & exp2);
 
-	return r1 - r2 > std::ldexp(EPS, std::max(exp1, exp2));
+	return r1 - r2 > std::ldexp(epsilon<T>(), std::max(exp1, exp2));
 }
 
 //additional FP functions
@@ -165,12 +166,12 @@ bool cgt(T r1, T r2)
  *
  * @see absEps().
  */
-inline
-real_t eps(real_t r)
+template <typename T>
+T eps(T r)
 {
 	int exp;
 	std::frexp(r, & exp);
-	return std::ldexp(std::signbit(r) ? -EPS : EPS, exp);
+	return std::ldexp(std::signbit(r) ? -epsilon<T>() : epsilon<T>(), exp);
 }
 
 /**
@@ -182,12 +183,12 @@ real_t eps(real_t r)
  *
  * @see eps().
  */
-inline
-real_t absEps(real_t r)
+template <typename T>
+T absEps(T r)
 {
 	int exp;
 	std::frexp(r, & exp);
-	return std::ldexp(EPS, exp);
+	return std::ldexp(epsilon<T>(), exp);
 }
 
 }
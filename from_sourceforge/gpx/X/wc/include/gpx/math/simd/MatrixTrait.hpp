@@ -0,0 +1,67 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_SIMD_MATRIXTRAIT_HPP_
+#define GPX_X_MATH_SIMD_MATRIXTRAIT_HPP_
+
+#include "kernels.hpp"
+#include "../basic/MatrixTrait.hpp"
+
+namespace gpx {
+namespace math {
+namespace simd {
+
+/**
+ * Backend implementation of gpx::math::MatrixTrait<DERIVED, M, N, T, DIMSPEC>.
+ * Extends basic backend with SIMD arithmetic.
+ */
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+class MatrixTrait : public gpx::math::basic::MatrixTrait<DERIVED, M, N, T, DIMSPEC>
+{
+	typedef gpx::math::basic::MatrixTrait<DERIVED, M, N, T, DIMSPEC> Parent;
+
+	protected:
+		void add(gpx::math::const_MatrixRef<M, N, T> other);
+
+		void sub(gpx::math::const_MatrixRef<M, N, T> other);
+
+		void mul(gpx::math::const_MatrixRef<N, N, T> other);
+
+		void mul(T val);
+};
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::add(gpx::math::const_MatrixRef<M, N, T> other)
+{
+	Kernels::Add(other.ptr(), Parent::derived().ptr(), Parent::derived().size());
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::sub(gpx::math::const_MatrixRef<M, N, T> other)
+{
+	Kernels::Sub(other.ptr(), Parent::derived().ptr(), Parent::derived().size());
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::mul(gpx::math::const_MatrixRef<N, N, T> other)
+{
+	if (gpx::math::basic::SmallMatrixKernels<M, N, T>::Mul(Parent::derived().ptr(), other.ptr()))
+		return;
+	Matrix<M, N, T> tmp(Parent::derived());	//temporal copy
+	for (std::size_t c = 0; c < Parent::derived().cols(); c++)
+		Kernels::Gemv(tmp.ptr(), tmp.rows(), tmp.cols(), other.ptr() + c * other.rows(), Parent::derived().ptr() + c * Parent::derived().rows());
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+void MatrixTrait<DERIVED, M, N, T, DIMSPEC>::mul(T val)
+{
+	Kernels::Scale(val, Parent::derived().ptr(), Parent::derived().size());
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_SIMD_MATRIXTRAIT_HPP_ */
@@ -0,0 +1,82 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_SIMD_VECTORTRAIT_HPP_
+#define GPX_X_MATH_SIMD_VECTORTRAIT_HPP_
+
+#include "kernels.hpp"
+#include "../basic/VectorTrait.hpp"
+
+namespace gpx {
+namespace math {
+namespace simd {
+
+/**
+ * Backend implementation of gpx::math::VectorTrait<DERIVED, N, T, DIMSPEC>.
+ * Extends basic backend with SIMD arithmetic.
+ */
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+class VectorTrait : public gpx::math::basic::VectorTrait<DERIVED, N, T, DIMSPEC>
+{
+	typedef gpx::math::basic::VectorTrait<DERIVED, N, T, DIMSPEC> Parent;
+
+	protected:
+		void add(gpx::math::const_VectorRef<N, T> other);
+
+		void sub(gpx::math::const_VectorRef<N, T> other);
+
+		void mul(T scalar);
+
+		void mul(gpx::math::const_MatrixRef<N, N, T> matrix);
+
+		void div(T scalar);
+
+		void normalize();
+};
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::add(gpx::math::const_VectorRef<N, T> other)
+{
+	Kernels::Add(other.ptr(), Parent::derived().ptr(), Parent::derived().size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::sub(gpx::math::const_VectorRef<N, T> other)
+{
+	Kernels::Sub(other.ptr(), Parent::derived().ptr(), Parent::derived().size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::mul(T scalar)
+{
+	Kernels::Scale(scalar, Parent::derived().ptr(), Parent::derived().size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::mul(gpx::math::const_MatrixRef<N, N, T> matrix)
+{
+	//row vector times matrix, i-th coordinate is a dot product with i-th column
+	gpx::math::Vector<N, T> copy(Parent::derived());
+	for (std::size_t i = 0; i < Parent::derived().size(); i++)
+		Parent::derived().coord(i) = Kernels::Dot(copy.ptr(), matrix.ptr() + i * matrix.rows(), copy.size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::div(T scalar)
+{
+	Kernels::Div(scalar, Parent::derived().ptr(), Parent::derived().size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+void VectorTrait<DERIVED, N, T, DIMSPEC>::normalize()
+{
+	div(Parent::derived().length());
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_SIMD_VECTORTRAIT_HPP_ */
@@ -0,0 +1,19 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_SIMD_BACKEND_HPP_
+#define GPX_X_MATH_SIMD_BACKEND_HPP_
+
+#define GPX_X_MATH_BACKEND_NAMESPACE gpx::math::simd
+#define GPX_X_MATH_BACKEND_CONST_VECTORTRAIT_HEADER "simd/const_VectorTrait.hpp"
+#define GPX_X_MATH_BACKEND_VECTORTRAIT_HEADER "simd/VectorTrait.hpp"
+#define GPX_X_MATH_BACKEND_CONST_MATRIXTRAIT_HEADER "simd/const_MatrixTrait.hpp"
+#define GPX_X_MATH_BACKEND_MATRIXTRAIT_HEADER "simd/MatrixTrait.hpp"
+#define GPX_X_MATH_BACKEND_SOLVER_HEADER "simd/Solver.hpp"
+#define GPX_X_MATH_BACKEND_NNSOLVER_HEADER "simd/NNSolver.hpp"
+#define GPX_X_MATH_BACKEND_LCPSOLVER_HEADER "simd/LCPSolver.hpp"
+#define GPX_X_MATH_BACKEND_SPARSESOLVER_HEADER "simd/SparseSolver.hpp"
+
+#endif /* GPX_X_MATH_SIMD_BACKEND_HPP_ */
@@ -0,0 +1,62 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_SIMD_CONST_MATRIXTRAIT_HPP_
+#define GPX_X_MATH_SIMD_CONST_MATRIXTRAIT_HPP_
+
+#include "kernels.hpp"
+#include "../basic/const_MatrixTrait.hpp"
+
+namespace gpx {
+namespace math {
+namespace simd {
+
+/**
+ * Backend implementation of gpx::math::const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>.
+ * Extends basic backend with SIMD matrix-vector and matrix-matrix products.
+ */
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+class const_MatrixTrait : public gpx::math::basic::const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>
+{
+	typedef gpx::math::basic::const_MatrixTrait<DERIVED, M, N, T, DIMSPEC> Parent;
+
+	protected:
+		using Parent::prod;
+
+		template <std::size_t ON>
+		gpx::math::Matrix<M, ON, T> prod(gpx::math::const_MatrixRef<N, ON, T> other) const;
+
+		gpx::math::Vector<M, T> prod(gpx::math::const_VectorRef<N, T> other) const;
+};
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+template <std::size_t ON>
+gpx::math::Matrix<M, ON, T> const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::prod(gpx::math::const_MatrixRef<N, ON, T> other) const
+{
+	//each column of result is a product of this matrix and corresponding column of other matrix
+	gpx::math::Matrix<M, ON, T> result = gpx::math::basic::MatrixTraits<M, ON, T>::MakeUninitializedMatrix(Parent::derived().rows(), other.cols());
+	//small matrices are better served by unrolled kernels of basic backend
+	if (gpx::math::basic::SmallMatrixKernels<M, N, T>::Gemm(Parent::derived().ptr(), other.ptr(), other.cols(), result.ptr()))
+		return result;
+	for (std::size_t c = 0; c < other.cols(); c++)
+		Kernels::Gemv(Parent::derived().ptr(), Parent::derived().rows(), Parent::derived().cols(), other.ptr() + c * other.rows(), result.ptr() + c * result.rows());
+	return result;
+}
+
+template <template <std::size_t, std::size_t, typename> class DERIVED, std::size_t M, std::size_t N, typename T, bool DIMSPEC>
+gpx::math::Vector<M, T> const_MatrixTrait<DERIVED, M, N, T, DIMSPEC>::prod(gpx::math::const_VectorRef<N, T> vec) const
+{
+	gpx::math::Vector<M, T> result = gpx::math::basic::VectorTraits<M, T>::MakeUninitializedVector(Parent::derived().rows());
+	if (gpx::math::basic::SmallMatrixKernels<M, N, T>::Gemv(Parent::derived().ptr(), vec.ptr(), result.ptr()))
+		return result;
+	Kernels::Gemv(Parent::derived().ptr(), Parent::derived().rows(), Parent::derived().cols(), vec.ptr(), result.ptr());
+	return result;
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_SIMD_CONST_MATRIXTRAIT_HPP_ */
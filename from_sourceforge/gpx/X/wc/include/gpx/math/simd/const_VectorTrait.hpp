@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @brief .
+ */
+
+#ifndef GPX_X_MATH_SIMD_CONST_VECTORTRAIT_HPP_
+#define GPX_X_MATH_SIMD_CONST_VECTORTRAIT_HPP_
+
+#include "kernels.hpp"
+#include "../basic/const_VectorTrait.hpp"
+
+#include <cmath>
+
+namespace gpx {
+namespace math {
+namespace simd {
+
+/**
+ * Backend implementation of gpx::math::const_VectorTrait<DERIVED, N, T, DIMSPEC>.
+ * Extends basic backend with SIMD dot product.
+ */
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+class const_VectorTrait : public gpx::math::basic::const_VectorTrait<DERIVED, N, T, DIMSPEC>
+{
+	typedef gpx::math::basic::const_VectorTrait<DERIVED, N, T, DIMSPEC> Parent;
+
+	protected:
+		T dot(gpx::math::const_VectorRef<N, T> other) const;
+
+		T dot() const;
+
+		T length() const;
+};
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+T const_VectorTrait<DERIVED, N, T, DIMSPEC>::dot(gpx::math::const_VectorRef<N, T> other) const
+{
+	return Kernels::Dot(Parent::derived().ptr(), other.ptr(), Parent::derived().size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+T const_VectorTrait<DERIVED, N, T, DIMSPEC>::dot() const
+{
+	return Kernels::Dot(Parent::derived().ptr(), Parent::derived().ptr(), Parent::derived().size());
+}
+
+template <template <std::size_t, typename> class DERIVED, std::size_t N, typename T, bool DIMSPEC>
+T const_VectorTrait<DERIVED, N, T, DIMSPEC>::length() const
+{
+	return std::sqrt(dot());
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_SIMD_CONST_VECTORTRAIT_HPP_ */
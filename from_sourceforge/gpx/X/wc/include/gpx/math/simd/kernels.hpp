@@ -0,0 +1,447 @@
+/**
+ * @file
+ * @brief SIMD kernels of simd math backend.
+ */
+
+#ifndef GPX_X_MATH_SIMD_KERNELS_HPP_
+#define GPX_X_MATH_SIMD_KERNELS_HPP_
+
+#include "../../platform.hpp"
+
+#include <cstddef>
+#include <algorithm>
+
+#ifdef GPX_SIMD_AVX
+	#include <immintrin.h>
+#elif defined(GPX_SIMD_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace gpx {
+namespace math {
+namespace simd {
+
+/**
+ * Dense kernels. Kernels operate on contiguous arrays (matrices are stored in
+ * column-major order) and process them in packs (4 or 8 elements with AVX, 2 or 4
+ * elements with SSE2, depending on type), remaining elements are processed with
+ * scalar code. Types other than float and double are processed with scalar code only.
+ *
+ * Unaligned loads and stores are used, because vector and matrix storage is owned by
+ * frontend classes, which do not guarantee any particular alignment. With AVX there is
+ * virtually no penalty for unaligned access to aligned data anyway.
+ *
+ * Element-wise kernels, Axpy() and Gemv() perform exactly the same floating point
+ * operations in the same order as basic backend, so they give bit-identical results
+ * (as long as compiler does not contract floating point expressions). Dot() sums
+ * products in several partial sums, so its result may differ in the last bits.
+ */
+class Kernels
+{
+	public:
+		/**
+		 * Dot product.
+		 * @param a first array.
+		 * @param b second array.
+		 * @param n number of elements.
+		 * @return sum of products of corresponding elements of @a a and @a b.
+		 */
+		template <typename T>
+		static T Dot(const T * a, const T * b, std::size_t n);
+
+		/**
+		 * Scaled addition. Computes y = y + alpha * x.
+		 * @param alpha scalar multiplier.
+		 * @param x array to be scaled.
+		 * @param y array to be updated.
+		 * @param n number of elements.
+		 */
+		template <typename T>
+		static void Axpy(T alpha, const T * x, T * y, std::size_t n);
+
+		/**
+		 * Element-wise addition. Computes y = y + x.
+		 */
+		template <typename T>
+		static void Add(const T * x, T * y, std::size_t n);
+
+		/**
+		 * Element-wise subtraction. Computes y = y - x.
+		 */
+		template <typename T>
+		static void Sub(const T * x, T * y, std::size_t n);
+
+		/**
+		 * Scaling. Computes y = alpha * y.
+		 */
+		template <typename T>
+		static void Scale(T alpha, T * y, std::size_t n);
+
+		/**
+		 * Division. Computes y = y / alpha.
+		 */
+		template <typename T>
+		static void Div(T alpha, T * y, std::size_t n);
+
+		/**
+		 * Matrix-vector product. Computes y = A * x. Columns are fused in groups of
+		 * four, so that @a y is loaded and stored once per group.
+		 * @param a matrix elements in column-major order.
+		 * @param rows number of rows of matrix (size of @a y).
+		 * @param cols number of columns of matrix (size of @a x).
+		 * @param x vector to be multiplied.
+		 * @param y result. Must not overlap @a a or @a x.
+		 */
+		template <typename T>
+		static void Gemv(const T * a, std::size_t rows, std::size_t cols, const T * x, T * y);
+
+	private:
+#ifdef GPX_SIMD_AVX
+		struct AVXLanes;
+#endif
+
+#ifdef GPX_SIMD_SSE2
+		struct SSE2Lanes;
+#endif
+
+		template <typename T>
+		struct Lanes;
+
+		template <typename T, bool PACKED = (Lanes<T>::WIDTH > 0)>
+		struct Packs;
+};
+
+#ifdef GPX_SIMD_AVX
+/**
+ * AVX lanes.
+ */
+struct Kernels::AVXLanes
+{
+	typedef __m256d vdouble;
+	typedef __m256 vfloat;
+
+	static const std::size_t WIDTH_DOUBLE = 4;
+	static const std::size_t WIDTH_FLOAT = 8;
+
+	static vdouble Set(double x) { return _mm256_set1_pd(x); }
+	static vdouble Load(const double * p) { return _mm256_loadu_pd(p); }
+	static void Store(double * p, vdouble a) { _mm256_storeu_pd(p, a); }
+	static vdouble Add(vdouble a, vdouble b) { return _mm256_add_pd(a, b); }
+	static vdouble Sub(vdouble a, vdouble b) { return _mm256_sub_pd(a, b); }
+	static vdouble Mul(vdouble a, vdouble b) { return _mm256_mul_pd(a, b); }
+	static vdouble Div(vdouble a, vdouble b) { return _mm256_div_pd(a, b); }
+	static vdouble Zero(double) { return _mm256_setzero_pd(); }
+
+	static double Sum(vdouble a)
+	{
+		__m128d s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+	}
+
+	static vfloat Set(float x) { return _mm256_set1_ps(x); }
+	static vfloat Load(const float * p) { return _mm256_loadu_ps(p); }
+	static void Store(float * p, vfloat a) { _mm256_storeu_ps(p, a); }
+	static vfloat Add(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+	static vfloat Sub(vfloat a, vfloat b) { return _mm256_sub_ps(a, b); }
+	static vfloat Mul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+	static vfloat Div(vfloat a, vfloat b) { return _mm256_div_ps(a, b); }
+	static vfloat Zero(float) { return _mm256_setzero_ps(); }
+
+	static float Sum(vfloat a)
+	{
+		__m128 s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+		s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+		return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+	}
+};
+#endif
+
+#ifdef GPX_SIMD_SSE2
+/**
+ * SSE2 lanes.
+ */
+struct Kernels::SSE2Lanes
+{
+	typedef __m128d vdouble;
+	typedef __m128 vfloat;
+
+	static const std::size_t WIDTH_DOUBLE = 2;
+	static const std::size_t WIDTH_FLOAT = 4;
+
+	static vdouble Set(double x) { return _mm_set1_pd(x); }
+	static vdouble Load(const double * p) { return _mm_loadu_pd(p); }
+	static void Store(double * p, vdouble a) { _mm_storeu_pd(p, a); }
+	static vdouble Add(vdouble a, vdouble b) { return _mm_add_pd(a, b); }
+	static vdouble Sub(vdouble a, vdouble b) { return _mm_sub_pd(a, b); }
+	static vdouble Mul(vdouble a, vdouble b) { return _mm_mul_pd(a, b); }
+	static vdouble Div(vdouble a, vdouble b) { return _mm_div_pd(a, b); }
+	static vdouble Zero(double) { return _mm_setzero_pd(); }
+
+	static double Sum(vdouble a)
+	{
+		return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+	}
+
+	static vfloat Set(float x) { return _mm_set1_ps(x); }
+	static vfloat Load(const float * p) { return _mm_loadu_ps(p); }
+	static void Store(float * p, vfloat a) { _mm_storeu_ps(p, a); }
+	static vfloat Add(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+	static vfloat Sub(vfloat a, vfloat b) { return _mm_sub_ps(a, b); }
+	static vfloat Mul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+	static vfloat Div(vfloat a, vfloat b) { return _mm_div_ps(a, b); }
+	static vfloat Zero(float) { return _mm_setzero_ps(); }
+
+	static float Sum(vfloat a)
+	{
+		__m128 s = _mm_add_ps(a, _mm_movehl_ps(a, a));
+		return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+	}
+};
+#endif
+
+/**
+ * Lanes selector. Picks widest instruction set available for type @a T. Zero width
+ * means that only scalar code is available.
+ */
+template <typename T>
+struct Kernels::Lanes
+{
+	static const std::size_t WIDTH = 0;
+};
+
+#ifdef GPX_SIMD_AVX
+template <>
+struct Kernels::Lanes<double>
+{
+	typedef AVXLanes Type;
+	typedef AVXLanes::vdouble Vector;
+	static const std::size_t WIDTH = AVXLanes::WIDTH_DOUBLE;
+};
+
+template <>
+struct Kernels::Lanes<float>
+{
+	typedef AVXLanes Type;
+	typedef AVXLanes::vfloat Vector;
+	static const std::size_t WIDTH = AVXLanes::WIDTH_FLOAT;
+};
+#elif defined(GPX_SIMD_SSE2)
+template <>
+struct Kernels::Lanes<double>
+{
+	typedef SSE2Lanes Type;
+	typedef SSE2Lanes::vdouble Vector;
+	static const std::size_t WIDTH = SSE2Lanes::WIDTH_DOUBLE;
+};
+
+template <>
+struct Kernels::Lanes<float>
+{
+	typedef SSE2Lanes Type;
+	typedef SSE2Lanes::vfloat Vector;
+	static const std::size_t WIDTH = SSE2Lanes::WIDTH_FLOAT;
+};
+#endif
+
+/**
+ * Packed kernels. Generic version, which does not process any elements. Each function
+ * returns number of elements, which have been processed.
+ */
+template <typename T, bool PACKED>
+struct Kernels::Packs
+{
+	static std::size_t Dot(const T * , const T * , std::size_t , T & ) { return 0; }
+
+	static std::size_t Axpy(T , const T * , T * , std::size_t ) { return 0; }
+
+	static std::size_t Add(const T * , T * , std::size_t ) { return 0; }
+
+	static std::size_t Sub(const T * , T * , std::size_t ) { return 0; }
+
+	static std::size_t Scale(T , T * , std::size_t ) { return 0; }
+
+	static std::size_t Div(T , T * , std::size_t ) { return 0; }
+
+	static std::size_t Gemv4(const T * , std::size_t , const T * , T * ) { return 0; }
+};
+
+/**
+ * Packed kernels. Elements are processed in packs of Lanes<T>::WIDTH elements as long
+ * as whole pack fits into an array.
+ */
+template <typename T>
+struct Kernels::Packs<T, true>
+{
+	typedef typename Lanes<T>::Type L;
+	typedef typename Lanes<T>::Vector V;
+	static const std::size_t W = Lanes<T>::WIDTH;
+
+	static std::size_t Dot(const T * a, const T * b, std::size_t n, T & result)
+	{
+		std::size_t i = 0;
+		V acc0 = L::Zero(T());
+		V acc1 = L::Zero(T());
+		//two accumulators hide latency of additions
+		for (; i + 2 * W <= n; i += 2 * W) {
+			acc0 = L::Add(acc0, L::Mul(L::Load(a + i), L::Load(b + i)));
+			acc1 = L::Add(acc1, L::Mul(L::Load(a + i + W), L::Load(b + i + W)));
+		}
+		for (; i + W <= n; i += W)
+			acc0 = L::Add(acc0, L::Mul(L::Load(a + i), L::Load(b + i)));
+		result = L::Sum(L::Add(acc0, acc1));
+		return i;
+	}
+
+	static std::size_t Axpy(T alpha, const T * x, T * y, std::size_t n)
+	{
+		std::size_t i = 0;
+		V va = L::Set(alpha);
+		for (; i + W <= n; i += W)
+			L::Store(y + i, L::Add(L::Load(y + i), L::Mul(L::Load(x + i), va)));
+		return i;
+	}
+
+	static std::size_t Add(const T * x, T * y, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+			L::Store(y + i, L::Add(L::Load(y + i), L::Load(x + i)));
+		return i;
+	}
+
+	static std::size_t Sub(const T * x, T * y, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+			L::Store(y + i, L::Sub(L::Load(y + i), L::Load(x + i)));
+		return i;
+	}
+
+	static std::size_t Scale(T alpha, T * y, std::size_t n)
+	{
+		std::size_t i = 0;
+		V va = L::Set(alpha);
+		for (; i + W <= n; i += W)
+			L::Store(y + i, L::Mul(L::Load(y + i), va));
+		return i;
+	}
+
+	static std::size_t Div(T alpha, T * y, std::size_t n)
+	{
+		std::size_t i = 0;
+		V va = L::Set(alpha);
+		for (; i + W <= n; i += W)
+			L::Store(y + i, L::Div(L::Load(y + i), va));
+		return i;
+	}
+
+	/**
+	 * Fused update with four columns. Computes y = y + c[0] * x[0] + c[1] * x[1] +
+	 * c[2] * x[2] + c[3] * x[3], where c[k] is k-th column starting at @a a.
+	 */
+	static std::size_t Gemv4(const T * a, std::size_t rows, const T * x, T * y)
+	{
+		std::size_t i = 0;
+		V x0 = L::Set(x[0]);
+		V x1 = L::Set(x[1]);
+		V x2 = L::Set(x[2]);
+		V x3 = L::Set(x[3]);
+		const T * c0 = a;
+		const T * c1 = c0 + rows;
+		const T * c2 = c1 + rows;
+		const T * c3 = c2 + rows;
+		for (; i + W <= rows; i += W) {
+			V acc = L::Load(y + i);
+			acc = L::Add(acc, L::Mul(L::Load(c0 + i), x0));
+			acc = L::Add(acc, L::Mul(L::Load(c1 + i), x1));
+			acc = L::Add(acc, L::Mul(L::Load(c2 + i), x2));
+			acc = L::Add(acc, L::Mul(L::Load(c3 + i), x3));
+			L::Store(y + i, acc);
+		}
+		return i;
+	}
+};
+
+template <typename T>
+inline
+T Kernels::Dot(const T * a, const T * b, std::size_t n)
+{
+	T result = T();
+	std::size_t i = Packs<T>::Dot(a, b, n, result);
+	for (; i < n; i++)
+		result += a[i] * b[i];
+	return result;
+}
+
+template <typename T>
+inline
+void Kernels::Axpy(T alpha, const T * x, T * y, std::size_t n)
+{
+	for (std::size_t i = Packs<T>::Axpy(alpha, x, y, n); i < n; i++)
+		y[i] += x[i] * alpha;
+}
+
+template <typename T>
+inline
+void Kernels::Add(const T * x, T * y, std::size_t n)
+{
+	for (std::size_t i = Packs<T>::Add(x, y, n); i < n; i++)
+		y[i] += x[i];
+}
+
+template <typename T>
+inline
+void Kernels::Sub(const T * x, T * y, std::size_t n)
+{
+	for (std::size_t i = Packs<T>::Sub(x, y, n); i < n; i++)
+		y[i] -= x[i];
+}
+
+template <typename T>
+inline
+void Kernels::Scale(T alpha, T * y, std::size_t n)
+{
+	for (std::size_t i = Packs<T>::Scale(alpha, y, n); i < n; i++)
+		y[i] *= alpha;
+}
+
+template <typename T>
+inline
+void Kernels::Div(T alpha, T * y, std::size_t n)
+{
+	for (std::size_t i = Packs<T>::Div(alpha, y, n); i < n; i++)
+		y[i] /= alpha;
+}
+
+template <typename T>
+inline
+void Kernels::Gemv(const T * a, std::size_t rows, std::size_t cols, const T * x, T * y)
+{
+	std::fill(y, y + rows, T());
+	std::size_t c = 0;
+	for (; c + 4 <= cols; c += 4) {
+		const T * col = a + c * rows;
+		std::size_t r = Packs<T>::Gemv4(col, rows, x + c, y);
+		for (; r < rows; r++) {
+			T acc = y[r];
+			acc += col[r] * x[c];
+			acc += col[r + rows] * x[c + 1];
+			acc += col[r + 2 * rows] * x[c + 2];
+			acc += col[r + 3 * rows] * x[c + 3];
+			y[r] = acc;
+		}
+	}
+	for (; c < cols; c++)
+		Axpy(x[c], a + c * rows, y, rows);
+}
+
+}
+}
+}
+
+#endif /* GPX_X_MATH_SIMD_KERNELS_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
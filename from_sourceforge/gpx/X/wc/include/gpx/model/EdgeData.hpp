@@ -0,0 +1,543 @@
+/**
+ * @file
+ * @brief Polygon edges in structure of arrays layout.
+ */
+
+#ifndef GPX_X_MODEL_EDGEDATA_HPP_
+#define GPX_X_MODEL_EDGEDATA_HPP_
+
+#include "../platform.hpp"
+#include "functions.hpp"
+
+#include <vector>
+
+#ifdef GPX_SIMD_AVX
+	#include <immintrin.h>
+#elif defined(GPX_SIMD_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace gpx {
+namespace model {
+
+/**
+ * Segment intersection kernel. Tests single segment against a range of edges given
+ * as structure of arrays (coordinates of first and second endpoints of each edge are
+ * kept in separate arrays). Edges are tested in packs (4 or 8 edges with AVX,
+ * 2 or 4 edges with SSE2, depending on real_t), remaining edges are tested with
+ * ccw(). Functions give exactly the same answers as intersect() and xintersect()
+ * respectively, as long as compiler does not contract floating point expressions
+ * (i.e. -ffp-contract=off should be used when compiling for FMA capable targets).
+ *
+ * Kernel operates on raw arrays, so it can be used with any edge storage.
+ */
+class EdgeKernel
+{
+	public:
+		/**
+		 * Find edge intersecting segment (including endpoints).
+		 * @param A first endpoint of segment.
+		 * @param B second endpoint of segment.
+		 * @param x1 x coordinates of first endpoints of edges.
+		 * @param y1 y coordinates of first endpoints of edges.
+		 * @param x2 x coordinates of second endpoints of edges.
+		 * @param y2 y coordinates of second endpoints of edges.
+		 * @param begin index of first edge to be tested.
+		 * @param end index of one past the last edge to be tested.
+		 * @return index of first edge from range [@a begin, @a end) intersecting
+		 * segment @a AB or @a end if there is no such edge.
+		 */
+		static std::size_t Intersect(const real_t * A, const real_t * B,
+				const real_t * x1, const real_t * y1, const real_t * x2, const real_t * y2,
+				std::size_t begin, std::size_t end);
+
+		/**
+		 * Find edge intersecting segment (excluding endpoints). Parameters are the
+		 * same as in case of Intersect().
+		 * @return index of first edge from range [@a begin, @a end) intersecting
+		 * segment @a AB or @a end if there is no such edge.
+		 */
+		static std::size_t XIntersect(const real_t * A, const real_t * B,
+				const real_t * x1, const real_t * y1, const real_t * x2, const real_t * y2,
+				std::size_t begin, std::size_t end);
+
+	private:
+#ifdef GPX_SIMD_AVX
+		struct AVXLanes;
+#endif
+
+#ifdef GPX_SIMD_SSE2
+		struct SSE2Lanes;
+#endif
+
+		template <typename T>
+		struct Lanes;
+
+		template <class LANES, bool EXCLUSIVE, bool PACKED = (LANES::WIDTH > 0)>
+		struct Packs;
+
+		template <class LANES, bool EXCLUSIVE>
+		static std::size_t Find(const real_t * A, const real_t * B,
+				const real_t * x1, const real_t * y1, const real_t * x2, const real_t * y2,
+				std::size_t begin, std::size_t end);
+
+		template <bool EXCLUSIVE>
+		static bool Test(const real_t * A, const real_t * B, real_t x1, real_t y1, real_t x2, real_t y2);
+};
+
+#ifdef GPX_SIMD_AVX
+/**
+ * AVX lanes.
+ */
+struct EdgeKernel::AVXLanes
+{
+	typedef __m256d vdouble;
+	typedef __m256 vfloat;
+
+	static const std::size_t WIDTH_DOUBLE = 4;
+	static const std::size_t WIDTH_FLOAT = 8;
+
+	static vdouble Set(double x) { return _mm256_set1_pd(x); }
+	static vdouble Load(const double * p) { return _mm256_loadu_pd(p); }
+	static vdouble Add(vdouble a, vdouble b) { return _mm256_add_pd(a, b); }
+	static vdouble Sub(vdouble a, vdouble b) { return _mm256_sub_pd(a, b); }
+	static vdouble Mul(vdouble a, vdouble b) { return _mm256_mul_pd(a, b); }
+	static vdouble Abs(vdouble a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+	static vdouble Gt(vdouble a, vdouble b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+	static vdouble Lt(vdouble a, vdouble b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+	static vdouble Xor(vdouble a, vdouble b) { return _mm256_xor_pd(a, b); }
+	static vdouble Or(vdouble a, vdouble b) { return _mm256_or_pd(a, b); }
+	static vdouble And(vdouble a, vdouble b) { return _mm256_and_pd(a, b); }
+	static int Mask(vdouble a) { return _mm256_movemask_pd(a); }
+	static vdouble Zero(double) { return _mm256_setzero_pd(); }
+
+	static vfloat Set(float x) { return _mm256_set1_ps(x); }
+	static vfloat Load(const float * p) { return _mm256_loadu_ps(p); }
+	static vfloat Add(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+	static vfloat Sub(vfloat a, vfloat b) { return _mm256_sub_ps(a, b); }
+	static vfloat Mul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+	static vfloat Abs(vfloat a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+	static vfloat Gt(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static vfloat Lt(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static vfloat Xor(vfloat a, vfloat b) { return _mm256_xor_ps(a, b); }
+	static vfloat Or(vfloat a, vfloat b) { return _mm256_or_ps(a, b); }
+	static vfloat And(vfloat a, vfloat b) { return _mm256_and_ps(a, b); }
+	static int Mask(vfloat a) { return _mm256_movemask_ps(a); }
+	static vfloat Zero(float) { return _mm256_setzero_ps(); }
+};
+#endif
+
+#ifdef GPX_SIMD_SSE2
+/**
+ * SSE2 lanes.
+ */
+struct EdgeKernel::SSE2Lanes
+{
+	typedef __m128d vdouble;
+	typedef __m128 vfloat;
+
+	static const std::size_t WIDTH_DOUBLE = 2;
+	static const std::size_t WIDTH_FLOAT = 4;
+
+	static vdouble Set(double x) { return _mm_set1_pd(x); }
+	static vdouble Load(const double * p) { return _mm_loadu_pd(p); }
+	static vdouble Add(vdouble a, vdouble b) { return _mm_add_pd(a, b); }
+	static vdouble Sub(vdouble a, vdouble b) { return _mm_sub_pd(a, b); }
+	static vdouble Mul(vdouble a, vdouble b) { return _mm_mul_pd(a, b); }
+	static vdouble Abs(vdouble a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+	static vdouble Gt(vdouble a, vdouble b) { return _mm_cmpgt_pd(a, b); }
+	static vdouble Lt(vdouble a, vdouble b) { return _mm_cmplt_pd(a, b); }
+	static vdouble Xor(vdouble a, vdouble b) { return _mm_xor_pd(a, b); }
+	static vdouble Or(vdouble a, vdouble b) { return _mm_or_pd(a, b); }
+	static vdouble And(vdouble a, vdouble b) { return _mm_and_pd(a, b); }
+	static int Mask(vdouble a) { return _mm_movemask_pd(a); }
+	static vdouble Zero(double) { return _mm_setzero_pd(); }
+
+	static vfloat Set(float x) { return _mm_set1_ps(x); }
+	static vfloat Load(const float * p) { return _mm_loadu_ps(p); }
+	static vfloat Add(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+	static vfloat Sub(vfloat a, vfloat b) { return _mm_sub_ps(a, b); }
+	static vfloat Mul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+	static vfloat Abs(vfloat a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+	static vfloat Gt(vfloat a, vfloat b) { return _mm_cmpgt_ps(a, b); }
+	static vfloat Lt(vfloat a, vfloat b) { return _mm_cmplt_ps(a, b); }
+	static vfloat Xor(vfloat a, vfloat b) { return _mm_xor_ps(a, b); }
+	static vfloat Or(vfloat a, vfloat b) { return _mm_or_ps(a, b); }
+	static vfloat And(vfloat a, vfloat b) { return _mm_and_ps(a, b); }
+	static int Mask(vfloat a) { return _mm_movemask_ps(a); }
+	static vfloat Zero(float) { return _mm_setzero_ps(); }
+};
+#endif
+
+/**
+ * Lanes selector. Picks widest instruction set available for type @a T. Zero width
+ * means that only scalar code is available.
+ */
+template <typename T>
+struct EdgeKernel::Lanes
+{
+	static const std::size_t WIDTH = 0;
+};
+
+#ifdef GPX_SIMD_AVX
+template <>
+struct EdgeKernel::Lanes<double>
+{
+	typedef AVXLanes Type;
+	typedef AVXLanes::vdouble Vector;
+	static const std::size_t WIDTH = AVXLanes::WIDTH_DOUBLE;
+};
+
+template <>
+struct EdgeKernel::Lanes<float>
+{
+	typedef AVXLanes Type;
+	typedef AVXLanes::vfloat Vector;
+	static const std::size_t WIDTH = AVXLanes::WIDTH_FLOAT;
+};
+#elif defined(GPX_SIMD_SSE2)
+template <>
+struct EdgeKernel::Lanes<double>
+{
+	typedef SSE2Lanes Type;
+	typedef SSE2Lanes::vdouble Vector;
+	static const std::size_t WIDTH = SSE2Lanes::WIDTH_DOUBLE;
+};
+
+template <>
+struct EdgeKernel::Lanes<float>
+{
+	typedef SSE2Lanes Type;
+	typedef SSE2Lanes::vfloat Vector;
+	static const std::size_t WIDTH = SSE2Lanes::WIDTH_FLOAT;
+};
+#endif
+
+inline
+std::size_t EdgeKernel::Intersect(const real_t * A, const real_t * B,
+		const real_t * x1, const real_t * y1, const real_t * x2, const real_t * y2,
+		std::size_t begin, std::size_t end)
+{
+	return Find<Lanes<real_t>, false>(A, B, x1, y1, x2, y2, begin, end);
+}
+
+inline
+std::size_t EdgeKernel::XIntersect(const real_t * A, const real_t * B,
+		const real_t * x1, const real_t * y1, const real_t * x2, const real_t * y2,
+		std::size_t begin, std::size_t end)
+{
+	return Find<Lanes<real_t>, true>(A, B, x1, y1, x2, y2, begin, end);
+}
+
+template <bool EXCLUSIVE>
+inline
+bool EdgeKernel::Test(const real_t * A, const real_t * B, real_t x1, real_t y1, real_t x2, real_t y2)
+{
+	real_t C[2] = {x1, y1};
+	real_t D[2] = {x2, y2};
+	if (EXCLUSIVE)
+		return xintersect(const_SegmentPtr<2>(A, B), const_SegmentPtr<2>(C, D));
+	else
+		return intersect(const_SegmentPtr<2>(A, B), const_SegmentPtr<2>(C, D));
+}
+
+/**
+ * Packed edge tests. Generic version, which does not process any edges.
+ */
+template <class LANES, bool EXCLUSIVE, bool PACKED>
+struct EdgeKernel::Packs
+{
+	static bool Find(const real_t * , const real_t * ,
+			const real_t * , const real_t * , const real_t * , const real_t * ,
+			std::size_t & , std::size_t )
+	{
+		return false;
+	}
+};
+
+/**
+ * Packed edge tests. Edges are tested in packs of LANES::WIDTH edges as long as
+ * whole pack fits into a range.
+ */
+template <class LANES, bool EXCLUSIVE>
+struct EdgeKernel::Packs<LANES, EXCLUSIVE, true>
+{
+	/**
+	 * Find edge in packs.
+	 * @param i index of first edge to be tested. On output index of intersecting
+	 * edge or index of first edge, which has not been tested.
+	 * @param end index of one past the last edge to be tested.
+	 * @return @p true if intersecting edge has been found, @p false otherwise.
+	 */
+	static bool Find(const real_t * A, const real_t * B,
+			const real_t * x1, const real_t * y1, const real_t * x2, const real_t * y2,
+			std::size_t & i, std::size_t end)
+	{
+		typedef typename LANES::Type L;
+		typedef typename LANES::Vector V;
+
+		//operations are arranged in the same order as in ccw() to produce identical results
+		V ax = L::Set(A[0]);
+		V ay = L::Set(A[1]);
+		V bx = L::Set(B[0]);
+		V by = L::Set(B[1]);
+		V abx = L::Sub(bx, ax);
+		V aby = L::Sub(by, ay);
+		V zero = L::Zero(real_t());
+		V ccwEps = L::Set(CCW_EPS);
+		for (; i + LANES::WIDTH <= end; i += LANES::WIDTH) {
+			V cx = L::Load(x1 + i);
+			V cy = L::Load(y1 + i);
+			V dx = L::Load(x2 + i);
+			V dy = L::Load(y2 + i);
+
+			//ccw(A, C, D), ccw(B, C, D), ccw(A, B, C), ccw(A, B, D) as differences of products l - r
+			V lACD = L::Mul(L::Sub(dy, ay), L::Sub(cx, ax));
+			V rACD = L::Mul(L::Sub(cy, ay), L::Sub(dx, ax));
+			V lBCD = L::Mul(L::Sub(dy, by), L::Sub(cx, bx));
+			V rBCD = L::Mul(L::Sub(cy, by), L::Sub(dx, bx));
+			V lABC = L::Mul(L::Sub(cy, ay), abx);
+			V rABC = L::Mul(aby, L::Sub(cx, ax));
+			V lABD = L::Mul(L::Sub(dy, ay), abx);
+			V rABD = L::Mul(aby, L::Sub(dx, ax));
+			V ccwACD = L::Sub(lACD, rACD);
+			V ccwBCD = L::Sub(lBCD, rBCD);
+			V ccwABC = L::Sub(lABC, rABC);
+			V ccwABD = L::Sub(lABD, rABD);
+			V tolACD = L::Mul(ccwEps, L::Add(L::Abs(lACD), L::Abs(rACD)));
+			V tolBCD = L::Mul(ccwEps, L::Add(L::Abs(lBCD), L::Abs(rBCD)));
+			V tolABC = L::Mul(ccwEps, L::Add(L::Abs(lABC), L::Abs(rABC)));
+			V tolABD = L::Mul(ccwEps, L::Add(L::Abs(lABD), L::Abs(rABD)));
+
+			V gtACD = L::Gt(ccwACD, tolACD);
+			V ltACD = L::Lt(ccwACD, L::Sub(zero, tolACD));
+			V gtBCD = L::Gt(ccwBCD, tolBCD);
+			V ltBCD = L::Lt(ccwBCD, L::Sub(zero, tolBCD));
+			V gtABC = L::Gt(ccwABC, tolABC);
+			V ltABC = L::Lt(ccwABC, L::Sub(zero, tolABC));
+			V gtABD = L::Gt(ccwABD, tolABD);
+			V ltABD = L::Lt(ccwABD, L::Sub(zero, tolABD));
+
+			int mask;
+			if (EXCLUSIVE) {
+				//signs are opposite (or both zero), when positive flag of one matches negative flag of the other
+				V differ = L::Or(L::Or(L::Xor(gtACD, ltBCD), L::Xor(ltACD, gtBCD)),
+								 L::Or(L::Xor(gtABC, ltABD), L::Xor(ltABC, gtABD)));
+				mask = ~L::Mask(differ) & ((1 << LANES::WIDTH) - 1);
+			} else {
+				//signs differ, when either positive or negative flags differ
+				V hit = L::And(L::Or(L::Xor(gtACD, gtBCD), L::Xor(ltACD, ltBCD)),
+							   L::Or(L::Xor(gtABC, gtABD), L::Xor(ltABC, ltABD)));
+				mask = L::Mask(hit);
+			}
+			if (mask) {
+				while (!(mask & 1)) {
+					mask >>= 1;
+					i++;
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+template <class LANES, bool EXCLUSIVE>
+inline
+std::size_t EdgeKernel::Find(const real_t * A, const real_t * B,
+		const real_t * x1, const real_t * y1, const real_t * x2, const real_t * y2,
+		std::size_t begin, std::size_t end)
+{
+	std::size_t i = begin;
+	if (Packs<LANES, EXCLUSIVE>::Find(A, B, x1, y1, x2, y2, i, end))
+		return i;
+	//remaining edges
+	for (; i < end; i++)
+		if (Test<EXCLUSIVE>(A, B, x1[i], y1[i], x2[i], y2[i]))
+			return i;
+	return end;
+}
+
+/**
+ * Edge data. Keeps copy of polygon edges in structure of arrays layout, which is
+ * suitable for EdgeKernel. Edge data has to be updated, whenever vertices of
+ * a polygon change.
+ */
+class EdgeData
+{
+	public:
+		/**
+		 * Default constructor. Constructs empty edge data.
+		 */
+		EdgeData();
+
+		/**
+		 * Assign edges of a polygon. Each pair of consecutive vertices (including
+		 * looping pair made of last and first vertex) forms an edge.
+		 * @param begin iterator pointing to the first vertex.
+		 * @param end iterator pointing past the last vertex.
+		 */
+		template <class IT>
+		void assign(IT begin, IT end);
+
+		/**
+		 * Remove all edges.
+		 */
+		void clear();
+
+		/**
+		 * Append edge.
+		 * @param first edge's first endpoint.
+		 * @param second edge's second endpoint.
+		 */
+		void push_back(const real_t * first, const real_t * second);
+
+		/**
+		 * Get number of edges.
+		 * @return number of edges.
+		 */
+		std::size_t size() const;
+
+		/**
+		 * Get x coordinates of first endpoints.
+		 * @return pointer to array of x coordinates of first endpoints.
+		 */
+		const real_t * x1() const;
+
+		/**
+		 * Get y coordinates of first endpoints.
+		 * @return pointer to array of y coordinates of first endpoints.
+		 */
+		const real_t * y1() const;
+
+		/**
+		 * Get x coordinates of second endpoints.
+		 * @return pointer to array of x coordinates of second endpoints.
+		 */
+		const real_t * x2() const;
+
+		/**
+		 * Get y coordinates of second endpoints.
+		 * @return pointer to array of y coordinates of second endpoints.
+		 */
+		const real_t * y2() const;
+
+		/**
+		 * Find edge intersecting segment (including endpoints).
+		 * @param A first endpoint of segment.
+		 * @param B second endpoint of segment.
+		 * @param begin index of edge, from which search begins.
+		 * @return index of first edge, starting from @a begin, which intersects
+		 * segment @a AB or size() if there is no such edge.
+		 */
+		std::size_t intersect(const real_t * A, const real_t * B, std::size_t begin = 0) const;
+
+		/**
+		 * Find edge intersecting segment (excluding endpoints).
+		 * @param A first endpoint of segment.
+		 * @param B second endpoint of segment.
+		 * @param begin index of edge, from which search begins.
+		 * @return index of first edge, starting from @a begin, which intersects
+		 * segment @a AB or size() if there is no such edge.
+		 */
+		std::size_t xintersect(const real_t * A, const real_t * B, std::size_t begin = 0) const;
+
+	private:
+		typedef std::vector<real_t> CoordsContainer;
+
+	private:
+		CoordsContainer m_x1;
+		CoordsContainer m_y1;
+		CoordsContainer m_x2;
+		CoordsContainer m_y2;
+};
+
+inline
+EdgeData::EdgeData()
+{
+}
+
+template <class IT>
+void EdgeData::assign(IT begin, IT end)
+{
+	clear();
+	if (begin == end)
+		return;
+	IT i = begin;
+	const real_t * first = *i;
+	while (++i != end) {
+		push_back(first, *i);
+		first = *i;
+	}
+	push_back(first, *begin); //looping edge
+}
+
+inline
+void EdgeData::clear()
+{
+	m_x1.clear();
+	m_y1.clear();
+	m_x2.clear();
+	m_y2.clear();
+}
+
+inline
+void EdgeData::push_back(const real_t * first, const real_t * second)
+{
+	m_x1.push_back(first[0]);
+	m_y1.push_back(first[1]);
+	m_x2.push_back(second[0]);
+	m_y2.push_back(second[1]);
+}
+
+inline
+std::size_t EdgeData::size() const
+{
+	return m_x1.size();
+}
+
+inline
+const real_t * EdgeData::x1() const
+{
+	return m_x1.empty() ? 0 : & m_x1.front();
+}
+
+inline
+const real_t * EdgeData::y1() const
+{
+	return m_y1.empty() ? 0 : & m_y1.front();
+}
+
+inline
+const real_t * EdgeData::x2() const
+{
+	return m_x2.empty() ? 0 : & m_x2.front();
+}
+
+inline
+const real_t * EdgeData::y2() const
+{
+	return m_y2.empty() ? 0 : & m_y2.front();
+}
+
+inline
+std::size_t EdgeData::intersect(const real_t * A, const real_t * B, std::size_t begin) const
+{
+	return EdgeKernel::Intersect(A, B, x1(), y1(), x2(), y2(), begin, size());
+}
+
+inline
+std::size_t EdgeData::xintersect(const real_t * A, const real_t * B, std::size_t begin) const
+{
+	return EdgeKernel::XIntersect(A, B, x1(), y1(), x2(), y2(), begin, size());
+}
+
+}
+}
+
+#endif /* GPX_X_MODEL_EDGEDATA_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
@@ -12,6 +12,15 @@
 namespace gpx {
 namespace model {
 
+/**
+ * Relative error bound of orientation determinant. Determinant computed by ccw() is
+ * a difference of two products. Its sign can be trusted only if its magnitude exceeds
+ * rounding error, which is bounded by CCW_EPS times sum of magnitudes of products.
+ * Bound depends on precision of real_t (rounding of subtractions, products and final
+ * difference gives roughly 1.5 machine epsilon).
+ */
+const real_t CCW_EPS = static_cast<real_t>(2.0) * std::numeric_limits<real_t>::epsilon();
+
 /**
  * Check orientation of triangle ABC. This function checks orientation of triangle
  * on the plane (considering two first coordinates of given vertices).
@@ -20,13 +29,17 @@ namespace model {
  * @param C triangle's third vertex.
  * @return 1 if curve is positively (or counterclockwise) oriented, -1 if curve is
  * negatively (or clockwise) oriented. When curve is non-orientable
- * (points are collinear) function returns 0.
+ * (points are collinear) function returns 0. Points are also considered to be collinear
+ * if orientation is within rounding error (see CCW_EPS).
  */
 inline
 int ccw(math::const_PointRef<2> A, math::const_PointRef<2> B, math::const_PointRef<2> C)
 {
-	real_t ccw = ((C[1] - A[1]) * (B[0] - A[0])) - ((B[1] - A[1]) * (C[0] - A[0]));
-	return ccw > 0.0 ? 1 : ccw < 0.0 ? -1 : 0;
+	real_t l = (C[1] - A[1]) * (B[0] - A[0]);
+	real_t r = (B[1] - A[1]) * (C[0] - A[0]);
+	real_t ccw = l - r;
+	real_t tol = CCW_EPS * (std::abs(l) + std::abs(r));
+	return ccw > tol ? 1 : ccw < -tol ? -1 : 0;
 }
 
 /**
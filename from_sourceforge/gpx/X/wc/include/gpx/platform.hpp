@@ -44,7 +44,17 @@
 	#define GPX_API
 #endif
 
-//math library back-end (basic) @todo: tnt_jama, eigen, armadillo...
+//SIMD instruction sets (define GPX_NO_SIMD to use scalar code only)
+#ifndef GPX_NO_SIMD
+	#if defined(__AVX__)
+		#define GPX_SIMD_AVX
+	#endif
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define GPX_SIMD_SSE2
+	#endif
+#endif
+
+//math library back-end (basic, simd, eigen) @todo: tnt_jama, armadillo...
 #ifndef GPX_X_MATH_BACKEND_HEADER
 	#define GPX_X_MATH_BACKEND_HEADER "basic/backend.hpp"
 #endif
@@ -66,6 +76,15 @@ namespace gpx {
 //machine epsilon * 0.5 is the smallest possible epsilon for which GPX approximation functions make sense
 const real_t EPS = std::numeric_limits<real_t>::epsilon() * static_cast<real_t>(0.5) * GPX_EPS_MULT;
 
+//epsilon of particular type, scaled in the same way as EPS (epsilon<real_t>() equals EPS); lets
+//code instantiated with types other than real_t (e.g. float solvers in double build) use tolerances
+//matching precision of the type
+template <typename T>
+inline T epsilon()
+{
+	return std::numeric_limits<T>::epsilon() * static_cast<T>(0.5) * static_cast<T>(GPX_EPS_MULT);
+}
+
 }
 
 //macro to stop bitching about unused parameter
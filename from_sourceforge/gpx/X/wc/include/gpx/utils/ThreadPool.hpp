@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @brief Thread pool.
+ */
+
+#ifndef GPX_X_UTILS_THREADPOOL_HPP_
+#define GPX_X_UTILS_THREADPOOL_HPP_
+
+#include "../platform.hpp"
+#include "NonCopyable.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gpx {
+namespace utils {
+
+/**
+ * Thread pool. Pool executes batches of indexed tasks. Tasks are claimed by threads in
+ * order of their indices, so caller may arrange them (e.g. most expensive first). Calling
+ * thread participates in execution, thus pool of @a n threads spawns @a n - 1 workers.
+ */
+class ThreadPool : NonCopyable
+{
+	public:
+		/**
+		 * Task function. First argument is task index, second one is index of thread
+		 * executing the task, in range [0, threads()). Thread index may be used to select
+		 * per-thread storage. Calling thread has index 0. Function must not throw.
+		 */
+		typedef std::function<void(std::size_t, std::size_t)> TaskFunction;
+
+	public:
+		/**
+		 * Constructor.
+		 * @param threads number of threads including calling thread. If 0, number of
+		 * hardware threads is used.
+		 */
+		explicit ThreadPool(std::size_t threads);
+
+		/**
+		 * Destructor. Stops worker threads.
+		 */
+		~ThreadPool();
+
+	public:
+		/**
+		 * Get number of threads.
+		 * @return number of threads including calling thread.
+		 */
+		std::size_t threads() const;
+
+		/**
+		 * Run tasks. Function returns when all tasks are finished.
+		 * @param tasks number of tasks.
+		 * @param func task function.
+		 *
+		 * @warning function is not reentrant. Do not call it from within a task.
+		 */
+		void run(std::size_t tasks, const TaskFunction & func);
+
+	private:
+		void work(std::size_t thread);
+
+		void execute(std::size_t thread);
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_startCond;
+		std::condition_variable m_doneCond;
+		const TaskFunction * m_func;
+		std::size_t m_tasks;
+		std::atomic<std::size_t> m_next;
+		std::size_t m_busy;
+		std::size_t m_generation;
+		bool m_stop;
+};
+
+
+inline
+ThreadPool::ThreadPool(std::size_t threads):
+	m_func(0),
+	m_tasks(0),
+	m_next(0),
+	m_busy(0),
+	m_generation(0),
+	m_stop(false)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	for (std::size_t i = 1; i < threads; i++)
+		m_workers.push_back(std::thread(& ThreadPool::work, this, i));
+}
+
+inline
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+		m_startCond.notify_all();
+	}
+	for (std::vector<std::thread>::iterator worker = m_workers.begin(); worker != m_workers.end(); ++worker)
+		worker->join();
+}
+
+inline
+std::size_t ThreadPool::threads() const
+{
+	return m_workers.size() + 1;
+}
+
+inline
+void ThreadPool::run(std::size_t tasks, const TaskFunction & func)
+{
+	if (m_workers.empty() || tasks < 2) {
+		for (std::size_t task = 0; task < tasks; task++)
+			func(task, 0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_func = & func;
+		m_tasks = tasks;
+		m_next = 0;
+		m_busy = m_workers.size();
+		m_generation++;
+		m_startCond.notify_all();
+	}
+	execute(0);
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (m_busy > 0)
+		m_doneCond.wait(lock);
+	m_func = 0;
+}
+
+inline
+void ThreadPool::work(std::size_t thread)
+{
+	std::size_t generation = 0;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;) {
+		while (!m_stop && m_generation == generation)
+			m_startCond.wait(lock);
+		if (m_stop)
+			return;
+		generation = m_generation;
+		lock.unlock();
+		execute(thread);
+		lock.lock();
+		if (--m_busy == 0)
+			m_doneCond.notify_one();
+	}
+}
+
+inline
+void ThreadPool::execute(std::size_t thread)
+{
+	for (std::size_t task = m_next++; task < m_tasks; task = m_next++)
+		(*m_func)(task, thread);
+}
+
+}
+}
+
+#endif /* GPX_X_UTILS_THREADPOOL_HPP_ */
+
+//(c)MP: Copyright © 2014, Michał Policht. All rights reserved.
+//(c)MP: Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met: 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer. 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//(c)MP: THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//(c)MP: The above copyright statement is OSI approved, Simplified BSD License without 3. clause.
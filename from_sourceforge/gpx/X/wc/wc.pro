@@ -7,9 +7,14 @@ DEFINES += GPX_BUILD
 #static library build
 CONFIG += static
 
+#Eigen (required by eigen math backend only)
+INCLUDEPATH += $$PWD/../../../Eigen/include
+DEPENDPATH += $$PWD/../../../Eigen/include
+
 HEADERS += \ 
     include/gpx/ext/UnorderedMap.hpp \
     include/gpx/ext/UnorderedSet.hpp \
+    include/gpx/log/AsyncLogBuf.hpp \
     include/gpx/log/Log.hpp \
     include/gpx/log/LogBuf.hpp \
     include/gpx/log/LogStream.hpp \
@@ -22,12 +27,34 @@ HEADERS += \
     include/gpx/math/basic/MatrixStorage.hpp \
     include/gpx/math/basic/MatrixStorage.imp.hpp \
     include/gpx/math/basic/NNSolver.hpp \
+    include/gpx/math/basic/LCPSolver.hpp \
     include/gpx/math/basic/Solver.hpp \
+    include/gpx/math/basic/SparseSolver.hpp \
     include/gpx/math/basic/Solver.imp.hpp \
     include/gpx/math/basic/VectorPtr.hpp \
     include/gpx/math/basic/VectorPtr.imp.hpp \
     include/gpx/math/basic/VectorPtrStorage.hpp \
     include/gpx/math/basic/VectorPtrStorage.imp.hpp \
+    include/gpx/math/eigen/backend.hpp \
+    include/gpx/math/eigen/const_MatrixTrait.hpp \
+    include/gpx/math/eigen/const_VectorTrait.hpp \
+    include/gpx/math/eigen/LCPSolver.hpp \
+    include/gpx/math/eigen/MatrixTrait.hpp \
+    include/gpx/math/eigen/NNSolver.hpp \
+    include/gpx/math/eigen/Solver.hpp \
+    include/gpx/math/eigen/SparseSolver.hpp \
+    include/gpx/math/eigen/traits.hpp \
+    include/gpx/math/eigen/VectorTrait.hpp \
+    include/gpx/math/simd/backend.hpp \
+    include/gpx/math/simd/const_MatrixTrait.hpp \
+    include/gpx/math/simd/const_VectorTrait.hpp \
+    include/gpx/math/simd/kernels.hpp \
+    include/gpx/math/simd/LCPSolver.hpp \
+    include/gpx/math/simd/MatrixTrait.hpp \
+    include/gpx/math/simd/NNSolver.hpp \
+    include/gpx/math/simd/Solver.hpp \
+    include/gpx/math/simd/SparseSolver.hpp \
+    include/gpx/math/simd/VectorTrait.hpp \
     include/gpx/math/native/_base_const_VectorPtr.hpp \
     include/gpx/math/native/_base_const_VectorPtr.imp.hpp \
     include/gpx/math/native/_base_VectorPtr.hpp \
@@ -48,6 +75,9 @@ HEADERS += \
     include/gpx/math/functions.hpp \
     include/gpx/math/Matrix.hpp \
     include/gpx/math/NNSolver.hpp \
+    include/gpx/math/LCPSolver.hpp \
+    include/gpx/math/SparseMatrix.hpp \
+    include/gpx/math/SparseLCPSolver.hpp \
     include/gpx/math/Solver.hpp \
     include/gpx/math/structures.hpp \
     include/gpx/math/Vector.hpp \
@@ -56,6 +86,7 @@ HEADERS += \
     include/gpx/model/_base_IndexedPoly_Iterator.hpp \
     include/gpx/model/_base_UnindexedPoly.hpp \
     include/gpx/model/_Poly_warning.hpp \
+    include/gpx/model/EdgeData.hpp \
     include/gpx/model/Element.hpp \
     include/gpx/model/FillData.hpp \
     include/gpx/model/functions.hpp \
@@ -74,6 +105,7 @@ HEADERS += \
     include/gpx/utils/NonCopyable.hpp \
     include/gpx/utils/Observable.hpp \
     include/gpx/utils/Singleton.hpp \
+    include/gpx/utils/ThreadPool.hpp \
     include/gpx/log.hpp \
     include/gpx/math.hpp \
     include/gpx/model.hpp \
@@ -129,6 +161,7 @@ HEADERS += \
     include/gpx/math/MatrixTrait.hpp \
     include/gpx/math/basic/const_MatrixTrait.hpp \
     include/gpx/math/basic/MatrixTrait.hpp \
+    include/gpx/math/basic/kernels.hpp \
     include/gpx/math/const_MatrixRef.hpp \
     include/gpx/math/MatrixRef.hpp \
     include/gpx/math/basic/Vector.hpp \